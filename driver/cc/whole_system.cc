@@ -36,8 +36,7 @@
 //#include "read_atmosphere.h"
 //#include "ReadTestData.hh"
 
-#include "incident_shortwave.h"
-#include "day_length.h"
+#include "solar_geometry.h"
 
 #include "canopy_hydrology.h"
 #include "surface_radiation.h"
@@ -162,8 +161,8 @@ auto t_grnd = create<ArrayD1>("t_grnd", ncells);
 auto h2ocan = create<ArrayD1>("h2ocan", ncells); // - BeginGridWaterBalance() - other stuff, too
 const double lat = 71.323;
 const double lon = 203.3886;
-const double lat_r = lat * ELM::ELM_PI / 180.0;
-const double lon_r = lon * ELM::ELM_PI / 180.0;
+auto lat_r = create<ArrayD1>("lat_r", ncells, lat * ELM::ELMconst::ELM_PI / 180.0);
+auto lon_r = create<ArrayD1>("lon_r", ncells, lon * ELM::ELMconst::ELM_PI / 180.0);
 const double dewmx = 0.1;
 const double irrig_rate = 0.0;
 const int n_irrig_steps_left = 0;
@@ -653,6 +652,11 @@ test_ZBOT.read_atm_forcing(dd, fstart, nsteps);
 auto coszen = create<ArrayD1>("coszen", ncells);
 auto cosz_factor = create<ArrayD1>("cosz_factor", ncells);
 
+// computes max_dayl once, caches declination and dayl by day
+ELM::SolarGeometry<ArrayD1> solar(lat_r, lon_r);
+auto max_dayl = solar.max_dayl;
+auto dayl = solar.dayl;
+
 ELM::Utils::Date current(start);
 ELM::Utils::Date big(start);
 int idx = 0; // hardwire for ncells = 1
@@ -664,41 +668,13 @@ time_plus_half_dt.increment_seconds(900);
 
 /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
 /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
-// get coszen - should make this a function
+// get coszen, cosz_factor, and daylength
 /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
 /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
-    double max_dayl;
-    double dayl;
     {
       ELM::Utils::Date forc_dt_start{test_FSDS.get_data_start_time()};
       forc_dt_start.increment_seconds(round(test_FSDS.forc_t_idx(time_plus_half_dt, test_FSDS.get_data_start_time()) * test_FSDS.get_forc_dt_secs()));
-      //std::cout << "forc_dt_start: " << forc_dt_start.doy << "  " << forc_dt_start.sec << "  " << forc_dt_start.year << std::endl;
-      //std::cout << "forc_dt_start: " << test_FSDS.forc_t_idx(time_plus_half_dt, test_FSDS.get_data_start_time()) << "  " << test_FSDS.get_forc_dt_secs() << std::endl;
-      //std::cout << "time_plus_half_dt: " << time_plus_half_dt.doy << "  " << time_plus_half_dt.sec << std::endl;
-      //std::cout << "current: " << current.doy << "  " << current.sec << std::endl;
-    
-      int cosz_doy = current.doy + 1;
-      //std::cout << "cosz_doy::  " << cosz_doy << std::endl;
-      double declin = ELM::incident_shortwave::declination_angle2(cosz_doy); // should be the same for model and forcing - don't cross day barrier in forcing timeseries
-      double cosz_decday = ELM::Utils::decimal_doy(current) + 1.0;
-      //std::cout << std::setprecision(15) << "cosz_decday::  " << cosz_decday << std::endl;
-      double cosz_forc_decday = ELM::Utils::decimal_doy(forc_dt_start) + 1.0;
-      //std::cout << "cosz_forc_decday::  " << cosz_forc_decday << std::endl;
-      double cosz_forcdt_avg = ELM::incident_shortwave::average_cosz(lat_r, lon_r, declin, test_FSDS.get_forc_dt_secs(), cosz_forc_decday);
-      //std::cout << "cosz_forcdt_avg::  " << cosz_forcdt_avg << std::endl;
-      double thiscosz = ELM::incident_shortwave::coszen(lat_r, lon_r, cosz_decday + dtime_d/2.0);
-      //std::cout << "thiscosz::  " << thiscosz << std::endl;
-
-      //std::cout << "test_FSDS.get_forc_dt_secs()::  " << test_FSDS.get_forc_dt_secs() << std::endl;
-    
-      //double cosz_factor = (thiscosz > 0.001) ? std::min(thiscosz/cosz_forcdt_avg, 10.0) : 0.0;
-      cosz_factor[0] = (thiscosz > 0.001) ? 1.0 : 0.0;
-      //std::cout << "cosz_factor::  " << cosz_factor << std::endl;
-      //coszen[0] = thiscosz * cosz_factor;
-      coszen[0] = thiscosz;
-      //std::cout << "coszen::  " << coszen[0] << std::endl;
-      max_dayl = ELM::max_daylength(lat_r);
-      dayl = ELM::daylength(lat_r, declin);
+      solar.update(current, dtime, forc_dt_start, test_FSDS.get_forc_dt_secs(), coszen, cosz_factor);
     }
 
 /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
@@ -1148,7 +1124,7 @@ time_plus_half_dt.increment_seconds(900);
 
     ELM::canopy_fluxes::initialize_flux(
         Land, snl[idx], frac_veg_nosno[idx], frac_sno[idx], forc_hgt_u[idx],
-        thm[idx], thv[idx], max_dayl, dayl, altmax_indx[idx], altmax_lastyear_indx[idx], 
+        thm[idx], thv[idx], max_dayl[idx], dayl[idx], altmax_indx[idx], altmax_lastyear_indx[idx], 
         t_soisno[idx], h2osoi_ice[idx], h2osoi_liq[idx], dz[idx], rootfr[idx], psnveg.tc_stress, 
         sucsat[idx], watsat[idx], bsw[idx], psnveg.smpso, psnveg.smpsc, elai[idx], esai[idx], 
         emv[idx], emg[idx], qg[idx], t_grnd[idx], forc_tbot[idx], forc_pbot[idx], forc_lwrad[idx], 
@@ -1263,8 +1239,8 @@ for (auto i : frac_sno) std::cout << "frac_sno:  " << i << std::endl;
 for (auto i : forc_hgt_u) std::cout << "forc_hgt_u:  " << i << std::endl;
 for (auto i : thm) std::cout << "thm:  " << i << std::endl;
 for (auto i : thv) std::cout << "thv:  " << i << std::endl;
-std::cout << "max_dayl:  " << max_dayl << std::endl;
-std::cout << "dayl:  " << dayl << std::endl;
+for (auto i : max_dayl) std::cout << "max_dayl:  " << i << std::endl;
+for (auto i : dayl) std::cout << "dayl:  " << i << std::endl;
 for (auto i : elai) std::cout << "elai:  " << i << std::endl;
 for (auto i : esai) std::cout << "esai:  " << i << std::endl;
 for (auto i : emv) std::cout << "emv:  " << i << std::endl;
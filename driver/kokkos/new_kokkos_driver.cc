@@ -1,9 +1,13 @@
 
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <string>
 
 // utilities
 #include "array.hh"
+#include "field_registry.hh"
+#include "profiler.hh"
 #include "read_input.hh"
 #include "read_netcdf.hh"
 #include "utils.hh"
@@ -27,9 +31,7 @@
 #include "init_topography.h"
 
 // physics kernels
-#include "day_length.h" // serial
-
-#include "incident_shortwave.h"
+#include "solar_geometry.h"
 #include "canopy_hydrology.h"
 #include "surface_radiation.h"
 #include "canopy_temperature.h"
@@ -40,6 +42,7 @@
 #include "snow_snicar.h"
 #include "surface_fluxes.h"
 #include "soil_texture_hydraulic_model.h"
+#include "state_validation.h"
 
 // conditional compilation options
 #include "invoke_kernel.hh"
@@ -57,6 +60,10 @@ using ViewD3 =  Kokkos::View<double ***>;
 using h_ViewD1 = ViewD1::HostMirror;
 using h_ViewD2 = ViewD2::HostMirror;
 using h_ViewD3 = ViewD3::HostMirror;
+// radiation partitioning and phenology fields, float with ENABLE_MIXED_PRECISION
+using ViewRad2 = Kokkos::View<ELM::RadReal **>;
+using ViewPhen1 = Kokkos::View<ELM::PhenReal *>;
+using ViewPhen3 = Kokkos::View<ELM::PhenReal ***>;
 
 
 template <class Array_t> Array_t create(const std::string &name, int D0)
@@ -81,249 +88,13 @@ atm_forc_util<ftype> create_forc_util(const std::string& filename,
 { return atm_forc_util<ftype>(filename, file_start_time, ntimes, ncells); }
 
 
-std::map<std::string, h_ViewD2> get_phen_host_views(const ELM::PhenologyDataManager<ViewD2>& phen_data)
-{
-  std::map<std::string, h_ViewD2> phen_host_views;
-  phen_host_views["MONTHLY_LAI"] = Kokkos::create_mirror_view(phen_data.mlai);
-  phen_host_views["MONTHLY_SAI"] = Kokkos::create_mirror_view(phen_data.msai);
-  phen_host_views["MONTHLY_HEIGHT_TOP"] = Kokkos::create_mirror_view(phen_data.mhtop);
-  phen_host_views["MONTHLY_HEIGHT_BOT"] = Kokkos::create_mirror_view(phen_data.mhbot);
-  return phen_host_views;
-}
-
-std::map<std::string, h_ViewD1> get_aero_host_views(const ELM::AerosolDataManager<ViewD1>& aero_data)
-{
-  std::map<std::string, h_ViewD1> aero_host_views;
-  aero_host_views["BCDEPWET"] = Kokkos::create_mirror_view(aero_data.bcdep);
-  aero_host_views["BCPHODRY"] = Kokkos::create_mirror_view(aero_data.bcpho);
-  aero_host_views["BCPHIDRY"] = Kokkos::create_mirror_view(aero_data.bcphi);
-  aero_host_views["DSTX01DD"] = Kokkos::create_mirror_view(aero_data.dst1_1);
-  aero_host_views["DSTX02DD"] = Kokkos::create_mirror_view(aero_data.dst1_2);
-  aero_host_views["DSTX03DD"] = Kokkos::create_mirror_view(aero_data.dst2_1);
-  aero_host_views["DSTX04DD"] = Kokkos::create_mirror_view(aero_data.dst2_2);
-  aero_host_views["DSTX01WD"] = Kokkos::create_mirror_view(aero_data.dst3_1);
-  aero_host_views["DSTX02WD"] = Kokkos::create_mirror_view(aero_data.dst3_2);
-  aero_host_views["DSTX03WD"] = Kokkos::create_mirror_view(aero_data.dst4_1);
-  aero_host_views["DSTX04WD"] = Kokkos::create_mirror_view(aero_data.dst4_2);
-  return aero_host_views;
-}
-
-void copy_aero_host_views(std::map<std::string, h_ViewD1>& aero_host_views, ELM::AerosolDataManager<ViewD1>& aero_data)
-{
-  Kokkos::deep_copy(aero_data.bcdep, aero_host_views["BCDEPWET"]);
-  Kokkos::deep_copy(aero_data.bcpho, aero_host_views["BCPHODRY"]);
-  Kokkos::deep_copy(aero_data.bcphi, aero_host_views["BCPHIDRY"]);
-  Kokkos::deep_copy(aero_data.dst1_1, aero_host_views["DSTX01DD"]);
-  Kokkos::deep_copy(aero_data.dst1_2, aero_host_views["DSTX02DD"]);
-  Kokkos::deep_copy(aero_data.dst2_1, aero_host_views["DSTX03DD"]);
-  Kokkos::deep_copy(aero_data.dst2_2, aero_host_views["DSTX04DD"]);
-  Kokkos::deep_copy(aero_data.dst3_1, aero_host_views["DSTX01WD"]);
-  Kokkos::deep_copy(aero_data.dst3_2, aero_host_views["DSTX02WD"]);
-  Kokkos::deep_copy(aero_data.dst4_1, aero_host_views["DSTX03WD"]);
-  Kokkos::deep_copy(aero_data.dst4_2, aero_host_views["DSTX04WD"]);
-}
-
-std::map<std::string, h_ViewD1> get_snicar_host_views_d1(const ELM::SnicarData<ViewD1, ViewD2, ViewD3>& snicar_data)
-{
-  std::map<std::string, h_ViewD1> snicar_host_views_d1;
-  snicar_host_views_d1["ss_alb_ocphil"] = Kokkos::create_mirror_view(snicar_data.ss_alb_oc1);
-  snicar_host_views_d1["asm_prm_ocphil"] = Kokkos::create_mirror_view(snicar_data.asm_prm_oc1);
-  snicar_host_views_d1["ext_cff_mss_ocphil"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_oc1);
-  snicar_host_views_d1["ss_alb_ocphob"] = Kokkos::create_mirror_view(snicar_data.ss_alb_oc2);
-  snicar_host_views_d1["asm_prm_ocphob"] = Kokkos::create_mirror_view(snicar_data.asm_prm_oc2);
-  snicar_host_views_d1["ext_cff_mss_ocphob"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_oc2);
-  snicar_host_views_d1["ss_alb_dust01"] = Kokkos::create_mirror_view(snicar_data.ss_alb_dst1);
-  snicar_host_views_d1["asm_prm_dust01"] = Kokkos::create_mirror_view(snicar_data.asm_prm_dst1);
-  snicar_host_views_d1["ext_cff_mss_dust01"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_dst1);
-  snicar_host_views_d1["ss_alb_dust02"] = Kokkos::create_mirror_view(snicar_data.ss_alb_dst2);
-  snicar_host_views_d1["asm_prm_dust02"] = Kokkos::create_mirror_view(snicar_data.asm_prm_dst2);
-  snicar_host_views_d1["ext_cff_mss_dust02"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_dst2);
-  snicar_host_views_d1["ss_alb_dust03"] = Kokkos::create_mirror_view(snicar_data.ss_alb_dst3);
-  snicar_host_views_d1["asm_prm_dust03"] = Kokkos::create_mirror_view(snicar_data.asm_prm_dst3);
-  snicar_host_views_d1["ext_cff_mss_dust03"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_dst3);
-  snicar_host_views_d1["ss_alb_dust04"] = Kokkos::create_mirror_view(snicar_data.ss_alb_dst4);
-  snicar_host_views_d1["asm_prm_dust04"] = Kokkos::create_mirror_view(snicar_data.asm_prm_dst4);
-  snicar_host_views_d1["ext_cff_mss_dust04"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_dst4);
-  return snicar_host_views_d1;
-}
-
-std::map<std::string, h_ViewD2> get_snicar_host_views_d2(const ELM::SnicarData<ViewD1, ViewD2, ViewD3>& snicar_data)
-{
-  std::map<std::string, h_ViewD2> snicar_host_views_d2;
-  snicar_host_views_d2["ss_alb_ice_drc"] = Kokkos::create_mirror_view(snicar_data.ss_alb_snw_drc);
-  snicar_host_views_d2["asm_prm_ice_drc"] = Kokkos::create_mirror_view(snicar_data.asm_prm_snw_drc);
-  snicar_host_views_d2["ext_cff_mss_ice_drc"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_snw_drc);
-  snicar_host_views_d2["ss_alb_ice_dfs"] = Kokkos::create_mirror_view(snicar_data.ss_alb_snw_dfs);
-  snicar_host_views_d2["asm_prm_ice_dfs"] = Kokkos::create_mirror_view(snicar_data.asm_prm_snw_dfs);
-  snicar_host_views_d2["ext_cff_mss_ice_dfs"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_snw_dfs);
-  snicar_host_views_d2["ss_alb_bc_mam"] = Kokkos::create_mirror_view(snicar_data.ss_alb_bc1);
-  snicar_host_views_d2["asm_prm_bc_mam"] = Kokkos::create_mirror_view(snicar_data.asm_prm_bc1);
-  snicar_host_views_d2["ext_cff_mss_bc_mam"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_bc1);
-  snicar_host_views_d2["ss_alb_bc_mam"] = Kokkos::create_mirror_view(snicar_data.ss_alb_bc2);
-  snicar_host_views_d2["asm_prm_bc_mam"] = Kokkos::create_mirror_view(snicar_data.asm_prm_bc2);
-  snicar_host_views_d2["ext_cff_mss_bc_mam"] = Kokkos::create_mirror_view(snicar_data.ext_cff_mss_bc2);
-  return snicar_host_views_d2;
-}
-
-std::map<std::string, h_ViewD3> get_snicar_host_views_d3(const ELM::SnicarData<ViewD1, ViewD2, ViewD3>& snicar_data)
-{
-  std::map<std::string, h_ViewD3> snicar_host_views_d3;
-  snicar_host_views_d3["bcint_enh_mam"] = Kokkos::create_mirror_view(snicar_data.bcenh);
-  return snicar_host_views_d3;
-}
-
-
-
-
-void copy_snicar_host_views_d1(std::map<std::string, h_ViewD1>& snicar_host_views_d1, ELM::SnicarData<ViewD1, ViewD2, ViewD3>& snicar_data)
-{
-  Kokkos::deep_copy(snicar_data.ss_alb_oc1, snicar_host_views_d1["ss_alb_ocphil"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_oc1, snicar_host_views_d1["asm_prm_ocphil"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_oc1, snicar_host_views_d1["ext_cff_mss_ocphil"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_oc2, snicar_host_views_d1["ss_alb_ocphob"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_oc2, snicar_host_views_d1["asm_prm_ocphob"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_oc2, snicar_host_views_d1["ext_cff_mss_ocphob"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_dst1, snicar_host_views_d1["ss_alb_dust01"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_dst1, snicar_host_views_d1["asm_prm_dust01"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_dst1, snicar_host_views_d1["ext_cff_mss_dust01"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_dst2, snicar_host_views_d1["ss_alb_dust02"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_dst2, snicar_host_views_d1["asm_prm_dust02"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_dst2, snicar_host_views_d1["ext_cff_mss_dust02"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_dst3, snicar_host_views_d1["ss_alb_dust03"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_dst3, snicar_host_views_d1["asm_prm_dust03"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_dst3, snicar_host_views_d1["ext_cff_mss_dust03"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_dst4, snicar_host_views_d1["ss_alb_dust04"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_dst4, snicar_host_views_d1["asm_prm_dust04"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_dst4, snicar_host_views_d1["ext_cff_mss_dust04"]);
-}
-
-
-void copy_snicar_host_views_d2(std::map<std::string, h_ViewD2>& snicar_host_views_d2, ELM::SnicarData<ViewD1, ViewD2, ViewD3>& snicar_data)
-{
-  Kokkos::deep_copy(snicar_data.ss_alb_snw_drc, snicar_host_views_d2["ss_alb_ice_drc"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_snw_drc, snicar_host_views_d2["asm_prm_ice_drc"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_snw_drc, snicar_host_views_d2["ext_cff_mss_ice_drc"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_snw_dfs, snicar_host_views_d2["ss_alb_ice_dfs"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_snw_dfs, snicar_host_views_d2["asm_prm_ice_dfs"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_snw_dfs, snicar_host_views_d2["ext_cff_mss_ice_dfs"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_bc1, snicar_host_views_d2["ss_alb_bc_mam"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_bc1, snicar_host_views_d2["asm_prm_bc_mam"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_bc1, snicar_host_views_d2["ext_cff_mss_bc_mam"]);
-  Kokkos::deep_copy(snicar_data.ss_alb_bc2, snicar_host_views_d2["ss_alb_bc_mam"]);
-  Kokkos::deep_copy(snicar_data.asm_prm_bc2, snicar_host_views_d2["asm_prm_bc_mam"]);
-  Kokkos::deep_copy(snicar_data.ext_cff_mss_bc2, snicar_host_views_d2["ext_cff_mss_bc_mam"]);
-}
-
-
-void copy_snicar_host_views_d3(std::map<std::string, h_ViewD3>& snicar_host_views_d3, ELM::SnicarData<ViewD1, ViewD2, ViewD3>& snicar_data)
-{
-  Kokkos::deep_copy(snicar_data.bcenh, snicar_host_views_d3["bcint_enh_mam"]);
-}
-
-
-
-
-
-
-
-std::map<std::string, h_ViewD1> get_pft_host_views(const ELM::PFTData<ViewD1, ViewD2>& pft_data)
-{
-  std::map<std::string, h_ViewD1> pft_host_views;
-  pft_host_views["fnr"] = Kokkos::create_mirror_view(pft_data.fnr);
-  pft_host_views["act25"] = Kokkos::create_mirror_view(pft_data.act25);
-  pft_host_views["kcha"] = Kokkos::create_mirror_view(pft_data.kcha);
-  pft_host_views["koha"] = Kokkos::create_mirror_view(pft_data.koha);
-  pft_host_views["cpha"] = Kokkos::create_mirror_view(pft_data.cpha);
-  pft_host_views["vcmaxha"] = Kokkos::create_mirror_view(pft_data.vcmaxha);
-  pft_host_views["jmaxha"] = Kokkos::create_mirror_view(pft_data.jmaxha);
-  pft_host_views["tpuha"] = Kokkos::create_mirror_view(pft_data.tpuha);
-  pft_host_views["lmrha"] = Kokkos::create_mirror_view(pft_data.lmrha);
-  pft_host_views["vcmaxhd"] = Kokkos::create_mirror_view(pft_data.vcmaxhd);
-  pft_host_views["jmaxhd"] = Kokkos::create_mirror_view(pft_data.jmaxhd);
-  pft_host_views["tpuhd"] = Kokkos::create_mirror_view(pft_data.tpuhd);
-  pft_host_views["lmrhd"] = Kokkos::create_mirror_view(pft_data.lmrhd);
-  pft_host_views["lmrse"] = Kokkos::create_mirror_view(pft_data.lmrse);
-  pft_host_views["qe"] = Kokkos::create_mirror_view(pft_data.qe);
-  pft_host_views["theta_cj"] = Kokkos::create_mirror_view(pft_data.theta_cj);
-  pft_host_views["bbbopt"] = Kokkos::create_mirror_view(pft_data.bbbopt);
-  pft_host_views["mbbopt"] = Kokkos::create_mirror_view(pft_data.mbbopt);
-  pft_host_views["c3psn"] = Kokkos::create_mirror_view(pft_data.c3psn);
-  pft_host_views["slatop"] = Kokkos::create_mirror_view(pft_data.slatop);
-  pft_host_views["leafcn"] = Kokkos::create_mirror_view(pft_data.leafcn);
-  pft_host_views["flnr"] = Kokkos::create_mirror_view(pft_data.flnr);
-  pft_host_views["fnitr"] = Kokkos::create_mirror_view(pft_data.fnitr);
-  pft_host_views["dleaf"] = Kokkos::create_mirror_view(pft_data.dleaf);
-  pft_host_views["smpso"] = Kokkos::create_mirror_view(pft_data.smpso);
-  pft_host_views["smpsc"] = Kokkos::create_mirror_view(pft_data.smpsc);
-  pft_host_views["tc_stress"] = Kokkos::create_mirror_view(pft_data.tc_stress);
-  pft_host_views["z0mr"] = Kokkos::create_mirror_view(pft_data.z0mr);
-  pft_host_views["displar"] = Kokkos::create_mirror_view(pft_data.displar);
-  pft_host_views["xl"] = Kokkos::create_mirror_view(pft_data.xl);
-  pft_host_views["roota_par"] = Kokkos::create_mirror_view(pft_data.roota_par);
-  pft_host_views["rootb_par"] = Kokkos::create_mirror_view(pft_data.rootb_par);
-  pft_host_views["rholvis"] = Kokkos::create_mirror_view(pft_data.rholvis);
-  pft_host_views["rholnir"] = Kokkos::create_mirror_view(pft_data.rholnir);
-  pft_host_views["rhosvis"] = Kokkos::create_mirror_view(pft_data.rhosvis);
-  pft_host_views["rhosnir"] = Kokkos::create_mirror_view(pft_data.rhosnir);
-  pft_host_views["taulvis"] = Kokkos::create_mirror_view(pft_data.taulvis);
-  pft_host_views["taulnir"] = Kokkos::create_mirror_view(pft_data.taulnir);
-  pft_host_views["tausvis"] = Kokkos::create_mirror_view(pft_data.tausvis);
-  pft_host_views["tausnir"] = Kokkos::create_mirror_view(pft_data.tausnir);
-  return pft_host_views;
-}
-
-
-void copy_pft_host_views(std::map<std::string, h_ViewD1>& pft_host_views, ELM::PFTData<ViewD1, ViewD2>& pft_data)
-{
-  Kokkos::deep_copy(pft_data.fnr, pft_host_views["fnr"]);
-  Kokkos::deep_copy(pft_data.act25, pft_host_views["act25"]);
-  Kokkos::deep_copy(pft_data.kcha, pft_host_views["kcha"]);
-  Kokkos::deep_copy(pft_data.koha, pft_host_views["koha"]);
-  Kokkos::deep_copy(pft_data.cpha, pft_host_views["cpha"]);
-  Kokkos::deep_copy(pft_data.vcmaxha, pft_host_views["vcmaxha"]);
-  Kokkos::deep_copy(pft_data.jmaxha, pft_host_views["jmaxha"]);
-  Kokkos::deep_copy(pft_data.tpuha, pft_host_views["tpuha"]);
-  Kokkos::deep_copy(pft_data.lmrha, pft_host_views["lmrha"]);
-  Kokkos::deep_copy(pft_data.vcmaxhd, pft_host_views["vcmaxhd"]);
-  Kokkos::deep_copy(pft_data.jmaxhd, pft_host_views["jmaxhd"]);
-  Kokkos::deep_copy(pft_data.tpuhd, pft_host_views["tpuhd"]);
-  Kokkos::deep_copy(pft_data.lmrhd, pft_host_views["lmrhd"]);
-  Kokkos::deep_copy(pft_data.lmrse, pft_host_views["lmrse"]);
-  Kokkos::deep_copy(pft_data.qe, pft_host_views["qe"]);
-  Kokkos::deep_copy(pft_data.theta_cj, pft_host_views["theta_cj"]);
-  Kokkos::deep_copy(pft_data.bbbopt, pft_host_views["bbbopt"]);
-  Kokkos::deep_copy(pft_data.mbbopt, pft_host_views["mbbopt"]);
-  Kokkos::deep_copy(pft_data.c3psn, pft_host_views["c3psn"]);
-  Kokkos::deep_copy(pft_data.slatop, pft_host_views["slatop"]);
-  Kokkos::deep_copy(pft_data.leafcn, pft_host_views["leafcn"]);
-  Kokkos::deep_copy(pft_data.flnr, pft_host_views["flnr"]);
-  Kokkos::deep_copy(pft_data.fnitr, pft_host_views["fnitr"]);
-  Kokkos::deep_copy(pft_data.dleaf, pft_host_views["dleaf"]);
-  Kokkos::deep_copy(pft_data.smpso, pft_host_views["smpso"]);
-  Kokkos::deep_copy(pft_data.smpsc, pft_host_views["smpsc"]);
-  Kokkos::deep_copy(pft_data.tc_stress, pft_host_views["tc_stress"]);
-  Kokkos::deep_copy(pft_data.z0mr, pft_host_views["z0mr"]);
-  Kokkos::deep_copy(pft_data.displar, pft_host_views["displar"]);
-  Kokkos::deep_copy(pft_data.xl, pft_host_views["xl"]);
-  Kokkos::deep_copy(pft_data.roota_par, pft_host_views["roota_par"]);
-  Kokkos::deep_copy(pft_data.rootb_par, pft_host_views["rootb_par"]);
-  Kokkos::deep_copy(pft_data.rholvis, pft_host_views["rholvis"]);
-  Kokkos::deep_copy(pft_data.rholnir, pft_host_views["rholnir"]);
-  Kokkos::deep_copy(pft_data.rhosvis, pft_host_views["rhosvis"]);
-  Kokkos::deep_copy(pft_data.rhosnir, pft_host_views["rhosnir"]);
-  Kokkos::deep_copy(pft_data.taulvis, pft_host_views["taulvis"]);
-  Kokkos::deep_copy(pft_data.taulnir, pft_host_views["taulnir"]);
-  Kokkos::deep_copy(pft_data.tausvis, pft_host_views["tausvis"]);
-  Kokkos::deep_copy(pft_data.tausnir, pft_host_views["tausnir"]);
-}
-
-
 template <AtmForcType ftype>
 void read_atm_data(ELM::AtmDataManager<ViewD1, ViewD2, ftype>& atm_data,
                    const ELM::Utils::DomainDecomposition<2>& dd,
                    const ELM::Utils::Date& model_time,
                    const size_t& ntimes)
 {
+  ELM::Utils::ScopedRegion region("read_atm_data");
   auto h_data = Kokkos::create_mirror_view(atm_data.data);
   atm_data.read_atm_forcing(h_data, dd, model_time, ntimes);
 
@@ -331,6 +102,7 @@ void read_atm_data(ELM::AtmDataManager<ViewD1, ViewD2, ftype>& atm_data,
     NS::resize(atm_data.data, h_data.extent(0), h_data.extent(1));
 
   Kokkos::deep_copy(atm_data.data, h_data);
+  ELM::Utils::add_bytes("deep_copy", h_data.span() * sizeof(double));
 }
 
 
@@ -342,6 +114,12 @@ int main(int argc, char **argv) {
 
   Kokkos::initialize(argc, argv);
 
+  // region timers - set ELM_PROFILE in the environment to enable
+  const bool profile = std::getenv("ELM_PROFILE") != nullptr;
+  if (profile) {
+    enable_kokkos_profiling();
+  }
+
   { // inner scope
 
     std::string fname_surfdata(
@@ -373,8 +151,11 @@ int main(int argc, char **argv) {
     // hardwired params
     const double lat = 71.323;
     const double lon = 203.3886;
-    const double lat_r = lat * ELM::ELMconst::ELM_PI / 180.0;
-    const double lon_r = lon * ELM::ELMconst::ELM_PI / 180.0;
+    // per-cell latitude/longitude [radians]
+    auto lat_r = create<ViewD1>("lat_r", ncells);
+    auto lon_r = create<ViewD1>("lon_r", ncells);
+    assign(lat_r, lat * ELM::ELMconst::ELM_PI / 180.0);
+    assign(lon_r, lon * ELM::ELMconst::ELM_PI / 180.0);
     ELM::LandType Land;
     Land.ltype = 1;
     Land.ctype = 1;
@@ -416,12 +197,12 @@ int main(int argc, char **argv) {
     auto forc_pco2 = create<ViewD1>("forc_pco2", ncells);    
 
     // prescribed sat phenology
-    auto tlai = create<ViewD1>("tlai", ncells);
-    auto tsai = create<ViewD1>("tsai", ncells);
-    auto elai = create<ViewD1>("elai", ncells);
-    auto esai = create<ViewD1>("esai", ncells);
-    auto htop = create<ViewD1>("htop", ncells);
-    auto hbot = create<ViewD1>("hbot", ncells);
+    auto tlai = create<ViewPhen1>("tlai", ncells);
+    auto tsai = create<ViewPhen1>("tsai", ncells);
+    auto elai = create<ViewPhen1>("elai", ncells);
+    auto esai = create<ViewPhen1>("esai", ncells);
+    auto htop = create<ViewPhen1>("htop", ncells);
+    auto hbot = create<ViewPhen1>("hbot", ncells);
     auto frac_veg_nosno_alb = create<ViewI1>("frac_veg_nosno_alb", ncells);
 
     // soil hydraulics
@@ -445,9 +226,6 @@ int main(int argc, char **argv) {
     auto isoicol = create<ViewI1>("isoicol", ncells);
     auto albsat = create<ViewD2>("albsat", ncells, 2);
     auto albdry = create<ViewD2>("albdry", ncells, 2);
-    auto pct_sand = create<ViewD2>("pct_sand", ncells, nlevgrnd);
-    auto pct_clay = create<ViewD2>("pct_clay", ncells, nlevgrnd);
-    auto organic = create<ViewD2>("organic", ncells, nlevgrnd);
 
     // snow variables
     auto snl = create<ViewI1>("snl", ncells);
@@ -499,11 +277,11 @@ int main(int argc, char **argv) {
     auto laisun = create<ViewD1>("laisun", ncells);
     auto laisha = create<ViewD1>("laisha", ncells);
     auto tlai_z = create<ViewD2>("tlai_z", ncells, nlevcan);
-    auto fsun_z = create<ViewD2>("fsun_z", ncells, nlevcan);
-    auto fabd_sun_z = create<ViewD2>("fabd_sun_z", ncells, nlevcan);
-    auto fabd_sha_z = create<ViewD2>("fabd_sha_z", ncells, nlevcan);
-    auto fabi_sun_z = create<ViewD2>("fabi_sun_z", ncells, nlevcan);
-    auto fabi_sha_z = create<ViewD2>("fabi_sha_z", ncells, nlevcan);
+    auto fsun_z = create<ViewRad2>("fsun_z", ncells, nlevcan);
+    auto fabd_sun_z = create<ViewRad2>("fabd_sun_z", ncells, nlevcan);
+    auto fabd_sha_z = create<ViewRad2>("fabd_sha_z", ncells, nlevcan);
+    auto fabi_sun_z = create<ViewRad2>("fabi_sun_z", ncells, nlevcan);
+    auto fabi_sha_z = create<ViewRad2>("fabi_sha_z", ncells, nlevcan);
     auto parsun_z = create<ViewD2>("parsun_z", ncells, nlevcan);
     auto parsha_z = create<ViewD2>("parsha_z", ncells, nlevcan);
     auto laisun_z = create<ViewD2>("laisun_z", ncells, nlevcan);
@@ -517,23 +295,23 @@ int main(int argc, char **argv) {
     auto fsa = create<ViewD1>("fsa", ncells);
     auto fsr = create<ViewD1>("fsr", ncells);
     auto sabg_lyr = create<ViewD2>("sabg_lyr", ncells, nlevsno + 1);
-    auto ftdd = create<ViewD2>("ftdd", ncells, numrad);
-    auto ftid = create<ViewD2>("ftid", ncells, numrad);
-    auto ftii = create<ViewD2>("ftii", ncells, numrad);
-    auto fabd = create<ViewD2>("fabd", ncells, numrad);
-    auto fabi = create<ViewD2>("fabi", ncells, numrad);
+    auto ftdd = create<ViewRad2>("ftdd", ncells, numrad);
+    auto ftid = create<ViewRad2>("ftid", ncells, numrad);
+    auto ftii = create<ViewRad2>("ftii", ncells, numrad);
+    auto fabd = create<ViewRad2>("fabd", ncells, numrad);
+    auto fabi = create<ViewRad2>("fabi", ncells, numrad);
     auto albsod = create<ViewD2>("albsod", ncells, numrad);
     auto albsoi = create<ViewD2>("albsoi", ncells, numrad);
     auto albsnd_hst = create<ViewD2>("albsnd_hst", ncells, numrad);
     auto albsni_hst = create<ViewD2>("albsni_hst", ncells, numrad);
-    auto albgrd = create<ViewD2>("albgrd", ncells, numrad);
-    auto albgri = create<ViewD2>("albgri", ncells, numrad);
+    auto albgrd = create<ViewRad2>("albgrd", ncells, numrad);
+    auto albgri = create<ViewRad2>("albgri", ncells, numrad);
     auto flx_absdv = create<ViewD2>("flx_absdv", ncells, nlevsno + 1);
     auto flx_absdn = create<ViewD2>("flx_absdn", ncells, nlevsno + 1);
     auto flx_absiv = create<ViewD2>("flx_absiv", ncells, nlevsno + 1);
     auto flx_absin = create<ViewD2>("flx_absin", ncells, nlevsno + 1);
-    auto albd = create<ViewD2>("albd", ncells, numrad);
-    auto albi = create<ViewD2>("albi", ncells, numrad);
+    auto albd = create<ViewRad2>("albd", ncells, numrad);
+    auto albi = create<ViewRad2>("albi", ncells, numrad);
 
 
 
@@ -571,6 +349,7 @@ int main(int argc, char **argv) {
     auto eflx_lh_tot_u = create<ViewD1>("eflx_lh_tot_u", ncells);
     auto eflx_lh_tot_r = create<ViewD1>("eflx_lh_tot_r", ncells);
     auto eflx_sh_veg = create<ViewD1>("eflx_sh_veg", ncells);
+    auto canopy_err = create<ViewD1>("canopy_err", ncells);
     auto qflx_evap_tot = create<ViewD1>("qflx_evap_tot", ncells);
     auto qflx_evap_veg = create<ViewD1>("qflx_evap_veg", ncells);
     auto qflx_tran_veg = create<ViewD1>("qflx_tran_veg", ncells);
@@ -640,10 +419,10 @@ int main(int argc, char **argv) {
     // D1
     auto mu_not = create<ViewD1>("mu_not", ncells);
     // D2
-    auto fabd_sun = create<ViewD2>("fabd_sun", ncells, numrad);
-    auto fabd_sha = create<ViewD2>("fabd_sha", ncells, numrad);
-    auto fabi_sun = create<ViewD2>("fabi_sun", ncells, numrad);
-    auto fabi_sha = create<ViewD2>("fabi_sha", ncells, numrad);
+    auto fabd_sun = create<ViewRad2>("fabd_sun", ncells, numrad);
+    auto fabd_sha = create<ViewRad2>("fabd_sha", ncells, numrad);
+    auto fabi_sun = create<ViewRad2>("fabi_sun", ncells, numrad);
+    auto fabi_sha = create<ViewRad2>("fabi_sha", ncells, numrad);
     auto albsnd = create<ViewD2>("albsnd", ncells, numrad);
     auto albsni = create<ViewD2>("albsni", ncells, numrad);
     auto tsai_z = create<ViewD2>("tsai_z", ncells, nlevcan);
@@ -775,63 +554,62 @@ int main(int argc, char **argv) {
     }
 
     {
-      // soil texture constants
-      auto h_pct_sand = Kokkos::create_mirror_view(pct_sand);
-      auto h_pct_clay = Kokkos::create_mirror_view(pct_clay);
-      auto h_organic = Kokkos::create_mirror_view(organic);
-      ELM::read_soil::read_soil_texture(dd, fname_surfdata, h_pct_sand, h_pct_clay, h_organic);
-      Kokkos::deep_copy(pct_sand, h_pct_sand);
-      Kokkos::deep_copy(pct_clay, h_pct_clay);
-      Kokkos::deep_copy(organic, h_organic);
+      // soil hydraulic properties, (cell, layer) parallel - soil texture is read into temporaries
+      // the soil grid is the same for every cell, so the organic soil terms are computed once per layer
+      auto h_zsoi = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), Kokkos::subview(zsoi, 0, Kokkos::ALL));
+      h_ViewD1 zsoi_soil("zsoi_soil", nlevgrnd);
+      for (int k = 0; k < nlevgrnd; ++k) {
+        zsoi_soil(k) = h_zsoi(k + nlevsno);
+      }
+      ELM::read_soil::init_soil_hydraulics(dd, fname_surfdata, zsoi_soil, watsat, bsw, sucsat, watdry, watopt, watfc);
     }
 
-    // snicar radiation parameters
+    // time-invariant parameter tables, filled through a registry of the file variables
+    // the tables are packed into one aligned device block (the registry owns it, keep it in scope)
+    // that is uploaded with a single transfer - get_pft_psn(), get_pft_alb() and the snicar kernels
+    // read straight from the block
     ELM::SnicarData<ViewD1, ViewD2, ViewD3> snicar_data;
+    ELM::PFTData<ViewD1, ViewD2> pft_data;
+    ELM::FieldRegistry param_registry;
+    snicar_data.register_fields(param_registry);
+    pft_data.register_fields(param_registry);
+    param_registry.create_mirrors(ELM::FieldRegistry::Storage::packed);
     {
-      auto host_snicar_d1 = get_snicar_host_views_d1(snicar_data);
-      auto host_snicar_d2 = get_snicar_host_views_d2(snicar_data);
-      auto host_snicar_d3 = get_snicar_host_views_d3(snicar_data);
+      // snicar radiation parameters
+      auto host_snicar_d1 = param_registry.host_views<h_ViewD1>("snicar");
+      auto host_snicar_d2 = param_registry.host_views<h_ViewD2>("snicar");
+      auto host_snicar_d3 = param_registry.host_views<h_ViewD3>("snicar");
       ELM::read_snicar_data(host_snicar_d1, host_snicar_d2,
                             host_snicar_d3, dd.comm, fname_snicar);
-      copy_snicar_host_views_d1(host_snicar_d1, snicar_data);
-      copy_snicar_host_views_d2(host_snicar_d2, snicar_data);
-      copy_snicar_host_views_d3(host_snicar_d3, snicar_data);
-    }
-
 
-
-    // pft data constants
-    ELM::PFTData<ViewD1, ViewD2> pft_data;
-    {
-      auto host_pft_views = get_pft_host_views(pft_data);
+      // pft data constants
+      auto host_pft_views = param_registry.host_views<h_ViewD1>("pft");
       ELM::read_pft_data(host_pft_views, dd.comm, fname_pft);
-      copy_pft_host_views(host_pft_views, pft_data);
     }
-    // Kokkos view of struct PSNVegData
-    auto psn_pft = create<Kokkos::View<ELM::PFTDataPSN *>>("psn_pft", ncells);
-    Kokkos::parallel_for("pft_psn_init", ncells, KOKKOS_LAMBDA (const int i) {
-      psn_pft(i) = pft_data.get_pft_psn(vtype(i));
-    });
-
-
-
-
-    // aerosol deposition data manager
-    ELM::AerosolDataManager<ViewD1> aerosol_data;
-    {
-      auto host_aero_views = get_aero_host_views(aerosol_data);
-      ELM::read_aerosol_data(host_aero_views, dd.comm, fname_aerosol, lon, lat);
-      copy_aero_host_views(host_aero_views, aerosol_data);
+    param_registry.copy_to_device();
+
+    // per-cell pft parameters, gathered by vtype once - vtype is time-invariant here,
+    // rerun the gather if land cover changes
+    ELM::PFTData<ViewD1, ViewD2> cell_pft(ncells);
+    invoke_kernel(ELM::GatherPFTData(pft_data, vtype, cell_pft), std::make_tuple(ncells), "gather_pft_data");
+
+    // monthly data managers - months are read as needed, the following month is prefetched
+    // on a background thread (the only file reads in the time loop) when MPI allows it
+    // aerosol deposition data at the closest file point to each cell
+    h_ViewD1 lon_d("lon_d", ncells), lat_d("lat_d", ncells);
+    Kokkos::deep_copy(lon_d, lon);
+    Kokkos::deep_copy(lat_d, lat);
+    ELM::GriddedAerosolDataManager<ViewD3> aerosol_data(dd.comm, fname_aerosol, lon_d, lat_d);
+    // phenology data
+    ELM::PhenologyDataManager<ViewPhen3> phen_data(dd, ncells, 17);
+    if (ELM::monthly_data::prefetch_supported()) {
+      aerosol_data.monthly().set_prefetch(true);
+      phen_data.monthly().set_prefetch(true);
     }
+    auto h_vtype = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), vtype);
 
-    // phenology data manager
-    // make host mirrors - need to be persistent
-    ELM::PhenologyDataManager<ViewD2> phen_data(dd, ncells, 17);
-    auto host_phen_views = get_phen_host_views(phen_data);
-
-    // containers for aerosol deposition and concentration within snowpack layers
-    ELM::AerosolMasses<ViewD2> aerosol_masses(ncells);
-    ELM::AerosolConcentrations<ViewD2> aerosol_concentrations(ncells);
+    // per-cell aerosol forcing and mass within snowpack layers - concentrations are written to mss_cnc_aer_in_fdb
+    ELM::AerosolState<ViewD2, ViewD3> aerosol_state(ncells);
 
 
 
@@ -859,25 +637,6 @@ int main(int argc, char **argv) {
                             Kokkos::subview(zsoi, idx, Kokkos::ALL),
                             Kokkos::subview(zisoi, idx, Kokkos::ALL));
 
-      ELM::init_soil_hydraulics(
-                              Kokkos::subview(pct_sand, idx, Kokkos::ALL),
-                              Kokkos::subview(pct_clay, idx, Kokkos::ALL),
-                              Kokkos::subview(organic, idx, Kokkos::ALL),
-                              Kokkos::subview(zsoi, idx, Kokkos::ALL),
-                              Kokkos::subview(watsat, idx, Kokkos::ALL),
-                              Kokkos::subview(bsw, idx, Kokkos::ALL),
-                              Kokkos::subview(sucsat, idx, Kokkos::ALL),
-                              Kokkos::subview(watdry, idx, Kokkos::ALL),
-                              Kokkos::subview(watopt, idx, Kokkos::ALL),
-                              Kokkos::subview(watfc, idx, Kokkos::ALL));
-
-
-      ELM::init_vegrootfr(
-                          vtype(idx), pft_data.roota_par(vtype(idx)),
-                          pft_data.rootb_par(vtype(idx)),
-                          Kokkos::subview(zisoi, idx, Kokkos::ALL),
-                          Kokkos::subview(rootfr, idx, Kokkos::ALL));
-
       ELM::init_soil_temp(
                           Land, snl(idx),
                           Kokkos::subview(t_soisno, idx, Kokkos::ALL),
@@ -899,6 +658,10 @@ int main(int argc, char **argv) {
                               Kokkos::subview(h2osoi_ice, idx, Kokkos::ALL));
     });
 
+    // root fraction per (cell, layer)
+    invoke_kernel(ELM::ComputeRootFraction(vtype, cell_pft.roota_par, cell_pft.rootb_par, zisoi, rootfr),
+                  std::make_tuple(ncells, nlevgrnd), "ComputeRootFraction");
+
 
 
     /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
@@ -920,10 +683,32 @@ int main(int argc, char **argv) {
     auto coszen = create<ViewD1>("coszen", ncells);
     auto cosz_factor = create<ViewD1>("cosz_factor", ncells);
 
+    // computes max_dayl once, caches declination and dayl by day
+    ELM::SolarGeometry<ViewD1> solar(lat_r, lon_r);
+    auto max_dayl = solar.max_dayl;
+    auto dayl = solar.dayl;
+
+    // independent execution space instances for timestep preprocessing
+    auto exec_instances = ELM::partition_exec_space<3>();
+    const auto exec_forc = exec_instances[0];
+    const auto exec_aero = exec_instances[1];
+    const auto exec_phen = exec_instances[2];
+
+    // NaN/Inf and bounds checks after driver stages, one reduction per stage
+    // compiled in with ENABLE_VALIDATION, set ELM_VALIDATE in the environment to run them
+    // offending cells are written to std::cerr and the run continues
+    ELM::StateValidator validator(ncells, ELM::StateValidator::Action::Report);
+    validator.set_enabled(std::getenv("ELM_VALIDATE") != nullptr);
+    // ELM only warns about the canopy energy balance residual, so its check reports whatever validator does
+    ELM::StateValidator balance_validator(ncells, ELM::StateValidator::Action::Report);
+    balance_validator.set_enabled(validator.enabled());
+
     ELM::Utils::Date current(start);
 
     for (int t = 0; t < ntimes; ++t) {
 
+      ELM::Utils::ScopedRegion timestep_region("timestep");
+
       ELM::Utils::Date time_plus_half_dt(current);
       time_plus_half_dt.increment_seconds(dtime/2);
 
@@ -931,6 +716,7 @@ int main(int argc, char **argv) {
       // need for a few variables that are needed by downstream
       // data processing kernels, before main physics section
       // more will be added to this kernel in the future
+      ELM::Utils::Profiler::instance().start("init_spatial_loop");
       Kokkos::parallel_for("init_spatial_loop", ncells, KOKKOS_LAMBDA (const int idx) {
 
         ELM::init_timestep(lakpoi, veg_active(idx),
@@ -942,28 +728,18 @@ int main(int argc, char **argv) {
                            frac_veg_nosno(idx),
                            Kokkos::subview(frac_iceold, idx, Kokkos::ALL));
       });
+      ELM::Utils::Profiler::instance().stop();
 
       /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
       /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
-      // get coszen - should make this a function
+      // get coszen, cosz_factor, and daylength
       /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
       /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
-      double max_dayl;
-      double dayl;
       {
+        ELM::Utils::ScopedRegion region("solar_geometry");
         ELM::Utils::Date forc_dt_start{forc_FSDS.get_data_start_time()};
         forc_dt_start.increment_seconds(round(forc_FSDS.forc_t_idx(time_plus_half_dt, forc_FSDS.get_data_start_time()) * forc_FSDS.get_forc_dt_secs()));
-        int cosz_doy = current.doy + 1;
-        double declin = ELM::incident_shortwave::declination_angle2(cosz_doy); // should be the same for model and forcing - don't cross day barrier in forcing timeseries
-        double cosz_forc_decday = ELM::Utils::decimal_doy(forc_dt_start) + 1.0;
-        double cosz_forcdt_avg = ELM::incident_shortwave::average_cosz(lat_r, lon_r, declin, forc_FSDS.get_forc_dt_secs(), cosz_forc_decday);
-        double cosz_decday = ELM::Utils::decimal_doy(current) + 1.0;
-        double thiscosz = ELM::incident_shortwave::coszen(lat_r, lon_r, cosz_decday + dtime_d/2.0);
-        cosz_factor(0) = (thiscosz > 0.001) ? std::min(thiscosz/cosz_forcdt_avg, 10.0) : 0.0;
-        //cosz_factor(0) = (thiscosz > 0.001) ? 1.0 : 0.0;
-        coszen(0) = thiscosz;
-        max_dayl = ELM::max_daylength(lat_r);
-        dayl = ELM::daylength(lat_r, declin);
+        solar.update(current, dtime, forc_dt_start, forc_FSDS.get_forc_dt_secs(), coszen, cosz_factor);
       }
 
 
@@ -976,50 +752,22 @@ int main(int argc, char **argv) {
       /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
 
 
-      // read phenology data if required
-      // reader will read 3 months of data on first call
-      // subsequent calls only read the newest months (when phen_data.need_data() == true)
-      // and shift the index of the two remaining older months
-
-      // copy device data to host
-      // copying entire views is likely inefficient, but it's currently necessary
-      // could be eliminated by shifting older month indices in parallel kernel
-      // and reading new data into a mirror of a subview (or a subview of a mirror?)
-      // then we would only need one copy from host view into the device view
-      // instead of the two we currently have
-      // will fix later - too infrequently run (once per month) to cause concern
-      if (phen_data.need_data()) {
-        Kokkos::deep_copy(host_phen_views["MONTHLY_LAI"], phen_data.mlai);
-        Kokkos::deep_copy(host_phen_views["MONTHLY_SAI"], phen_data.msai);
-        Kokkos::deep_copy(host_phen_views["MONTHLY_HEIGHT_TOP"], phen_data.mhtop);
-        Kokkos::deep_copy(host_phen_views["MONTHLY_HEIGHT_BOT"], phen_data.mhbot);
-      }
-      // reads three months of data on first call
-      // after first call, read new data if phen_data.need_new_data_ == true
-      auto phen_updated = phen_data.read_data(host_phen_views, fname_surfdata, current, vtype); // if needed
-      // copy host views to device
-      // could be made more efficient, see above
-      if (phen_updated) {
-        Kokkos::deep_copy(phen_data.mlai, host_phen_views["MONTHLY_LAI"]);
-        Kokkos::deep_copy(phen_data.msai, host_phen_views["MONTHLY_SAI"]);
-        Kokkos::deep_copy(phen_data.mhtop, host_phen_views["MONTHLY_HEIGHT_TOP"]);
-        Kokkos::deep_copy(phen_data.mhbot, host_phen_views["MONTHLY_HEIGHT_BOT"]);
-      }
-      // run parallel kernel to process phenology data
-      phen_data.get_data(current, snow_depth,
-                         frac_sno, vtype, elai, esai,
-                         htop, hbot, tlai, tsai,
-                         frac_veg_nosno_alb);
+      // forcing, aerosol, and phenology preprocessing are independent of each other
+      // launch each on its own execution space instance so the kernels can overlap,
+      // and so the phenology file read on host overlaps with forcing/aerosol kernels on device
+      // the default instance (solar geometry, init_timestep) must be complete first
+      ELM::ExecSpace().fence();
 
       // get new and data and process in parallel
-      forc_TBOT.get_atm_forcing(dtime_d, time_plus_half_dt, forc_tbot, forc_thbot);
-      forc_PBOT.get_atm_forcing(dtime_d, time_plus_half_dt, forc_pbot);
-      forc_QBOT.get_atm_forcing(dtime_d, time_plus_half_dt, forc_tbot, forc_pbot, forc_qbot, forc_rh);
-      forc_FLDS.get_atm_forcing(dtime_d, time_plus_half_dt, forc_pbot, forc_qbot, forc_tbot, forc_lwrad);
-      forc_FSDS.get_atm_forcing(dtime_d, time_plus_half_dt, cosz_factor, forc_solai, forc_solad);
-      forc_PREC.get_atm_forcing(dtime_d, time_plus_half_dt, forc_tbot, forc_rain, forc_snow);
-      forc_WIND.get_atm_forcing(dtime_d, time_plus_half_dt, forc_u, forc_v);
-      forc_ZBOT.get_atm_forcing(dtime_d, time_plus_half_dt, forc_hgt, forc_hgt_u, forc_hgt_t,  forc_hgt_q);
+      ELM::Utils::Profiler::instance().start("atm_forcing");
+      forc_TBOT.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, forc_tbot, forc_thbot);
+      forc_PBOT.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, forc_pbot);
+      forc_QBOT.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, forc_tbot, forc_pbot, forc_qbot, forc_rh);
+      forc_FLDS.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, forc_pbot, forc_qbot, forc_tbot, forc_lwrad);
+      forc_FSDS.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, cosz_factor, forc_solai, forc_solad);
+      forc_PREC.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, forc_tbot, forc_rain, forc_snow);
+      forc_WIND.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, forc_u, forc_v);
+      forc_ZBOT.get_atm_forcing(exec_forc, dtime_d, time_plus_half_dt, forc_hgt, forc_hgt_u, forc_hgt_t,  forc_hgt_q);
 
       // calculate constitutive air properties
       ELM::atm_forcing_physics::ConstitutiveAirProperties
@@ -1028,12 +776,50 @@ int main(int argc, char **argv) {
                     forc_rho, forc_po2,
                     forc_pco2);
 
-      invoke_kernel(compute_air, std::make_tuple(forc_pbot.extent(0)), "ConstitutiveAirProperties");
+      invoke_kernel(exec_forc, compute_air, std::make_tuple(forc_pbot.extent(0)), "ConstitutiveAirProperties");
+      ELM::Utils::Profiler::instance().stop();
 
       // get aerosol mss and cnc
-      ELM::aerosols::invoke_aerosol_source(time_plus_half_dt, dtime, snl, aerosol_data, aerosol_masses);
-      ELM::aerosols::invoke_aerosol_concen_and_mass(dtime, do_capsnow, snl, h2osoi_liq,
-      h2osoi_ice, snw_rds, qflx_snwcp_ice, aerosol_masses, aerosol_concentrations);
+      ELM::Utils::Profiler::instance().start("aerosols");
+      aerosol_data.read_data(exec_aero, time_plus_half_dt);
+      ELM::aerosols::invoke_aerosol_snow_state(exec_aero, time_plus_half_dt, dtime, do_capsnow, snl, h2osoi_liq,
+      h2osoi_ice, snw_rds, qflx_snwcp_ice, aerosol_data, aerosol_state, mss_cnc_aer_in_fdb);
+      ELM::Utils::Profiler::instance().stop();
+
+      // make the phenology months needed at current available on device
+      // months are kept in a ring - a new month is read once (ahead of time on a background thread
+      // when prefetching) and copied to device once, nothing is shifted or copied back to host
+      ELM::Utils::Profiler::instance().start("phenology");
+      phen_data.read_data(exec_phen, fname_surfdata, current, h_vtype);
+      // run parallel kernel to process phenology data
+      phen_data.get_data(exec_phen, current, snow_depth,
+                         frac_sno, vtype, elai, esai,
+                         htop, hbot, tlai, tsai,
+                         frac_veg_nosno_alb);
+      ELM::Utils::Profiler::instance().stop();
+
+      // physics reads the output of all three
+      exec_forc.fence();
+      exec_aero.fence();
+      exec_phen.fence();
+
+      ELM_VALIDATE(validator, "atm_forcing",
+                   ELM::validation::bounds("forc_tbot", forc_tbot, 150.0, 350.0),
+                   ELM::validation::bounds("forc_pbot", forc_pbot, 1.0e4, 1.2e5),
+                   ELM::validation::nonnegative("forc_qbot", forc_qbot),
+                   ELM::validation::nonnegative("forc_lwrad", forc_lwrad),
+                   ELM::validation::nonnegative("forc_solad", forc_solad),
+                   ELM::validation::nonnegative("forc_solai", forc_solai),
+                   ELM::validation::nonnegative("forc_rain", forc_rain),
+                   ELM::validation::nonnegative("forc_snow", forc_snow),
+                   ELM::validation::nonnegative("forc_rho", forc_rho));
+      ELM_VALIDATE(validator, "phenology",
+                   ELM::validation::nonnegative("elai", elai),
+                   ELM::validation::nonnegative("esai", esai),
+                   ELM::validation::nonnegative("tlai", tlai),
+                   ELM::validation::nonnegative("tsai", tsai),
+                   ELM::validation::nonnegative("htop", htop),
+                   ELM::validation::nonnegative("hbot", hbot));
 
 
 
@@ -1046,6 +832,7 @@ int main(int argc, char **argv) {
       /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
       /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
 
+      ELM::Utils::Profiler::instance().start("main_spatial_loop");
       Kokkos::parallel_for("main_spatial_loop", ncells, KOKKOS_LAMBDA (const int idx) {
 
 
@@ -1055,18 +842,12 @@ int main(int argc, char **argv) {
         /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
         /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
         {
-          // parse pft data for Land.vtype
-          ELM::PFTDataAlb alb_pft = pft_data.get_pft_alb(vtype(idx));
+          // pft albedo parameters of this cell
+          ELM::PFTDataAlb alb_pft = cell_pft.get_pft_alb(idx);
 
           ELM::surface_albedo::init_timestep(
               Land.urbpoi,
               elai(idx),
-              Kokkos::subview(aerosol_concentrations.mss_cnc_bcphi, idx, Kokkos::ALL),
-              Kokkos::subview(aerosol_concentrations.mss_cnc_bcpho, idx, Kokkos::ALL),
-              Kokkos::subview(aerosol_concentrations.mss_cnc_dst1, idx, Kokkos::ALL),
-              Kokkos::subview(aerosol_concentrations.mss_cnc_dst2, idx, Kokkos::ALL),
-              Kokkos::subview(aerosol_concentrations.mss_cnc_dst3, idx, Kokkos::ALL),
-              Kokkos::subview(aerosol_concentrations.mss_cnc_dst4, idx, Kokkos::ALL),
               vcmaxcintsun(idx),
               vcmaxcintsha(idx),
               Kokkos::subview(albsod, idx, Kokkos::ALL),
@@ -1087,8 +868,7 @@ int main(int argc, char **argv) {
               Kokkos::subview(flx_absdv, idx, Kokkos::ALL),
               Kokkos::subview(flx_absdn, idx, Kokkos::ALL),
               Kokkos::subview(flx_absiv, idx, Kokkos::ALL),
-              Kokkos::subview(flx_absin, idx, Kokkos::ALL),
-              Kokkos::subview(mss_cnc_aer_in_fdb, idx, Kokkos::ALL, Kokkos::ALL));
+              Kokkos::subview(flx_absin, idx, Kokkos::ALL));
 
           ELM::surface_albedo::soil_albedo(
               Land,
@@ -1647,8 +1427,8 @@ int main(int argc, char **argv) {
               elai(idx),
               esai(idx),
               htop(idx),
-              pft_data.displar,
-              pft_data.z0mr,
+              cell_pft.displar(idx),
+              cell_pft.z0mr(idx),
               Kokkos::subview(h2osoi_liq, idx, Kokkos::ALL),
               Kokkos::subview(h2osoi_ice, idx, Kokkos::ALL),
               emg(idx),
@@ -1855,8 +1635,8 @@ int main(int argc, char **argv) {
               forc_hgt_u_patch(idx),
               thm(idx),
               thv(idx),
-              max_dayl,
-              dayl,
+              max_dayl(idx),
+              dayl(idx),
               altmax_indx(idx),
               altmax_lastyear_indx(idx),
               Kokkos::subview(t_soisno, idx, Kokkos::ALL),
@@ -1864,12 +1644,12 @@ int main(int argc, char **argv) {
               Kokkos::subview(h2osoi_liq, idx, Kokkos::ALL),
               Kokkos::subview(dz, idx, Kokkos::ALL),
               Kokkos::subview(rootfr, idx, Kokkos::ALL),
-              psn_pft(idx).tc_stress,
+              cell_pft.tc_stress(idx),
               Kokkos::subview(sucsat, idx, Kokkos::ALL),
               Kokkos::subview(watsat, idx, Kokkos::ALL),
               Kokkos::subview(bsw, idx, Kokkos::ALL),
-              psn_pft(idx).smpso,
-              psn_pft(idx).smpsc,
+              cell_pft.smpso(idx),
+              cell_pft.smpsc(idx),
               elai(idx),
               esai(idx),
               emv(idx),
@@ -1948,7 +1728,7 @@ int main(int argc, char **argv) {
               thm(idx),
               thv(idx),
               qg(idx),
-              psn_pft(idx),
+              cell_pft.get_pft_psn(idx),
               nrad(idx),
               t10(idx),
               Kokkos::subview(tlai_z, idx, Kokkos::ALL),
@@ -2058,7 +1838,8 @@ int main(int argc, char **argv) {
               t_ref2m_r(idx),
               q_ref2m(idx),
               rh_ref2m(idx),
-              rh_ref2m_r(idx));
+              rh_ref2m_r(idx),
+              canopy_err(idx));
         }
 
         /* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
@@ -2142,21 +1923,33 @@ int main(int argc, char **argv) {
         }
 
       }); // parallel for over cells
-
-      for (int i = 0; i < ncells; ++i) {
-        std::cout << "elai: " << elai(i) << std::endl;
-        std::cout << "esai: " << esai(i) << std::endl;
-        std::cout << "tlai: " << tlai(i) << std::endl;
-        std::cout << "tsai: " << tsai(i) << std::endl;
-        std::cout << "htop: " << htop(i) << std::endl;
-        std::cout << "hbot: " << hbot(i) << std::endl;
-        std::cout << "frac_veg_nosno_alb: " << frac_veg_nosno_alb(i) << std::endl;
-      }
+      ELM::Utils::Profiler::instance().stop();
+
+      ELM_VALIDATE(validator, "main_spatial_loop",
+                   ELM::validation::bounds("t_grnd", t_grnd, 150.0, 400.0),
+                   ELM::validation::bounds("t_veg", t_veg, 150.0, 400.0),
+                   ELM::validation::nonnegative("h2osoi_liq", h2osoi_liq),
+                   ELM::validation::nonnegative("h2osoi_ice", h2osoi_ice),
+                   ELM::validation::nonnegative("h2osno", h2osno),
+                   ELM::validation::bounds("albd", albd, 0.0, 1.0),
+                   ELM::validation::bounds("albi", albi, 0.0, 1.0),
+                   ELM::validation::finite("eflx_sh_tot", eflx_sh_tot),
+                   ELM::validation::finite("eflx_lh_tot", eflx_lh_tot));
+      // canopy_err is flagged like ELM's energy balance warning in CanopyFluxes, |err| > 0.1 W/m2
+      ELM_VALIDATE(balance_validator, "canopy_energy_balance",
+                   ELM::validation::bounds("canopy_err", canopy_err, -0.1, 0.1));
 
       current.increment_seconds(dtime);
 
     } // time loop
 
+    if (profile) {
+      auto& profiler = ELM::Utils::Profiler::instance();
+      profiler.report(std::cout);
+      std::ofstream json("elm_profile.json");
+      profiler.report_json(json);
+    }
+
   } // inner scope
 
   Kokkos::finalize();
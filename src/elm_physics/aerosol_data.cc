@@ -1,10 +1,21 @@
 
 #include "aerosol_data.h"
 
+#include <stdexcept>
+
 std::pair<size_t, size_t>
 ELM::aerosol_utils::get_nearest_indices(const Comm_type& comm,
                                         const std::string& filename,
                                         const double& lon_d, const double& lat_d)
+{
+  return get_nearest_indices(comm, filename, std::vector<double>{lon_d}, std::vector<double>{lat_d})[0];
+}
+
+std::vector<std::pair<size_t, size_t>>
+ELM::aerosol_utils::get_nearest_indices(const Comm_type& comm,
+                                        const std::string& filename,
+                                        const std::vector<double>& lon_d,
+                                        const std::vector<double>& lat_d)
 {
   Array<double, 1> file_lon(144);
   Array<double, 1> file_lat(96);
@@ -13,31 +24,45 @@ ELM::aerosol_utils::get_nearest_indices(const Comm_type& comm,
   const std::array<size_t, 1> count_lat{96};
   IO::read_netcdf(comm, filename, "lon", start, count_lon, file_lon.data());
   IO::read_netcdf(comm, filename, "lat", start, count_lat, file_lat.data());
-  double mindist = 99999.0;
-  size_t lon_idx;
-  size_t lat_idx;
-  for (size_t thisx = 0; thisx < 144; ++thisx) {
-    for (size_t thisy = 0; thisy < 96; ++thisy) {
-
-      if (lon_d < 0.0) {
-        if (file_lon(thisx) >= 180.0) {
-          file_lon(thisx) -= 360.0;
+
+  std::vector<std::pair<size_t, size_t>> indices(lon_d.size());
+  for (size_t i = 0; i != lon_d.size(); ++i) {
+    double mindist = 99999.0;
+    bool found = false;
+    size_t lon_idx = 0;
+    size_t lat_idx = 0;
+    for (size_t thisx = 0; thisx < 144; ++thisx) {
+
+      // shift file longitude to the convention of lon_d
+      double this_lon = file_lon(thisx);
+      if (lon_d[i] < 0.0) {
+        if (this_lon >= 180.0) {
+          this_lon -= 360.0;
         }
-      } else if (lon_d >= 180.0) {
-        if (file_lon(thisx) < 0.0)
-          file_lon(thisx) += 360.0;
+      } else if (lon_d[i] >= 180.0) {
+        if (this_lon < 0.0)
+          this_lon += 360.0;
       }
 
-      double dlon2 = pow(file_lon(thisx) - lon_d, 2.0);
-      double dlat2 = pow(file_lat(thisy) - lat_d, 2.0);
-      double thisdist = 100.0 * pow(dlon2 + dlat2, 0.5);
+      for (size_t thisy = 0; thisy < 96; ++thisy) {
+        double dlon2 = pow(this_lon - lon_d[i], 2.0);
+        double dlat2 = pow(file_lat(thisy) - lat_d[i], 2.0);
+        double thisdist = 100.0 * pow(dlon2 + dlat2, 0.5);
 
-      if (thisdist < mindist) {
-        mindist = thisdist;
-        lon_idx = thisx;
-        lat_idx = thisy;
+        if (thisdist < mindist) {
+          mindist = thisdist;
+          lon_idx = thisx;
+          lat_idx = thisy;
+          found = true;
+        }
       }
     }
+    // no distance compares less than mindist for a NaN coordinate
+    if (!found) {
+      throw std::runtime_error("ELM ERROR: no nearest aerosol grid point in " + filename + " for lon " +
+                               std::to_string(lon_d[i]) + ", lat " + std::to_string(lat_d[i]));
+    }
+    indices[i] = std::make_pair(lon_idx, lat_idx);
   }
-  return std::make_pair(lon_idx, lat_idx);
+  return indices;
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "monthly_data.h"
+#include "monthly_data_manager.h"
 #include "read_input.hh"
 
 #include "array.hh"
@@ -11,10 +12,12 @@
 #include <string>
 #include <utility>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <functional>
 #include <tuple>
+#include <vector>
 
 #include "kokkos_includes.hh"
 #include "invoke_kernel.hh"
@@ -97,23 +100,106 @@ public:
 
   AerosolDataManager();
 
+  // register arrays under the file variables that fill them, see field_registry.hh
+  template <typename Registry>
+  void register_fields(Registry& registry);
+
   // interpolate and accumulate aerosol forcing data to get aerosol sources for this timestep
   auto get_aerosol_source(const Utils::Date& model_time, const double& dtime) const; 
 };
 
 
+// class to manage gridded aerosol data - monthly values at the closest file point to each cell
+// held by a MonthlyDataManager (see monthly_data_manager.h) and interpolated on device
+// ArrayD3 is the storage of the monthly data (11, 3, ncells)
+template <typename ArrayD3>
+class GriddedAerosolDataManager {
+
+public:
+
+  // file variables, in the order they are stored in monthly().data()
+  static constexpr std::array<const char*, 11> varnames{"BCDEPWET", "BCPHODRY", "BCPHIDRY", "DSTX01DD",
+                                                        "DSTX02DD", "DSTX03DD", "DSTX04DD", "DSTX01WD",
+                                                        "DSTX02WD", "DSTX03WD", "DSTX04WD"};
+
+  // data is read from filename at the closest point to each cell's lon_d(i) and lat_d(i) [degrees]
+  // lon_d and lat_d must be host accessible
+  template <typename h_ArrayD1>
+  GriddedAerosolDataManager(const Comm_type& comm, const std::string& filename, const h_ArrayD1 lon_d,
+                            const h_ArrayD1 lat_d);
+
+  // make the months needed at model_time available on device, reading them from file if needed
+  // one read per variable of the file region covering all cells, see MonthlyDataManager
+  // returns true if data was copied to device
+  bool read_data(const Utils::Date& model_time);
+  bool read_data(const ExecSpace& space, const Utils::Date& model_time);
+
+  // interpolate and accumulate aerosol forcing data to get the aerosol sources of each cell for this timestep
+  // aerosol_forc(ncells, 6) is ordered bcphi, bcpho, dst1, dst2, dst3, dst4
+  template <typename ArrayD2>
+  void get_aerosol_source(const Utils::Date& model_time, const double& dtime, ArrayD2 aerosol_forc) const;
+
+  // as above, with the kernel launched on execution space instance space
+  template <typename ArrayD2>
+  void get_aerosol_source(const ExecSpace& space, const Utils::Date& model_time, const double& dtime,
+                          ArrayD2 aerosol_forc) const;
+
+  // monthly data
+  const MonthlyDataManager<ArrayD3>& monthly() const { return monthly_; }
+  MonthlyDataManager<ArrayD3>& monthly() { return monthly_; }
+
+private:
+  // read month of varname over the file region into values(ncells)
+  void read_month(const std::string& varname, const int& month, std::vector<double>& values) const;
+
+  Comm_type comm_;
+  std::string filename_;
+  // closest file [lon, lat] indices of each cell and the file region covering them
+  std::vector<std::pair<size_t, size_t>> indices_;
+  size_t lon_min_, lat_min_, nlon_, nlat_;
+  MonthlyDataManager<ArrayD3> monthly_;
+};
+
+
 // read 12 months of values at closest point to lon_d and lat_d
 template <typename h_ArrayD1>
 void read_aerosol_data(std::map<std::string, h_ArrayD1>& aerosol_views, const Comm_type& comm,
   const std::string& filename, const double& lon_d, const double& lat_d);
 
 
+
+namespace aerosols {
+
+// functor to interpolate gridded aerosol forcing data to model time for each cell
+// data(11, nslots, ncells) is ordered as GriddedAerosolDataManager::varnames
+template <typename ArrayD3, typename ArrayD2>
+struct ComputeAerosolSource {
+  ComputeAerosolSource(const ArrayD3 data, const MonthlySlots& slots, const double& dtime, ArrayD2 aerosol_forc);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayD3 data_;
+  int s1_, s2_;
+  double wt1_, wt2_, dtime_;
+  ArrayD2 aerosol_forc_;
+};
+
+} // namespace aerosols
+
+
 namespace aerosol_utils {
 
   // get closest indices to [lon, lat]
   std::pair<size_t, size_t> get_nearest_indices(const Comm_type& comm, const std::string& filename, const double& lon_d,
                                                 const double& lat_d);
 
+  // get closest indices to each [lon_d[i], lat_d[i]] - file coordinates are read once
+  std::vector<std::pair<size_t, size_t>> get_nearest_indices(const Comm_type& comm, const std::string& filename,
+                                                             const std::vector<double>& lon_d,
+                                                             const std::vector<double>& lat_d);
+
   // read a slice from file and reshape into 1D array
   template <typename h_ArrayD1>
   void read_variable_slice(const Comm_type& comm, const std::string& filename, const std::string& varname,
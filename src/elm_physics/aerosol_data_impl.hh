@@ -28,6 +28,25 @@ ELM::AerosolDataManager<ArrayD1>::AerosolDataManager()
       dst4_1("dst4_1", 12), dst4_2("dst4_2", 12)
     {}
 
+template <typename ArrayD1>
+template <typename Registry>
+void ELM::AerosolDataManager<ArrayD1>::
+register_fields(Registry& registry)
+{
+  const std::string group("aerosol");
+  registry.add(group, "BCDEPWET", bcdep);
+  registry.add(group, "BCPHODRY", bcpho);
+  registry.add(group, "BCPHIDRY", bcphi);
+  registry.add(group, "DSTX01DD", dst1_1);
+  registry.add(group, "DSTX02DD", dst1_2);
+  registry.add(group, "DSTX03DD", dst2_1);
+  registry.add(group, "DSTX04DD", dst2_2);
+  registry.add(group, "DSTX01WD", dst3_1);
+  registry.add(group, "DSTX02WD", dst3_2);
+  registry.add(group, "DSTX03WD", dst4_1);
+  registry.add(group, "DSTX04WD", dst4_2);
+}
+
 template <typename ArrayD1>
 auto ELM::AerosolDataManager<ArrayD1>::
 get_aerosol_source(const Utils::Date& model_time, const double& dtime) const
@@ -53,3 +72,105 @@ void ELM::read_aerosol_data(std::map<std::string, h_ArrayD1>& aerosol_views,
     aerosol_utils::read_variable_slice(comm, filename, varname, lon_idx, lat_idx, arr);
   }
 }
+
+template <typename ArrayD3>
+template <typename h_ArrayD1>
+ELM::GriddedAerosolDataManager<ArrayD3>::
+GriddedAerosolDataManager(const Comm_type& comm, const std::string& filename, const h_ArrayD1 lon_d,
+                          const h_ArrayD1 lat_d)
+    : comm_{comm}, filename_{filename},
+      monthly_(std::vector<std::string>(varnames.begin(), varnames.end()), lon_d.extent(0),
+               [this](const std::string& varname, const int& month, std::vector<double>& values) {
+                 read_month(varname, month, values);
+               })
+{
+  const size_t ncells = lon_d.extent(0);
+  std::vector<double> lon(ncells), lat(ncells);
+  for (size_t i = 0; i != ncells; ++i) {
+    lon[i] = lon_d(i);
+    lat[i] = lat_d(i);
+  }
+  indices_ = aerosol_utils::get_nearest_indices(comm_, filename_, lon, lat);
+
+  // smallest file region that covers every cell
+  size_t lon_max = indices_[0].first, lat_max = indices_[0].second;
+  lon_min_ = lon_max;
+  lat_min_ = lat_max;
+  for (const auto& [lon_idx, lat_idx] : indices_) {
+    lon_min_ = std::min(lon_min_, lon_idx);
+    lon_max = std::max(lon_max, lon_idx);
+    lat_min_ = std::min(lat_min_, lat_idx);
+    lat_max = std::max(lat_max, lat_idx);
+  }
+  nlon_ = lon_max - lon_min_ + 1;
+  nlat_ = lat_max - lat_min_ + 1;
+}
+
+template <typename ArrayD3>
+bool ELM::GriddedAerosolDataManager<ArrayD3>::read_data(const Utils::Date& model_time)
+{
+  return read_data(ExecSpace(), model_time);
+}
+
+template <typename ArrayD3>
+bool ELM::GriddedAerosolDataManager<ArrayD3>::read_data(const ExecSpace& space, const Utils::Date& model_time)
+{
+  return monthly_.update(space, model_time);
+}
+
+template <typename ArrayD3>
+void ELM::GriddedAerosolDataManager<ArrayD3>::
+read_month(const std::string& varname, const int& month, std::vector<double>& values) const
+{
+  Array<double, 3> file_data(1, nlat_, nlon_);
+  const std::array<size_t, 3> start{static_cast<size_t>(month), lat_min_, lon_min_};
+  const std::array<size_t, 3> count{1, nlat_, nlon_};
+  IO::read_netcdf(comm_, filename_, varname, start, count, file_data.data());
+  for (size_t i = 0; i != indices_.size(); ++i) {
+    const auto [lon_idx, lat_idx] = indices_[i];
+    values[i] = file_data(0, lat_idx - lat_min_, lon_idx - lon_min_);
+  }
+}
+
+template <typename ArrayD3>
+template <typename ArrayD2>
+void ELM::GriddedAerosolDataManager<ArrayD3>::
+get_aerosol_source(const Utils::Date& model_time, const double& dtime, ArrayD2 aerosol_forc) const
+{
+  get_aerosol_source(ExecSpace(), model_time, dtime, aerosol_forc);
+}
+
+template <typename ArrayD3>
+template <typename ArrayD2>
+void ELM::GriddedAerosolDataManager<ArrayD3>::
+get_aerosol_source(const ExecSpace& space, const Utils::Date& model_time, const double& dtime,
+                   ArrayD2 aerosol_forc) const
+{
+  aerosols::ComputeAerosolSource compute_source(monthly_.data(), monthly_.slots(model_time), dtime, aerosol_forc);
+
+  invoke_kernel(space, compute_source, std::make_tuple(aerosol_forc.extent(0)), "ComputeAerosolSource");
+}
+
+template <typename ArrayD3, typename ArrayD2>
+ELM::aerosols::ComputeAerosolSource<ArrayD3, ArrayD2>::
+ComputeAerosolSource(const ArrayD3 data, const MonthlySlots& slots, const double& dtime, ArrayD2 aerosol_forc)
+    : data_{data}, s1_{slots.s1}, s2_{slots.s2}, wt1_{slots.wt1}, wt2_{slots.wt2}, dtime_{dtime},
+      aerosol_forc_{aerosol_forc}
+    {}
+
+template <typename ArrayD3, typename ArrayD2>
+ACCELERATE
+void ELM::aerosols::ComputeAerosolSource<ArrayD3, ArrayD2>::
+operator()(const int i) const
+{
+  // sum of fields a and b, interpolated to model time
+  auto interp = [this, i] (const int a, const int b) {
+    return (wt1_ * (data_(a, s1_, i) + data_(b, s1_, i)) + wt2_ * (data_(a, s2_, i) + data_(b, s2_, i))) * dtime_;
+  };
+  aerosol_forc_(i, 0) = (wt1_ * data_(2, s1_, i) + wt2_ * data_(2, s2_, i)) * dtime_; // BCPHIDRY
+  aerosol_forc_(i, 1) = interp(0, 1);  // BCDEPWET + BCPHODRY
+  aerosol_forc_(i, 2) = interp(3, 4);  // DSTX01DD + DSTX02DD
+  aerosol_forc_(i, 3) = interp(5, 6);  // DSTX03DD + DSTX04DD
+  aerosol_forc_(i, 4) = interp(7, 8);  // DSTX01WD + DSTX02WD
+  aerosol_forc_(i, 5) = interp(9, 10); // DSTX03WD + DSTX04WD
+}
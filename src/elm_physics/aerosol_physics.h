@@ -29,6 +29,19 @@ struct AerosolConcentrations {
   static constexpr int nlevsno_{ELMdims::nlevsno};
 };
 
+// aerosol deposition forcing this timestep - (ncells, nspecies)
+// and aerosol masses in snow layers with species innermost - (ncells, nlevsno, nspecies)
+// species are ordered bcphi, bcpho, dst1, dst2, dst3, dst4
+template <typename ArrayD2, typename ArrayD3>
+struct AerosolState {
+  AerosolState(const size_t& ncells);
+  ~AerosolState() = default;
+  ArrayD2 forc;
+  ArrayD3 mss;
+  static constexpr int nlevsno_{ELMdims::nlevsno};
+  static constexpr int nspecies_{6};
+};
+
 }
 
 namespace ELM::aerosols {
@@ -75,6 +88,35 @@ private:
   AerosolConcentrations<ArrayD2> aerosol_concentrations_;
 };
 
+// functor to deposit aerosols, update aerosol mass in snow layers, and write
+// the SNICAR aerosol concentrations (mss_cnc_aer_in_fdb) in a single pass
+// combines ComputeAerosolDeposition, ComputeAerosolConcenAndMass, and the
+// concentration copy in surface_albedo::init_timestep
+// cells without snow layers only have their aerosol state cleared
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayD3>
+struct ComputeAerosolSnowState {
+  ComputeAerosolSnowState(const double& dtime, const ArrayB1 do_capsnow, const ArrayI1 snl, const ArrayD2 h2osoi_liq,
+                          const ArrayD2 h2osoi_ice, const ArrayD2 snw_rds, const ArrayD1 qflx_snwcp_ice,
+                          AerosolState<ArrayD2, ArrayD3>& aerosol_state, ArrayD3 mss_cnc_aer_in_fdb);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  static constexpr int nspecies_{AerosolState<ArrayD2, ArrayD3>::nspecies_};
+
+  double dtime_;
+  ArrayB1 do_capsnow_;
+  ArrayI1 snl_;
+  ArrayD2 h2osoi_liq_;
+  ArrayD2 h2osoi_ice_;
+  ArrayD2 snw_rds_;
+  ArrayD1 qflx_snwcp_ice_;
+  ArrayD2 forc_;
+  ArrayD3 mss_;
+  ArrayD3 mss_cnc_aer_in_fdb_;
+};
+
 // convenience function to invoke aerosol deposition source functor
 template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
 void invoke_aerosol_source(const Utils::Date& model_time, const double& dtime, const ArrayI1 snl,
@@ -88,6 +130,34 @@ void invoke_aerosol_concen_and_mass(const double& dtime, const ArrayB1 do_capsno
                                     const ArrayD1 qflx_snwcp_ice, AerosolMasses<ArrayD2>& aerosol_masses,
                                     AerosolConcentrations<ArrayD2>& aerosol_concentrations);
 
+// as above, with the functors launched on execution space instance space
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+void invoke_aerosol_source(const ExecSpace& space, const Utils::Date& model_time, const double& dtime,
+                           const ArrayI1 snl, const AerosolDataManager<ArrayD1>& aerosol_data,
+                           AerosolMasses<ArrayD2>& aerosol_masses);
+
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2>
+void invoke_aerosol_concen_and_mass(const ExecSpace& space, const double& dtime, const ArrayB1 do_capsnow,
+                                    const ArrayI1 snl, const ArrayD2 h2osoi_liq, const ArrayD2 h2osoi_ice,
+                                    const ArrayD2 snw_rds, const ArrayD1 qflx_snwcp_ice,
+                                    AerosolMasses<ArrayD2>& aerosol_masses,
+                                    AerosolConcentrations<ArrayD2>& aerosol_concentrations);
+
+// convenience function to invoke gridded aerosol source and fused aerosol functors
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayD3>
+void invoke_aerosol_snow_state(const Utils::Date& model_time, const double& dtime, const ArrayB1 do_capsnow,
+                               const ArrayI1 snl, const ArrayD2 h2osoi_liq, const ArrayD2 h2osoi_ice,
+                               const ArrayD2 snw_rds, const ArrayD1 qflx_snwcp_ice,
+                               const GriddedAerosolDataManager<ArrayD3>& aerosol_data,
+                               AerosolState<ArrayD2, ArrayD3>& aerosol_state, ArrayD3 mss_cnc_aer_in_fdb);
+
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayD3>
+void invoke_aerosol_snow_state(const ExecSpace& space, const Utils::Date& model_time, const double& dtime,
+                               const ArrayB1 do_capsnow, const ArrayI1 snl, const ArrayD2 h2osoi_liq,
+                               const ArrayD2 h2osoi_ice, const ArrayD2 snw_rds, const ArrayD1 qflx_snwcp_ice,
+                               const GriddedAerosolDataManager<ArrayD3>& aerosol_data,
+                               AerosolState<ArrayD2, ArrayD3>& aerosol_state, ArrayD3 mss_cnc_aer_in_fdb);
+
 } // namespace ELM::aerosols
 
 #include "aerosol_physics_impl.hh"
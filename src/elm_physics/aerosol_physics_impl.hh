@@ -21,6 +21,12 @@ ELM::AerosolConcentrations<ArrayD2>::AerosolConcentrations(const size_t& ncells)
       mss_cnc_dst4("mss_cnc_dst4", ncells, nlevsno_)
     {}
 
+template <typename ArrayD2, typename ArrayD3>
+ELM::AerosolState<ArrayD2, ArrayD3>::AerosolState(const size_t& ncells)
+    : forc("aerosol_forc", ncells, nspecies_),
+      mss("aerosol_mss", ncells, nlevsno_, nspecies_)
+    {}
+
 namespace ELM::aerosols {
 
 template <typename T, typename ArrayI1, typename ArrayD2>
@@ -101,15 +107,75 @@ operator()(const int i) const {
   }
 }
 
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayD3>
+ComputeAerosolSnowState<ArrayB1, ArrayI1, ArrayD1, ArrayD2, ArrayD3>::
+ComputeAerosolSnowState(const double& dtime, const ArrayB1 do_capsnow, const ArrayI1 snl,
+                        const ArrayD2 h2osoi_liq, const ArrayD2 h2osoi_ice, const ArrayD2 snw_rds,
+                        const ArrayD1 qflx_snwcp_ice, AerosolState<ArrayD2, ArrayD3>& aerosol_state,
+                        ArrayD3 mss_cnc_aer_in_fdb)
+    : dtime_{dtime}, do_capsnow_{do_capsnow}, snl_{snl}, h2osoi_liq_{h2osoi_liq}, h2osoi_ice_{h2osoi_ice},
+      snw_rds_{snw_rds}, qflx_snwcp_ice_{qflx_snwcp_ice}, forc_{aerosol_state.forc}, mss_{aerosol_state.mss},
+      mss_cnc_aer_in_fdb_{mss_cnc_aer_in_fdb} {}
+
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayD3>
+ACCELERATE
+void ComputeAerosolSnowState<ArrayB1, ArrayI1, ArrayD1, ArrayD2, ArrayD3>::
+operator()(const int i) const {
+  const int top = ELMdims::nlevsno - snl_(i);
+
+  // inactive layers - no snow, no aerosols
+  // OC concentrations are ignored due to poor constraint and negligible effect on snow
+  for (int sl = 0; sl < top; ++sl) {
+    snw_rds_(i, sl) = 0.0;
+    for (int k = 0; k < nspecies_; ++k) {
+      mss_(i, sl, k) = 0.0;
+    }
+    for (int k = 0; k < ELMdims::sno_nbr_aer; ++k) {
+      mss_cnc_aer_in_fdb_(i, sl, k) = 0.0;
+    }
+  }
+  if (snl_(i) == 0) { return; }
+
+  // deposition to top layer, then scale top layer for capped snow
+  double scl_fct = 1.0;
+  if (do_capsnow_(i)) {
+    const double snowmass = h2osoi_ice_(i, top) + h2osoi_liq_(i, top);
+    scl_fct = snowmass / (snowmass + qflx_snwcp_ice_(i) * dtime_);
+  }
+  for (int k = 0; k < nspecies_; ++k) {
+    mss_(i, top, k) = (mss_(i, top, k) + forc_(i, k)) * scl_fct;
+  }
+
+  for (int sl = top; sl < ELMdims::nlevsno; ++sl) {
+    const double snowmass = h2osoi_ice_(i, sl) + h2osoi_liq_(i, sl);
+    // SNICAR species order is bcphi, bcpho, ocphi, ocpho, dst1-4
+    mss_cnc_aer_in_fdb_(i, sl, 0) = mss_(i, sl, 0) / snowmass;
+    mss_cnc_aer_in_fdb_(i, sl, 1) = mss_(i, sl, 1) / snowmass;
+    mss_cnc_aer_in_fdb_(i, sl, 2) = 0.0;
+    mss_cnc_aer_in_fdb_(i, sl, 3) = 0.0;
+    for (int k = 2; k < nspecies_; ++k) {
+      mss_cnc_aer_in_fdb_(i, sl, k + 2) = mss_(i, sl, k) / snowmass;
+    }
+  }
+}
+
 template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
 void invoke_aerosol_source(const Utils::Date& model_time, const double& dtime, const ArrayI1 snl,
                            const AerosolDataManager<ArrayD1>& aerosol_data,
                            AerosolMasses<ArrayD2>& aerosol_masses)
+{
+  invoke_aerosol_source(ExecSpace(), model_time, dtime, snl, aerosol_data, aerosol_masses);
+}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+void invoke_aerosol_source(const ExecSpace& space, const Utils::Date& model_time, const double& dtime,
+                           const ArrayI1 snl, const AerosolDataManager<ArrayD1>& aerosol_data,
+                           AerosolMasses<ArrayD2>& aerosol_masses)
 {
   auto aerosol_forc_flux = aerosol_data.get_aerosol_source(model_time, dtime);
   ComputeAerosolDeposition aerosol_source_object(aerosol_forc_flux, snl, aerosol_masses);
   
-  invoke_kernel(aerosol_source_object, std::make_tuple(snl.extent(0)), "ComputeAerosolDeposition");
+  invoke_kernel(space, aerosol_source_object, std::make_tuple(snl.extent(0)), "ComputeAerosolDeposition");
 
 }
 
@@ -118,11 +184,49 @@ void invoke_aerosol_concen_and_mass(const double& dtime, const ArrayB1 do_capsno
                                     const ArrayD2 h2osoi_liq, const ArrayD2 h2osoi_ice, const ArrayD2 snw_rds,
                                     const ArrayD1 qflx_snwcp_ice, AerosolMasses<ArrayD2>& aerosol_masses,
                                     AerosolConcentrations<ArrayD2>& aerosol_concentrations)
+{
+  invoke_aerosol_concen_and_mass(ExecSpace(), dtime, do_capsnow, snl, h2osoi_liq, h2osoi_ice, snw_rds,
+                                 qflx_snwcp_ice, aerosol_masses, aerosol_concentrations);
+}
+
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2>
+void invoke_aerosol_concen_and_mass(const ExecSpace& space, const double& dtime, const ArrayB1 do_capsnow,
+                                    const ArrayI1 snl, const ArrayD2 h2osoi_liq, const ArrayD2 h2osoi_ice,
+                                    const ArrayD2 snw_rds, const ArrayD1 qflx_snwcp_ice,
+                                    AerosolMasses<ArrayD2>& aerosol_masses,
+                                    AerosolConcentrations<ArrayD2>& aerosol_concentrations)
 {
   ComputeAerosolConcenAndMass aerosol_c_mass_object(dtime, do_capsnow, snl, h2osoi_liq, h2osoi_ice, snw_rds,
                                                     qflx_snwcp_ice, aerosol_masses, aerosol_concentrations);
 
-  invoke_kernel(aerosol_c_mass_object, std::make_tuple(snl.extent(0)), "ComputeAerosolConcenAndMass");
+  invoke_kernel(space, aerosol_c_mass_object, std::make_tuple(snl.extent(0)), "ComputeAerosolConcenAndMass");
+}
+
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayD3>
+void invoke_aerosol_snow_state(const Utils::Date& model_time, const double& dtime, const ArrayB1 do_capsnow,
+                               const ArrayI1 snl, const ArrayD2 h2osoi_liq, const ArrayD2 h2osoi_ice,
+                               const ArrayD2 snw_rds, const ArrayD1 qflx_snwcp_ice,
+                               const GriddedAerosolDataManager<ArrayD3>& aerosol_data,
+                               AerosolState<ArrayD2, ArrayD3>& aerosol_state, ArrayD3 mss_cnc_aer_in_fdb)
+{
+  invoke_aerosol_snow_state(ExecSpace(), model_time, dtime, do_capsnow, snl, h2osoi_liq, h2osoi_ice, snw_rds,
+                            qflx_snwcp_ice, aerosol_data, aerosol_state, mss_cnc_aer_in_fdb);
+}
+
+template <typename ArrayB1, typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayD3>
+void invoke_aerosol_snow_state(const ExecSpace& space, const Utils::Date& model_time, const double& dtime,
+                               const ArrayB1 do_capsnow, const ArrayI1 snl, const ArrayD2 h2osoi_liq,
+                               const ArrayD2 h2osoi_ice, const ArrayD2 snw_rds, const ArrayD1 qflx_snwcp_ice,
+                               const GriddedAerosolDataManager<ArrayD3>& aerosol_data,
+                               AerosolState<ArrayD2, ArrayD3>& aerosol_state, ArrayD3 mss_cnc_aer_in_fdb)
+{
+  // per-cell forcing, interpolated on device
+  aerosol_data.get_aerosol_source(space, model_time, dtime, aerosol_state.forc);
+
+  ComputeAerosolSnowState aerosol_state_object(dtime, do_capsnow, snl, h2osoi_liq, h2osoi_ice, snw_rds,
+                                               qflx_snwcp_ice, aerosol_state, mss_cnc_aer_in_fdb);
+
+  invoke_kernel(space, aerosol_state_object, std::make_tuple(snl.extent(0)), "ComputeAerosolSnowState");
 }
 
 } // namespace ELM::aerosols
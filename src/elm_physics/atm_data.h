@@ -4,6 +4,7 @@
 #include "array.hh"
 #include "atm_physics.h"
 #include "elm_constants.h"
+#include "land_mask.hh"
 #include "read_input.hh"
 #include "utils.hh"
 
@@ -151,12 +152,27 @@ public:
                                   const size_t& ntimes, const Utils::Date& new_file_start_time,
                                   const std::string& new_filename);
 
+  // land-only versions - gather land points of the local rectangle into h_data(ntimes, mask.n_land())
+  template <typename h_ArrayD2>
+  constexpr void read_atm_forcing(h_ArrayD2 h_data, const Utils::DomainDecomposition<2>& dd,
+                                  const Utils::LandMask& mask, const Utils::Date& model_time, const size_t& ntimes);
+
+  template <typename h_ArrayD2>
+  constexpr void read_atm_forcing(h_ArrayD2 h_data, const Utils::DomainDecomposition<2>& dd,
+                                  const Utils::LandMask& mask, const Utils::Date& model_time, const size_t& ntimes,
+                                  const Utils::Date& new_file_start_time, const std::string& new_filename);
+
   // get forcing data for the current timestep
   // interpolate point values
   // process data
   template <typename... Args>
   constexpr void get_atm_forcing(const double& model_dt, const Utils::Date& model_time, Args&&...args);
 
+  // as above, with the processing kernel launched on execution space instance space
+  template <typename... Args>
+  constexpr void get_atm_forcing(const ExecSpace& space, const double& model_dt, const Utils::Date& model_time,
+                                 Args&&...args);
+
 private:
   // return reference to arg in Args that matches position of dimension dimname in file array
   template <typename... Args, size_t D>
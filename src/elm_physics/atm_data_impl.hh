@@ -262,6 +262,19 @@ read_atm_forcing(h_ArrayD2 h_data,
                  const Utils::DomainDecomposition<2>& dd,
                  const Utils::Date& model_time,
                  const size_t& ntimes)
+{
+  read_atm_forcing(h_data, dd, Utils::all_land(dd), model_time, ntimes);
+}
+
+// read forcing data from a file for land points only
+template <typename ArrayD1, typename ArrayD2, AtmForcType ftype>
+template <typename h_ArrayD2>
+constexpr void AtmDataManager<ArrayD1, ArrayD2, ftype>::
+read_atm_forcing(h_ArrayD2 h_data,
+                 const Utils::DomainDecomposition<2>& dd,
+                 const Utils::LandMask& mask,
+                 const Utils::Date& model_time,
+                 const size_t& ntimes)
 {
   // resize if ntimes has changed - assume ncells_ doesn't change
   if (ntimes != static_cast<size_t>(h_data.extent(0))) {
@@ -298,7 +311,7 @@ read_atm_forcing(h_ArrayD2 h_data,
   update_data_start_time(file_t_idx);
   // check data extents
   assert(static_cast<size_t>(h_data.extent(0)) == ntimes);
-  assert(static_cast<size_t>(h_data.extent(1)) == dd.n_local[0] * dd.n_local[1]);
+  assert(static_cast<size_t>(h_data.extent(1)) == mask.n_land());
 
   // maps h_data(ntimes, ncells) = arr_for_read(ii, jj, kk)
   // where (ii, jj, kk) are references to some arbitrary permutation of {ntimes, nlongitude, nlatitude}
@@ -317,11 +330,14 @@ read_atm_forcing(h_ArrayD2 h_data,
   // get references to loop indices
   size_t i, j, k;
   const auto [ii, jj, kk] = order_inputs(dd.comm, i, j, k);
-  // copy file data into model host array
+  // copy land points of file data into model host array
   for (i = 0; i != ntimes; ++i) {
     for (j = 0; j != dd.n_local[0]; ++j) {
       for (k = 0; k != dd.n_local[1]; ++k) {
-        h_data(i, j * dd.n_local[1] + k) = arr_for_read(ii, jj, kk) * scale_factor_ + add_offset_;
+        const int cell = mask.cell_idx[j * dd.n_local[1] + k];
+        if (cell >= 0) {
+          h_data(i, cell) = arr_for_read(ii, jj, kk) * scale_factor_ + add_offset_;
+        }
       }
     }
   }
@@ -342,6 +358,22 @@ read_atm_forcing(h_ArrayD2 h_data,
   read_atm_forcing(h_data, dd, model_time, ntimes);
 }
 
+// read forcing data from a file for land points only - update file info and call main read_atm method
+template <typename ArrayD1, typename ArrayD2, AtmForcType ftype>
+template <typename h_ArrayD2>
+constexpr void AtmDataManager<ArrayD1, ArrayD2, ftype>::
+read_atm_forcing(h_ArrayD2 h_data,
+                 const Utils::DomainDecomposition<2>& dd,
+                 const Utils::LandMask& mask,
+                 const Utils::Date& model_time,
+                 const size_t& ntimes,
+                 const Utils::Date& new_file_start_time,
+                 const std::string& new_filename)
+{
+  update_file_info(new_file_start_time, new_filename);
+  read_atm_forcing(h_data, dd, mask, model_time, ntimes);
+}
+
 // get forcing data for the current timestep
 // interpolate point values
 // process data
@@ -352,6 +384,17 @@ constexpr void AtmDataManager<ArrayD1, ArrayD2, ftype>::
 get_atm_forcing(const double& model_dt,
                 const Utils::Date& model_time,
                 Args&&...args)
+{
+  get_atm_forcing(ExecSpace(), model_dt, model_time, std::forward<Args>(args)...);
+}
+
+template <typename ArrayD1, typename ArrayD2, AtmForcType ftype>
+template <typename... Args>
+constexpr void AtmDataManager<ArrayD1, ArrayD2, ftype>::
+get_atm_forcing(const ExecSpace& space,
+                const double& model_dt,
+                const Utils::Date& model_time,
+                Args&&...args)
 {
   const size_t t_idx = forc_t_idx_check_bounds(model_dt, model_time, data_start_time_);
   const auto [wt1, wt2] = forcing_time_weights(t_idx, model_time);
@@ -383,7 +426,7 @@ get_atm_forcing(const double& model_dt,
     }
   }();
 
-  invoke_kernel(physics_object, std::make_tuple(static_cast<int>(ncells_)), "ComputeAtmForcing_"+atm_utils::get_varname<ftype>());
+  invoke_kernel(space, physics_object, std::make_tuple(static_cast<int>(ncells_)), "ComputeAtmForcing_"+atm_utils::get_varname<ftype>());
 }
 
 } // namespace ELM
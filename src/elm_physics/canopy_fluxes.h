@@ -101,6 +101,25 @@ void initialize_flux(const LandType& Land, const int& snl, const int& frac_veg_n
                      double& qsatl, double& qsatldT, double& taf, double& qaf, double& um, double& ur, double& obu,
                      double& zldis, double& delq, double& t_veg);
 
+/*! As above, with soil suction of layer i given by suction(i, s) in place of sucsat and bsw
+- see soil_moist_stress::calc_root_moist_stress()
+*/
+template <class ArrayD1, class Suction>
+ACCELERATE
+void initialize_flux(const LandType& Land, const int& snl, const int& frac_veg_nosno, const double& frac_sno,
+                     const double& forc_hgt_u_patch, const double& thm, const double& thv, const double& max_dayl,
+                     const double& dayl, const int& altmax_indx, const int& altmax_lastyear_indx,
+                     const ArrayD1 t_soisno, const ArrayD1 h2osoi_ice, const ArrayD1 h2osoi_liq, const ArrayD1 dz,
+                     const ArrayD1 rootfr, const double& tc_stress, const Suction& suction,
+                     const ArrayD1 watsat, const double& smpso, const double& smpsc, const double& elai,
+                     const double& esai, const double& emv, const double& emg, const double& qg, const double& t_grnd,
+                     const double& forc_t, const double& forc_pbot, const double& forc_lwrad, const double& forc_u,
+                     const double& forc_v, const double& forc_q, const double& forc_th, const double& z0mg,
+                     double& btran, double& displa, double& z0mv, double& z0hv, double& z0qv, ArrayD1 rootr,
+                     ArrayD1 eff_porosity, double& dayl_factor, double& air, double& bir, double& cir, double& el,
+                     double& qsatl, double& qsatldT, double& taf, double& qaf, double& um, double& ur, double& obu,
+                     double& zldis, double& delq, double& t_veg);
+
 /*! Calculate Monin-Obukhov length and wind speed, call photosynthesis, calculate ET & SH flux
 Iterates until convergence, up to 40 iterations, calling friction velocity functions, then
 photosynthesis for both sun & shade.
@@ -295,6 +314,29 @@ void compute_flux(const LandType& Land, const double& dtime, const int& snl, con
                   double& qflx_ev_h2osfc, double& dlrad, double& ulrad, double& cgrnds, double& cgrndl, double& cgrnd,
                   double& t_ref2m, double& t_ref2m_r, double& q_ref2m, double& rh_ref2m, double& rh_ref2m_r);
 
+/*! compute_flux() that also returns the canopy energy balance error
+
+\param[out] err                        [double] canopy energy balance error (W/m**2), 0 without exposed vegetation
+*/
+template <class ArrayD1>
+ACCELERATE
+void compute_flux(const LandType& Land, const double& dtime, const int& snl, const int& frac_veg_nosno,
+                  const double& frac_sno, const ArrayD1 t_soisno, const double& frac_h2osfc, const double& t_h2osfc,
+                  const double& sabv, const double& qg_snow, const double& qg_soil, const double& qg_h2osfc,
+                  const double& dqgdT, const double& htvp, const double& wtg, const double& wtl0, const double& wta0,
+                  const double& wtal, const double& air, const double& bir, const double& cir, const double& qsatl,
+                  const double& qsatldT, const double& dth, const double& dqh, const double& temp1, const double& temp2,
+                  const double& temp12m, const double& temp22m, const double& tlbef, const double& delq,
+                  const double& dt_veg, const double& t_veg, const double& t_grnd, const double& forc_pbot,
+                  const double& qflx_tran_veg, const double& qflx_evap_veg, const double& eflx_sh_veg,
+                  const double& forc_q, const double& forc_rho, const double& thm, const double& emv, const double& emg,
+                  const double& forc_lwrad, const double& wtgq, const double& wtalq, const double& wtlq0,
+                  const double& wtaq0, double& h2ocan, double& eflx_sh_grnd, double& eflx_sh_snow, double& eflx_sh_soil,
+                  double& eflx_sh_h2osfc, double& qflx_evap_soi, double& qflx_ev_snow, double& qflx_ev_soil,
+                  double& qflx_ev_h2osfc, double& dlrad, double& ulrad, double& cgrnds, double& cgrndl, double& cgrnd,
+                  double& t_ref2m, double& t_ref2m_r, double& q_ref2m, double& rh_ref2m, double& rh_ref2m_r,
+                  double& err);
+
 } // namespace ELM::canopy_fluxes
 
 #include "canopy_fluxes_impl.hh"
@@ -105,6 +105,30 @@ void initialize_flux(const LandType& Land, const int& snl, const int& frac_veg_n
                      ArrayD1 eff_porosity, double& dayl_factor, double& air, double& bir, double& cir, double& el,
                      double& qsatl, double& qsatldT, double& taf, double& qaf, double& um, double& ur, double& obu,
                      double& zldis, double& delq, double& t_veg)
+{
+  initialize_flux(Land, snl, frac_veg_nosno, frac_sno, forc_hgt_u_patch, thm, thv, max_dayl, dayl, altmax_indx,
+                  altmax_lastyear_indx, t_soisno, h2osoi_ice, h2osoi_liq, dz, rootfr, tc_stress,
+                  soil_moist_stress::ClappHornbergerSuction(sucsat, bsw), watsat, smpso, smpsc, elai, esai, emv, emg,
+                  qg, t_grnd, forc_t, forc_pbot, forc_lwrad, forc_u, forc_v, forc_q, forc_th, z0mg, btran, displa,
+                  z0mv, z0hv, z0qv, rootr, eff_porosity, dayl_factor, air, bir, cir, el, qsatl, qsatldT, taf, qaf,
+                  um, ur, obu, zldis, delq, t_veg);
+}
+
+template <class ArrayD1, class Suction>
+ACCELERATE
+void initialize_flux(const LandType& Land, const int& snl, const int& frac_veg_nosno, const double& frac_sno,
+                     const double& forc_hgt_u_patch, const double& thm, const double& thv, const double& max_dayl,
+                     const double& dayl, const int& altmax_indx, const int& altmax_lastyear_indx,
+                     const ArrayD1 t_soisno, const ArrayD1 h2osoi_ice, const ArrayD1 h2osoi_liq, const ArrayD1 dz,
+                     const ArrayD1 rootfr, const double& tc_stress, const Suction& suction,
+                     const ArrayD1 watsat, const double& smpso, const double& smpsc, const double& elai,
+                     const double& esai, const double& emv, const double& emg, const double& qg, const double& t_grnd,
+                     const double& forc_t, const double& forc_pbot, const double& forc_lwrad, const double& forc_u,
+                     const double& forc_v, const double& forc_q, const double& forc_th, const double& z0mg,
+                     double& btran, double& displa, double& z0mv, double& z0hv, double& z0qv, ArrayD1 rootr,
+                     ArrayD1 eff_porosity, double& dayl_factor, double& air, double& bir, double& cir, double& el,
+                     double& qsatl, double& qsatldT, double& taf, double& qaf, double& um, double& ur, double& obu,
+                     double& zldis, double& delq, double& t_veg)
 {
   // -----------------------------------------------------------------
   // Time step initialization of photosynthesis variables
@@ -142,7 +166,7 @@ void initialize_flux(const LandType& Land, const int& snl, const int& frac_veg_n
       double h2osoi_liqvol[nlevgrnd + nlevsno];
       soil_moist_stress::calc_volumetric_h2oliq(eff_porosity, h2osoi_liq, dz, h2osoi_liqvol);
       // calculate root moisture stress
-      soil_moist_stress::calc_root_moist_stress(h2osoi_liqvol, rootfr, t_soisno, tc_stress, sucsat, watsat, bsw, smpso,
+      soil_moist_stress::calc_root_moist_stress(h2osoi_liqvol, rootfr, t_soisno, tc_stress, suction, watsat, smpso,
                                                 smpsc, eff_porosity, altmax_indx, altmax_lastyear_indx, rootr, btran);
 
       // Modify aerodynamic parameters for sparse/dense canopy (X. Zeng)
@@ -227,7 +251,6 @@ void stability_iteration(
     static const double dlemin = 0.1; // max limit for energy flux convergence [w/m2]
     static const double dtmin = 0.01; // max limit for temperature convergence [K]
 
-    double ci_z[nlevcan] = {0.0}; // solution to integration eval from previous iteration
     while (itlef <= itmax && !stop) {
       // Determine friction velocity, and potential temperature and humidity profiles of the surface boundary layer
       friction_velocity::friction_velocity_wind(forc_hgt_u_patch, displa, um, obu, z0mv, ustar);
@@ -283,7 +306,7 @@ void stability_iteration(
 
       // call photosynthesis (phase=sun)
       photosynthesis::photosynthesis(psn_pft, nrad, forc_pbot, t_veg, t10, svpts, eah, forc_po2, forc_pco2, rb, btran,
-                                     dayl_factor, thm, tlai_z, vcmaxcintsun, parsun_z, laisun_z, ci_z, rssun);
+                                     dayl_factor, thm, tlai_z, vcmaxcintsun, parsun_z, laisun_z, rssun);
 
       if (Land.vtype == PFT::nsoybean || Land.vtype == PFT::nsoybeanirrig) {
         btran = std::min(1.0, btran * 1.25);
@@ -291,7 +314,7 @@ void stability_iteration(
 
       // call photosynthesis (phase=shade)
       photosynthesis::photosynthesis(psn_pft, nrad, forc_pbot, t_veg, t10, svpts, eah, forc_po2, forc_pco2, rb, btran,
-                                     dayl_factor, thm, tlai_z, vcmaxcintsha, parsha_z, laisha_z, ci_z, rssha);
+                                     dayl_factor, thm, tlai_z, vcmaxcintsha, parsha_z, laisha_z, rssha);
 
       // Sensible heat conductance for air, leaf and ground
       wta = 1.0 / rah[0];       // air
@@ -466,9 +489,39 @@ void compute_flux(const LandType& Land, const double& dtime, const int& snl, con
                   double& eflx_sh_h2osfc, double& qflx_evap_soi, double& qflx_ev_snow, double& qflx_ev_soil,
                   double& qflx_ev_h2osfc, double& dlrad, double& ulrad, double& cgrnds, double& cgrndl, double& cgrnd,
                   double& t_ref2m, double& t_ref2m_r, double& q_ref2m, double& rh_ref2m, double& rh_ref2m_r)
+{
+  double err;
+  compute_flux(Land, dtime, snl, frac_veg_nosno, frac_sno, t_soisno, frac_h2osfc, t_h2osfc, sabv, qg_snow, qg_soil,
+               qg_h2osfc, dqgdT, htvp, wtg, wtl0, wta0, wtal, air, bir, cir, qsatl, qsatldT, dth, dqh, temp1, temp2,
+               temp12m, temp22m, tlbef, delq, dt_veg, t_veg, t_grnd, forc_pbot, qflx_tran_veg, qflx_evap_veg,
+               eflx_sh_veg, forc_q, forc_rho, thm, emv, emg, forc_lwrad, wtgq, wtalq, wtlq0, wtaq0, h2ocan,
+               eflx_sh_grnd, eflx_sh_snow, eflx_sh_soil, eflx_sh_h2osfc, qflx_evap_soi, qflx_ev_snow, qflx_ev_soil,
+               qflx_ev_h2osfc, dlrad, ulrad, cgrnds, cgrndl, cgrnd, t_ref2m, t_ref2m_r, q_ref2m, rh_ref2m, rh_ref2m_r,
+               err);
+} // compute_flux()
+
+template <class ArrayD1>
+ACCELERATE
+void compute_flux(const LandType& Land, const double& dtime, const int& snl, const int& frac_veg_nosno,
+                  const double& frac_sno, const ArrayD1 t_soisno, const double& frac_h2osfc, const double& t_h2osfc,
+                  const double& sabv, const double& qg_snow, const double& qg_soil, const double& qg_h2osfc,
+                  const double& dqgdT, const double& htvp, const double& wtg, const double& wtl0, const double& wta0,
+                  const double& wtal, const double& air, const double& bir, const double& cir, const double& qsatl,
+                  const double& qsatldT, const double& dth, const double& dqh, const double& temp1, const double& temp2,
+                  const double& temp12m, const double& temp22m, const double& tlbef, const double& delq,
+                  const double& dt_veg, const double& t_veg, const double& t_grnd, const double& forc_pbot,
+                  const double& qflx_tran_veg, const double& qflx_evap_veg, const double& eflx_sh_veg,
+                  const double& forc_q, const double& forc_rho, const double& thm, const double& emv, const double& emg,
+                  const double& forc_lwrad, const double& wtgq, const double& wtalq, const double& wtlq0,
+                  const double& wtaq0, double& h2ocan, double& eflx_sh_grnd, double& eflx_sh_snow, double& eflx_sh_soil,
+                  double& eflx_sh_h2osfc, double& qflx_evap_soi, double& qflx_ev_snow, double& qflx_ev_soil,
+                  double& qflx_ev_h2osfc, double& dlrad, double& ulrad, double& cgrnds, double& cgrndl, double& cgrnd,
+                  double& t_ref2m, double& t_ref2m_r, double& q_ref2m, double& rh_ref2m, double& rh_ref2m_r,
+                  double& err)
 {
   using ELMconst::CPAIR;
 
+  err = 0.0;
   if (!Land.lakpoi) {
     // Initial set for calculation
     cgrnd = 0.0;
@@ -483,8 +536,8 @@ void compute_flux(const LandType& Land, const double& dtime, const int& snl, con
     // Energy balance check in canopy
     double lw_grnd = (frac_sno * pow(t_soisno(nlevsno - snl), 4.0) +
                       (1.0 - frac_sno - frac_h2osfc) * pow(t_soisno(nlevsno), 4.0) + frac_h2osfc * pow(t_h2osfc, 4.0));
-    double err = sabv + air + bir * pow(tlbef, 3.0) * (tlbef + 4.0 * dt_veg) + cir * lw_grnd - eflx_sh_veg -
-                 ELMconst::HVAP * qflx_evap_veg;
+    err = sabv + air + bir * pow(tlbef, 3.0) * (tlbef + 4.0 * dt_veg) + cir * lw_grnd - eflx_sh_veg -
+          ELMconst::HVAP * qflx_evap_veg;
 
     // Fluxes from ground to canopy space
     double delt = wtal * t_grnd - wtl0 * t_veg - wta0 * thm;
@@ -531,8 +584,7 @@ void compute_flux(const LandType& Land, const double& dtime, const int& snl, con
     // Determine total photosynthesis -- need to implement -- vars don't get used - diagnostics, maybe??
     // photosynthesis_total(fn, filterp, atm2lnd_vars, cnstate_vars, canopystate_vars, photosyns_vars)
 
-    // evaluate error and write?? -- best way to write?
-    //  if (abs(err(p)) > 0.1_r8)
+    // err is checked by the caller, see state_validation.h
   }
 } // compute_flux()
 
@@ -161,6 +161,15 @@ void ground_properties(const LandType& Land, const int& snl, const double& frac_
                        double& emg, double& emv, double& htvp, double& z0mg, double& z0hg, double& z0qg, double& z0mv,
                        double& z0hv, double& z0qv, double& thv, double& z0m, double& displa);
 
+// as above, with displar and z0mr already taken for this cell's pft (see GatherPFTData)
+template <typename ArrayD1>
+ACCELERATE
+void ground_properties(const LandType& Land, const int& snl, const double& frac_sno, const double& forc_th,
+                       const double& forc_q, const double& elai, const double& esai, const double& htop,
+                       const double& displar, const double& z0mr, const ArrayD1 h2osoi_liq, const ArrayD1 h2osoi_ice,
+                       double& emg, double& emv, double& htvp, double& z0mg, double& z0hg, double& z0qg, double& z0mv,
+                       double& z0hv, double& z0qv, double& thv, double& z0m, double& displa);
+
 /*! Calculate roughness length, displacement height, and forcing height for wind, temp, and humidity.
 
 \param[in]  Land             [LandType] struct containing information about landtype
@@ -190,6 +190,20 @@ void ground_properties(const LandType& Land, const int& snl, const double& frac_
                        const SubviewD1 displar, const SubviewD1 z0mr, const ArrayD1 h2osoi_liq, const ArrayD1 h2osoi_ice,
                        double& emg, double& emv, double& htvp, double& z0mg, double& z0hg, double& z0qg, double& z0mv,
                        double& z0hv, double& z0qv, double& thv, double& z0m, double& displa)
+{
+  const double displar_pft = displar(Land.vtype);
+  const double z0mr_pft = z0mr(Land.vtype);
+  ground_properties(Land, snl, frac_sno, forc_th, forc_q, elai, esai, htop, displar_pft, z0mr_pft, h2osoi_liq,
+                    h2osoi_ice, emg, emv, htvp, z0mg, z0hg, z0qg, z0mv, z0hv, z0qv, thv, z0m, displa);
+} // ground_properties
+
+template <typename ArrayD1>
+ACCELERATE
+void ground_properties(const LandType& Land, const int& snl, const double& frac_sno, const double& forc_th,
+                       const double& forc_q, const double& elai, const double& esai, const double& htop,
+                       const double& displar, const double& z0mr, const ArrayD1 h2osoi_liq, const ArrayD1 h2osoi_ice,
+                       double& emg, double& emv, double& htvp, double& z0mg, double& z0hg, double& z0qg, double& z0mv,
+                       double& z0hv, double& z0qv, double& thv, double& z0m, double& displa)
 {
   if (!Land.lakpoi) {
     double avmuir; // ir inverse optical depth per unit leaf area
@@ -224,8 +238,8 @@ void ground_properties(const LandType& Land, const int& snl, const double& frac_
     }
     z0hg = z0mg; // initial set only
     z0qg = z0mg; // initial set only
-    z0m = z0mr(Land.vtype) * htop;
-    displa = displar(Land.vtype) * htop;
+    z0m = z0mr * htop;
+    displa = displar * htop;
 
     // vegetation roughness lengths
     z0mv = z0m;
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "array.hh"
+#include "mpi_types.hh"
+#include "utils.hh"
+
+#include <algorithm>
+#include <assert.h>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+
+/*
+optional permutation layer for the local cell index
+
+the drivers lay cells out in grid order, idx = j * dd.n_local[1] + k
+neighbouring cells in that order frequently differ in vegetation type, snow state and landunit,
+which breaks up control flow coherence across SIMD lanes/GPU warps and scatters lookups into the
+pft and snicar parameter tables
+
+CellPermutation holds a map between grid order and compute order
+perm(i) = grid-order index of the cell stored at compute index i
+inv(g)  = compute index of grid-order cell g
+
+orderings are built on host, either along a Hilbert curve through the local grid (spatial locality)
+or by a stable sort on (landunit, vtype, snow/no-snow) keys - applying the key sort to a Hilbert
+ordering keeps ties spatially local
+
+all per-cell views must be permuted with the same CellPermutation before the first timestep
+data read in grid order (forcing, phenology) is gathered through perm, and output is scattered
+back to grid order through inv (see IO::reshape_and_write_grid_cell)
+*/
+
+namespace ELM {
+
+template <typename ArrayI1>
+struct CellPermutation {
+  CellPermutation(const size_t& ncells);
+  ~CellPermutation() = default;
+  ArrayI1 perm, inv;
+};
+
+} // namespace ELM
+
+namespace ELM::cell_ordering {
+
+// position of cell (x, y) along a Hilbert curve through an n x n grid, n a power of 2
+GO hilbert_index(const GO n, GO x, GO y);
+
+// host-side ordering builders - arguments are host arrays of length ncells
+// grid order, perm(i) = i
+template <typename h_ArrayI1>
+void identity_order(h_ArrayI1 perm);
+
+// order local cells of a 2D decomposition along a Hilbert curve
+template <typename h_ArrayI1>
+void hilbert_order(const Utils::DomainDecomposition<2>& dd, h_ArrayI1 perm);
+
+// stable sort of an existing ordering by (ltype, vtype, snl > 0)
+// ltype, vtype, and snl are indexed in grid order
+template <typename h_ArrayI1>
+void key_order(const h_ArrayI1 ltype, const h_ArrayI1 vtype, const h_ArrayI1 snl, h_ArrayI1 perm);
+
+// inv(perm(i)) = i
+template <typename h_ArrayI1>
+void invert_order(const h_ArrayI1 perm, h_ArrayI1 inv);
+
+// functors to gather cells through an index map
+// arr(i) = src(idx(i))
+template <typename ArrayI1, typename ArrayT1>
+struct GatherCellsD1 {
+  GatherCellsD1(const ArrayI1 idx, const ArrayT1 src, ArrayT1 arr);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayI1 idx_;
+  ArrayT1 src_, arr_;
+};
+
+// cell is the first dimension - arr(i, :) = src(idx(i), :)
+template <typename ArrayI1, typename ArrayT2>
+struct GatherCellsD2 {
+  GatherCellsD2(const ArrayI1 idx, const ArrayT2 src, ArrayT2 arr);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayI1 idx_;
+  ArrayT2 src_, arr_;
+};
+
+// cell is the second dimension, as in (ntimes, ncells) forcing data - arr(:, i) = src(:, idx(i))
+template <typename ArrayI1, typename ArrayT2>
+struct GatherCellsTrailing {
+  GatherCellsTrailing(const ArrayI1 idx, const ArrayT2 src, ArrayT2 arr);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayI1 idx_;
+  ArrayT2 src_, arr_;
+};
+
+// convenience functions to permute views in place
+// pass cell_perm.perm to move grid-order data into compute order
+// pass cell_perm.inv to move compute-order data back into grid order
+template <typename ArrayI1, typename ArrayT1>
+void permute_d1(const ArrayI1 idx, ArrayT1& arr);
+
+template <typename ArrayI1, typename ArrayT2>
+void permute_d2(const ArrayI1 idx, ArrayT2& arr);
+
+template <typename ArrayI1, typename ArrayT2>
+void permute_trailing(const ArrayI1 idx, ArrayT2& arr);
+
+} // namespace ELM::cell_ordering
+
+#include "cell_ordering_impl.hh"
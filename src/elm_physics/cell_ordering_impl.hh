@@ -0,0 +1,154 @@
+#pragma once
+
+template <typename ArrayI1>
+ELM::CellPermutation<ArrayI1>::CellPermutation(const size_t& ncells)
+    : perm("cell_perm", ncells), inv("cell_perm_inv", ncells)
+    {}
+
+namespace ELM::cell_ordering {
+
+inline GO hilbert_index(const GO n, GO x, GO y)
+{
+  GO d = 0;
+  for (GO s = n / 2; s > 0; s /= 2) {
+    const GO rx = (x & s) > 0;
+    const GO ry = (y & s) > 0;
+    d += s * s * ((3 * rx) ^ ry);
+    // rotate quadrant
+    if (ry == 0) {
+      if (rx == 1) {
+        x = s - 1 - x;
+        y = s - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+template <typename h_ArrayI1>
+void identity_order(h_ArrayI1 perm)
+{
+  for (int i = 0; i < static_cast<int>(perm.extent(0)); ++i) {
+    perm(i) = i;
+  }
+}
+
+template <typename h_ArrayI1>
+void hilbert_order(const Utils::DomainDecomposition<2>& dd, h_ArrayI1 perm)
+{
+  const GO ncells = dd.n_local[0] * dd.n_local[1];
+  assert(static_cast<GO>(perm.extent(0)) == ncells && "hilbert_order: perm must have length n_local[0]*n_local[1]");
+
+  GO n = 1;
+  while (n < std::max(dd.n_local[0], dd.n_local[1])) {
+    n *= 2;
+  }
+
+  std::vector<GO> curve_idx(ncells);
+  for (GO j = 0; j < dd.n_local[0]; ++j) {
+    for (GO k = 0; k < dd.n_local[1]; ++k) {
+      curve_idx[j * dd.n_local[1] + k] = hilbert_index(n, j, k);
+    }
+  }
+
+  std::vector<int> order(ncells);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&curve_idx](const int a, const int b) {
+    return curve_idx[a] < curve_idx[b];
+  });
+
+  for (GO i = 0; i < ncells; ++i) {
+    perm(i) = order[i];
+  }
+}
+
+template <typename h_ArrayI1>
+void key_order(const h_ArrayI1 ltype, const h_ArrayI1 vtype, const h_ArrayI1 snl, h_ArrayI1 perm)
+{
+  const int ncells = perm.extent(0);
+  std::vector<int> order(ncells);
+  for (int i = 0; i < ncells; ++i) {
+    order[i] = perm(i);
+  }
+
+  std::stable_sort(order.begin(), order.end(), [&ltype, &vtype, &snl](const int a, const int b) {
+    return std::make_tuple(ltype(a), vtype(a), snl(a) > 0) < std::make_tuple(ltype(b), vtype(b), snl(b) > 0);
+  });
+
+  for (int i = 0; i < ncells; ++i) {
+    perm(i) = order[i];
+  }
+}
+
+template <typename h_ArrayI1>
+void invert_order(const h_ArrayI1 perm, h_ArrayI1 inv)
+{
+  assert(perm.extent(0) == inv.extent(0) && "invert_order: perm and inv must be the same length");
+  for (int i = 0; i < static_cast<int>(perm.extent(0)); ++i) {
+    inv(perm(i)) = i;
+  }
+}
+
+template <typename ArrayI1, typename ArrayT1>
+GatherCellsD1<ArrayI1, ArrayT1>::GatherCellsD1(const ArrayI1 idx, const ArrayT1 src, ArrayT1 arr)
+    : idx_{idx}, src_{src}, arr_{arr} {}
+
+template <typename ArrayI1, typename ArrayT1>
+ACCELERATE
+void GatherCellsD1<ArrayI1, ArrayT1>::operator()(const int i) const {
+  arr_(i) = src_(idx_(i));
+}
+
+template <typename ArrayI1, typename ArrayT2>
+GatherCellsD2<ArrayI1, ArrayT2>::GatherCellsD2(const ArrayI1 idx, const ArrayT2 src, ArrayT2 arr)
+    : idx_{idx}, src_{src}, arr_{arr} {}
+
+template <typename ArrayI1, typename ArrayT2>
+ACCELERATE
+void GatherCellsD2<ArrayI1, ArrayT2>::operator()(const int i) const {
+  for (int j = 0; j < static_cast<int>(arr_.extent(1)); ++j) {
+    arr_(i, j) = src_(idx_(i), j);
+  }
+}
+
+template <typename ArrayI1, typename ArrayT2>
+GatherCellsTrailing<ArrayI1, ArrayT2>::GatherCellsTrailing(const ArrayI1 idx, const ArrayT2 src, ArrayT2 arr)
+    : idx_{idx}, src_{src}, arr_{arr} {}
+
+template <typename ArrayI1, typename ArrayT2>
+ACCELERATE
+void GatherCellsTrailing<ArrayI1, ArrayT2>::operator()(const int i) const {
+  for (int t = 0; t < static_cast<int>(arr_.extent(0)); ++t) {
+    arr_(t, i) = src_(t, idx_(i));
+  }
+}
+
+template <typename ArrayI1, typename ArrayT1>
+void permute_d1(const ArrayI1 idx, ArrayT1& arr)
+{
+  ArrayT1 src(arr.label() + "_unpermuted", arr.extent(0));
+  NS::deep_copy(src, arr);
+  GatherCellsD1 gather_object(idx, src, arr);
+  invoke_kernel(gather_object, std::make_tuple(idx.extent(0)), "GatherCellsD1_" + arr.label());
+}
+
+template <typename ArrayI1, typename ArrayT2>
+void permute_d2(const ArrayI1 idx, ArrayT2& arr)
+{
+  ArrayT2 src(arr.label() + "_unpermuted", arr.extent(0), arr.extent(1));
+  NS::deep_copy(src, arr);
+  GatherCellsD2 gather_object(idx, src, arr);
+  invoke_kernel(gather_object, std::make_tuple(idx.extent(0)), "GatherCellsD2_" + arr.label());
+}
+
+template <typename ArrayI1, typename ArrayT2>
+void permute_trailing(const ArrayI1 idx, ArrayT2& arr)
+{
+  ArrayT2 src(arr.label() + "_unpermuted", arr.extent(0), arr.extent(1));
+  NS::deep_copy(src, arr);
+  GatherCellsTrailing gather_object(idx, src, arr);
+  invoke_kernel(gather_object, std::make_tuple(idx.extent(0)), "GatherCellsTrailing_" + arr.label());
+}
+
+} // namespace ELM::cell_ordering
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "array.hh"
+#include "elm_constants.h"
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+
+/*
+incremental evaluation for stages whose per-cell inputs change slowly
+
+some per-step stages only depend on inputs that change far less often than every step - eg
+surface_albedo::canopy_layer_lai() distributes elai/esai/tlai/tsai over canopy layers, and those come from
+phenology, which is updated once per day - recomputing them every step repeats the same work
+
+ChangeTracker keeps the last value of ninputs per-cell scalar inputs of a stage
+update(inputs) flags cell i dirty if any inputs[n](i) differs (!=) from the value seen by the last update, and
+saves the new values - every cell is dirty on the first update and after invalidate()
+NaN inputs never compare equal, so their cells are always dirty
+
+invoke_dirty_kernel() launches obj(i) for dirty cells only, and optionally clean(i) for the others, for outputs
+that have to be refreshed every step even when the stage itself is skipped
+
+with the profiler enabled update() adds the number of skipped (clean) cells and of tracked cells to the counters
+"skipped" and "cells" of the current region, so they show up in the timing report next to the stage's time
+on device backends this copies the dirty flags to host - with the profiler off nothing is copied
+*/
+
+namespace ELM {
+
+template <typename ArrayI1, typename ArrayD2>
+class ChangeTracker {
+
+public:
+  ChangeTracker(const size_t& ncells, const int& ninputs);
+
+  // compare inputs with the saved values and flag changed cells
+  // inputs must hold ninputs arrays of extent ncells
+  template <typename ArrayD1, size_t N>
+  void update(const std::array<ArrayD1, N>& inputs);
+  template <typename ArrayD1, size_t N>
+  void update(const ExecSpace& space, const std::array<ArrayD1, N>& inputs);
+
+  // every cell is dirty on the next update
+  void invalidate() { force_ = true; }
+
+  // dirty(i) == 1 if cell i changed in the last update
+  const ArrayI1& dirty() const { return dirty_; }
+
+  // number of dirty cells after the last update - copies the flags to host on device backends
+  size_t count_dirty() const;
+  size_t count_dirty(const ExecSpace& space) const;
+
+  size_t ncells() const { return ncells_; }
+  int ninputs() const { return ninputs_; }
+
+private:
+  size_t ncells_;
+  int ninputs_;
+  bool force_;
+  ArrayI1 dirty_;
+  ArrayD2 saved_;
+#ifdef ENABLE_KOKKOS
+  typename ArrayI1::HostMirror h_dirty_;
+#endif
+};
+
+namespace change_tracker {
+
+// functor to compare and save the inputs of every cell
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, size_t N>
+struct UpdateDirty {
+  UpdateDirty(const std::array<ArrayD1, N>& inputs, const bool& force, ArrayD2 saved, ArrayI1 dirty);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  template <size_t... I>
+  UpdateDirty(const std::array<ArrayD1, N>& inputs, const bool& force, ArrayD2 saved, ArrayI1 dirty,
+              std::index_sequence<I...>);
+
+  ArrayD1 inputs_[N];
+  bool force_;
+  ArrayD2 saved_;
+  ArrayI1 dirty_;
+};
+
+// functor to run obj on dirty cells and clean on the others
+template <typename ArrayI1, typename F, typename C>
+struct DirtyCells {
+  DirtyCells(const ArrayI1 dirty, const F& obj, const C& clean);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayI1 dirty_;
+  F obj_;
+  C clean_;
+};
+
+// clean action of invoke_dirty_kernel() without one
+struct NoClean {
+  ACCELERATE
+  void operator()(const int) const {}
+};
+
+} // namespace change_tracker
+
+// call obj(i) for every dirty cell of tracker
+template <typename ArrayI1, typename ArrayD2, typename F>
+void invoke_dirty_kernel(const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj, const std::string& name = "");
+
+template <typename ArrayI1, typename ArrayD2, typename F>
+void invoke_dirty_kernel(const ExecSpace& space, const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj,
+                         const std::string& name = "");
+
+// call obj(i) for every dirty cell of tracker and clean(i) for every other cell, in one launch
+// (C can't be a string, so invoke_dirty_kernel(tracker, obj, "name") calls the overload above)
+template <typename ArrayI1, typename ArrayD2, typename F, typename C,
+          typename = std::enable_if_t<!std::is_convertible_v<C, std::string>>>
+void invoke_dirty_kernel(const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj, C&& clean,
+                         const std::string& name = "");
+
+template <typename ArrayI1, typename ArrayD2, typename F, typename C,
+          typename = std::enable_if_t<!std::is_convertible_v<C, std::string>>>
+void invoke_dirty_kernel(const ExecSpace& space, const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj,
+                         C&& clean, const std::string& name = "");
+
+} // namespace ELM
+
+#include "change_tracker_impl.hh"
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "profiler.hh"
+
+#include <stdexcept>
+
+template <typename ArrayI1, typename ArrayD2>
+ELM::ChangeTracker<ArrayI1, ArrayD2>::ChangeTracker(const size_t& ncells, const int& ninputs)
+    : ncells_{ncells}, ninputs_{ninputs}, force_{true}, dirty_("change_tracker_dirty", ncells),
+      saved_("change_tracker_saved", ncells, ninputs)
+#ifdef ENABLE_KOKKOS
+      , h_dirty_{Kokkos::create_mirror_view(dirty_)}
+#endif
+{
+  // nothing has been seen before the first update()
+  NS::deep_copy(dirty_, 1);
+}
+
+template <typename ArrayI1, typename ArrayD2>
+template <typename ArrayD1, size_t N>
+void ELM::ChangeTracker<ArrayI1, ArrayD2>::update(const std::array<ArrayD1, N>& inputs)
+{
+  update(ExecSpace(), inputs);
+}
+
+template <typename ArrayI1, typename ArrayD2>
+template <typename ArrayD1, size_t N>
+void ELM::ChangeTracker<ArrayI1, ArrayD2>::update(const ExecSpace& space, const std::array<ArrayD1, N>& inputs)
+{
+  if (static_cast<int>(N) != ninputs_) {
+    throw std::runtime_error("ELM ERROR: ChangeTracker tracks " + std::to_string(ninputs_) + " inputs, update got " +
+                             std::to_string(N));
+  }
+  for (const auto& input : inputs) {
+    if (static_cast<size_t>(input.extent(0)) != ncells_) {
+      throw std::runtime_error("ELM ERROR: ChangeTracker input must have length ncells");
+    }
+  }
+
+  change_tracker::UpdateDirty<ArrayI1, ArrayD1, ArrayD2, N> update_dirty(inputs, force_, saved_, dirty_);
+  invoke_kernel(space, update_dirty, std::make_tuple(ncells_), "ChangeTracker::update");
+  force_ = false;
+
+  if (Utils::Profiler::instance().enabled()) {
+    Utils::add_count("skipped", ncells_ - count_dirty(space));
+    Utils::add_count("cells", ncells_);
+  }
+}
+
+template <typename ArrayI1, typename ArrayD2>
+size_t ELM::ChangeTracker<ArrayI1, ArrayD2>::count_dirty() const
+{
+  return count_dirty(ExecSpace());
+}
+
+template <typename ArrayI1, typename ArrayD2>
+size_t ELM::ChangeTracker<ArrayI1, ArrayD2>::count_dirty(const ExecSpace& space) const
+{
+#ifdef ENABLE_KOKKOS
+  Kokkos::deep_copy(space, h_dirty_, dirty_);
+  space.fence();
+  Utils::add_bytes("deep_copy", ncells_ * sizeof(typename ArrayI1::value_type));
+  const auto& h_dirty = h_dirty_;
+#else
+  (void)space;
+  const auto& h_dirty = dirty_;
+#endif
+  size_t ndirty = 0;
+  for (size_t i = 0; i != ncells_; ++i) {
+    ndirty += h_dirty(i) != 0;
+  }
+  return ndirty;
+}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, size_t N>
+ELM::change_tracker::UpdateDirty<ArrayI1, ArrayD1, ArrayD2, N>::
+UpdateDirty(const std::array<ArrayD1, N>& inputs, const bool& force, ArrayD2 saved, ArrayI1 dirty)
+    : UpdateDirty(inputs, force, saved, dirty, std::make_index_sequence<N>()) {}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, size_t N>
+template <size_t... I>
+ELM::change_tracker::UpdateDirty<ArrayI1, ArrayD1, ArrayD2, N>::
+UpdateDirty(const std::array<ArrayD1, N>& inputs, const bool& force, ArrayD2 saved, ArrayI1 dirty,
+            std::index_sequence<I...>)
+    : inputs_{inputs[I]...}, force_{force}, saved_{saved}, dirty_{dirty} {}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, size_t N>
+ACCELERATE
+void ELM::change_tracker::UpdateDirty<ArrayI1, ArrayD1, ArrayD2, N>::operator()(const int i) const
+{
+  bool changed = force_;
+  for (size_t n = 0; n != N; ++n) {
+    const double value = inputs_[n](i);
+    if (value != saved_(i, n)) {
+      changed = true;
+      saved_(i, n) = value;
+    }
+  }
+  dirty_(i) = changed;
+}
+
+template <typename ArrayI1, typename F, typename C>
+ELM::change_tracker::DirtyCells<ArrayI1, F, C>::DirtyCells(const ArrayI1 dirty, const F& obj, const C& clean)
+    : dirty_{dirty}, obj_{obj}, clean_{clean} {}
+
+template <typename ArrayI1, typename F, typename C>
+ACCELERATE
+void ELM::change_tracker::DirtyCells<ArrayI1, F, C>::operator()(const int i) const
+{
+  if (dirty_(i)) {
+    obj_(i);
+  } else {
+    clean_(i);
+  }
+}
+
+template <typename ArrayI1, typename ArrayD2, typename F>
+void ELM::invoke_dirty_kernel(const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj, const std::string& name)
+{
+  invoke_dirty_kernel(ExecSpace(), tracker, std::forward<F>(obj), change_tracker::NoClean(), name);
+}
+
+template <typename ArrayI1, typename ArrayD2, typename F>
+void ELM::invoke_dirty_kernel(const ExecSpace& space, const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj,
+                              const std::string& name)
+{
+  invoke_dirty_kernel(space, tracker, std::forward<F>(obj), change_tracker::NoClean(), name);
+}
+
+template <typename ArrayI1, typename ArrayD2, typename F, typename C, typename>
+void ELM::invoke_dirty_kernel(const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj, C&& clean,
+                              const std::string& name)
+{
+  invoke_dirty_kernel(ExecSpace(), tracker, std::forward<F>(obj), std::forward<C>(clean), name);
+}
+
+template <typename ArrayI1, typename ArrayD2, typename F, typename C, typename>
+void ELM::invoke_dirty_kernel(const ExecSpace& space, const ChangeTracker<ArrayI1, ArrayD2>& tracker, F&& obj,
+                              C&& clean, const std::string& name)
+{
+  change_tracker::DirtyCells<ArrayI1, std::decay_t<F>, std::decay_t<C>> dirty_object(tracker.dirty(), obj, clean);
+  invoke_kernel(space, dirty_object, std::make_tuple(tracker.ncells()), name);
+}
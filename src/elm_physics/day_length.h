@@ -3,6 +3,8 @@
 */
 #pragma once
 
+#include "kokkos_includes.hh"
+
 namespace ELM {
 
 // Computes daylength [seconds]
@@ -10,6 +12,7 @@ namespace ELM {
 // be strictly less than pi/2; lat must be less than pi/2 within a small tolerance.
 // lat  [double]    latitude [radians]
 // decl [double]    solar declination angle [radians]
+ACCELERATE
 double daylength(const double& lat, const double& decl);
 
 // compute maximum daylength [seconds]
@@ -17,6 +20,9 @@ double daylength(const double& lat, const double& decl);
 // maximum declination hardwired for present-day orbital parameters,
 // +/- 23.4667 degrees = +/- 0.409571 radians, use negative value for S. Hem
 // lat  [double]    latitude [radians]
+ACCELERATE
 double max_daylength(const double& lat);
 
 } // namespace ELM
+
+#include "day_length_impl.hh"
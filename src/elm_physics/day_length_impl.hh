@@ -1,9 +1,11 @@
-/*! \file day_length.cc
+/*! \file day_length_impl.hh
 \brief Functions derived from DaylengthMod.F90
 */
 
-#include "day_length.h"
+#pragma once
+
 #include "elm_constants.h"
+#include <algorithm>
 #include <assert.h>
 #include <cmath>
 #include <limits>
@@ -13,6 +15,7 @@ namespace ELM {
 // Computes daylength (in seconds)
 // Latitude and solar declination angle should both be specified in radians. decl must
 // be strictly less than pi/2; lat must be less than pi/2 within a small tolerance.
+ACCELERATE
 double daylength(const double& lat, const double& decl) {
   // number of seconds per radian of hour-angle
   static constexpr double secs_per_radian = 13750.9871;
@@ -26,7 +29,7 @@ double daylength(const double& lat, const double& decl) {
   assert((std::abs(decl) <= pole) && "decl must be strictly less than pi/2");
 
   // Ensure that latitude isn't too close to pole, to avoid problems with cos(lat) being negative
-  double my_lat = std::min(offset_pole, std::max(1.0 * offset_pole, lat));
+  double my_lat = std::min(offset_pole, std::max(-1.0 * offset_pole, lat));
   double temp = -(sin(my_lat) * sin(decl)) / (cos(my_lat) * cos(decl));
   temp = std::min(1.0, std::max(-1.0, temp));
 
@@ -36,6 +39,7 @@ double daylength(const double& lat, const double& decl) {
 // Initialize maximum daylength, based on latitude and maximum declination
 // maximum declination hardwired for present-day orbital parameters,
 // +/- 23.4667 degrees = +/- 0.409571 radians, use negative value for S. Hem
+ACCELERATE
 double max_daylength(const double& lat) { return (lat < 0.0) ? daylength(lat, -0.409571) : daylength(lat, 0.409571); }
 
 } // namespace ELM
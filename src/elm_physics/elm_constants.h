@@ -92,7 +92,7 @@ namespace ELM::ELMdims {
   static constexpr int nlevgrnd{15};   // number of total subsurface layers
   static constexpr int nlevurb{5};     // number of urban layers
   static constexpr int numrad{2};      // number of solar radiation bands: vis, nir
-  static constexpr int nlevcan{1};     // number of leaf layers in canopy layer
+  static constexpr int nlevcan{1};     // number of leaf layers in canopy layer - default size of the layer arrays
   static constexpr int nlevsoi{10};    // number of soil layers (hydrologically active)
   static constexpr int nlevbed{15};    // number of layers to bedrock (hydrologically inactive below)
   static constexpr int mxpft{25};      // maximum number of PFT's for any mode
@@ -100,6 +100,9 @@ namespace ELM::ELMdims {
   static constexpr int numpft{(ELM::use_crop) ? mxpft : numveg}; // number of pfts - (use_crop ? 25 : 17)
   static constexpr int sno_nbr_aer{8}; // number of aerosol species in snowpack
   static constexpr int numrad_snw{5};  // number of spectral bands used in snow model [nbr]
+
+  // canopy_layer_lai() fills at least 4 layers of a multi-layer canopy
+  static_assert(nlevcan == 1 || nlevcan >= 4, "nlevcan must be 1 (big leaf) or at least 4 (multi-layer canopy)");
 } // namespace ELM::ELMdims
 
 
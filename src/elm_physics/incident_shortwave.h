@@ -1,52 +1,71 @@
 
 #pragma once
 
+#include "kokkos_includes.hh"
+
 namespace ELM::incident_shortwave {
 
 // declination angle calc from ats/landlab
 // doy [int]      day of year
 // returns delination angle [radians]
+ACCELERATE
 double declination_angle(const int& doy);
 
 // declination angle calc from ELM lnd_import szenith()/shr_orb_cosz()
 // doy [int]      integer day of year
 // returns delination angle [radians]
+ACCELERATE
 double declination_angle2(const int& doy);
 
 // cosine of the solar zenith angle
 // latrad [double]    latitude [radians]
 // lonrad [double]    longitude [radians]
 // jday   [double]    Julian day of year
+ACCELERATE
 double coszen(const double& latrad, const double& lonrad, const double& jday);
 
+// cosine of the solar zenith angle with a precomputed declination angle
+// for callers that evaluate many points on the same day
+// latrad [double]    latitude [radians]
+// lonrad [double]    longitude [radians]
+// jday   [double]    Julian day of year
+// declin [double]    solar declination angle for floor(jday) [radians]
+ACCELERATE
+double coszen(const double& latrad, const double& lonrad, const double& jday, const double& declin);
+
 // average coszen functions
 // derived from shr_orb_avg_cosz() in shr_orb_mod.F90
 
 // adjust variable (latitude or declination angle) so that its tangent will be defined
 // var [double]    variable to be bounded
+ACCELERATE
 double ensure_tan_defined(const double& var);
 
 // convert model dt from seconds to radians wrt daylength
 // dt [double]    timestep [seconds]
 // returns model dt [radians]
+ACCELERATE
 double dt_radians(const double& dt);
 
 // define dt start time of day on the period -2*p1 to 2*pi
 // jday   [double]    Julian day of year
 // lonrad [double]    longitude [radians]
 // returns dt start time of day [-2pi to 2pi]
+ACCELERATE
 double dt_start_rad(const double& jday, const double& lonrad);
 
 // define time of day at end of dt
 // t_start [double]    start time of day [-2pi to 2pi]
 // dtrad   [double]    timestep [radians]
 // returns dt end time of day [-2pi to 2pi]
+ACCELERATE
 double dt_end_rad(const double& t_start, const double& dtrad);
 
 // define the cosine of the half-day length [0 to pi]
 // adjust for cases of all daylight or all night
 // latrad [double]    latitude [radians]
 // declin [double]    solar declination angle [radians]
+ACCELERATE
 double coshalfday(const double& latrad, const double& declin);
 
 // define the hour angle
@@ -59,6 +78,7 @@ double coshalfday(const double& latrad, const double& declin);
 // cos_h          [double]    cosine of the half-day length
 // output:
 // hour_angle[4]  [double]    hour angle parameters
+ACCELERATE
 void avg_hourangle(const double& t_start, const double& t_end, const double& dtrad,
                    const double& cos_h, double hour_angle[4]);
 
@@ -71,6 +91,7 @@ void avg_hourangle(const double& t_start, const double& t_end, const double& dtr
 // latrad   [double]    latitude [radians]
 // declin   [double]    solar declination angle [radians]
 // returns time-integrated cosine of the solar zenith angle
+ACCELERATE
 double integrate_cosz(const double& t_start, const double& t_end, const double& dtrad,
                       const double& cos_h, const double& latrad, const double& declin);
 
@@ -92,7 +113,10 @@ jday    [double] Julian date at the beginning of dt
 out:
 cosine of the solar zenith angle averaged over dt
 */
+ACCELERATE
 double average_cosz(const double& latrad, const double& lonrad, const double& declin,
                     const double& dt, const double& jday);
 
 } // namespace ELM::incident_shortwave
+
+#include "incident_shortwave_impl.hh"
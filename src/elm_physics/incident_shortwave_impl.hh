@@ -1,26 +1,37 @@
 
-#include "incident_shortwave.h"
+#pragma once
+
 #include "elm_constants.h"
+#include <algorithm>
 #include <cmath>
 
-namespace ns = ELM::incident_shortwave;
-using ELM::ELMconst::ELM_PI;
-
 namespace ELM::incident_shortwave::detail {
-static constexpr double TWO_PI = ELM_PI * 2.0;
-static constexpr double PI_OVER_TWO = ELM_PI / 2.0;
+static constexpr double TWO_PI = ELMconst::ELM_PI * 2.0;
+static constexpr double PI_OVER_TWO = ELMconst::ELM_PI / 2.0;
 } // namespace detail
 
+namespace ELM::incident_shortwave {
+
+using ELMconst::ELM_PI;
+
 // declination angle calc from ats/landlab
-double ns::declination_angle(const int& doy) { return 23.45 * ELM_PI / 180.0 * cos(detail::TWO_PI / 365.0 * (172.0 - doy)); }
+ACCELERATE
+double declination_angle(const int& doy) { return 23.45 * ELM_PI / 180.0 * cos(detail::TWO_PI / 365.0 * (172.0 - doy)); }
 
 // declination angle calc from ELM lnd_import szenith()/shr_orb_cosz()
-double ns::declination_angle2(const int& doy) { return 23.45 * ELM_PI / 180.0 * sin(detail::TWO_PI * (284.0 + doy) / 365.0); }
+ACCELERATE
+double declination_angle2(const int& doy) { return 23.45 * ELM_PI / 180.0 * sin(detail::TWO_PI * (284.0 + doy) / 365.0); }
 
 // cosine of the solar zenith angle
-double ns::coszen(const double& latrad, const double& lonrad, const double& jday) {
-  const double decrad = declination_angle2(floor(jday));
-  double cosz = sin(latrad) * sin(decrad) - cos(latrad) * cos(decrad) * cos((jday - floor(jday)) * detail::TWO_PI + lonrad);
+ACCELERATE
+double coszen(const double& latrad, const double& lonrad, const double& jday) {
+  return coszen(latrad, lonrad, jday, declination_angle2(floor(jday)));
+}
+
+// cosine of the solar zenith angle with a precomputed declination angle
+ACCELERATE
+double coszen(const double& latrad, const double& lonrad, const double& jday, const double& declin) {
+  double cosz = sin(latrad) * sin(declin) - cos(latrad) * cos(declin) * cos((jday - floor(jday)) * detail::TWO_PI + lonrad);
   return cosz > 0.001 ? cosz : 0.001;
 }
 
@@ -28,15 +39,18 @@ double ns::coszen(const double& latrad, const double& lonrad, const double& jday
 // derived from shr_orb_avg_cosz() in shr_orb_mod.F90
 
 // adjust variable (latitude or declination angle) so that its tangent will be defined
-double ns::ensure_tan_defined(const double& var) {
+ACCELERATE
+double ensure_tan_defined(const double& var) {
   return (var == detail::PI_OVER_TWO) ? var - 1.0e-05 : (var == -detail::PI_OVER_TWO) ? var + 1.0e-05 : var;
 }
 
 // convert model dt from seconds to radians wrt daylength
-double ns::dt_radians(const double& dt) { return dt * detail::TWO_PI / 86400.0; }
+ACCELERATE
+double dt_radians(const double& dt) { return dt * detail::TWO_PI / 86400.0; }
 
 // define dt start time of day on the period -pi to pi
-double ns::dt_start_rad(const double& jday, const double& lonrad)
+ACCELERATE
+double dt_start_rad(const double& jday, const double& lonrad)
 {
   // adjust t to be between -2pi and 2pi
   double t_start = (jday - floor(jday)) * detail::TWO_PI + lonrad - ELM_PI;
@@ -44,14 +58,16 @@ double ns::dt_start_rad(const double& jday, const double& lonrad)
 }
 
 // define time of day at end of dt
-double ns::dt_end_rad(const double& t_start, const double& dtrad)
+ACCELERATE
+double dt_end_rad(const double& t_start, const double& dtrad)
 { 
   return t_start + dtrad;
 }
 
 // define the cosine of the half-day length [0 to pi]
 // adjust for cases of all daylight or all night
-double ns::coshalfday(const double& latrad, const double& declin)
+ACCELERATE
+double coshalfday(const double& latrad, const double& declin)
 {
   double cos_h = -tan(ensure_tan_defined(latrad)) * tan(ensure_tan_defined(declin));
   return (cos_h <= -1.0) ? ELM_PI : (cos_h >= 1.0) ? 0.0 : acos(cos_h);
@@ -60,7 +76,8 @@ double ns::coshalfday(const double& latrad, const double& declin)
 // define the hour angle
 // force it to be between -cos_h and cos_h
 // consider the situation when the night period is too short
-void ns::avg_hourangle(const double& t_start, const double& t_end, const double& dtrad,
+ACCELERATE
+void avg_hourangle(const double& t_start, const double& t_end, const double& dtrad,
                        const double& cos_h, double hour_angle[4])
 {
   if (t_end >= ELM_PI && t_start <= ELM_PI && ELM_PI - cos_h <= dtrad) {
@@ -95,7 +112,8 @@ void ns::avg_hourangle(const double& t_start, const double& t_end, const double&
 
 // perform a time integration to obtain cosz if desired
 // output is valid over the period from t to t + dt
-double ns::integrate_cosz(const double& t_start, const double& t_end, const double& dtrad,
+ACCELERATE
+double integrate_cosz(const double& t_start, const double& t_end, const double& dtrad,
                           const double& cos_h, const double& latrad, const double& declin)
 {
   // define terms needed in the cosine zenith angle equation
@@ -110,7 +128,8 @@ double ns::integrate_cosz(const double& t_start, const double& t_end, const doub
 }
 
 // evaluate average cosine(zenith) for a given dt
-double ns::average_cosz(const double&  latrad, const double&  lonrad, const double&  declin,
+ACCELERATE
+double average_cosz(const double&  latrad, const double&  lonrad, const double&  declin,
                         const double&  dt, const double& jday)
 {
   const double dtrad = dt_radians(dt);
@@ -119,3 +138,5 @@ double ns::average_cosz(const double&  latrad, const double&  lonrad, const doub
   const double cos_h = coshalfday(latrad, declin);
   return integrate_cosz(t_start, t_end, dtrad, cos_h, latrad, declin);
 }
+
+} // namespace ELM::incident_shortwave
@@ -50,6 +50,27 @@ ACCELERATE
 void init_vegrootfr(const int& vtype, const double& roota_par, const double& rootb_par, const ArrayD1 zi,
                     ArrayD1 rootfr);
 
+// root fraction of soil layer i with interfaces zi_top and zi_btm [m], as in init_vegrootfr()
+ACCELERATE
+double vegrootfr_layer(const int& vtype, const double& roota_par, const double& rootb_par, const int& i,
+                       const double& zi_top, const double& zi_btm);
+
+// functor to compute rootfr over (cell, layer) - launch with (ncells, nlevgrnd)
+// vtype, roota_par and rootb_par are per-cell, zi is (ncells, nlevsno + nlevgrnd + 1)
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+struct ComputeRootFraction {
+  ComputeRootFraction(const ArrayI1 vtype, const ArrayD1 roota_par, const ArrayD1 rootb_par, const ArrayD2 zi,
+                      ArrayD2 rootfr);
+
+  ACCELERATE
+  void operator()(const int i, const int k) const;
+
+private:
+  ArrayI1 vtype_;
+  ArrayD1 roota_par_, rootb_par_;
+  ArrayD2 zi_, rootfr_;
+};
+
 } // namespace ELM
 
 #include "init_soil_state_impl.hh"
@@ -68,7 +68,6 @@ void init_soilh2o_state(const LandType& Land, const int& snl, const ArrayD1 wats
   using ELMdims::nlevgrnd;
   using ELMdims::nlevsno;
   using ELMdims::nlevsoi;
-  using ELMdims::nlevbed;
   using ELMdims::nlevurb;
 
   for (int i = 0; i < nlevgrnd; ++i) {
@@ -192,7 +191,6 @@ void init_vegrootfr(const int& vtype, const double& roota_par, const double& roo
   using ELMdims::nlevsoi;
   using ELMdims::nlevgrnd;
   using ELMdims::nlevsno;
-  using ELMdims::nlevbed;
   // (computing from surface, d is depth in meters: Y = 1 -1/2 (exp(-ad)+exp(-bd) under the constraint that
   // Y(d =0.1m) = 1-beta^(10 cm) and Y(d=d_obs)=0.99 with beta & d_obs given in Zeng et al. (1998).
 
@@ -200,25 +198,39 @@ void init_vegrootfr(const int& vtype, const double& roota_par, const double& roo
     rootfr(i) = 0.0;
   }
 
-  if (vtype != PFT::noveg) {
-    double totrootfr = 0.0;
-    for (int i = 0; i <nlevsoi - 1; i++) {
-      rootfr(i) = 0.5 * (exp(-roota_par * zi(i +nlevsno)) + exp(-rootb_par * zi(i +nlevsno)) -
-                         exp(-roota_par * zi(i + 1 +nlevsno)) - exp(-rootb_par * zi(i + 1 +nlevsno)));
-      if (i <nlevbed) {
-        totrootfr += rootfr(i);
-      }
-    }
-    rootfr(nlevsoi - 1) =
-        0.5 * (exp(-roota_par * zi(nlevsoi - 1 +nlevsno)) + exp(-rootb_par * zi(nlevsoi - 1 +nlevsno)));
-  } else {
-    for (int i = 0; i <nlevsoi; i++) {
-      rootfr(i) = 0.0;
-    }
+  for (int i = 0; i < nlevsoi; ++i) {
+    rootfr(i) = vegrootfr_layer(vtype, roota_par, rootb_par, i, zi(i + nlevsno), zi(i + 1 + nlevsno));
   }
-  for (int i = nlevsoi; i <nlevgrnd; i++) {
-    rootfr(i) = 0.0;
+}
+
+ACCELERATE
+double vegrootfr_layer(const int& vtype, const double& roota_par, const double& rootb_par, const int& i,
+                       const double& zi_top, const double& zi_btm)
+{
+  using ELMdims::nlevsoi;
+  if (vtype == PFT::noveg || i >= nlevsoi) {
+    return 0.0;
+  } else if (i < nlevsoi - 1) {
+    return 0.5 * (exp(-roota_par * zi_top) + exp(-rootb_par * zi_top) -
+                  exp(-roota_par * zi_btm) - exp(-rootb_par * zi_btm));
+  } else {
+    return 0.5 * (exp(-roota_par * zi_top) + exp(-rootb_par * zi_top));
   }
 }
 
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+ComputeRootFraction<ArrayI1, ArrayD1, ArrayD2>::
+ComputeRootFraction(const ArrayI1 vtype, const ArrayD1 roota_par, const ArrayD1 rootb_par, const ArrayD2 zi,
+                    ArrayD2 rootfr)
+    : vtype_{vtype}, roota_par_{roota_par}, rootb_par_{rootb_par}, zi_{zi}, rootfr_{rootfr} {}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+ACCELERATE
+void ComputeRootFraction<ArrayI1, ArrayD1, ArrayD2>::operator()(const int i, const int k) const
+{
+  using ELMdims::nlevsno;
+  rootfr_(i, k) = vegrootfr_layer(vtype_(i), roota_par_(i), rootb_par_(i), k, zi_(i, k + nlevsno),
+                                  zi_(i, k + 1 + nlevsno));
+}
+
 } // namespace ELM
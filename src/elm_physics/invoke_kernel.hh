@@ -1,17 +1,95 @@
-
 #pragma once
 
 
+#include <array>
+#include <exception>
 #include <functional>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
 
 #include "kokkos_includes.hh"
+#include "profiler.hh"
 
 // is there a better way than ifdefs to do conditional compilation?
-// wrapping in constexpr if still required Kokkos to be available 
+// wrapping in constexpr if still required Kokkos to be available
+
+// launch interface
+//
+// invoke_kernel(obj, std::make_tuple(N), name)
+//   flat range, obj(i) for i in [0, N)
+// invoke_kernel(obj, std::make_tuple(N0, N1), name)
+// invoke_kernel(obj, std::make_tuple(N0, N1, N2), name)
+//   multi-dimensional range (MDRangePolicy), obj(i, j) or obj(i, j, k)
+//   e.g. cell x layer for kernels with no dependence between layers
+// invoke_team_kernel(obj, std::make_tuple(N), name)
+// invoke_team_kernel(obj, std::make_tuple(N, vector_length), name)
+//   one team per cell, obj(const ELM::TeamMember& member) with member.league_rank() the cell index
+//   inner loops over layers/bands use ELM::team_for and ELM::vector_for
+//   ELM::team_single runs per-cell work once and broadcasts its result to the team
+//   ELM::team_reduce sums over layers/bands across the team
+// invoke_team_kernel(space, obj, args, name)
+//   team launch on an execution space instance
+// invoke_reduce(obj, std::make_tuple(N), result, name)
+//   flat range reduction, obj(i, partial) for i in [0, N) joined into result
+//   obj defines value_type, init(value_type&) and join(value_type& dst, const value_type& src), like a Kokkos
+//   reduction functor - result is available on return
+// invoke_kernel(space, obj, args, name)
+//   any of the range launches above on an execution space instance
+//   kernels on different instances may run concurrently, call space.fence() before using the results
+//   ELM::partition_exec_space<N>() returns N independent instances (CUDA/HIP streams)
+//   note - when the profiler is enabled every region stop calls Kokkos::fence(), which serializes instances
 
 #ifdef ENABLE_KOKKOS
+namespace ELM {
+
+using ExecSpace = Kokkos::DefaultExecutionSpace;
+using TeamMember = Kokkos::TeamPolicy<>::member_type;
+
+namespace impl {
+template <std::size_t... I>
+auto partition_exec_space(std::index_sequence<I...>) {
+  return Kokkos::Experimental::partition_space(ExecSpace(), (static_cast<void>(I), 1)...);
+}
+} // namespace impl
+
+// N instances of the default execution space that can execute concurrently
+template <std::size_t N>
+auto partition_exec_space() {
+  return impl::partition_exec_space(std::make_index_sequence<N>{});
+}
+
+// distribute [0, n) over the threads of a team
+template <class F>
+ACCELERATE void team_for(const TeamMember& member, const int& n, F&& f) {
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, n), std::forward<F>(f));
+}
+
+// distribute [0, n) over the vector lanes of a thread
+template <class F>
+ACCELERATE void vector_for(const TeamMember& member, const int& n, F&& f) {
+  Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, n), std::forward<F>(f));
+}
+
+// call f(value) on one thread of a team, then broadcast value to every thread
+template <class F, class T>
+ACCELERATE void team_single(const TeamMember& member, F&& f, T& value) {
+  Kokkos::single(Kokkos::PerTeam(member), std::forward<F>(f), value);
+}
+
+// result = sum of f(i, partial) for i in [0, n), distributed over the threads of a team
+template <class F, class T>
+ACCELERATE void team_reduce(const TeamMember& member, const int& n, F&& f, T& result) {
+  Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member, n), std::forward<F>(f), result);
+}
+
+} // namespace ELM
+
 namespace impl {
 template <class F, typename T, std::size_t... I>
 constexpr decltype(auto) apply_kokkos_parallel_for(F&& obj, T&& args, const std::string& name, std::index_sequence<I...>)
@@ -22,28 +100,343 @@ constexpr decltype(auto) apply_kokkos_parallel_for(F&& obj, T&& args, const std:
 
   return run_kernel(std::forward<F>(obj), std::forward<T>(args), name);
 }
+
+template <class F, typename T, std::size_t... I>
+void apply_kokkos_mdrange_for(const ELM::ExecSpace& space, F&& obj, T&& args, const std::string& name,
+                              std::index_sequence<I...>)
+{
+  using policy_type = Kokkos::MDRangePolicy<ELM::ExecSpace, Kokkos::Rank<sizeof...(I)>>;
+  using index_type = typename policy_type::index_type;
+  typename policy_type::point_type lower{}, upper{static_cast<index_type>(std::get<I>(args))...};
+  Kokkos::parallel_for(name, policy_type(space, lower, upper), std::forward<F>(obj));
+}
 }  // namespace impl
 
 template <class F, typename T>
-constexpr decltype(auto) invoke_kernel(F&& obj, T&& args, const std::string& name = "") {
-  return impl::apply_kokkos_parallel_for(
-         std::forward<F>(obj), std::forward<T>(args), name,
-         std::make_index_sequence<std::tuple_size_v<std::remove_reference_t<T>>>{});
+decltype(auto) invoke_kernel(F&& obj, T&& args, const std::string& name = "") {
+  constexpr std::size_t rank = std::tuple_size_v<std::remove_reference_t<T>>;
+  static_assert(rank >= 1 && rank <= 3, "invoke_kernel supports ranges of rank 1, 2, or 3");
+
+  ELM::Utils::ScopedRegion region(name);
+  if constexpr (rank == 1) {
+    return impl::apply_kokkos_parallel_for(
+           std::forward<F>(obj), std::forward<T>(args), name,
+           std::make_index_sequence<rank>{});
+  } else {
+    return impl::apply_kokkos_mdrange_for(
+           ELM::ExecSpace(), std::forward<F>(obj), std::forward<T>(args), name,
+           std::make_index_sequence<rank>{});
+  }
 }
-#else
 
 template <class F, typename T>
-constexpr decltype(auto) invoke_kernel(F&& obj, T&& args, const std::string& name = "") {
-  // args will be a scalar int (index/num func calls)
+void invoke_kernel(const ELM::ExecSpace& space, F&& obj, T&& args, const std::string& name = "") {
+  constexpr std::size_t rank = std::tuple_size_v<std::remove_reference_t<T>>;
+  static_assert(rank >= 1 && rank <= 3, "invoke_kernel supports ranges of rank 1, 2, or 3");
 
-  auto run_kernel = [] (F&& obj, int N) {
-    for (int i = 0; i < N; ++i) {
-      std::invoke(std::forward<F>(obj), i);
-    }
-  };
+  ELM::Utils::ScopedRegion region(name);
+  if constexpr (rank == 1) {
+    const int N = std::get<0>(args);
+    Kokkos::parallel_for(name, Kokkos::RangePolicy<ELM::ExecSpace>(space, 0, N), std::forward<F>(obj));
+  } else {
+    impl::apply_kokkos_mdrange_for(
+        space, std::forward<F>(obj), std::forward<T>(args), name,
+        std::make_index_sequence<rank>{});
+  }
+}
+
+template <class F, typename T>
+void invoke_team_kernel(F&& obj, T&& args, const std::string& name = "") {
+  constexpr std::size_t rank = std::tuple_size_v<std::remove_reference_t<T>>;
+  static_assert(rank == 1 || rank == 2, "invoke_team_kernel expects (league_size) or (league_size, vector_length)");
+
+  ELM::Utils::ScopedRegion region(name);
+  const int league_size = std::get<0>(args);
+  if constexpr (rank == 1) {
+    Kokkos::parallel_for(name, Kokkos::TeamPolicy<>(league_size, Kokkos::AUTO), std::forward<F>(obj));
+  } else {
+    const int vector_length = std::get<1>(args);
+    Kokkos::parallel_for(name, Kokkos::TeamPolicy<>(league_size, Kokkos::AUTO, vector_length), std::forward<F>(obj));
+  }
+}
+
+template <class F, typename T>
+void invoke_team_kernel(const ELM::ExecSpace& space, F&& obj, T&& args, const std::string& name = "") {
+  constexpr std::size_t rank = std::tuple_size_v<std::remove_reference_t<T>>;
+  static_assert(rank == 1 || rank == 2, "invoke_team_kernel expects (league_size) or (league_size, vector_length)");
+
+  using policy_type = Kokkos::TeamPolicy<ELM::ExecSpace>;
+  ELM::Utils::ScopedRegion region(name);
+  const int league_size = std::get<0>(args);
+  if constexpr (rank == 1) {
+    Kokkos::parallel_for(name, policy_type(space, league_size, Kokkos::AUTO), std::forward<F>(obj));
+  } else {
+    const int vector_length = std::get<1>(args);
+    Kokkos::parallel_for(name, policy_type(space, league_size, Kokkos::AUTO, vector_length), std::forward<F>(obj));
+  }
+}
+
+template <class F, typename T>
+void invoke_reduce(const ELM::ExecSpace& space, F&& obj, T&& args, typename std::decay_t<F>::value_type& result,
+                   const std::string& name = "") {
+  static_assert(std::tuple_size_v<std::remove_reference_t<T>> == 1, "invoke_reduce supports ranges of rank 1");
+
+  ELM::Utils::ScopedRegion region(name);
+  const int N = std::get<0>(args);
+  Kokkos::parallel_reduce(name, Kokkos::RangePolicy<ELM::ExecSpace>(space, 0, N), std::forward<F>(obj), result);
+}
+
+template <class F, typename T>
+void invoke_reduce(F&& obj, T&& args, typename std::decay_t<F>::value_type& result, const std::string& name = "") {
+  invoke_reduce(ELM::ExecSpace(), std::forward<F>(obj), std::forward<T>(args), result, name);
+}
+
+// turn on region timers for the Kokkos backend
+// kernel launches are asynchronous, so regions fence before they are stopped
+// regions are forwarded to Kokkos Tools (Kokkos::Profiling::pushRegion/popRegion)
+inline void enable_kokkos_profiling() {
+  auto& profiler = ELM::Utils::Profiler::instance();
+  profiler.set_fence([] { Kokkos::fence(); });
+  profiler.set_hooks(
+      [](const std::string& name) { Kokkos::Profiling::pushRegion(name); },
+      [](const std::string&) { Kokkos::Profiling::popRegion(); });
+  profiler.set_enabled(true);
+}
+#else
+
+// host backend
+// kernels run serially, or across OpenMP threads when built with ENABLE_OPENMP
+// set_host_schedule() selects the loop schedule used by every invoke_kernel launch
+//   Static  - iterations are split into fixed chunks assigned round-robin to threads,
+//             the same cells always run on the same thread for a given thread count
+//   Dynamic - threads take the next chunk as they finish, balances kernels
+//             with cell-dependent cost (snow layers, canopy iteration)
+// chunk is the number of iterations per chunk, 0 uses the OpenMP default
+// loops shorter than min_parallel run serially on the calling thread
+// multi-dimensional ranges are flattened, so chunks count (i, j) pairs
+namespace ELM {
+
+struct HostSchedule {
+  enum class Kind { Static, Dynamic };
+  Kind kind{Kind::Static};
+  int chunk{0};
+  int min_parallel{2};
+};
+
+inline HostSchedule& host_schedule() {
+  static HostSchedule schedule;
+  return schedule;
+}
+
+inline void set_host_schedule(const HostSchedule::Kind& kind, const int& chunk = 0, const int& min_parallel = 2) {
+  host_schedule() = HostSchedule{kind, chunk, min_parallel};
+}
 
-  return run_kernel(std::forward<F>(obj), std::get<0>(args));
+// number of threads a kernel launch will use
+inline int host_concurrency() {
+#ifdef ENABLE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// host execution space instance
+// launches are synchronous, so instances never overlap and fence() has nothing to wait for
+class HostExecSpace {
+public:
+  void fence() const {}
+  static constexpr const char* name() { return "Host"; }
+};
+
+using ExecSpace = HostExecSpace;
+
+template <std::size_t N>
+std::array<ExecSpace, N> partition_exec_space() {
+  return std::array<ExecSpace, N>{};
+}
+
+// a team is one thread on the host, team_for, vector_for and team_reduce are serial loops
+class TeamMember {
+public:
+  TeamMember(const int& league_rank, const int& league_size)
+      : league_rank_(league_rank), league_size_(league_size) {}
+
+  int league_rank() const { return league_rank_; }
+  int league_size() const { return league_size_; }
+  int team_rank() const { return 0; }
+  int team_size() const { return 1; }
+  void team_barrier() const {}
+
+private:
+  int league_rank_, league_size_;
+};
+
+template <class F>
+void team_for(const TeamMember&, const int& n, F&& f) {
+  for (int i = 0; i < n; ++i) {
+    f(i);
+  }
 }
 
+template <class F>
+void vector_for(const TeamMember&, const int& n, F&& f) {
+  for (int i = 0; i < n; ++i) {
+    f(i);
+  }
+}
+
+template <class F, class T>
+void team_single(const TeamMember&, F&& f, T& value) {
+  f(value);
+}
+
+template <class F, class T>
+void team_reduce(const TeamMember&, const int& n, F&& f, T& result) {
+  result = T();
+  for (int i = 0; i < n; ++i) {
+    f(i, result);
+  }
+}
+
+} // namespace ELM
+
+namespace impl {
+// call f(i) for i in [0, N) with the host schedule
+template <class F>
+void host_parallel_for(const int N, F&& f) {
+#ifdef ENABLE_OPENMP
+  const auto& schedule = ELM::host_schedule();
+  omp_set_schedule(schedule.kind == ELM::HostSchedule::Kind::Static ? omp_sched_static : omp_sched_dynamic,
+                   schedule.chunk);
+
+  // exceptions can't leave a parallel region - keep the first one and rethrow it after the loop
+  std::exception_ptr error = nullptr;
+  #pragma omp parallel for schedule(runtime) if(N >= schedule.min_parallel)
+  for (int i = 0; i < N; ++i) {
+    try {
+      f(i);
+    } catch (...) {
+      #pragma omp critical(invoke_kernel_error)
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+#else
+  for (int i = 0; i < N; ++i) {
+    f(i);
+  }
 #endif
+}
 
+// result = f.join of f(i, partial) for i in [0, N)
+// each thread reduces a static chunk into its own partial, partials are joined in thread order
+template <class F, class T>
+void host_parallel_reduce(const int N, const F& f, T& result) {
+  f.init(result);
+#ifdef ENABLE_OPENMP
+  if (N >= ELM::host_schedule().min_parallel) {
+    // the team may be smaller than omp_get_max_threads() (OMP_DYNAMIC, thread limits, nesting),
+    // partials of threads that don't join it are joined as initialized
+    std::vector<T> partials(omp_get_max_threads());
+    for (auto& partial : partials) {
+      f.init(partial);
+    }
+    std::exception_ptr error = nullptr;
+    #pragma omp parallel
+    {
+      T& partial = partials[omp_get_thread_num()];
+      #pragma omp for schedule(static)
+      for (int i = 0; i < N; ++i) {
+        try {
+          f(i, partial);
+        } catch (...) {
+          #pragma omp critical(invoke_kernel_error)
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    for (const auto& partial : partials) {
+      f.join(result, partial);
+    }
+    return;
+  }
+#endif
+  for (int i = 0; i < N; ++i) {
+    f(i, result);
+  }
+}
+}  // namespace impl
+
+template <class F, typename T>
+decltype(auto) invoke_kernel(F&& obj, T&& args, const std::string& name = "") {
+  constexpr std::size_t rank = std::tuple_size_v<std::remove_reference_t<T>>;
+  static_assert(rank >= 1 && rank <= 3, "invoke_kernel supports ranges of rank 1, 2, or 3");
+
+  ELM::Utils::ScopedRegion region(name);
+  if constexpr (rank == 1) {
+    // args will be a scalar int (index/num func calls)
+    const int N = std::get<0>(args);
+    impl::host_parallel_for(N, [&obj] (const int i) { std::invoke(obj, i); });
+  } else if constexpr (rank == 2) {
+    const int N1 = std::get<1>(args);
+    const int N = std::get<0>(args) * N1;
+    impl::host_parallel_for(N, [&obj, N1] (const int ij) { std::invoke(obj, ij / N1, ij % N1); });
+  } else {
+    const int N1 = std::get<1>(args);
+    const int N2 = std::get<2>(args);
+    const int N = std::get<0>(args) * N1 * N2;
+    impl::host_parallel_for(N, [&obj, N1, N2] (const int ijk) {
+      std::invoke(obj, ijk / (N1 * N2), (ijk / N2) % N1, ijk % N2);
+    });
+  }
+}
+
+template <class F, typename T>
+void invoke_kernel(const ELM::ExecSpace&, F&& obj, T&& args, const std::string& name = "") {
+  invoke_kernel(std::forward<F>(obj), std::forward<T>(args), name);
+}
+
+template <class F, typename T>
+void invoke_team_kernel(F&& obj, T&& args, const std::string& name = "") {
+  constexpr std::size_t rank = std::tuple_size_v<std::remove_reference_t<T>>;
+  static_assert(rank == 1 || rank == 2, "invoke_team_kernel expects (league_size) or (league_size, vector_length)");
+
+  // vector_length is ignored on the host
+  ELM::Utils::ScopedRegion region(name);
+  const int league_size = std::get<0>(args);
+  impl::host_parallel_for(league_size, [&obj, league_size] (const int i) {
+    std::invoke(obj, ELM::TeamMember(i, league_size));
+  });
+}
+
+template <class F, typename T>
+void invoke_team_kernel(const ELM::ExecSpace&, F&& obj, T&& args, const std::string& name = "") {
+  invoke_team_kernel(std::forward<F>(obj), std::forward<T>(args), name);
+}
+
+template <class F, typename T>
+void invoke_reduce(F&& obj, T&& args, typename std::decay_t<F>::value_type& result, const std::string& name = "") {
+  static_assert(std::tuple_size_v<std::remove_reference_t<T>> == 1, "invoke_reduce supports ranges of rank 1");
+
+  ELM::Utils::ScopedRegion region(name);
+  const int N = std::get<0>(args);
+  impl::host_parallel_reduce(N, obj, result);
+}
+
+template <class F, typename T>
+void invoke_reduce(const ELM::ExecSpace&, F&& obj, T&& args, typename std::decay_t<F>::value_type& result,
+                   const std::string& name = "") {
+  invoke_reduce(std::forward<F>(obj), std::forward<T>(args), result, name);
+}
+
+#endif
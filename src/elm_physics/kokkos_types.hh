@@ -1,6 +1,26 @@
 
 #pragma once
 
+// floating point type of each group of kernels
+// RadReal  - radiation partitioning: ground albedos (albgrd/albgri), albd/albi, fabd/fabi, ftdd/ftid/ftii
+//            and the sunlit/shaded absorption profiles (fsun_z, fabd_sun_z, ...)
+//            soil albedos (albsod/albsoi) are SNICAR inputs and stay double, as do the snow layer
+//            absorption factors (flx_abs*) - layer_absorbed_radiation() checks their sum to 1e-5 W/m2
+// PhenReal - phenology: monthly lai/sai/heights and the interpolated elai/esai/tlai/tsai/htop/hbot
+// EbalReal - energy balance iterations, prognostic state and everything else
+// with ENABLE_MIXED_PRECISION RadReal and PhenReal are float, arithmetic inside the kernels is still
+// done in double and only the stored fields are narrowed
+namespace ELM {
+#ifdef ENABLE_MIXED_PRECISION
+using RadReal = float;
+using PhenReal = float;
+#else
+using RadReal = double;
+using PhenReal = double;
+#endif
+using EbalReal = double;
+} // namespace ELM
+
 #ifndef ENABLE_KOKKOS
 
 namespace ELM { template <typename T, size_t D> class Array; }
@@ -11,6 +31,10 @@ typedef ELM::Array<std::string, 1> ArrayS1;
 typedef ELM::Array<double, 1> ArrayD1;
 typedef ELM::Array<double, 2> ArrayD2;
 typedef ELM::Array<double, 3> ArrayD3;
+typedef ELM::Array<ELM::RadReal, 1> ArrayRad1;
+typedef ELM::Array<ELM::RadReal, 2> ArrayRad2;
+typedef ELM::Array<ELM::PhenReal, 1> ArrayPhen1;
+typedef ELM::Array<ELM::PhenReal, 2> ArrayPhen2;
 
 
 typedef ArrayD1 h_ArrayD1;
@@ -26,6 +50,10 @@ typedef ArrayD3 h_ArrayD3;
 //typedef Kokkos::View<double *> ArrayD1;
 //typedef Kokkos::View<double **> ArrayD2;
 //typedef Kokkos::View<double ***> ArrayD3;
+//typedef Kokkos::View<ELM::RadReal *> ArrayRad1;
+//typedef Kokkos::View<ELM::RadReal **> ArrayRad2;
+//typedef Kokkos::View<ELM::PhenReal *> ArrayPhen1;
+//typedef Kokkos::View<ELM::PhenReal **> ArrayPhen2;
 //
 //
 //typedef ArrayD1::HostMirror h_ArrayD1;
@@ -0,0 +1,164 @@
+
+#pragma once
+
+#include "date_time.hh"
+#include "monthly_data.h"
+#include "mpi_types.hh"
+
+#include <array>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+
+/*
+generic manager for monthly climatologies (phenology, aerosol deposition, ...)
+
+all fields are stored in one array data(nfields, nslots, ncells) on device, with a host mirror
+the three months used at model_time - the two bracketing it and the one after - live in a ring of
+nslots = 3 slots, month m is always held by slot m % 3 (12 is a multiple of 3, so any three
+consecutive months map to three different slots)
+
+update() makes the two bracketing months available on device:
+- a (field, slot) pair is only read when it does not already hold the month it needs, so
+  a new month costs one read per field and nothing is shifted or copied back to host
+- nothing is read before the first update()
+- when prefetch is enabled (set_prefetch(true), off by default) the following month is then read
+  into its (unused) slot on a background thread, overlapping file IO with the next model timesteps -
+  the next update() waits for it, so the month is already on host when model_time reaches it
+- host to device transfers only happen when the device lacks a needed month (about once a month)
+
+slots() gives the ring slots and weights for model_time - custom kernels (eg ComputePhenology)
+index field() with them, interpolate() evaluates all fields in one fused kernel
+
+the reader fills values(ncells) with month (0-11) of variable varname
+when prefetching it is called on a background thread, concurrently with the caller - calls from all
+managers are serialized (NetCDF is not thread-safe), but the reader must not share non-thread-safe state
+with anything else the caller does in between updates
+- with MPI the background reads run alongside the caller's MPI calls, set_prefetch(true) throws unless
+  MPI is initialized with MPI_THREAD_MULTIPLE, see monthly_data::prefetch_supported()
+- profiler regions and counters of the background reads are dropped, Utils::Profiler only records the
+  thread that enabled it
+*/
+
+namespace ELM {
+
+// ring slots and interpolation weights for a model time
+struct MonthlySlots {
+  int s1, s2;
+  double wt1, wt2;
+};
+
+template <typename ArrayD3>
+class MonthlyDataManager {
+
+public:
+  using Reader = std::function<void(const std::string& varname, const int& month, std::vector<double>& values)>;
+
+  static constexpr int nslots{3};
+
+  MonthlyDataManager(const std::vector<std::string>& varnames, const size_t& ncells, const Reader& reader);
+
+  // waits for a pending prefetch
+  ~MonthlyDataManager();
+
+  MonthlyDataManager(const MonthlyDataManager&) = delete;
+  MonthlyDataManager& operator=(const MonthlyDataManager&) = delete;
+
+  // make the months bracketing model_time available on device, then prefetch the following month
+  // returns true if data was copied to device
+  bool update(const Utils::Date& model_time);
+  bool update(const ExecSpace& space, const Utils::Date& model_time);
+
+  // ring slots and weights for model_time
+  MonthlySlots slots(const Utils::Date& model_time) const;
+
+  // device data of all fields (nfields, nslots, ncells)
+  const ArrayD3& data() const { return data_; }
+
+  // device data (nslots, ncells) of variable varname
+  auto field(const std::string& varname) const;
+
+  // interpolate every field to model_time in one kernel - out(nfields, ncells)
+  template <typename ArrayOut2>
+  void interpolate(const Utils::Date& model_time, ArrayOut2 out) const;
+
+  template <typename ArrayOut2>
+  void interpolate(const ExecSpace& space, const Utils::Date& model_time, ArrayOut2 out) const;
+
+  // read the following month on a background thread after update() (default false)
+  // throws if prefetch is requested and monthly_data::prefetch_supported() is false
+  void set_prefetch(const bool prefetch);
+
+  size_t nfields() const { return varnames_.size(); }
+
+private:
+  // read month into its slot for every field that does not hold it on host
+  void read_month(const int& month);
+
+  std::vector<std::string> varnames_;
+  size_t ncells_;
+  ArrayD3 data_;
+#ifdef ENABLE_KOKKOS
+  typename ArrayD3::HostMirror h_data_;
+#else
+  ArrayD3 h_data_;
+#endif
+  // month held by each slot of each field on host and on device, -1 if none
+  std::vector<std::array<int, nslots>> h_month_, d_month_;
+  Reader reader_;
+  bool prefetch_{false};
+  std::future<void> pending_;
+};
+
+namespace monthly_data {
+
+// held by every MonthlyDataManager while it calls its reader
+inline std::mutex& reader_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// true if readers may run on a background thread - without MPI always, with MPI only if it
+// was initialized with MPI_THREAD_MULTIPLE
+inline bool prefetch_supported()
+{
+#ifdef HAVE_MPI
+  int initialized;
+  MPI_Initialized(&initialized);
+  if (!initialized) {
+    return false;
+  }
+  int provided;
+  MPI_Query_thread(&provided);
+  return provided >= MPI_THREAD_MULTIPLE;
+#else
+  return true;
+#endif
+}
+
+// functor to interpolate every field of a monthly data array to model time in one pass
+template <typename ArrayD3, typename ArrayOut2>
+struct InterpolateMonthlyData {
+  InterpolateMonthlyData(const ArrayD3 data, const MonthlySlots& slots, ArrayOut2 out);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayD3 data_;
+  int s1_, s2_;
+  double wt1_, wt2_;
+  ArrayOut2 out_;
+};
+
+} // namespace monthly_data
+
+} // namespace ELM
+
+#include "monthly_data_manager_impl.hh"
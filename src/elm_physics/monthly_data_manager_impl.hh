@@ -0,0 +1,155 @@
+
+#pragma once
+
+#include "profiler.hh"
+
+#include <stdexcept>
+
+template <typename ArrayD3>
+ELM::MonthlyDataManager<ArrayD3>::
+MonthlyDataManager(const std::vector<std::string>& varnames, const size_t& ncells, const Reader& reader)
+    : varnames_{varnames}, ncells_{ncells}, data_("monthly_data", varnames.size(), nslots, ncells),
+#ifdef ENABLE_KOKKOS
+      h_data_{Kokkos::create_mirror_view(data_)},
+#else
+      h_data_{data_},
+#endif
+      h_month_(varnames.size()), d_month_(varnames.size()), reader_{reader}
+{
+  for (size_t f = 0; f != nfields(); ++f) {
+    h_month_[f].fill(-1);
+    d_month_[f].fill(-1);
+  }
+}
+
+template <typename ArrayD3>
+ELM::MonthlyDataManager<ArrayD3>::~MonthlyDataManager()
+{
+  if (pending_.valid()) {
+    pending_.wait();
+  }
+}
+
+template <typename ArrayD3>
+void ELM::MonthlyDataManager<ArrayD3>::set_prefetch(const bool prefetch)
+{
+  if (prefetch && !monthly_data::prefetch_supported()) {
+    throw std::runtime_error("ELM ERROR: MonthlyDataManager prefetch needs MPI initialized with MPI_THREAD_MULTIPLE");
+  }
+  prefetch_ = prefetch;
+}
+
+template <typename ArrayD3>
+bool ELM::MonthlyDataManager<ArrayD3>::update(const Utils::Date& model_time)
+{
+  return update(ExecSpace(), model_time);
+}
+
+template <typename ArrayD3>
+bool ELM::MonthlyDataManager<ArrayD3>::update(const ExecSpace& space, const Utils::Date& model_time)
+{
+  // finish the prefetch - rethrows reader errors
+  if (pending_.valid()) {
+    pending_.get();
+  }
+
+  const auto [m1, m2] = monthly_data::month_indices(model_time);
+  read_month(m1);
+  read_month(m2);
+
+  bool copy = false;
+  for (size_t f = 0; f != nfields(); ++f) {
+    copy = copy || d_month_[f][m1 % nslots] != m1 || d_month_[f][m2 % nslots] != m2;
+  }
+  if (copy) {
+#ifdef ENABLE_KOKKOS
+    Kokkos::deep_copy(space, data_, h_data_);
+    Utils::add_bytes("deep_copy", data_.span() * sizeof(typename ArrayD3::value_type));
+#endif
+    d_month_ = h_month_;
+    // the prefetch writes to the host array
+    space.fence();
+  }
+
+  if (prefetch_) {
+    const int m3 = monthly_data::third_month_idx(model_time);
+    bool need = false;
+    for (size_t f = 0; f != nfields(); ++f) {
+      need = need || h_month_[f][m3 % nslots] != m3;
+    }
+    if (need) {
+      pending_ = std::async(std::launch::async, [this, m3] { read_month(m3); });
+    }
+  }
+  return copy;
+}
+
+template <typename ArrayD3>
+void ELM::MonthlyDataManager<ArrayD3>::read_month(const int& month)
+{
+  const int slot = month % nslots;
+  std::vector<double> values(ncells_);
+  std::lock_guard<std::mutex> lock(monthly_data::reader_mutex());
+  for (size_t f = 0; f != nfields(); ++f) {
+    if (h_month_[f][slot] != month) {
+      reader_(varnames_[f], month, values);
+      for (size_t i = 0; i != ncells_; ++i) {
+        h_data_(f, slot, i) = values[i];
+      }
+      h_month_[f][slot] = month;
+    }
+  }
+}
+
+template <typename ArrayD3>
+ELM::MonthlySlots ELM::MonthlyDataManager<ArrayD3>::slots(const Utils::Date& model_time) const
+{
+  const auto [wt1, wt2] = monthly_data::monthly_data_weights(model_time);
+  const auto [m1, m2] = monthly_data::month_indices(model_time);
+  return MonthlySlots{m1 % nslots, m2 % nslots, wt1, wt2};
+}
+
+template <typename ArrayD3>
+auto ELM::MonthlyDataManager<ArrayD3>::field(const std::string& varname) const
+{
+  for (size_t f = 0; f != nfields(); ++f) {
+    if (varnames_[f] == varname) {
+#ifdef ENABLE_KOKKOS
+      return Kokkos::subview(data_, f, Kokkos::ALL, Kokkos::ALL);
+#else
+      return subview(data_, f);
+#endif
+    }
+  }
+  throw std::runtime_error("ELM ERROR: MonthlyDataManager has no field " + varname);
+}
+
+template <typename ArrayD3>
+template <typename ArrayOut2>
+void ELM::MonthlyDataManager<ArrayD3>::interpolate(const Utils::Date& model_time, ArrayOut2 out) const
+{
+  interpolate(ExecSpace(), model_time, out);
+}
+
+template <typename ArrayD3>
+template <typename ArrayOut2>
+void ELM::MonthlyDataManager<ArrayD3>::
+interpolate(const ExecSpace& space, const Utils::Date& model_time, ArrayOut2 out) const
+{
+  monthly_data::InterpolateMonthlyData interp(data_, slots(model_time), out);
+  invoke_kernel(space, interp, std::make_tuple(ncells_), "InterpolateMonthlyData");
+}
+
+template <typename ArrayD3, typename ArrayOut2>
+ELM::monthly_data::InterpolateMonthlyData<ArrayD3, ArrayOut2>::
+InterpolateMonthlyData(const ArrayD3 data, const MonthlySlots& slots, ArrayOut2 out)
+    : data_{data}, s1_{slots.s1}, s2_{slots.s2}, wt1_{slots.wt1}, wt2_{slots.wt2}, out_{out} {}
+
+template <typename ArrayD3, typename ArrayOut2>
+ACCELERATE
+void ELM::monthly_data::InterpolateMonthlyData<ArrayD3, ArrayOut2>::operator()(const int i) const
+{
+  for (size_t f = 0; f != data_.extent(0); ++f) {
+    out_(f, i) = wt1_ * data_(f, s1_, i) + wt2_ * data_(f, s2_, i);
+  }
+}
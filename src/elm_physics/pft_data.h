@@ -31,10 +31,12 @@ struct PFTDataAlb {
 };
 
 // struct that stores array objects containing time-invariant vegetation data
+// indexed by pft, or by cell when constructed with ncells and filled by GatherPFTData
 template <typename ArrayD1, typename ArrayD2>
 struct PFTData {
 
   PFTData();
+  explicit PFTData(const int ncells);
   ~PFTData() = default;
 
   ArrayD1 fnr;       //  fraction of nitrogen in RuBisCO
@@ -80,15 +82,36 @@ struct PFTData {
 
   static constexpr int numpft_{ELMdims::numpft};
 
-  // get struct of photosynthesis variables for pft
+  // register arrays under the file variables that fill them, see field_registry.hh
+  template <typename Registry>
+  void register_fields(Registry& registry);
+
+  // get struct of photosynthesis variables for pft (or cell)
   ACCELERATE
   PFTDataPSN get_pft_psn(const int pft) const;
 
-  // get struct of albedo variables for pft
+  // get struct of albedo variables for pft (or cell)
   ACCELERATE
   PFTDataAlb get_pft_alb(const int pft) const;
 };
 
+// functor to copy the parameters of pft vtype(i) into cell i of cell_data
+// run once, or whenever vtype changes, so kernels read per-cell parameters without the vtype indirection
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+struct GatherPFTData {
+
+  GatherPFTData(const PFTData<ArrayD1, ArrayD2>& pft_data, const ArrayI1 vtype,
+                const PFTData<ArrayD1, ArrayD2>& cell_data);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  PFTData<ArrayD1, ArrayD2> pft_data_;
+  ArrayI1 vtype_;
+  PFTData<ArrayD1, ArrayD2> cell_data_;
+};
+
 // Read pft time-invariant file data into member variables
 template <typename h_ArrayD1>
 void read_pft_data(std::map<std::string, h_ArrayD1>& pft_views,
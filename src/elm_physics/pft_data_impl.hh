@@ -30,6 +30,32 @@ PFTData()
       tausvis("tausvis", numpft_), tausnir("tausnir", numpft_)
     {}
 
+// per-cell parameters - every array has extent ncells
+template <typename ArrayD1, typename ArrayD2>
+PFTData<ArrayD1, ArrayD2>::
+PFTData(const int ncells)
+    : fnr("fnr", ncells), act25("act25", ncells),
+      kcha("kcha", ncells), koha("koha", ncells),
+      cpha("cpha", ncells), vcmaxha("vcmaxha", ncells),
+      jmaxha("jmaxha", ncells), tpuha("tpuha", ncells),
+      lmrha("lmrha", ncells), vcmaxhd("vcmaxhd", ncells),
+      jmaxhd("jmaxhd", ncells), tpuhd("tpuhd", ncells),
+      lmrhd("lmrhd", ncells), lmrse("lmrse", ncells),
+      qe("qe", ncells), theta_cj("theta_cj", ncells),
+      bbbopt("bbbopt", ncells), mbbopt("mbbopt", ncells),
+      c3psn("c3psn", ncells), slatop("slatop", ncells),
+      leafcn("leafcn", ncells), flnr("flnr", ncells),
+      fnitr("fnitr", ncells), dleaf("dleaf", ncells),
+      smpso("smpso", ncells), smpsc("smpsc", ncells),
+      tc_stress("tc_stress", ncells), z0mr("z0mr", ncells),
+      displar("displar", ncells), xl("xl", ncells),
+      roota_par("roota_par", ncells), rootb_par("rootb_par", ncells),
+      rholvis("rholvis", ncells), rholnir("rholnir", ncells),
+      rhosvis("rhosvis", ncells), rhosnir("rhosnir", ncells),
+      taulvis("taulvis", ncells), taulnir("taulnir", ncells),
+      tausvis("tausvis", ncells), tausnir("tausnir", ncells)
+    {}
+
 template <typename ArrayD1, typename ArrayD2>
 ACCELERATE
 PFTDataPSN PFTData<ArrayD1, ArrayD2>::
@@ -84,6 +110,109 @@ get_pft_alb(const int pft) const
   return alb_pft_data;
 }
 
+template <typename ArrayD1, typename ArrayD2>
+template <typename Registry>
+void PFTData<ArrayD1, ArrayD2>::
+register_fields(Registry& registry)
+{
+  const std::string group("pft");
+  registry.add(group, "fnr", fnr);
+  registry.add(group, "act25", act25);
+  registry.add(group, "kcha", kcha);
+  registry.add(group, "koha", koha);
+  registry.add(group, "cpha", cpha);
+  registry.add(group, "vcmaxha", vcmaxha);
+  registry.add(group, "jmaxha", jmaxha);
+  registry.add(group, "tpuha", tpuha);
+  registry.add(group, "lmrha", lmrha);
+  registry.add(group, "vcmaxhd", vcmaxhd);
+  registry.add(group, "jmaxhd", jmaxhd);
+  registry.add(group, "tpuhd", tpuhd);
+  registry.add(group, "lmrhd", lmrhd);
+  registry.add(group, "lmrse", lmrse);
+  registry.add(group, "qe", qe);
+  registry.add(group, "theta_cj", theta_cj);
+  registry.add(group, "bbbopt", bbbopt);
+  registry.add(group, "mbbopt", mbbopt);
+  registry.add(group, "c3psn", c3psn);
+  registry.add(group, "slatop", slatop);
+  registry.add(group, "leafcn", leafcn);
+  registry.add(group, "flnr", flnr);
+  registry.add(group, "fnitr", fnitr);
+  registry.add(group, "dleaf", dleaf);
+  registry.add(group, "smpso", smpso);
+  registry.add(group, "smpsc", smpsc);
+  registry.add(group, "tc_stress", tc_stress);
+  registry.add(group, "z0mr", z0mr);
+  registry.add(group, "displar", displar);
+  registry.add(group, "xl", xl);
+  registry.add(group, "roota_par", roota_par);
+  registry.add(group, "rootb_par", rootb_par);
+  registry.add(group, "rholvis", rholvis);
+  registry.add(group, "rholnir", rholnir);
+  registry.add(group, "rhosvis", rhosvis);
+  registry.add(group, "rhosnir", rhosnir);
+  registry.add(group, "taulvis", taulvis);
+  registry.add(group, "taulnir", taulnir);
+  registry.add(group, "tausvis", tausvis);
+  registry.add(group, "tausnir", tausnir);
+}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+GatherPFTData<ArrayI1, ArrayD1, ArrayD2>::
+GatherPFTData(const PFTData<ArrayD1, ArrayD2>& pft_data, const ArrayI1 vtype,
+              const PFTData<ArrayD1, ArrayD2>& cell_data)
+    : pft_data_{pft_data}, vtype_{vtype}, cell_data_{cell_data}
+    {}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+ACCELERATE
+void GatherPFTData<ArrayI1, ArrayD1, ArrayD2>::
+operator()(const int i) const
+{
+  const int pft = vtype_(i);
+  cell_data_.fnr(i) = pft_data_.fnr(pft);
+  cell_data_.act25(i) = pft_data_.act25(pft);
+  cell_data_.kcha(i) = pft_data_.kcha(pft);
+  cell_data_.koha(i) = pft_data_.koha(pft);
+  cell_data_.cpha(i) = pft_data_.cpha(pft);
+  cell_data_.vcmaxha(i) = pft_data_.vcmaxha(pft);
+  cell_data_.jmaxha(i) = pft_data_.jmaxha(pft);
+  cell_data_.tpuha(i) = pft_data_.tpuha(pft);
+  cell_data_.lmrha(i) = pft_data_.lmrha(pft);
+  cell_data_.vcmaxhd(i) = pft_data_.vcmaxhd(pft);
+  cell_data_.jmaxhd(i) = pft_data_.jmaxhd(pft);
+  cell_data_.tpuhd(i) = pft_data_.tpuhd(pft);
+  cell_data_.lmrhd(i) = pft_data_.lmrhd(pft);
+  cell_data_.lmrse(i) = pft_data_.lmrse(pft);
+  cell_data_.qe(i) = pft_data_.qe(pft);
+  cell_data_.theta_cj(i) = pft_data_.theta_cj(pft);
+  cell_data_.bbbopt(i) = pft_data_.bbbopt(pft);
+  cell_data_.mbbopt(i) = pft_data_.mbbopt(pft);
+  cell_data_.c3psn(i) = pft_data_.c3psn(pft);
+  cell_data_.slatop(i) = pft_data_.slatop(pft);
+  cell_data_.leafcn(i) = pft_data_.leafcn(pft);
+  cell_data_.flnr(i) = pft_data_.flnr(pft);
+  cell_data_.fnitr(i) = pft_data_.fnitr(pft);
+  cell_data_.dleaf(i) = pft_data_.dleaf(pft);
+  cell_data_.smpso(i) = pft_data_.smpso(pft);
+  cell_data_.smpsc(i) = pft_data_.smpsc(pft);
+  cell_data_.z0mr(i) = pft_data_.z0mr(pft);
+  cell_data_.displar(i) = pft_data_.displar(pft);
+  cell_data_.xl(i) = pft_data_.xl(pft);
+  cell_data_.roota_par(i) = pft_data_.roota_par(pft);
+  cell_data_.rootb_par(i) = pft_data_.rootb_par(pft);
+  cell_data_.rholvis(i) = pft_data_.rholvis(pft);
+  cell_data_.rholnir(i) = pft_data_.rholnir(pft);
+  cell_data_.rhosvis(i) = pft_data_.rhosvis(pft);
+  cell_data_.rhosnir(i) = pft_data_.rhosnir(pft);
+  cell_data_.taulvis(i) = pft_data_.taulvis(pft);
+  cell_data_.taulnir(i) = pft_data_.taulnir(pft);
+  cell_data_.tausvis(i) = pft_data_.tausvis(pft);
+  cell_data_.tausnir(i) = pft_data_.tausnir(pft);
+  // single value in the pft table
+  cell_data_.tc_stress(i) = pft_data_.tc_stress(0);
+}
 
 template <typename h_ArrayD1>
 void read_pft_data(std::map<std::string, h_ArrayD1>& pft_views,
@@ -4,15 +4,17 @@
 #include "array.hh"
 #include "date_time.hh"
 #include "elm_constants.h"
+#include "land_mask.hh"
 #include "utils.hh"
 
 #include "monthly_data.h"
+#include "monthly_data_manager.h"
 #include "phenology_physics.h"
 #include "read_input.hh"
 
 #include <array>
-#include <map>
 #include <string>
+#include <vector>
 
 #include "kokkos_includes.hh"
 #include "invoke_kernel.hh"
@@ -21,56 +23,59 @@
 namespace ELM {
 
 // class to manage phenology data
-template <typename ArrayD2>
+// monthly lai, sai, and heights are held by a MonthlyDataManager, see monthly_data_manager.h
+// ArrayD3 is the storage of the monthly data (4, 3, ncells), eg Kokkos::View<ELM::PhenReal ***>
+template <typename ArrayD3>
 class PhenologyDataManager {
 
 public:
 
-  // these are public to provide access from driver
-  // for eg hostview creation
-  ArrayD2 mlai, msai, mhtop, mhbot;
-
   PhenologyDataManager(const Utils::DomainDecomposition<2>& dd, const size_t& ncells, const size_t& npfts);
 
-  // read data from file
-  // either all three months of data, or new single month
-  template <typename ArrayI1, typename h_ArrayD2>
-  bool read_data(std::map<std::string, h_ArrayD2>& phenology_views, const std::string& filename, const Utils::Date& model_time,
-                 const ArrayI1 vtype);
+  // land-only version - ncells = mask.n_land()
+  PhenologyDataManager(const Utils::DomainDecomposition<2>& dd, const Utils::LandMask& mask, const size_t& npfts);
+
+  // make the months needed at model_time available on device, reading them from file if needed
+  // with prefetch enabled the following month is then read on a background thread, see MonthlyDataManager
+  // vtype must be host accessible, it is copied on the first call
+  // returns true if data was copied to device
+  template <typename h_ArrayI1>
+  bool read_data(const std::string& filename, const Utils::Date& model_time, const h_ArrayI1 vtype);
+
+  // as above, with the transfer on execution space instance space
+  template <typename h_ArrayI1>
+  bool read_data(const ExecSpace& space, const std::string& filename, const Utils::Date& model_time,
+                 const h_ArrayI1 vtype);
 
   // get phenology data - call parallel physics kernel - return phenology data for this timestep
-  template <typename ArrayI1, typename ArrayD1>
+  template <typename ArrayI1, typename ArrayD1, typename ArrayPhen1>
+  // elai, esai, htop, hbot, tlai and tsai may be stored in a narrower type (ELM::PhenReal)
   void get_data(const Utils::Date& model_time, const ArrayD1 snow_depth, const ArrayD1 frac_sno, const ArrayI1 vtype,
-                ArrayD1 elai, ArrayD1 esai, ArrayD1 htop, ArrayD1 hbot, ArrayD1 tlai, ArrayD1 tsai,
-                ArrayI1 frac_veg_nosno_alb);
+                ArrayPhen1 elai, ArrayPhen1 esai, ArrayPhen1 htop, ArrayPhen1 hbot, ArrayPhen1 tlai,
+                ArrayPhen1 tsai, ArrayI1 frac_veg_nosno_alb);
 
-  // will data be read if read_data is called?
-  inline bool need_data() const { return need_new_data_; }
+  // as above, with the phenology kernel launched on execution space instance space
+  template <typename ArrayI1, typename ArrayD1, typename ArrayPhen1>
+  void get_data(const ExecSpace& space, const Utils::Date& model_time, const ArrayD1 snow_depth, const ArrayD1 frac_sno,
+                const ArrayI1 vtype, ArrayPhen1 elai, ArrayPhen1 esai, ArrayPhen1 htop, ArrayPhen1 hbot,
+                ArrayPhen1 tlai, ArrayPhen1 tsai, ArrayI1 frac_veg_nosno_alb);
+
+  // monthly data
+  const MonthlyDataManager<ArrayD3>& monthly() const { return monthly_; }
+  MonthlyDataManager<ArrayD3>& monthly() { return monthly_; }
 
 private:
   // read 1 month of data from file (1, npfts, nlat, nlon) for input param month
-  // and place into 2D array arr(ntimes, ncells) where ntimes = arr_idx
-  // by combining nlat & nlon and filtering by pft type (vtype) - only one pft per grid cell currently
-  template <typename ArrayI1, typename h_ArrayD2>
-  void read_month(const std::string& filename, const std::string& varname,
-                  const size_t& month, const ArrayI1 vtype, const int& arr_idx, h_ArrayD2 arr);
-
-  // read 3 months of data into member arrays
-  template <typename ArrayI1, typename h_ArrayD2>
-  void read_initial(std::map<std::string, h_ArrayD2>& phenology_views, const std::string& filename, const Utils::Date& model_time,
-                    const ArrayI1 vtype);
-
-  // advance index - move member data at month idx  1 & 2 to month 0 & 1 and then read new data into month idx 2
-  template <typename ArrayI1, typename h_ArrayD2>
-  void read_new_month(std::map<std::string, h_ArrayD2>& phenology_views, const std::string& filename,
-                      const Utils::Date& model_time, const ArrayI1 vtype);
+  // and place into values(ncells) by gathering land points of nlat & nlon
+  // and filtering by pft type (vtype_) - only one pft per grid cell currently
+  void read_month(const std::string& varname, const int& month, std::vector<double>& values) const;
 
   const Utils::DomainDecomposition<2> dd_;
+  const Utils::LandMask mask_;
   size_t ncells_, npfts_;
-  bool initialized_;
-  int data_m1_;
-  bool need_new_data_;
-
+  std::string filename_;
+  std::vector<int> vtype_;
+  MonthlyDataManager<ArrayD3> monthly_;
 };
 
 } // namespace ELM
@@ -8,13 +8,16 @@
 namespace ELM::phenology {
 
 // functor to calculate phenology parameters for time = model_time
-template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+// monthly data (ArrayD2) and results (ArrayPhen1) may be stored as float (ELM::PhenReal),
+// the interpolation and snow burial are computed in double
+// monthly data is interpolated between months m1 and m2 with weights wt1 and wt2
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayPhen1>
 struct ComputePhenology {
 
   ComputePhenology(const ArrayD2 mlai, const ArrayD2 msai, const ArrayD2 mhtop, const ArrayD2 mhbot,
                    const ArrayD1 snow_depth, const ArrayD1 frac_sno, const ArrayI1 vtype, const double wt1,
-                   const double wt2, const int start_idx, ArrayD1 elai, ArrayD1 esai, ArrayD1 htop, ArrayD1 hbot,
-                   ArrayD1 tlai, ArrayD1 tsai, ArrayI1 frac_veg_nosno_alb);
+                   const double wt2, const int m1, const int m2, ArrayPhen1 elai, ArrayPhen1 esai, ArrayPhen1 htop,
+                   ArrayPhen1 hbot, ArrayPhen1 tlai, ArrayPhen1 tsai, ArrayI1 frac_veg_nosno_alb);
 
   ACCELERATE
   void operator()(const int i) const;
@@ -24,8 +27,8 @@ private:
   ArrayD1 snow_depth_, frac_sno_;
   ArrayI1 vtype_;
   double wt1_, wt2_;
-  int start_idx_;
-  ArrayD1 elai_, esai_, htop_, hbot_, tlai_, tsai_;
+  int m1_, m2_;
+  ArrayPhen1 elai_, esai_, htop_, hbot_, tlai_, tsai_;
   ArrayI1 frac_veg_nosno_alb_;
 };
 
@@ -5,35 +5,29 @@
 namespace ELM::phenology {
 
 // functor to calculate phenology parameters for time = model_time
-template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
-ComputePhenology<ArrayI1, ArrayD1, ArrayD2>::ComputePhenology(const ArrayD2 mlai, const ArrayD2 msai,
-                                                              const ArrayD2 mhtop, const ArrayD2 mhbot,
-                                                              const ArrayD1 snow_depth, const ArrayD1 frac_sno,
-                                                              const ArrayI1 vtype, const double wt1, const double wt2,
-                                                              const int start_idx, ArrayD1 elai, ArrayD1 esai,
-                                                              ArrayD1 htop, ArrayD1 hbot, ArrayD1 tlai,
-                                                              ArrayD1 tsai, ArrayI1 frac_veg_nosno_alb)
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayPhen1>
+ComputePhenology<ArrayI1, ArrayD1, ArrayD2, ArrayPhen1>::ComputePhenology(
+    const ArrayD2 mlai, const ArrayD2 msai, const ArrayD2 mhtop, const ArrayD2 mhbot, const ArrayD1 snow_depth,
+    const ArrayD1 frac_sno, const ArrayI1 vtype, const double wt1, const double wt2, const int m1, const int m2,
+    ArrayPhen1 elai, ArrayPhen1 esai, ArrayPhen1 htop, ArrayPhen1 hbot, ArrayPhen1 tlai, ArrayPhen1 tsai,
+    ArrayI1 frac_veg_nosno_alb)
     : mlai_(mlai), msai_(msai), mhtop_(mhtop), mhbot_(mhbot), snow_depth_(snow_depth), frac_sno_(frac_sno),
-      vtype_(vtype), wt1_(wt1), wt2_(wt2), start_idx_(start_idx), elai_(elai), esai_(esai), htop_(htop), hbot_(hbot),
+      vtype_(vtype), wt1_(wt1), wt2_(wt2), m1_(m1), m2_(m2), elai_(elai), esai_(esai), htop_(htop), hbot_(hbot),
       tlai_(tlai), tsai_(tsai), frac_veg_nosno_alb_(frac_veg_nosno_alb) {}
 
-template <typename ArrayI1, typename ArrayD1, typename ArrayD2>
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayPhen1>
 ACCELERATE
-void ComputePhenology<ArrayI1, ArrayD1, ArrayD2>::operator()(const int i) const {
+void ComputePhenology<ArrayI1, ArrayD1, ArrayD2, ArrayPhen1>::operator()(const int i) const {
   // leaf phenology
   // Set leaf and stem areas based on day of year
   // Interpolate leaf area index, stem area index, and vegetation heights
   // between two monthly values using weights, (wt1, wt2)
+  double tlai = 0.0, tsai = 0.0, htop = 0.0, hbot = 0.0;
   if (vtype_(i) != PFT::noveg) {
-    tlai_(i) = wt1_ * mlai_(start_idx_, i) + wt2_ * mlai_(start_idx_ + 1, i);
-    tsai_(i) = wt1_ * msai_(start_idx_, i) + wt2_ * msai_(start_idx_ + 1, i);
-    htop_(i) = wt1_ * mhtop_(start_idx_, i) + wt2_ * mhtop_(start_idx_ + 1, i);
-    hbot_(i) = wt1_ * mhbot_(start_idx_, i) + wt2_ * mhbot_(start_idx_ + 1, i);
-  } else {
-    tlai_(i) = 0.0;
-    tsai_(i) = 0.0;
-    htop_(i) = 0.0;
-    hbot_(i) = 0.0;
+    tlai = wt1_ * mlai_(m1_, i) + wt2_ * mlai_(m2_, i);
+    tsai = wt1_ * msai_(m1_, i) + wt2_ * msai_(m2_, i);
+    htop = wt1_ * mhtop_(m1_, i) + wt2_ * mhtop_(m2_, i);
+    hbot = wt1_ * mhbot_(m1_, i) + wt2_ * mhbot_(m2_, i);
   }
 
   // adjust lai and sai for burying by snow. if exposed lai and sai
@@ -41,30 +35,39 @@ void ComputePhenology<ArrayI1, ArrayD1, ArrayD2>::operator()(const int i) const
   // problems associated with very small lai and sai.
   // snow burial fraction for short vegetation (e.g. grasses) as in
   // Wang and Zeng, 2007.
+  const double snow_depth = snow_depth_(i);
+  const double frac_sno = frac_sno_(i);
   double fb;
   if (vtype_(i) > PFT::noveg && vtype_(i) <= PFT::nbrdlf_dcd_brl_shrub) {
-    double ol = std::min(std::max(snow_depth_(i) - hbot_(i), 0.0), htop_(i) - hbot_(i));
-    fb = 1.0 - ol / std::max(1.e-06, htop_(i) - hbot_(i));
+    double ol = std::min(std::max(snow_depth - hbot, 0.0), htop - hbot);
+    fb = 1.0 - ol / std::max(1.e-06, htop - hbot);
   } else {
     // 0.2m is assumed depth of snow required for complete burial of grasses
-    fb = 1.0 - std::max(std::min(snow_depth_(i), 0.2), 0.0) / 0.2;
+    fb = 1.0 - std::max(std::min(snow_depth, 0.2), 0.0) / 0.2;
   }
 
   // area weight by snow covered fraction
-  elai_(i) = std::max(tlai_(i) * (1.0 - frac_sno_(i)) + tlai_(i) * fb * frac_sno_(i), 0.0);
-  esai_(i) = std::max(tsai_(i) * (1.0 - frac_sno_(i)) + tsai_(i) * fb * frac_sno_(i), 0.0);
-  if (elai_(i) < 0.05) {
-    elai_(i) = 0.0;
+  double elai = std::max(tlai * (1.0 - frac_sno) + tlai * fb * frac_sno, 0.0);
+  double esai = std::max(tsai * (1.0 - frac_sno) + tsai * fb * frac_sno, 0.0);
+  if (elai < 0.05) {
+    elai = 0.0;
   }
-  if (esai_(i) < 0.05) {
-    esai_(i) = 0.0;
+  if (esai < 0.05) {
+    esai = 0.0;
   }
   // Fraction of vegetation free of snow
-  if ((elai_(i) + esai_(i)) >= 0.05) {
+  if ((elai + esai) >= 0.05) {
     frac_veg_nosno_alb_(i) = 1;
   } else {
     frac_veg_nosno_alb_(i) = 0;
   }
+
+  tlai_(i) = tlai;
+  tsai_(i) = tsai;
+  htop_(i) = htop;
+  hbot_(i) = hbot;
+  elai_(i) = elai;
+  esai_(i) = esai;
 }
 
 } // namespace ELM::phenology
@@ -12,11 +12,33 @@
 #include <stdexcept>
 
 #include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
 
 namespace ELM::photosynthesis {
 
 constexpr double sco = 0.5 * 0.209 / (42.75 / 1.e06); // relative specificity of rubisco
 
+namespace detail {
+// terms of photosynthesis() that are the same for every canopy layer
+struct PhotosynthesisCanopy {
+  bool c3flag;       // true if C3 and false if C4
+  int nlevcan;       // number of canopy layers - 1 is the sun/shade big leaf
+  double vcmaxcint;  // leaf to canopy scaling coefficient (big leaf only)
+  double kn;         // leaf nitrogen decay coefficient (multi-layer only)
+  double vcmax25top; // canopy top: maximum rate of carboxylation at 25C (umol CO2/m**2/s)
+  double jmax25top;  // canopy top: maximum electron transport rate at 25C (umol electrons/m**2/s)
+  double tpu25top;   // canopy top: triose phosphate utilization rate at 25C (umol CO2/m**2/s)
+  double kp25top;    // canopy top: initial slope of CO2 response curve (C4 plants) at 25C
+  double lmr25top;   // canopy top: leaf maintenance respiration rate at 25C (umol CO2/m**2/s)
+  double cf;         // s m**2/umol -> s/m
+  double gb_mol;     // leaf boundary layer conductance (umol H2O/m**2/s)
+  double bbb;        // Ball-Berry minimum leaf conductance (umol H2O/m**2/s)
+  double kc;         // Michaelis-Menten constant for CO2 (Pa)
+  double ko;         // Michaelis-Menten constant for O2 (Pa)
+  double cp;         // CO2 compensation point (Pa)
+};
+} // namespace detail
+
 ACCELERATE
 double ft(const double& tl, const double& ha);
 
@@ -137,14 +159,47 @@ void hybrid(
     const double& bbb,      //  Ball-Berry minimum leaf conductance (umol H2O/m**2/s)
     const double& mbb);     //  Ball-Berry slope of conductance-photosynthesis relationship
 
-/*! Compute photosynthesis with iterative solution for vegetation in both sun and shade. (internal) */
+/*! Compute photosynthesis with iterative solution for vegetation in both sun and shade. (internal)
+The number of canopy layers is the extent of tlai_z - one layer uses the sun/shade big leaf scaling vcmaxcint,
+more layers the explicit leaf nitrogen profile. Layers are solved independently and their conductances summed. */
 template <class ArrayD1>
 ACCELERATE
 void photosynthesis(const PFTDataPSN& psn_pft, const int& nrad, const double& forc_pbot, const double& t_veg,
                     const double& t10, const double& esat_tv, const double& eair, const double& oair,
                     const double& cair, const double& rb, const double& btran, const double& dayl_factor,
                     const double& thm, const ArrayD1 tlai_z, const double& vcmaxcint, const ArrayD1 par_z,
-                    const ArrayD1 lai_z, ArrayD1 ci_z, double& rs);
+                    const ArrayD1 lai_z, double& rs);
+
+/*! photosynthesis() with the canopy layers distributed over the threads of a team (internal)
+the layer conductances are summed with team_reduce(), rs is set on every thread */
+template <class ArrayD1>
+ACCELERATE
+void photosynthesis(const TeamMember& member, const PFTDataPSN& psn_pft, const int& nrad, const double& forc_pbot,
+                    const double& t_veg, const double& t10, const double& esat_tv, const double& eair,
+                    const double& oair, const double& cair, const double& rb, const double& btran,
+                    const double& dayl_factor, const double& thm, const ArrayD1 tlai_z, const double& vcmaxcint,
+                    const ArrayD1 par_z, const ArrayD1 lai_z, double& rs);
+
+/*! Canopy terms of photosynthesis() - leaf nitrogen profile at the canopy top, boundary layer conductance and
+temperature adjusted kinetic constants. (internal) */
+ACCELERATE
+detail::PhotosynthesisCanopy photosynthesis_canopy(const PFTDataPSN& psn_pft, const double& forc_pbot,
+                                                   const double& t_veg, const double& t10, const double& oair,
+                                                   const double& rb, const double& btran, const double& dayl_factor,
+                                                   const double& thm, const double& vcmaxcint, const int& nlevcan);
+
+/*! Leaf-level photosynthesis of one canopy layer, returns the leaf stomatal resistance rs_z (s/m). (internal)
+laimid is the cumulative lai at the middle of the layer, par_z the par absorbed per unit lai (w/m**2) */
+ACCELERATE
+double photosynthesis_layer(const PFTDataPSN& psn_pft, const detail::PhotosynthesisCanopy& canopy,
+                            const double& laimid, const double& par_z, const double& t_veg, const double& t10,
+                            const double& esat_tv, const double& eair, const double& oair, const double& cair,
+                            const double& forc_pbot, const double& btran);
+
+/*! Effective leaf-level stomatal resistance of the canopy from the sum of layer conductances gscan. (internal) */
+template <class ArrayD1>
+ACCELERATE
+double canopy_resistance(const int& nrad, const double& rb, const ArrayD1 lai_z, const double& gscan);
 
 /*! Compute photosynthesis totals. (internal)
 note: none of these variables do anything - diagnostics maybe??
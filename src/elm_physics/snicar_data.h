@@ -64,6 +64,11 @@ struct SnicarData {
   ArrayD2 ext_cff_mss_bc2;
   ArrayD3 bcenh;
 
+  // register arrays under the file variables that fill them, see field_registry.hh
+  // both bc species are filled from the same *_bc_mam variables
+  template <typename Registry>
+  void register_fields(Registry& registry);
+
   static constexpr int numrad_snw_{ELMdims::numrad_snw};
   static constexpr int idx_Mie_snw_mx_{snow_snicar::detail::idx_Mie_snw_mx};
   static constexpr int idx_bc_nclrds_max_{snow_snicar::detail::idx_bc_nclrds_max};
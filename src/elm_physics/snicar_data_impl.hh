@@ -37,6 +37,45 @@ SnicarData()
       bcenh("bcenh", idx_bcint_icerds_max_ + 1, idx_bc_nclrds_max_ + 1, numrad_snw_)
     {}
 
+template <typename ArrayD1, typename ArrayD2, typename ArrayD3>
+template <typename Registry>
+void ELM::SnicarData<ArrayD1, ArrayD2, ArrayD3>::
+register_fields(Registry& registry)
+{
+  const std::string group("snicar");
+  registry.add(group, "ss_alb_ocphil", ss_alb_oc1);
+  registry.add(group, "asm_prm_ocphil", asm_prm_oc1);
+  registry.add(group, "ext_cff_mss_ocphil", ext_cff_mss_oc1);
+  registry.add(group, "ss_alb_ocphob", ss_alb_oc2);
+  registry.add(group, "asm_prm_ocphob", asm_prm_oc2);
+  registry.add(group, "ext_cff_mss_ocphob", ext_cff_mss_oc2);
+  registry.add(group, "ss_alb_dust01", ss_alb_dst1);
+  registry.add(group, "asm_prm_dust01", asm_prm_dst1);
+  registry.add(group, "ext_cff_mss_dust01", ext_cff_mss_dst1);
+  registry.add(group, "ss_alb_dust02", ss_alb_dst2);
+  registry.add(group, "asm_prm_dust02", asm_prm_dst2);
+  registry.add(group, "ext_cff_mss_dust02", ext_cff_mss_dst2);
+  registry.add(group, "ss_alb_dust03", ss_alb_dst3);
+  registry.add(group, "asm_prm_dust03", asm_prm_dst3);
+  registry.add(group, "ext_cff_mss_dust03", ext_cff_mss_dst3);
+  registry.add(group, "ss_alb_dust04", ss_alb_dst4);
+  registry.add(group, "asm_prm_dust04", asm_prm_dst4);
+  registry.add(group, "ext_cff_mss_dust04", ext_cff_mss_dst4);
+  registry.add(group, "ss_alb_ice_drc", ss_alb_snw_drc);
+  registry.add(group, "asm_prm_ice_drc", asm_prm_snw_drc);
+  registry.add(group, "ext_cff_mss_ice_drc", ext_cff_mss_snw_drc);
+  registry.add(group, "ss_alb_ice_dfs", ss_alb_snw_dfs);
+  registry.add(group, "asm_prm_ice_dfs", asm_prm_snw_dfs);
+  registry.add(group, "ext_cff_mss_ice_dfs", ext_cff_mss_snw_dfs);
+  registry.add(group, "ss_alb_bc_mam", ss_alb_bc1);
+  registry.add(group, "asm_prm_bc_mam", asm_prm_bc1);
+  registry.add(group, "ext_cff_mss_bc_mam", ext_cff_mss_bc1);
+  registry.add(group, "ss_alb_bc_mam", ss_alb_bc2);
+  registry.add(group, "asm_prm_bc_mam", asm_prm_bc2);
+  registry.add(group, "ext_cff_mss_bc_mam", ext_cff_mss_bc2);
+  registry.add(group, "bcint_enh_mam", bcenh);
+}
+
 template <typename h_ArrayD1, typename h_ArrayD2, typename h_ArrayD3>
 void ELM::read_snicar_data(
   std::map<std::string, h_ArrayD1>& snicar_views_d1,
@@ -88,11 +127,9 @@ void ELM::read_snicar_data(
     std::array<size_t, 2> count = {idx_bc_nclrds_max + 1, numrad_snw};
     Array<double, 2> arr_for_read(idx_bc_nclrds_max + 1, numrad_snw);
 
+    // bc1 and bc2 share these variables
     std::vector<std::string> names =
     {
-      "ss_alb_bc_mam",
-      "asm_prm_bc_mam",
-      "ext_cff_mss_bc_mam",
       "ss_alb_bc_mam",
       "asm_prm_bc_mam",
       "ext_cff_mss_bc_mam"
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "array.hh"
+#include "elm_constants.h"
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+
+/*
+snow-state-aware scheduling for kernels that loop over the active snow layers of a cell
+
+snow kernels (snow_snicar, aerosol concentrations, canopy_hydrology::snow_init,
+surface_radiation::layer_absorbed_radiation) loop over snl_top..snl_btm, so the work per cell ranges from
+nothing (no snow) to nlevsno layers - with a static launch over cells the threads/warps that own deep
+snowpacks finish last, and snow-covered and snow-free cells diverge inside a warp
+
+SnowBins groups cells by number of snow layers (snl = 0..nlevsno) with a counting sort
+cells() holds the cell indices of bin 0, then bin 1, ... - cells keep their relative order within a bin
+offset(snl) and count(snl) give the range of bin snl in cells()
+
+update() rebuilds the bins from the current snl, call it once per timestep after snl changes
+the sort runs on host over a copy of snl, the cell list is only copied back to device when it changed
+
+invoke_binned_kernel() launches obj(i) once for every cell, as one launch per non-empty bin
+every launch runs cells with the same amount of work, so a static schedule is balanced and warps
+don't diverge on snl - min_snl = 1 skips snow-free cells for kernels that do nothing without snow
+
+on the host backend set_host_schedule(HostSchedule::Kind::Dynamic, chunk) balances a single
+launch over all cells instead, without the per-bin launches - bench_kernels times both
+*/
+
+namespace ELM {
+
+template <typename ArrayI1>
+class SnowBins {
+
+public:
+  static constexpr int nbins{ELMdims::nlevsno + 1};
+
+  SnowBins(const size_t& ncells);
+
+  // counting sort of cells by snl(i)
+  // returns true if the cell list changed (and was copied to device)
+  bool update(const ArrayI1 snl);
+  bool update(const ExecSpace& space, const ArrayI1 snl);
+
+  // device cell indices, sorted by snl
+  const ArrayI1& cells() const { return cells_; }
+
+  // first entry and number of entries of bin snl in cells()
+  int offset(const int& snl) const { return offsets_[snl]; }
+  int count(const int& snl) const { return offsets_[snl + 1] - offsets_[snl]; }
+
+  size_t ncells() const { return ncells_; }
+
+private:
+  size_t ncells_;
+  ArrayI1 cells_;
+#ifdef ENABLE_KOKKOS
+  typename ArrayI1::HostMirror h_cells_, h_snl_;
+#else
+  ArrayI1 h_cells_;
+#endif
+  std::array<int, nbins + 1> offsets_;
+};
+
+namespace snow_bins {
+
+// functor to run obj on the cells of one bin - i is the position in the bin
+template <typename ArrayI1, typename F>
+struct BinnedCells {
+  BinnedCells(const ArrayI1 cells, const int& offset, const F& obj);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayI1 cells_;
+  int offset_;
+  F obj_;
+};
+
+// host counting sort of snl into cells - cells(offsets[s]..offsets[s+1]) holds the cells with snl == s
+// returns true if cells changed
+template <typename h_ArrayI1, size_t N>
+bool counting_sort(const h_ArrayI1 snl, h_ArrayI1 cells, std::array<int, N>& offsets);
+
+} // namespace snow_bins
+
+// call obj(i) for every cell i with snl(i) >= min_snl, one launch per non-empty bin of bins
+template <typename ArrayI1, typename F>
+void invoke_binned_kernel(const SnowBins<ArrayI1>& bins, F&& obj, const std::string& name = "",
+                          const int& min_snl = 0);
+
+template <typename ArrayI1, typename F>
+void invoke_binned_kernel(const ExecSpace& space, const SnowBins<ArrayI1>& bins, F&& obj,
+                          const std::string& name = "", const int& min_snl = 0);
+
+} // namespace ELM
+
+#include "snow_bins_impl.hh"
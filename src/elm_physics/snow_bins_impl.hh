@@ -0,0 +1,105 @@
+#pragma once
+
+#include "profiler.hh"
+
+#include <stdexcept>
+
+template <typename ArrayI1>
+ELM::SnowBins<ArrayI1>::SnowBins(const size_t& ncells)
+    : ncells_{ncells}, cells_("snow_bin_cells", ncells),
+#ifdef ENABLE_KOKKOS
+      h_cells_{Kokkos::create_mirror_view(cells_)}, h_snl_("snow_bin_snl", ncells),
+#else
+      h_cells_{cells_},
+#endif
+      offsets_{}
+{
+  // nothing is sorted before the first update()
+  NS::deep_copy(h_cells_, -1);
+}
+
+template <typename ArrayI1>
+bool ELM::SnowBins<ArrayI1>::update(const ArrayI1 snl)
+{
+  return update(ExecSpace(), snl);
+}
+
+template <typename ArrayI1>
+bool ELM::SnowBins<ArrayI1>::update(const ExecSpace& space, const ArrayI1 snl)
+{
+  if (static_cast<size_t>(snl.extent(0)) != ncells_) {
+    throw std::runtime_error("ELM ERROR: SnowBins snl must have length ncells");
+  }
+#ifdef ENABLE_KOKKOS
+  Kokkos::deep_copy(space, h_snl_, snl);
+  space.fence();
+  Utils::add_bytes("deep_copy", ncells_ * sizeof(int));
+  const bool changed = snow_bins::counting_sort(h_snl_, h_cells_, offsets_);
+  if (changed) {
+    Kokkos::deep_copy(space, cells_, h_cells_);
+    Utils::add_bytes("deep_copy", ncells_ * sizeof(int));
+    // the next update writes to the host array
+    space.fence();
+  }
+  return changed;
+#else
+  (void)space;
+  return snow_bins::counting_sort(snl, h_cells_, offsets_);
+#endif
+}
+
+template <typename ArrayI1, typename F>
+ELM::snow_bins::BinnedCells<ArrayI1, F>::BinnedCells(const ArrayI1 cells, const int& offset, const F& obj)
+    : cells_{cells}, offset_{offset}, obj_{obj} {}
+
+template <typename ArrayI1, typename F>
+ACCELERATE
+void ELM::snow_bins::BinnedCells<ArrayI1, F>::operator()(const int i) const {
+  obj_(cells_(offset_ + i));
+}
+
+template <typename h_ArrayI1, size_t N>
+bool ELM::snow_bins::counting_sort(const h_ArrayI1 snl, h_ArrayI1 cells, std::array<int, N>& offsets)
+{
+  constexpr int nbins = N - 1;
+  const int ncells = cells.extent(0);
+
+  offsets.fill(0);
+  for (int i = 0; i < ncells; ++i) {
+    if (snl(i) < 0 || snl(i) >= nbins) {
+      throw std::runtime_error("ELM ERROR: SnowBins - cell " + std::to_string(i) + " has " +
+                               std::to_string(snl(i)) + " snow layers");
+    }
+    ++offsets[snl(i) + 1];
+  }
+  for (int s = 0; s < nbins; ++s) {
+    offsets[s + 1] += offsets[s];
+  }
+
+  std::array<int, N> next = offsets;
+  bool changed = false;
+  for (int i = 0; i < ncells; ++i) {
+    const int pos = next[snl(i)]++;
+    changed = changed || cells(pos) != i;
+    cells(pos) = i;
+  }
+  return changed;
+}
+
+template <typename ArrayI1, typename F>
+void ELM::invoke_binned_kernel(const SnowBins<ArrayI1>& bins, F&& obj, const std::string& name, const int& min_snl)
+{
+  invoke_binned_kernel(ExecSpace(), bins, std::forward<F>(obj), name, min_snl);
+}
+
+template <typename ArrayI1, typename F>
+void ELM::invoke_binned_kernel(const ExecSpace& space, const SnowBins<ArrayI1>& bins, F&& obj,
+                               const std::string& name, const int& min_snl)
+{
+  for (int s = min_snl; s < SnowBins<ArrayI1>::nbins; ++s) {
+    if (bins.count(s) > 0) {
+      snow_bins::BinnedCells<ArrayI1, std::decay_t<F>> binned_object(bins.cells(), bins.offset(s), obj);
+      invoke_kernel(space, binned_object, std::make_tuple(bins.count(s)), name);
+    }
+  }
+}
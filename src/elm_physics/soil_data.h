@@ -3,13 +3,16 @@
 
 #include "array.hh"
 #include "elm_constants.h"
+#include "land_mask.hh"
 #include "read_input.hh"
+#include "soil_texture_hydraulic_model.h"
 #include "utils.hh"
 
 #include <array>
 #include <string>
 
 #include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
 
 namespace ELM::read_soil {
 
@@ -24,10 +27,40 @@ template <typename ArrayI1, typename ArrayD2>
 void read_soil_colors(const Utils::DomainDecomposition<2>& dd, const std::string& filename, ArrayI1 isoicol,
                       ArrayD2 albsat, ArrayD2 albdry);
 
+// land-only version - isoicol has extent mask.n_land()
+template <typename ArrayI1, typename ArrayD2>
+void read_soil_colors(const Utils::DomainDecomposition<2>& dd, const Utils::LandMask& mask,
+                      const std::string& filename, ArrayI1 isoicol, ArrayD2 albsat, ArrayD2 albdry);
+
 template <typename ArrayD2>
 void read_soil_texture(const Utils::DomainDecomposition<2>& dd, const std::string& filename, ArrayD2 pct_sand,
                        ArrayD2 pct_clay, ArrayD2 organic);
 
+// land-only version - texture arrays have extent (mask.n_land(), nlevsoi)
+template <typename ArrayD2>
+void read_soil_texture(const Utils::DomainDecomposition<2>& dd, const Utils::LandMask& mask,
+                       const std::string& filename, ArrayD2 pct_sand, ArrayD2 pct_clay, ArrayD2 organic);
+
+// read soil texture and initialize soil hydraulic properties (ncells, nlevgrnd) with ComputeSoilHydraulics
+// texture only lives in temporaries for the duration of the call
+// zsoi (host) holds the node depths of the nlevgrnd soil layers, shared by all cells
+template <typename ArrayD2, typename h_ArrayD1>
+void init_soil_hydraulics(const Utils::DomainDecomposition<2>& dd, const std::string& filename, const h_ArrayD1 zsoi,
+                          ArrayD2 watsat, ArrayD2 bsw, ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt,
+                          ArrayD2 watfc);
+
+// land-only version - output arrays have extent (mask.n_land(), nlevgrnd)
+template <typename ArrayD2, typename h_ArrayD1>
+void init_soil_hydraulics(const Utils::DomainDecomposition<2>& dd, const Utils::LandMask& mask,
+                          const std::string& filename, const h_ArrayD1 zsoi, ArrayD2 watsat, ArrayD2 bsw,
+                          ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt, ArrayD2 watfc);
+
+template <typename ArrayD2, typename h_ArrayD1>
+void init_soil_hydraulics(const ExecSpace& space, const Utils::DomainDecomposition<2>& dd,
+                          const Utils::LandMask& mask, const std::string& filename, const h_ArrayD1 zsoi,
+                          ArrayD2 watsat, ArrayD2 bsw, ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt,
+                          ArrayD2 watfc);
+
 } // namespace ELM::read_soil
 
 #include "soil_data_impl.hh"
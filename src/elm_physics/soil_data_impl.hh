@@ -1,6 +1,10 @@
 
 #pragma once
 
+#include "profiler.hh"
+
+#include <cassert>
+
 namespace ELM::read_soil {
 
 template <typename ArrayD2>
@@ -140,6 +144,14 @@ template <typename ArrayI1, typename ArrayD2>
 void read_soil_colors(const Utils::DomainDecomposition<2>& dd,
                       const std::string& filename, ArrayI1 isoicol,
                       ArrayD2 albsat, ArrayD2 albdry)
+{
+  read_soil_colors(dd, Utils::all_land(dd), filename, isoicol, albsat, albdry);
+}
+
+template <typename ArrayI1, typename ArrayD2>
+void read_soil_colors(const Utils::DomainDecomposition<2>& dd, const Utils::LandMask& mask,
+                      const std::string& filename, ArrayI1 isoicol,
+                      ArrayD2 albsat, ArrayD2 albdry)
 {
   // get soil color
   {
@@ -151,11 +163,10 @@ void read_soil_colors(const Utils::DomainDecomposition<2>& dd,
     Array<int, 2> arr_for_read(dd.n_local[0], dd.n_local[1]);
     IO::read_netcdf(dd.comm, filename, "SOIL_COLOR", start, count, arr_for_read.data());
 
-    // place data into [ncells] order
-    for (int i = 0; i != static_cast<int>(dd.n_local[0]); ++i) {
-      for (int j = 0; j != static_cast<int>(dd.n_local[1]); ++j) {
-        isoicol(i * dd.n_local[1] + j) = arr_for_read(i, j);
-      }
+    // gather land points into [ncells] order
+    for (size_t c = 0; c != mask.n_land(); ++c) {
+      const int g = mask.grid_idx[c];
+      isoicol(c) = arr_for_read(g / dd.n_local[1], g % dd.n_local[1]);
     }
   }
 
@@ -183,46 +194,94 @@ void read_soil_colors(const Utils::DomainDecomposition<2>& dd,
 
 template <typename ArrayD2>
 void read_soil_texture(const Utils::DomainDecomposition<2>& dd, const std::string& filename, ArrayD2 pct_sand,
-                       ArrayD2 pct_clay, ArrayD2 organic) {
-  // get pct_sand and pct_clay
+                       ArrayD2 pct_clay, ArrayD2 organic)
+{
+  read_soil_texture(dd, Utils::all_land(dd), filename, pct_sand, pct_clay, organic);
+}
+
+template <typename ArrayD2>
+void read_soil_texture(const Utils::DomainDecomposition<2>& dd, const Utils::LandMask& mask,
+                       const std::string& filename, ArrayD2 pct_sand, ArrayD2 pct_clay, ArrayD2 organic)
+{
   // get file start idx and size to read
   std::array<size_t, 3> start = {0, dd.start[0], dd.start[1]};
   std::array<size_t, 3> count = {ELM::nlevsoi, dd.n_local[0], dd.n_local[1]};
-
-  // read pct_sand
   Array<double, 3> arr_for_read(ELM::nlevsoi, dd.n_local[0], dd.n_local[1]);
-  IO::read_netcdf(dd.comm, filename, "PCT_SAND", start, count, arr_for_read.data());
 
-  // place data into [ncells, nlevsoi] order
-  for (int i = 0; i != static_cast<int>(dd.n_local[0]); ++i) {
-    for (int j = 0; j != static_cast<int>(dd.n_local[1]); ++j) {
+  // gather land points into [ncells, nlevsoi] order
+  auto gather_land = [&dd, &mask, &arr_for_read] (ArrayD2 arr) {
+    for (size_t c = 0; c != mask.n_land(); ++c) {
+      const int g = mask.grid_idx[c];
       for (int k = 0; k != ELM::nlevsoi; ++k) {
-        pct_sand(i * dd.n_local[1] + j, k) = arr_for_read(k, j, i);
+        arr(c, k) = arr_for_read(k, g / dd.n_local[1], g % dd.n_local[1]);
       }
     }
-  }
+  };
+
+  // read pct_sand
+  IO::read_netcdf(dd.comm, filename, "PCT_SAND", start, count, arr_for_read.data());
+  gather_land(pct_sand);
 
   // read pct_clay
   IO::read_netcdf(dd.comm, filename, "PCT_CLAY", start, count, arr_for_read.data());
-  // place data into [ncells, nlevsoi] order
-  for (int i = 0; i != static_cast<int>(dd.n_local[0]); ++i) {
-    for (int j = 0; j != static_cast<int>(dd.n_local[1]); ++j) {
-      for (int k = 0; k != ELM::nlevsoi; ++k) {
-        pct_clay(i * dd.n_local[1] + j, k) = arr_for_read(k, j, i);
-      }
-    }
-  }
+  gather_land(pct_clay);
 
   // read organic
   IO::read_netcdf(dd.comm, filename, "ORGANIC", start, count, arr_for_read.data());
-  // place data into [ncells, nlevsoi] order
-  for (int i = 0; i != static_cast<int>(dd.n_local[0]); ++i) {
-    for (int j = 0; j != static_cast<int>(dd.n_local[1]); ++j) {
-      for (int k = 0; k != ELM::nlevsoi; ++k) {
-        organic(i * dd.n_local[1] + j, k) = arr_for_read(k, j, i);
-      }
-    }
+  gather_land(organic);
+}
+
+template <typename ArrayD2, typename h_ArrayD1>
+void init_soil_hydraulics(const Utils::DomainDecomposition<2>& dd, const std::string& filename, const h_ArrayD1 zsoi,
+                          ArrayD2 watsat, ArrayD2 bsw, ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt,
+                          ArrayD2 watfc)
+{
+  init_soil_hydraulics(dd, Utils::all_land(dd), filename, zsoi, watsat, bsw, sucsat, watdry, watopt, watfc);
+}
+
+template <typename ArrayD2, typename h_ArrayD1>
+void init_soil_hydraulics(const Utils::DomainDecomposition<2>& dd, const Utils::LandMask& mask,
+                          const std::string& filename, const h_ArrayD1 zsoi, ArrayD2 watsat, ArrayD2 bsw,
+                          ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt, ArrayD2 watfc)
+{
+  init_soil_hydraulics(ExecSpace(), dd, mask, filename, zsoi, watsat, bsw, sucsat, watdry, watopt, watfc);
+}
+
+template <typename ArrayD2, typename h_ArrayD1>
+void init_soil_hydraulics(const ExecSpace& space, const Utils::DomainDecomposition<2>& dd,
+                          const Utils::LandMask& mask, const std::string& filename, const h_ArrayD1 zsoi,
+                          ArrayD2 watsat, ArrayD2 bsw, ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt,
+                          ArrayD2 watfc)
+{
+  const size_t ncells = mask.n_land();
+  assert(static_cast<size_t>(watsat.extent(0)) == ncells && static_cast<int>(watsat.extent(1)) == ELM::nlevgrnd);
+  assert(static_cast<int>(zsoi.extent(0)) == ELM::nlevgrnd);
+
+  ArrayD2 pct_sand("pct_sand", ncells, ELM::nlevsoi);
+  ArrayD2 pct_clay("pct_clay", ncells, ELM::nlevsoi);
+  ArrayD2 organic("organic", ncells, ELM::nlevsoi);
+  {
+#ifdef ENABLE_KOKKOS
+    auto h_pct_sand = Kokkos::create_mirror_view(pct_sand);
+    auto h_pct_clay = Kokkos::create_mirror_view(pct_clay);
+    auto h_organic = Kokkos::create_mirror_view(organic);
+    read_soil_texture(dd, mask, filename, h_pct_sand, h_pct_clay, h_organic);
+    Kokkos::deep_copy(space, pct_sand, h_pct_sand);
+    Kokkos::deep_copy(space, pct_clay, h_pct_clay);
+    Kokkos::deep_copy(space, organic, h_organic);
+    Utils::add_bytes("deep_copy", 3 * ncells * ELM::nlevsoi * sizeof(typename ArrayD2::value_type));
+    // host mirrors go out of scope
+    space.fence();
+#else
+    read_soil_texture(dd, mask, filename, pct_sand, pct_clay, organic);
+#endif
   }
+
+  ComputeSoilHydraulics<ArrayD2> hydraulics(pct_sand, pct_clay, organic, zsoi, watsat, bsw, sucsat, watdry, watopt,
+                                            watfc);
+  invoke_kernel(space, hydraulics, std::make_tuple(ncells, ELM::nlevgrnd), "ComputeSoilHydraulics");
+  // texture is freed on return
+  space.fence();
 }
 
 } // namespace ELM::read_soil
@@ -58,6 +58,25 @@ OUTPUTS:
 ACCELERATE
 double dsuction_dsat(const double& bsw, const double& smp, const double& s);
 
+/*
+DESCRIPTION: soil suction of layer i, suction(i, s) - evaluated with soil_suction()
+calc_root_moist_stress() takes any functor with this interface, see TabulatedSuction in soil_suction_table.h
+INPUTS:
+sucsat[nlevgrnd] [double] minimum soil suction (mm)
+bsw[nlevgrnd]    [double] Clapp and Hornberger "b"
+*/
+template <class ArrayD1>
+struct ClappHornbergerSuction {
+  ACCELERATE
+  ClappHornbergerSuction(const ArrayD1 sucsat, const ArrayD1 bsw);
+
+  ACCELERATE
+  double operator()(const int& i, const double& s) const;
+
+private:
+  ArrayD1 sucsat_, bsw_;
+};
+
 /*
 DESCRIPTION: normalize root fraction for total unfrozen depth
 
@@ -132,6 +151,14 @@ void calc_root_moist_stress(const double *h2osoi_liqvol, const ArrayD1 rootfr, c
                             const double& smpso, const double& smpsc, const ArrayD1 eff_porosity,
                             const int& altmax_indx, const int& altmax_lastyear_indx, ArrayD1 rootr, double& btran);
 
+// as above, with soil suction of layer i given by suction(i, s) in place of sucsat and bsw
+template <class ArrayD1, class Suction>
+ACCELERATE
+void calc_root_moist_stress(const double *h2osoi_liqvol, const ArrayD1 rootfr, const ArrayD1 t_soisno,
+                            const double& tc_stress, const Suction& suction, const ArrayD1 watsat,
+                            const double& smpso, const double& smpsc, const ArrayD1 eff_porosity,
+                            const int& altmax_indx, const int& altmax_lastyear_indx, ArrayD1 rootr, double& btran);
+
 } // namespace ELM::soil_moist_stress
 
 #include "soil_moist_stress_impl.hh"
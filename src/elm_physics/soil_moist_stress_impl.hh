@@ -25,6 +25,18 @@ double soil_suction(const double& smpsat, const double& s, const double& bsw) {
 ACCELERATE
 double dsuction_dsat(const double& bsw, const double& smp, const double& s) { return -bsw * smp / s; }
 
+template <class ArrayD1>
+ACCELERATE
+ClappHornbergerSuction<ArrayD1>::ClappHornbergerSuction(const ArrayD1 sucsat, const ArrayD1 bsw)
+    : sucsat_{sucsat}, bsw_{bsw} {}
+
+template <class ArrayD1>
+ACCELERATE
+double ClappHornbergerSuction<ArrayD1>::operator()(const int& i, const double& s) const
+{
+  return soil_suction(sucsat_(i), s, bsw_(i));
+}
+
 template <class ArrayD1>
 ACCELERATE
 void normalize_unfrozen_rootfr(const ArrayD1 t_soisno, const ArrayD1 rootfr, const int& altmax_indx,
@@ -87,6 +99,17 @@ void calc_root_moist_stress(const double *h2osoi_liqvol, const ArrayD1 rootfr, c
                             const double& tc_stress, const ArrayD1 sucsat, const ArrayD1 watsat, const ArrayD1 bsw,
                             const double& smpso, const double& smpsc, const ArrayD1 eff_porosity,
                             const int& altmax_indx, const int& altmax_lastyear_indx, ArrayD1 rootr, double& btran)
+{
+  calc_root_moist_stress(h2osoi_liqvol, rootfr, t_soisno, tc_stress, ClappHornbergerSuction(sucsat, bsw), watsat,
+                         smpso, smpsc, eff_porosity, altmax_indx, altmax_lastyear_indx, rootr, btran);
+}
+
+template <class ArrayD1, class Suction>
+ACCELERATE
+void calc_root_moist_stress(const double *h2osoi_liqvol, const ArrayD1 rootfr, const ArrayD1 t_soisno,
+                            const double& tc_stress, const Suction& suction, const ArrayD1 watsat,
+                            const double& smpso, const double& smpsc, const ArrayD1 eff_porosity,
+                            const int& altmax_indx, const int& altmax_lastyear_indx, ArrayD1 rootr, double& btran)
 {
   using ELMdims::nlevgrnd;
   using ELMdims::nlevsno;
@@ -104,7 +127,7 @@ void calc_root_moist_stress(const double *h2osoi_liqvol, const ArrayD1 rootfr, c
       rootr(i) = 0.0;
     } else {
       const double s_node = std::max(h2osoi_liqvol[nlevsno + i] / eff_porosity(i), 0.01);
-      double smp_node = soil_suction(sucsat(i), s_node, bsw(i));
+      double smp_node = suction(i, s_node);
       smp_node = std::max(smpsc, smp_node);
       rresis[i] = std::min((eff_porosity(i) / watsat(i)) * (smp_node - smpsc) / (smpso - smpsc), 1.0);
 
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "array.hh"
+#include "elm_constants.h"
+#include "soil_moist_stress.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+
+/*
+per-column tables of Clapp and Hornberger soil suction vs relative saturation, smp = -sucsat * s^-bsw
+
+calc_root_moist_stress() evaluates soil_suction() (one pow) per soil layer in every canopy_fluxes::initialize_flux
+sucsat and bsw are time-invariant, so SuctionTable::build() tabulates suction once per (cell, layer) at init and
+TabulatedSuction replaces the pow with a piecewise cubic Hermite interpolation of the table
+
+the table of a layer covers s_min <= s <= 1 on npts equally spaced nodes, with s_min the larger of 0.01 (the lower
+bound calc_root_moist_stress() puts on s) and the saturation at which smp reaches smpsc - below that smp is clamped
+to smpsc by calc_root_moist_stress(), so suction is never needed there
+interpolation error is bounded by h^4/384 * max|d4smp/ds4| on the interval, at s_min
+build() compares the bound, in units of the root resistance factor (smp - smpsc) / (smpso - smpsc), with max_err
+layers that don't meet it (and layers that are always clamped) fall back to soil_suction()
+
+tables are stored as (ncells, nlevgrnd, 2 + 2 * npts)
+(c, i, 0) = s_min
+(c, i, 1) = 1 / h, or 0 if layer i of cell c falls back to soil_suction()
+(c, i, 2 + 2 * j) = smp at node j
+(c, i, 3 + 2 * j) = h * dsmp/ds at node j
+
+the tables are opt-in - nothing uses them unless TabulatedSuction is passed to calc_root_moist_stress() or
+initialize_flux(). They take 8 * nlevgrnd * (2 + 2 * npts) bytes per cell, about 15.6 KB with 64 nodes, and the
+lookup only beats pow() while they stay in cache - bench_kernels initialize_flux, serial, ns/cell:
+  cells   pow()   table
+     64     486     366
+   1024     598     613
+   8192     751    1520
+*/
+
+namespace ELM::soil_moist_stress {
+
+template <typename ArrayD3>
+class SuctionTable {
+
+public:
+  SuctionTable(const size_t& ncells, const int& npts = 64, const double& max_err = 1.0e-4);
+
+  // tabulate suction from sucsat, bsw (ncells, nlevgrnd) and the pft stomatal limits smpso, smpsc (ncells)
+  template <typename ArrayD1, typename ArrayD2>
+  void build(const ArrayD2 sucsat, const ArrayD2 bsw, const ArrayD1 smpso, const ArrayD1 smpsc);
+  template <typename ArrayD1, typename ArrayD2>
+  void build(const ExecSpace& space, const ArrayD2 sucsat, const ArrayD2 bsw, const ArrayD1 smpso,
+             const ArrayD1 smpsc);
+
+  const ArrayD3& tables() const { return tables_; }
+  int npts() const { return npts_; }
+  double max_err() const { return max_err_; }
+
+private:
+  int npts_;
+  double max_err_;
+  ArrayD3 tables_;
+};
+
+// functor to fill SuctionTable - launch with (ncells, nlevgrnd)
+template <typename ArrayD1, typename ArrayD2, typename ArrayD3>
+struct BuildSuctionTable {
+  BuildSuctionTable(const ArrayD2 sucsat, const ArrayD2 bsw, const ArrayD1 smpso, const ArrayD1 smpsc,
+                    const double& max_err, ArrayD3 tables);
+
+  ACCELERATE
+  void operator()(const int i, const int k) const;
+
+private:
+  ArrayD2 sucsat_, bsw_;
+  ArrayD1 smpso_, smpsc_;
+  double max_err_;
+  ArrayD3 tables_;
+};
+
+/*
+DESCRIPTION: soil suction of layer i from the tables of one cell, suction(i, s) - see ClappHornbergerSuction
+INPUTS:
+table[nlevgrnd][2+2*npts] [double] SuctionTable::tables() of the cell
+sucsat[nlevgrnd]          [double] minimum soil suction (mm) - used by layers that fall back to soil_suction()
+bsw[nlevgrnd]             [double] Clapp and Hornberger "b"
+*/
+template <typename ArrayD1, typename ArrayD2>
+struct TabulatedSuction {
+  ACCELERATE
+  TabulatedSuction(const ArrayD2 table, const ArrayD1 sucsat, const ArrayD1 bsw);
+
+  ACCELERATE
+  double operator()(const int& i, const double& s) const;
+
+private:
+  ArrayD2 table_;
+  ArrayD1 sucsat_, bsw_;
+};
+
+} // namespace ELM::soil_moist_stress
+
+#include "soil_suction_table_impl.hh"
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdexcept>
+
+template <typename ArrayD3>
+ELM::soil_moist_stress::SuctionTable<ArrayD3>::
+SuctionTable(const size_t& ncells, const int& npts, const double& max_err)
+    : npts_{npts}, max_err_{max_err}, tables_("suction_tables", ncells, ELMdims::nlevgrnd, 2 + 2 * npts)
+{
+  if (npts < 2) {
+    throw std::runtime_error("ELM ERROR: SuctionTable needs at least 2 nodes per layer");
+  }
+}
+
+template <typename ArrayD3>
+template <typename ArrayD1, typename ArrayD2>
+void ELM::soil_moist_stress::SuctionTable<ArrayD3>::
+build(const ArrayD2 sucsat, const ArrayD2 bsw, const ArrayD1 smpso, const ArrayD1 smpsc)
+{
+  build(ExecSpace(), sucsat, bsw, smpso, smpsc);
+}
+
+template <typename ArrayD3>
+template <typename ArrayD1, typename ArrayD2>
+void ELM::soil_moist_stress::SuctionTable<ArrayD3>::
+build(const ExecSpace& space, const ArrayD2 sucsat, const ArrayD2 bsw, const ArrayD1 smpso, const ArrayD1 smpsc)
+{
+  if (sucsat.extent(0) != tables_.extent(0) || bsw.extent(0) != tables_.extent(0) ||
+      smpso.extent(0) != tables_.extent(0) || smpsc.extent(0) != tables_.extent(0)) {
+    throw std::runtime_error("ELM ERROR: SuctionTable inputs must have length ncells");
+  }
+  BuildSuctionTable<ArrayD1, ArrayD2, ArrayD3> build_tables(sucsat, bsw, smpso, smpsc, max_err_, tables_);
+  invoke_kernel(space, build_tables, std::make_tuple(tables_.extent(0), ELMdims::nlevgrnd), "BuildSuctionTable");
+}
+
+template <typename ArrayD1, typename ArrayD2, typename ArrayD3>
+ELM::soil_moist_stress::BuildSuctionTable<ArrayD1, ArrayD2, ArrayD3>::
+BuildSuctionTable(const ArrayD2 sucsat, const ArrayD2 bsw, const ArrayD1 smpso, const ArrayD1 smpsc,
+                  const double& max_err, ArrayD3 tables)
+    : sucsat_{sucsat}, bsw_{bsw}, smpso_{smpso}, smpsc_{smpsc}, max_err_{max_err}, tables_{tables} {}
+
+template <typename ArrayD1, typename ArrayD2, typename ArrayD3>
+ACCELERATE
+void ELM::soil_moist_stress::BuildSuctionTable<ArrayD1, ArrayD2, ArrayD3>::operator()(const int i, const int k) const
+{
+  const int npts = (tables_.extent(2) - 2) / 2;
+  const double sucsat = sucsat_(i, k);
+  const double b = bsw_(i, k);
+
+  // saturation at which smp == smpsc
+  const double s_c = pow(-smpsc_(i) / sucsat, -1.0 / b);
+  const double s_min = std::max(0.01, s_c);
+  const double h = (1.0 - s_min) / (npts - 1);
+
+  // error bound of the cubic Hermite interpolant, relative to the range of the root resistance factor
+  const double d4smp = sucsat * b * (b + 1.0) * (b + 2.0) * (b + 3.0) * pow(s_min, -b - 4.0);
+  const double err = h * h * h * h / 384.0 * d4smp / (smpso_(i) - smpsc_(i));
+
+  tables_(i, k, 0) = s_min;
+  tables_(i, k, 1) = (s_min < 1.0 && err <= max_err_) ? 1.0 / h : 0.0;
+  for (int j = 0; j < npts; ++j) {
+    const double s = (j == npts - 1) ? 1.0 : s_min + j * h;
+    const double smp = soil_suction(sucsat, s, b);
+    tables_(i, k, 2 + 2 * j) = smp;
+    tables_(i, k, 3 + 2 * j) = h * dsuction_dsat(b, smp, s);
+  }
+}
+
+template <typename ArrayD1, typename ArrayD2>
+ACCELERATE
+ELM::soil_moist_stress::TabulatedSuction<ArrayD1, ArrayD2>::
+TabulatedSuction(const ArrayD2 table, const ArrayD1 sucsat, const ArrayD1 bsw)
+    : table_{table}, sucsat_{sucsat}, bsw_{bsw} {}
+
+template <typename ArrayD1, typename ArrayD2>
+ACCELERATE
+double ELM::soil_moist_stress::TabulatedSuction<ArrayD1, ArrayD2>::operator()(const int& i, const double& s) const
+{
+  const double rdh = table_(i, 1);
+  if (rdh == 0.0) {
+    return soil_suction(sucsat_(i), s, bsw_(i));
+  }
+
+  // below s_min suction is clamped to smpsc by the caller
+  const double u = (s - table_(i, 0)) * rdh;
+  if (u <= 0.0) {
+    return table_(i, 2);
+  }
+  const int npts = (table_.extent(1) - 2) / 2;
+  const int j = std::min(static_cast<int>(u), npts - 2);
+  const double t = std::min(u - j, 1.0);
+  const double t1 = 1.0 - t;
+
+  // cubic Hermite basis on [node j, node j+1]
+  const double h00 = (1.0 + 2.0 * t) * t1 * t1;
+  const double h10 = t * t1 * t1;
+  const double h01 = t * t * (3.0 - 2.0 * t);
+  const double h11 = -t * t * t1;
+  return h00 * table_(i, 2 + 2 * j) + h10 * table_(i, 3 + 2 * j) + h01 * table_(i, 4 + 2 * j) +
+         h11 * table_(i, 5 + 2 * j);
+}
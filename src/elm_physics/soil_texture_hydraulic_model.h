@@ -14,15 +14,54 @@ ACCELERATE
 void pedotransfer(const double& pct_sand, const double& pct_clay, double& watsat, double& bsw, double& sucsat,
                   double& xksat);
 
+// hydraulic properties of organic soil (peat) at node depth zsoi
+// they only depend on layer depth, so they are the same for every cell that shares a soil grid
+struct OrganicSoil {
+  double watsat, bsw, sucsat, hksat;
+};
+
+ACCELERATE
+OrganicSoil organic_soil(const double& zsoi);
+
+// fraction of soil that is organic matter, organic [kg/m3]
+ACCELERATE
+double organic_fraction(const double& organic);
+
 ACCELERATE
 void soil_hydraulic_params(const double& pct_sand, const double& pct_clay, const double& zsoi, const double& om_frac,
                            double& watsat, double& bsw, double& sucsat, double& watdry, double& watopt, double& watfc);
 
+// as above, with the organic soil properties of the layer precomputed
+ACCELERATE
+void soil_hydraulic_params(const double& pct_sand, const double& pct_clay, const OrganicSoil& om,
+                           const double& om_frac, double& watsat, double& bsw, double& sucsat, double& watdry,
+                           double& watopt, double& watfc);
+
 template <typename ArrayD1>
 ACCELERATE
 void init_soil_hydraulics(const ArrayD1 pct_sand, const ArrayD1 pct_clay, const ArrayD1 organic, const ArrayD1 zsoi,
                           ArrayD1 watsat, ArrayD1 bsw, ArrayD1 sucsat, ArrayD1 watdry, ArrayD1 watopt, ArrayD1 watfc);
 
+// functor to initialize soil hydraulic properties over (cell, layer) - launch with (ncells, nlevgrnd)
+// texture (pct_sand, pct_clay, organic) is given for the nlevsoi hydrologically active layers
+// layers below take the texture of the deepest soil layer and no organic matter, as in init_soil_hydraulics()
+// zsoi holds the node depths of the nlevgrnd soil layers, shared by all cells - the organic soil
+// properties are evaluated once per layer on construction
+template <typename ArrayD2>
+struct ComputeSoilHydraulics {
+  template <typename h_ArrayD1>
+  ComputeSoilHydraulics(const ArrayD2 pct_sand, const ArrayD2 pct_clay, const ArrayD2 organic, const h_ArrayD1 zsoi,
+                        ArrayD2 watsat, ArrayD2 bsw, ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt, ArrayD2 watfc);
+
+  ACCELERATE
+  void operator()(const int i, const int k) const;
+
+private:
+  ArrayD2 pct_sand_, pct_clay_, organic_;
+  OrganicSoil om_[ELM::nlevgrnd];
+  ArrayD2 watsat_, bsw_, sucsat_, watdry_, watopt_, watfc_;
+};
+
 } // namespace ELM
 
 #include "soil_texture_hydraulic_model_impl.hh"
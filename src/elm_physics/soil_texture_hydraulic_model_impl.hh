@@ -15,22 +15,49 @@ void pedotransfer(const double& pct_sand, const double& pct_clay, double& watsat
   xksat = 0.0070556 * pow(10.0, (-0.884 + 0.0153 * pct_sand)); // mm/s, from table 5
 }
 
+ACCELERATE
+OrganicSoil organic_soil(const double& zsoi)
+{
+  static constexpr double zsapric = 0.5;  // depth (m) that organic matter takes on characteristics of sapric peat
+
+  OrganicSoil om;
+  om.watsat = std::max(0.93 - 0.1 * (zsoi / zsapric), 0.83);
+  om.bsw = std::min(2.7 + 9.3 * (zsoi / zsapric), 12.0);
+  om.sucsat = std::min(10.3 - 0.2 * (zsoi / zsapric), 10.1);
+  om.hksat = std::max(0.28 - 0.2799 * (zsoi / zsapric), 0.0001);
+  return om;
+}
+
+ACCELERATE
+double organic_fraction(const double& organic)
+{
+  return pow((organic / ELM::organic_max), 2.0);
+}
+
 ACCELERATE
 void soil_hydraulic_params(const double& pct_sand, const double& pct_clay,
                            const double& zsoi, const double& om_frac,
                            double& watsat, double& bsw, double& sucsat,
                            double& watdry, double& watopt, double& watfc)
 {
-  static constexpr double zsapric = 0.5;  // depth (m) that organic matter takes on characteristics of sapric peat
+  soil_hydraulic_params(pct_sand, pct_clay, organic_soil(zsoi), om_frac, watsat, bsw, sucsat, watdry, watopt, watfc);
+}
+
+ACCELERATE
+void soil_hydraulic_params(const double& pct_sand, const double& pct_clay,
+                           const OrganicSoil& om, const double& om_frac,
+                           double& watsat, double& bsw, double& sucsat,
+                           double& watdry, double& watopt, double& watfc)
+{
   static constexpr double pcalpha = 0.5;  // percolation threshold
   static constexpr double pcbeta = 0.139; // percolation exponent
 
   double xksat;
   pedotransfer(pct_sand, pct_clay, watsat, bsw, sucsat, xksat);
-  const double om_watsat = std::max(0.93 - 0.1 * (zsoi / zsapric), 0.83);
-  const double om_b = std::min(2.7 + 9.3 * (zsoi / zsapric), 12.0);
-  const double om_sucsat = std::min(10.3 - 0.2 * (zsoi / zsapric), 10.1);
-  const double om_hksat = std::max(0.28 - 0.2799 * (zsoi / zsapric), 0.0001);
+  const double om_watsat = om.watsat;
+  const double om_b = om.bsw;
+  const double om_sucsat = om.sucsat;
+  const double om_hksat = om.hksat;
 
   // const double bulk_den = (1.0 - watsat) * 2.7e3;
   // const double tkm = (1.0 - om_frac) * (8.8 * sand + 2.92 * clay) / (sand + clay) + om_tkm * om_frac; // W/(m K)
@@ -98,7 +125,7 @@ void init_soil_hydraulics(const ArrayD1 pct_sand, const ArrayD1 pct_clay,
 {
   double om_frac;
   for (int i = 0; i < ELM::nlevsoi; ++i) {
-    om_frac = pow((organic(i) / ELM::organic_max), 2.0);
+    om_frac = organic_fraction(organic(i));
     soil_hydraulic_params(pct_sand(i), pct_clay(i), zsoi(i + ELM::nlevsno), om_frac, watsat(i), bsw(i), sucsat(i),
                           watdry(i), watopt(i), watfc(i));
   }
@@ -110,4 +137,27 @@ void init_soil_hydraulics(const ArrayD1 pct_sand, const ArrayD1 pct_clay,
   }
 }
 
+template <typename ArrayD2>
+template <typename h_ArrayD1>
+ComputeSoilHydraulics<ArrayD2>::
+ComputeSoilHydraulics(const ArrayD2 pct_sand, const ArrayD2 pct_clay, const ArrayD2 organic, const h_ArrayD1 zsoi,
+                      ArrayD2 watsat, ArrayD2 bsw, ArrayD2 sucsat, ArrayD2 watdry, ArrayD2 watopt, ArrayD2 watfc)
+    : pct_sand_{pct_sand}, pct_clay_{pct_clay}, organic_{organic}, watsat_{watsat}, bsw_{bsw}, sucsat_{sucsat},
+      watdry_{watdry}, watopt_{watopt}, watfc_{watfc}
+{
+  for (int k = 0; k < ELM::nlevgrnd; ++k) {
+    om_[k] = organic_soil(zsoi(k));
+  }
+}
+
+template <typename ArrayD2>
+ACCELERATE
+void ComputeSoilHydraulics<ArrayD2>::operator()(const int i, const int k) const
+{
+  const int ks = k < ELM::nlevsoi ? k : ELM::nlevsoi - 1;
+  const double om_frac = k < ELM::nlevsoi ? organic_fraction(organic_(i, k)) : 0.0;
+  soil_hydraulic_params(pct_sand_(i, ks), pct_clay_(i, ks), om_[k], om_frac, watsat_(i, k), bsw_(i, k),
+                        sucsat_(i, k), watdry_(i, k), watopt_(i, k), watfc_(i, k));
+}
+
 } // namespace ELM
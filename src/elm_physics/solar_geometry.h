@@ -0,0 +1,112 @@
+#pragma once
+
+#include "date_time.hh"
+#include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+
+#include "day_length.h"
+#include "incident_shortwave.h"
+
+/*
+per-cell solar geometry
+
+replaces the host-side single-point coszen/daylength block in the drivers
+lat_r and lon_r are per-cell views [radians]
+
+quantities that only depend on the day of year (solar declination, daylength) are cached
+by SolarGeometry and recomputed when the model day changes
+max_dayl only depends on latitude and is computed once on construction
+coszen and cosz_factor are computed every timestep
+*/
+
+namespace ELM::solar_geometry {
+
+// functor to calculate daylength for each cell
+// declin [double] solar declination angle [radians]
+// lat_r  [radians] latitude
+// dayl   [seconds] daylength
+template <typename ArrayD1>
+struct ComputeDaylength {
+  ComputeDaylength(const double& declin, const ArrayD1 lat_r, ArrayD1 dayl);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  double declin_;
+  ArrayD1 lat_r_, dayl_;
+};
+
+// functor to calculate maximum daylength for each cell
+// lat_r    [radians] latitude
+// max_dayl [seconds] maximum daylength
+template <typename ArrayD1>
+struct ComputeMaxDaylength {
+  ComputeMaxDaylength(const ArrayD1 lat_r, ArrayD1 max_dayl);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  ArrayD1 lat_r_, max_dayl_;
+};
+
+// functor to calculate cosine of the solar zenith angle at the middle of the model timestep
+// and the factor used to distribute forcing-interval average shortwave radiation onto the model timestep
+// declin        [double] solar declination angle [radians]
+// cosz_decday   [double] decimal day of year at the middle of the model timestep (1-based)
+// forc_decday   [double] decimal day of year at the start of the current forcing interval (1-based)
+// forc_dt_secs  [double] forcing interval [seconds]
+// lat_r         [radians] latitude
+// lon_r         [radians] longitude
+// coszen        [-] cosine of the solar zenith angle
+// cosz_factor   [-] coszen / forcing-interval average coszen, 0 at night, capped at 10
+template <typename ArrayD1>
+struct ComputeCoszen {
+  ComputeCoszen(const double& declin, const double& cosz_decday, const double& forc_decday,
+                const double& forc_dt_secs, const ArrayD1 lat_r, const ArrayD1 lon_r,
+                ArrayD1 coszen, ArrayD1 cosz_factor);
+
+  ACCELERATE
+  void operator()(const int i) const;
+
+private:
+  double declin_, cosz_decday_, forc_decday_, forc_dt_secs_;
+  ArrayD1 lat_r_, lon_r_, coszen_, cosz_factor_;
+};
+
+} // namespace ELM::solar_geometry
+
+namespace ELM {
+
+// owns the per-cell daylength views and the per-day cache
+template <typename ArrayD1>
+class SolarGeometry {
+public:
+  // computes max_dayl
+  SolarGeometry(const ArrayD1 lat_r, const ArrayD1 lon_r);
+  ~SolarGeometry() = default;
+
+  // model_time    start of the model timestep
+  // dtime_secs    model timestep [seconds]
+  // forc_dt_start start of the forcing interval that contains the middle of the model timestep
+  // forc_dt_secs  forcing interval [seconds]
+  // declination and dayl are only recomputed when model_time moves to a new day
+  void update(const Utils::Date& model_time, const double& dtime_secs,
+              const Utils::Date& forc_dt_start, const double& forc_dt_secs,
+              ArrayD1 coszen, ArrayD1 cosz_factor);
+
+  double declination() const { return declin_; }
+
+  ArrayD1 dayl, max_dayl;
+
+private:
+  ArrayD1 lat_r_, lon_r_;
+  int ncells_;
+  int cached_doy_{-1};
+  double declin_{0.0};
+};
+
+} // namespace ELM
+
+#include "solar_geometry_impl.hh"
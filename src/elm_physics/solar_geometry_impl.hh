@@ -0,0 +1,77 @@
+#pragma once
+
+namespace ELM::solar_geometry {
+
+template <typename ArrayD1>
+ComputeDaylength<ArrayD1>::ComputeDaylength(const double& declin, const ArrayD1 lat_r, ArrayD1 dayl)
+    : declin_(declin), lat_r_(lat_r), dayl_(dayl)
+    {}
+
+template <typename ArrayD1>
+ACCELERATE
+void ComputeDaylength<ArrayD1>::operator()(const int i) const
+{
+  dayl_(i) = daylength(lat_r_(i), declin_);
+}
+
+template <typename ArrayD1>
+ComputeMaxDaylength<ArrayD1>::ComputeMaxDaylength(const ArrayD1 lat_r, ArrayD1 max_dayl)
+    : lat_r_(lat_r), max_dayl_(max_dayl)
+    {}
+
+template <typename ArrayD1>
+ACCELERATE
+void ComputeMaxDaylength<ArrayD1>::operator()(const int i) const
+{
+  max_dayl_(i) = max_daylength(lat_r_(i));
+}
+
+template <typename ArrayD1>
+ComputeCoszen<ArrayD1>::ComputeCoszen(const double& declin, const double& cosz_decday, const double& forc_decday,
+                                      const double& forc_dt_secs, const ArrayD1 lat_r, const ArrayD1 lon_r,
+                                      ArrayD1 coszen, ArrayD1 cosz_factor)
+    : declin_(declin), cosz_decday_(cosz_decday), forc_decday_(forc_decday), forc_dt_secs_(forc_dt_secs),
+      lat_r_(lat_r), lon_r_(lon_r), coszen_(coszen), cosz_factor_(cosz_factor)
+    {}
+
+template <typename ArrayD1>
+ACCELERATE
+void ComputeCoszen<ArrayD1>::operator()(const int i) const
+{
+  const double cosz = incident_shortwave::coszen(lat_r_(i), lon_r_(i), cosz_decday_, declin_);
+  const double cosz_forcdt_avg = incident_shortwave::average_cosz(lat_r_(i), lon_r_(i), declin_, forc_dt_secs_, forc_decday_);
+  coszen_(i) = cosz;
+  cosz_factor_(i) = (cosz > 0.001) ? std::min(cosz / cosz_forcdt_avg, 10.0) : 0.0;
+}
+
+} // namespace ELM::solar_geometry
+
+template <typename ArrayD1>
+ELM::SolarGeometry<ArrayD1>::SolarGeometry(const ArrayD1 lat_r, const ArrayD1 lon_r)
+    : dayl("dayl", lat_r.extent(0)), max_dayl("max_dayl", lat_r.extent(0)),
+      lat_r_(lat_r), lon_r_(lon_r), ncells_(lat_r.extent(0))
+{
+  solar_geometry::ComputeMaxDaylength max_dayl_object(lat_r_, max_dayl);
+  invoke_kernel(max_dayl_object, std::make_tuple(ncells_), "ComputeMaxDaylength");
+}
+
+template <typename ArrayD1>
+void ELM::SolarGeometry<ArrayD1>::update(const Utils::Date& model_time, const double& dtime_secs,
+                                         const Utils::Date& forc_dt_start, const double& forc_dt_secs,
+                                         ArrayD1 coszen, ArrayD1 cosz_factor)
+{
+  // declination should be the same for model and forcing - don't cross day barrier in forcing timeseries
+  const int cosz_doy = model_time.doy + 1;
+  if (cosz_doy != cached_doy_) {
+    declin_ = incident_shortwave::declination_angle2(cosz_doy);
+    solar_geometry::ComputeDaylength dayl_object(declin_, lat_r_, dayl);
+    invoke_kernel(dayl_object, std::make_tuple(ncells_), "ComputeDaylength");
+    cached_doy_ = cosz_doy;
+  }
+
+  const double cosz_decday = Utils::decimal_doy(model_time) + 1.0 + dtime_secs / 86400.0 / 2.0;
+  const double forc_decday = Utils::decimal_doy(forc_dt_start) + 1.0;
+  solar_geometry::ComputeCoszen coszen_object(declin_, cosz_decday, forc_decday, forc_dt_secs,
+                                              lat_r_, lon_r_, coszen, cosz_factor);
+  invoke_kernel(coszen_object, std::make_tuple(ncells_), "ComputeCoszen");
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "array.hh"
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+
+/*
+NaN/Inf and physical bounds checks of the model state after a stage
+
+StateValidator::check(stage, checks...) checks a set of per-cell fields in one launch - a single reduction over
+cells evaluates every check of a cell and keeps the number of offending cells and the first few of them (lowest
+cell index), so nothing but the small reduction result comes back to host
+validation::finite(), bounds() and nonnegative() build a check of an (ncells) or (ncells, n) field - a value
+fails if it's NaN, +-Inf or outside [lo, hi], fields of (ncells, n) fail a cell if any of their n values fails
+a cell is reported with the first check it fails, in argument order
+
+on failure check() throws (Action::Throw), or writes the report to std::cerr and returns false (Action::Report)
+ELM ERROR: state validation failed after canopy_fluxes - 2 of 1024 cells, first: t_grnd(17) = nan, ...
+
+switches
+runtime - set_enabled(false) turns check() into a return
+compile time - call sites use ELM_VALIDATE(validator, stage, checks...), which compiles to nothing unless the
+build defines ENABLE_VALIDATION (cmake -DENABLE_VALIDATION=ON), so the checks, and the views they copy, aren't
+even constructed
+*/
+
+#ifdef ENABLE_VALIDATION
+#define ELM_VALIDATE(validator, ...) static_cast<void>((validator).check(__VA_ARGS__))
+#else
+#define ELM_VALIDATE(validator, ...) static_cast<void>(0)
+#endif
+
+namespace ELM {
+
+namespace validation {
+
+// rank of an ELM::Array or Kokkos::View
+template <typename Array_t>
+struct array_rank;
+
+template <typename T, size_t D>
+struct array_rank<Array<T, D>> : std::integral_constant<size_t, D> {};
+
+#ifdef ENABLE_KOKKOS
+template <typename DT, typename... P>
+struct array_rank<Kokkos::View<DT, P...>> : std::integral_constant<size_t, Kokkos::View<DT, P...>::rank> {};
+#endif
+
+// lo <= field(i[, j]) <= hi, and finite
+template <typename Array_t>
+struct Bounds {
+  static_assert(array_rank<Array_t>::value == 1 || array_rank<Array_t>::value == 2,
+                "validation checks fields of (ncells) or (ncells, n)");
+
+  // true if cell i fails, with j the offending index of a (ncells, n) field (-1 for (ncells)) and its value
+  ACCELERATE
+  bool failed(const int i, int& j, double& value) const;
+
+  Array_t field;
+  double lo, hi;
+};
+
+// a named check, see finite(), bounds() and nonnegative()
+template <typename Array_t>
+struct Check {
+  std::string name;
+  Bounds<Array_t> bounds;
+};
+
+template <typename Array_t>
+Check<Array_t> bounds(const std::string& name, const Array_t& field, const double& lo, const double& hi) {
+  return {name, {field, lo, hi}};
+}
+
+template <typename Array_t>
+Check<Array_t> finite(const std::string& name, const Array_t& field) {
+  return bounds(name, field, std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max());
+}
+
+template <typename Array_t>
+Check<Array_t> nonnegative(const std::string& name, const Array_t& field) {
+  return bounds(name, field, 0.0, std::numeric_limits<double>::max());
+}
+
+struct Violation {
+  int cell;
+  int check; // argument position of the check
+  int index; // offending index of a (ncells, n) field, -1 for (ncells)
+  double value;
+};
+
+// reduction result - the number of offending cells and the first max_reported of them, sorted by cell
+struct Violations {
+  static constexpr int max_reported{4};
+
+  // insertion into the list sorted by cell, the highest cell drops out of a full list
+  ACCELERATE
+  void add(const Violation& v) {
+    int pos = nreported;
+    while (pos > 0 && first[pos - 1].cell > v.cell) {
+      --pos;
+    }
+    if (pos == max_reported) {
+      return;
+    }
+    if (nreported < max_reported) {
+      ++nreported;
+    }
+    for (int k = nreported - 1; k > pos; --k) {
+      first[k] = first[k - 1];
+    }
+    first[pos] = v;
+  }
+
+  int ncells{0};
+  int nreported{0};
+  Violation first[max_reported];
+};
+
+// reduction functor for invoke_reduce() - evaluates every check of a cell
+template <typename... Arrays>
+struct ValidateCells {
+  using value_type = Violations;
+
+  ValidateCells(const Bounds<Arrays>&... checks);
+
+  ACCELERATE
+  void init(value_type& result) const;
+
+  ACCELERATE
+  void join(value_type& dst, const value_type& src) const;
+
+  ACCELERATE
+  void operator()(const int i, value_type& result) const;
+
+private:
+  template <size_t... I>
+  ACCELERATE
+  bool first_failed(Violation& v, std::index_sequence<I...>) const;
+
+  std::tuple<Bounds<Arrays>...> checks_;
+};
+
+} // namespace validation
+
+class StateValidator {
+
+public:
+  enum class Action { Report, Throw };
+
+  StateValidator(const size_t& ncells, const Action& action = Action::Throw);
+
+  void set_enabled(const bool& enabled) { enabled_ = enabled; }
+  bool enabled() const { return enabled_; }
+
+  // run checks over every cell in one launch, returns true if every cell passes (or validation is disabled)
+  template <typename... Arrays>
+  bool check(const std::string& stage, const validation::Check<Arrays>&... checks);
+  template <typename... Arrays>
+  bool check(const ExecSpace& space, const std::string& stage, const validation::Check<Arrays>&... checks);
+
+  // number of failed check() calls
+  int nfailures() const { return nfailures_; }
+
+  size_t ncells() const { return ncells_; }
+
+private:
+  size_t ncells_;
+  Action action_;
+  bool enabled_;
+  int nfailures_;
+};
+
+} // namespace ELM
+
+#include "state_validation_impl.hh"
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+template <typename Array_t>
+ACCELERATE
+bool ELM::validation::Bounds<Array_t>::failed(const int i, int& j, double& value) const
+{
+  // false for NaN and +-Inf
+  const auto in_bounds = [this](const double& v) {
+    return std::abs(v) <= std::numeric_limits<double>::max() && v >= lo && v <= hi;
+  };
+
+  if constexpr (array_rank<Array_t>::value == 1) {
+    j = -1;
+    value = field(i);
+    return !in_bounds(value);
+  } else {
+    // locals, so the loop doesn't store through j and value
+    const int n = field.extent(1);
+    for (int k = 0; k < n; ++k) {
+      const double v = field(i, k);
+      if (!in_bounds(v)) {
+        j = k;
+        value = v;
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+template <typename... Arrays>
+ELM::validation::ValidateCells<Arrays...>::ValidateCells(const Bounds<Arrays>&... checks) : checks_{checks...} {}
+
+template <typename... Arrays>
+ACCELERATE
+void ELM::validation::ValidateCells<Arrays...>::init(value_type& result) const
+{
+  result.ncells = 0;
+  result.nreported = 0;
+}
+
+template <typename... Arrays>
+ACCELERATE
+void ELM::validation::ValidateCells<Arrays...>::join(value_type& dst, const value_type& src) const
+{
+  dst.ncells += src.ncells;
+  for (int k = 0; k < src.nreported; ++k) {
+    dst.add(src.first[k]);
+  }
+}
+
+template <typename... Arrays>
+ACCELERATE
+void ELM::validation::ValidateCells<Arrays...>::operator()(const int i, value_type& result) const
+{
+  Violation v{i, -1, -1, 0.0};
+  if (first_failed(v, std::index_sequence_for<Arrays...>())) {
+    ++result.ncells;
+    result.add(v);
+  }
+}
+
+template <typename... Arrays>
+template <size_t... I>
+ACCELERATE
+bool ELM::validation::ValidateCells<Arrays...>::first_failed(Violation& v, std::index_sequence<I...>) const
+{
+  // stops at the first failing check
+  return ((std::get<I>(checks_).failed(v.cell, v.index, v.value) && (v.check = I, true)) || ...);
+}
+
+inline ELM::StateValidator::StateValidator(const size_t& ncells, const Action& action)
+    : ncells_{ncells}, action_{action}, enabled_{true}, nfailures_{0} {}
+
+template <typename... Arrays>
+bool ELM::StateValidator::check(const std::string& stage, const validation::Check<Arrays>&... checks)
+{
+  return check(ExecSpace(), stage, checks...);
+}
+
+template <typename... Arrays>
+bool ELM::StateValidator::check(const ExecSpace& space, const std::string& stage,
+                                const validation::Check<Arrays>&... checks)
+{
+  static_assert(sizeof...(Arrays) > 0, "StateValidator::check needs at least one check");
+  if (!enabled_) {
+    return true;
+  }
+  const std::string names[] = {checks.name...};
+  const size_t extents[] = {static_cast<size_t>(checks.bounds.field.extent(0))...};
+  for (size_t n = 0; n != sizeof...(Arrays); ++n) {
+    if (extents[n] != ncells_) {
+      throw std::runtime_error("ELM ERROR: StateValidator field " + names[n] + " must have length ncells");
+    }
+  }
+
+  validation::ValidateCells<Arrays...> validate(checks.bounds...);
+  validation::Violations result;
+  invoke_reduce(space, validate, std::make_tuple(ncells_), result, "StateValidator::" + stage);
+  if (result.ncells == 0) {
+    return true;
+  }
+
+  ++nfailures_;
+  std::ostringstream msg;
+  msg << "ELM ERROR: state validation failed after " << stage << " - " << result.ncells << " of " << ncells_
+      << " cells, first:";
+  for (int k = 0; k < result.nreported; ++k) {
+    const auto& v = result.first[k];
+    msg << (k ? ", " : " ") << names[v.check] << "(" << v.cell;
+    if (v.index >= 0) {
+      msg << ", " << v.index;
+    }
+    msg << ") = " << v.value;
+  }
+
+  if (action_ == Action::Throw) {
+    throw std::runtime_error(msg.str());
+  }
+  std::cerr << msg.str() << std::endl;
+  return false;
+}
@@ -49,14 +49,39 @@ flux_absorption_factor() flx_absd_snw flx_absi_snw mss_cnc_aer_in_fdb - from Ini
 #include <stdexcept>
 
 #include "kokkos_includes.hh"
+#include "invoke_kernel.hh"
+#ifndef ENABLE_KOKKOS
+#include "array_span.hh"
+#endif
 
 namespace ELM::surface_albedo {
 
 namespace detail {
 static constexpr double mpe = 1.e-06;   // prevents overflow for division by zero
 static constexpr double extkn = 0.30;   // nitrogen allocation coefficient
+static constexpr double dincmax = 0.25; // maximum lai+sai increment for canopy layer
+
+// two-stream coefficients of one waveband
+struct TwoStreamBand {
+  double omega, b, c1, d, f, h, sigma, p1, p2, p3, p4;
+};
+
+// full canopy solution of a cell needed by the canopy layer derivatives -
+// waveband independent terms and the visible band coefficients
+struct TwoStreamCanopy {
+  int path; // TwoStreamPath of the cell
+  double avmu, twostext, tmp0, s2, t2;
+  TwoStreamBand vis;
+};
 } // namespace detail
 
+// path taken by two_stream_solver() for a cell, see two_stream_path()
+enum TwoStreamPath : int {
+  two_stream_skip = 0,  // urban, or sun below the horizon - outputs are left as they are
+  two_stream_bare = 1,  // novegsol() - no canopy, fluxes pass through to the ground
+  two_stream_canopy = 2 // vegsol() - two-stream canopy solution
+};
+
 /*
 inputs:
 urbpoi                                   [bool]   true if urban point, false otherwise
@@ -93,15 +118,25 @@ flx_absin[nlevsno]                       [double] diffuse flux absorption factor
 mss_cnc_aer_in_fdb[nlevsno][sno_nbr_aer] [double] mass concentration of all aerosol species for feedback calculation [kg
 kg-1]
 */
-template <class ArrayD1, class ArrayD2>
+template <class ArrayD1, class ArrayD2, class ArrayRad1>
 ACCELERATE
 void init_timestep(const bool& urbpoi, const double& elai, const ArrayD1 mss_cnc_bcphi, const ArrayD1 mss_cnc_bcpho,
                    const ArrayD1 mss_cnc_dst1, const ArrayD1 mss_cnc_dst2, const ArrayD1 mss_cnc_dst3,
                    const ArrayD1 mss_cnc_dst4, double& vcmaxcintsun, double& vcmaxcintsha, ArrayD1 albsod,
-                   ArrayD1 albsoi, ArrayD1 albgrd, ArrayD1 albgri, ArrayD1 albd, ArrayD1 albi, ArrayD1 fabd,
-                   ArrayD1 fabd_sun, ArrayD1 fabd_sha, ArrayD1 fabi, ArrayD1 fabi_sun, ArrayD1 fabi_sha, ArrayD1 ftdd,
-                   ArrayD1 ftid, ArrayD1 ftii, ArrayD1 flx_absdv, ArrayD1 flx_absdn, ArrayD1 flx_absiv,
-                   ArrayD1 flx_absin, ArrayD2 mss_cnc_aer_in_fdb);
+                   ArrayD1 albsoi, ArrayRad1 albgrd, ArrayRad1 albgri, ArrayRad1 albd, ArrayRad1 albi, ArrayRad1 fabd,
+                   ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha,
+                   ArrayRad1 ftdd, ArrayRad1 ftid, ArrayRad1 ftii, ArrayD1 flx_absdv, ArrayD1 flx_absdn,
+                   ArrayD1 flx_absiv, ArrayD1 flx_absin, ArrayD2 mss_cnc_aer_in_fdb);
+
+// as above, without the aerosol inputs - for drivers where mss_cnc_aer_in_fdb is written directly
+// by aerosols::ComputeAerosolSnowState
+template <class ArrayD1, class ArrayRad1>
+ACCELERATE
+void init_timestep(const bool& urbpoi, const double& elai, double& vcmaxcintsun, double& vcmaxcintsha, ArrayD1 albsod,
+                   ArrayD1 albsoi, ArrayRad1 albgrd, ArrayRad1 albgri, ArrayRad1 albd, ArrayRad1 albi, ArrayRad1 fabd,
+                   ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha,
+                   ArrayRad1 ftdd, ArrayRad1 ftid, ArrayRad1 ftii, ArrayD1 flx_absdv, ArrayD1 flx_absdn,
+                   ArrayD1 flx_absiv, ArrayD1 flx_absin);
 
 /*
 Compute ground albedo from weighted snow and soil albedos
@@ -119,10 +154,11 @@ outputs:
 albgrd[numrad]  [double] direct-beam ground albedo [frc]
 albgri[numrad]  [double] diffuse ground albedo [frc]
 */
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void ground_albedo(const bool& urbpoi, const double& coszen, const double& frac_sno, const ArrayD1 albsod,
-                   const ArrayD1 albsoi, const ArrayD1 albsnd, const ArrayD1 albsni, ArrayD1 albgrd, ArrayD1 albgri);
+                   const ArrayD1 albsoi, const ArrayD1 albsnd, const ArrayD1 albsni, ArrayRad1 albgrd,
+                   ArrayRad1 albgri);
 
 /*
 weight snow layer radiative absorption factors based on snow fraction and soil albedo
@@ -158,6 +194,8 @@ leaf+stem area. Then add any remaining leaf+stem area to next layer and exit the
 Do this first for elai and esai (not buried by snow) and then for the part of the
 canopy that is buried by snow. Sun/shade big leaf code uses only one layer
 (nrad = ncan = 1), triggered by nlevcan == 1.
+nlevcan is the extent of the layer arrays, so the number of canopy layers is chosen
+when they are allocated (default ELMdims::nlevcan).
 ------------------
 
 tlai_z summed from 1 to nrad = elai
@@ -185,11 +223,37 @@ fabd_sha_z[nlevcan]  [double] absorbed shaded leaf direct  PAR (per unit lai+sai
 fabi_sun_z[nlevcan]  [double] absorbed sunlit leaf diffuse PAR (per unit lai+sai) for each canopy layer
 fabi_sha_z[nlevcan]  [double] absorbed shaded leaf diffuse PAR (per unit lai+sai) for each canopy layer
 */
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void canopy_layer_lai(const int& urbpoi, const double& elai, const double& esai, const double& tlai, const double& tsai,
-                      int& nrad, int& ncan, ArrayD1 tlai_z, ArrayD1 tsai_z, ArrayD1 fsun_z, ArrayD1 fabd_sun_z,
-                      ArrayD1 fabd_sha_z, ArrayD1 fabi_sun_z, ArrayD1 fabi_sha_z);
+                      int& nrad, int& ncan, ArrayD1 tlai_z, ArrayD1 tsai_z, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                      ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z);
+
+/*
+number of canopy layers canopy_layer_lai() fills for a multi-layer canopy (nlevcan > 1) -
+at least 4 above snow, plus the layers buried by snow. Layer arrays of a multi-layer
+canopy need max(4, canopy_layers_needed()) layers; canopy_layer_lai() throws otherwise.
+
+inputs:
+elai                 [double] one-sided leaf area index with burying by snow
+esai                 [double] one-sided stem area index with burying by snow
+tlai                 [double] one-sided leaf area index, no burying by snow
+tsai                 [double] one-sided stem area index, no burying by snow
+
+returns:
+number of canopy layers (ncan)
+*/
+ACCELERATE
+int canopy_layers_needed(const double& elai, const double& esai, const double& tlai, const double& tsai);
+
+/*
+zero the absorbed PAR and sunlit fraction of the nrad canopy layers above snow - the last step of
+canopy_layer_lai(), for cells whose layer LAI is reused from a previous step (see ChangeTracker)
+*/
+template <class ArrayRad1>
+ACCELERATE
+void zero_canopy_layer_fluxes(const int& urbpoi, const int& nrad, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                              ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z);
 
 /*
 returns true if !urbpoi && coszen > 0 && landtype is vegetated
@@ -258,15 +322,94 @@ fabd_sha_z[nlevcan]      [double] absorbed shaded leaf direct  PAR (per unit lai
 fabi_sun_z[nlevcan]      [double] absorbed sunlit leaf diffuse PAR (per unit lai+sai) for each canopy layer
 fabi_sha_z[nlevcan]      [double] absorbed shaded leaf diffuse PAR (per unit lai+sai) for each canopy layer
 */
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void two_stream_solver(const LandType& Land, const int& nrad, const double& coszen, const double& t_veg,
                        const double& fwet, const double& elai, const double& esai, const ArrayD1 tlai_z,
-                       const ArrayD1 tsai_z, const ArrayD1 albgrd, const ArrayD1 albgri, const PFTDataAlb& alb_pft,
-                       double& vcmaxcintsun, double& vcmaxcintsha, ArrayD1 albd, ArrayD1 ftid, ArrayD1 ftdd,
-                       ArrayD1 fabd, ArrayD1 fabd_sun, ArrayD1 fabd_sha, ArrayD1 albi, ArrayD1 ftii, ArrayD1 fabi,
-                       ArrayD1 fabi_sun, ArrayD1 fabi_sha, ArrayD1 fsun_z, ArrayD1 fabd_sun_z, ArrayD1 fabd_sha_z,
-                       ArrayD1 fabi_sun_z, ArrayD1 fabi_sha_z);
+                       const ArrayD1 tsai_z, const ArrayRad1 albgrd, const ArrayRad1 albgri, const PFTDataAlb& alb_pft,
+                       double& vcmaxcintsun, double& vcmaxcintsha, ArrayRad1 albd, ArrayRad1 ftid, ArrayRad1 ftdd,
+                       ArrayRad1 fabd, ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 albi, ArrayRad1 ftii,
+                       ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                       ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z);
+
+/*
+returns the TwoStreamPath of a cell - two_stream_canopy if vegsol(), two_stream_bare if novegsol(),
+otherwise two_stream_skip
+*/
+ACCELERATE
+int two_stream_path(const LandType& Land, const double& coszen, const double& elai, const double& esai);
+
+/*
+canopy (vegsol) path of two_stream_solver()
+both wavebands and the direct and diffuse solutions are evaluated in one loop over bands,
+canopy layer derivatives are calculated afterwards from the visible band coefficients
+the number of canopy layers is the extent of the layer arrays - one layer is the sun/shade big leaf,
+more layers resolve the APAR profile over the nrad layers above snow
+arguments are those of two_stream_solver()
+*/
+template <class ArrayD1, class ArrayRad1>
+ACCELERATE
+void two_stream_canopy_fluxes(const int& nrad, const double& coszen, const double& t_veg, const double& fwet,
+                              const double& elai, const double& esai, const ArrayD1 tlai_z, const ArrayD1 tsai_z,
+                              const ArrayRad1 albgrd, const ArrayRad1 albgri, const PFTDataAlb& alb_pft,
+                              double& vcmaxcintsun, double& vcmaxcintsha, ArrayRad1 albd, ArrayRad1 ftid,
+                              ArrayRad1 ftdd, ArrayRad1 fabd, ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 albi,
+                              ArrayRad1 ftii, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha, ArrayRad1 fsun_z,
+                              ArrayRad1 fabd_sun_z, ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z);
+
+/*
+full canopy part of two_stream_canopy_fluxes() - albedos, transmitted and absorbed fluxes of both wavebands
+returns the terms the canopy layer fluxes are computed from
+arguments are those of two_stream_solver()
+*/
+template <class ArrayRad1>
+ACCELERATE
+detail::TwoStreamCanopy two_stream_canopy_bands(const double& coszen, const double& t_veg, const double& fwet,
+                                                const double& elai, const double& esai, const ArrayRad1 albgrd,
+                                                const ArrayRad1 albgri, const PFTDataAlb& alb_pft, ArrayRad1 albd,
+                                                ArrayRad1 ftid, ArrayRad1 ftdd, ArrayRad1 fabd, ArrayRad1 fabd_sun,
+                                                ArrayRad1 fabd_sha, ArrayRad1 albi, ArrayRad1 ftii, ArrayRad1 fabi,
+                                                ArrayRad1 fabi_sun, ArrayRad1 fabi_sha);
+
+/*
+sun/shade big leaf canopy (one canopy layer) - sunlit fraction, absorbed PAR per unit sun/shade lai+sai and
+the leaf to canopy scaling coefficients vcmaxcintsun and vcmaxcintsha
+canopy is the result of two_stream_canopy_bands()
+*/
+template <class ArrayRad1>
+ACCELERATE
+void two_stream_big_leaf(const detail::TwoStreamCanopy& canopy, const double& elai, const double& esai,
+                         const ArrayRad1 fabd_sun, const ArrayRad1 fabd_sha, const ArrayRad1 fabi_sun,
+                         const ArrayRad1 fabi_sha, double& vcmaxcintsun, double& vcmaxcintsha, ArrayRad1 fsun_z,
+                         ArrayRad1 fabd_sun_z, ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z);
+
+/*
+multi-layer canopy - sunlit fraction and absorbed PAR of canopy layer iv, from the derivatives of the
+visible band solution at the layer center
+layers do not depend on each other and can be computed in any order or in parallel
+canopy is the result of two_stream_canopy_bands(), laisum the cumulative lai+sai at the center of
+layer iv (see canopy_layer_center_lai())
+*/
+template <class ArrayRad1>
+ACCELERATE
+void two_stream_layer_fluxes(const detail::TwoStreamCanopy& canopy, const int& iv, const double& laisum,
+                             const ArrayRad1 albgrd, const ArrayRad1 albgri, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                             ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z);
+
+// cumulative lai+sai at the center of canopy layer iv
+template <class ArrayD1>
+ACCELERATE
+double canopy_layer_center_lai(const int& iv, const ArrayD1 tlai_z, const ArrayD1 tsai_z);
+
+/*
+bare (novegsol) path of two_stream_solver() - no absorption, direct and diffuse fluxes are transmitted to the ground
+arguments are those of two_stream_solver()
+*/
+template <class ArrayRad1>
+ACCELERATE
+void two_stream_bare_fluxes(const ArrayRad1 albgrd, const ArrayRad1 albgri, ArrayRad1 albd, ArrayRad1 ftid,
+                            ArrayRad1 ftdd, ArrayRad1 fabd, ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 albi,
+                            ArrayRad1 ftii, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha);
 
 /*
 Soil albedos
@@ -292,6 +435,108 @@ ACCELERATE
 void soil_albedo(const LandType& Land, const int& snl, const double& t_grnd, const double& coszen,
                  const ArrayD1 h2osoi_vol, const ArrayD1 albsat, const ArrayD1 albdry, ArrayD1 albsod, ArrayD1 albsoi);
 
+/*
+functor to run two_stream_solver() over all cells
+
+cells are routed by a mask, path(i) = two_stream_path() - a cell only ever executes the code of its own path,
+and cells that take the canopy path are solved together:
+- on the host cells are processed in blocks of block_size, the mask of a block is computed first,
+  then the block's canopy cells are gathered into a dense list and solved under simd_for, so the solver
+  vectorizes across cells (SIMD lanes) with no vegsol branch inside the loop, bare cells follow
+- with Kokkos every cell is one thread, routed by its own mask entry
+with more than one canopy layer (layer arrays of extent > 1) every cell is one team instead - one thread
+routes the cell and solves the full canopy, then the layers are distributed over the threads of the team
+
+
+per-cell pft parameters are read from cell_pft (see GatherPFTData)
+launch with invoke_two_stream_solver()
+*/
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+struct ComputeTwoStream {
+  ComputeTwoStream(const LandType& Land, const PFTData<ArrayD1, ArrayD2>& cell_pft, const ArrayI1 nrad,
+                   const ArrayD1 coszen, const ArrayD1 t_veg, const ArrayD1 fwet, const ArrayD1 elai,
+                   const ArrayD1 esai, const ArrayD2 tlai_z, const ArrayD2 tsai_z, const ArrayRad2 albgrd,
+                   const ArrayRad2 albgri, ArrayI1 path, ArrayD1 vcmaxcintsun, ArrayD1 vcmaxcintsha, ArrayRad2 albd,
+                   ArrayRad2 ftid, ArrayRad2 ftdd, ArrayRad2 fabd, ArrayRad2 fabd_sun, ArrayRad2 fabd_sha,
+                   ArrayRad2 albi, ArrayRad2 ftii, ArrayRad2 fabi, ArrayRad2 fabi_sun, ArrayRad2 fabi_sha,
+                   ArrayRad2 fsun_z, ArrayRad2 fabd_sun_z, ArrayRad2 fabd_sha_z, ArrayRad2 fabi_sun_z,
+                   ArrayRad2 fabi_sha_z);
+
+  static constexpr int block_size{128};
+
+  // route and solve cell i
+  ACCELERATE
+  void operator()(const int i) const;
+
+  // route and solve cell member.league_rank(), canopy layers in parallel
+  ACCELERATE
+  void operator()(const TeamMember& member) const;
+
+  // number of canopy layers the layer arrays are sized for
+  ACCELERATE
+  int nlevcan() const { return static_cast<int>(fsun_z_.extent(1)); }
+
+  // path(i) = two_stream_path()
+  ACCELERATE
+  void route(const int i) const;
+
+  // two_stream_canopy_fluxes() for cell i
+  ACCELERATE
+  void canopy(const int i) const;
+
+  // two_stream_bare_fluxes() for cell i
+  ACCELERATE
+  void bare(const int i) const;
+
+#ifndef ENABLE_KOKKOS
+  // host - route and solve cells [begin, end), at most block_size cells
+  void solve_block(const int begin, const int end) const;
+#endif
+
+private:
+  LandType Land_;
+  PFTData<ArrayD1, ArrayD2> cell_pft_;
+  ArrayI1 nrad_;
+  ArrayD1 coszen_;
+  ArrayD1 t_veg_;
+  ArrayD1 fwet_;
+  ArrayD1 elai_;
+  ArrayD1 esai_;
+  ArrayD2 tlai_z_;
+  ArrayD2 tsai_z_;
+  ArrayRad2 albgrd_;
+  ArrayRad2 albgri_;
+  ArrayI1 path_;
+  ArrayD1 vcmaxcintsun_;
+  ArrayD1 vcmaxcintsha_;
+  ArrayRad2 albd_;
+  ArrayRad2 ftid_;
+  ArrayRad2 ftdd_;
+  ArrayRad2 fabd_;
+  ArrayRad2 fabd_sun_;
+  ArrayRad2 fabd_sha_;
+  ArrayRad2 albi_;
+  ArrayRad2 ftii_;
+  ArrayRad2 fabi_;
+  ArrayRad2 fabi_sun_;
+  ArrayRad2 fabi_sha_;
+  ArrayRad2 fsun_z_;
+  ArrayRad2 fabd_sun_z_;
+  ArrayRad2 fabd_sha_z_;
+  ArrayRad2 fabi_sun_z_;
+  ArrayRad2 fabi_sha_z_;
+};
+
+// convenience function to invoke the two-stream solver functor over ncells cells
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+void invoke_two_stream_solver(const ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>& two_stream,
+                              const size_t& ncells);
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+void invoke_two_stream_solver(const ExecSpace& space,
+                              const ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>& two_stream,
+                              const size_t& ncells);
+
 } // namespace ELM::surface_albedo
 
 #include "surface_albedo_impl.hh"
@@ -85,15 +85,39 @@ bool novegsol(const LandType& Land, const double& coszen, const double& elai, co
   return false;
 }
 
-template <class ArrayD1, class ArrayD2>
+template <class ArrayD1, class ArrayD2, class ArrayRad1>
 ACCELERATE
 void init_timestep(const bool& urbpoi, const double& elai, const ArrayD1 mss_cnc_bcphi, const ArrayD1 mss_cnc_bcpho,
                    const ArrayD1 mss_cnc_dst1, const ArrayD1 mss_cnc_dst2, const ArrayD1 mss_cnc_dst3,
                    const ArrayD1 mss_cnc_dst4, double& vcmaxcintsun, double& vcmaxcintsha, ArrayD1 albsod,
-                   ArrayD1 albsoi, ArrayD1 albgrd, ArrayD1 albgri, ArrayD1 albd, ArrayD1 albi, ArrayD1 fabd,
-                   ArrayD1 fabd_sun, ArrayD1 fabd_sha, ArrayD1 fabi, ArrayD1 fabi_sun, ArrayD1 fabi_sha, ArrayD1 ftdd,
-                   ArrayD1 ftid, ArrayD1 ftii, ArrayD1 flx_absdv, ArrayD1 flx_absdn, ArrayD1 flx_absiv,
-                   ArrayD1 flx_absin, ArrayD2 mss_cnc_aer_in_fdb)
+                   ArrayD1 albsoi, ArrayRad1 albgrd, ArrayRad1 albgri, ArrayRad1 albd, ArrayRad1 albi, ArrayRad1 fabd,
+                   ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha,
+                   ArrayRad1 ftdd, ArrayRad1 ftid, ArrayRad1 ftii, ArrayD1 flx_absdv, ArrayD1 flx_absdn,
+                   ArrayD1 flx_absiv, ArrayD1 flx_absin, ArrayD2 mss_cnc_aer_in_fdb)
+{
+  init_timestep(urbpoi, elai, vcmaxcintsun, vcmaxcintsha, albsod, albsoi, albgrd, albgri, albd, albi, fabd, fabd_sun,
+                fabd_sha, fabi, fabi_sun, fabi_sha, ftdd, ftid, ftii, flx_absdv, flx_absdn, flx_absiv, flx_absin);
+
+  // set soot and dust aerosol concentrations:
+  for (int i = 0; i < nlevsno; ++i) {
+    mss_cnc_aer_in_fdb(i, 0) = mss_cnc_bcphi(i);
+    mss_cnc_aer_in_fdb(i, 1) = mss_cnc_bcpho(i);
+    mss_cnc_aer_in_fdb(i, 2) = 0.0; // ignore OC concentrations due to poor constraint and negligible effect on snow
+    mss_cnc_aer_in_fdb(i, 3) = 0.0; // ignore OC concentrations due to poor constraint and negligible effect on snow
+    mss_cnc_aer_in_fdb(i, 4) = mss_cnc_dst1(i);
+    mss_cnc_aer_in_fdb(i, 5) = mss_cnc_dst2(i);
+    mss_cnc_aer_in_fdb(i, 6) = mss_cnc_dst3(i);
+    mss_cnc_aer_in_fdb(i, 7) = mss_cnc_dst4(i);
+  }
+} // init_timestep
+
+template <class ArrayD1, class ArrayRad1>
+ACCELERATE
+void init_timestep(const bool& urbpoi, const double& elai, double& vcmaxcintsun, double& vcmaxcintsha, ArrayD1 albsod,
+                   ArrayD1 albsoi, ArrayRad1 albgrd, ArrayRad1 albgri, ArrayRad1 albd, ArrayRad1 albi, ArrayRad1 fabd,
+                   ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha,
+                   ArrayRad1 ftdd, ArrayRad1 ftid, ArrayRad1 ftii, ArrayD1 flx_absdv, ArrayD1 flx_absdn,
+                   ArrayD1 flx_absiv, ArrayD1 flx_absin)
 {
   // Initialize output because solar radiation only done if coszen > 0
   if (!urbpoi) {
@@ -133,23 +157,13 @@ void init_timestep(const bool& urbpoi, const double& elai, const ArrayD1 mss_cnc
       vcmaxcintsha = 0.0;
     }
   }
-  // set soot and dust aerosol concentrations:
-  for (int i = 0; i < nlevsno; ++i) {
-    mss_cnc_aer_in_fdb(i, 0) = mss_cnc_bcphi(i);
-    mss_cnc_aer_in_fdb(i, 1) = mss_cnc_bcpho(i);
-    mss_cnc_aer_in_fdb(i, 2) = 0.0; // ignore OC concentrations due to poor constraint and negligible effect on snow
-    mss_cnc_aer_in_fdb(i, 3) = 0.0; // ignore OC concentrations due to poor constraint and negligible effect on snow
-    mss_cnc_aer_in_fdb(i, 4) = mss_cnc_dst1(i);
-    mss_cnc_aer_in_fdb(i, 5) = mss_cnc_dst2(i);
-    mss_cnc_aer_in_fdb(i, 6) = mss_cnc_dst3(i);
-    mss_cnc_aer_in_fdb(i, 7) = mss_cnc_dst4(i);
-  }
 } // init_timestep
 
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void ground_albedo(const bool& urbpoi, const double& coszen, const double& frac_sno, const ArrayD1 albsod,
-                   const ArrayD1 albsoi, const ArrayD1 albsnd, const ArrayD1 albsni, ArrayD1 albgrd, ArrayD1 albgri)
+                   const ArrayD1 albsoi, const ArrayD1 albsnd, const ArrayD1 albsni, ArrayRad1 albgrd,
+                   ArrayRad1 albgri)
 {
   if (!urbpoi && coszen > 0.0) {
     for (int ib = 0; ib < numrad; ++ib) {
@@ -199,13 +213,35 @@ void flux_absorption_factor(const LandType& Land, const double& coszen, const do
   }       // if !Land.urbpoi && coszen > 0.0
 } // flux_absorption_factor
 
-template <class ArrayD1>
+ACCELERATE
+int canopy_layers_needed(const double& elai, const double& esai, const double& tlai, const double& tsai)
+{
+  using detail::dincmax;
+  // same increments as the layer loops of canopy_layer_lai()
+  const auto layers = [](const double& lai_sai) {
+    int n = 0;
+    double dincmax_sum = 0.0;
+    do {
+      ++n;
+      dincmax_sum += dincmax;
+    } while ((lai_sai - dincmax_sum) > detail::mpe);
+    return n;
+  };
+
+  const int nrad = (elai + esai == 0.0) ? 0 : std::max(layers(elai + esai), 4);
+  const double blai = tlai - elai;
+  const double bsai = tsai - esai;
+  return (blai + bsai == 0.0) ? nrad : nrad + layers(blai + bsai);
+}
+
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void canopy_layer_lai(const int& urbpoi, const double& elai, const double& esai, const double& tlai, const double& tsai,
-                      int& nrad, int& ncan, ArrayD1 tlai_z, ArrayD1 tsai_z, ArrayD1 fsun_z, ArrayD1 fabd_sun_z,
-                      ArrayD1 fabd_sha_z, ArrayD1 fabi_sun_z, ArrayD1 fabi_sha_z)
+                      int& nrad, int& ncan, ArrayD1 tlai_z, ArrayD1 tsai_z, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                      ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z)
 {
-  static constexpr double dincmax = 0.25; // maximum lai+sai increment for canopy layer
+  using detail::dincmax;
+  const int nlevcan = static_cast<int>(tlai_z.extent(0)); // number of canopy layers the arrays are sized for
 
   if (!urbpoi) {
     if (nlevcan == 1) {
@@ -214,6 +250,13 @@ void canopy_layer_lai(const int& urbpoi, const double& elai, const double& esai,
       tlai_z(0) = elai;
       tsai_z(0) = esai;
     } else if (nlevcan > 1) {
+      // the layer loops below write up to max(4, ncan) layers
+      if (nlevcan < 4) {
+        throw std::runtime_error("ELM ERROR: multi-layer canopy needs at least 4 canopy layers in SurfaceAlbedo");
+      }
+      if (canopy_layers_needed(elai, esai, tlai, tsai) > nlevcan) {
+        throw std::runtime_error("ELM ERROR: canopy lai+sai needs more than nlevcan canopy layers in SurfaceAlbedo");
+      }
       if (elai + esai == 0.0) {
         nrad = 0;
       } else {
@@ -294,6 +337,16 @@ void canopy_layer_lai(const int& urbpoi, const double& elai, const double& esai,
     }
 
     // Zero fluxes for active canopy layers
+    zero_canopy_layer_fluxes(urbpoi, nrad, fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z);
+  } // if !urbpoi
+} // canopy_layer_lai
+
+template <class ArrayRad1>
+ACCELERATE
+void zero_canopy_layer_fluxes(const int& urbpoi, const int& nrad, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                              ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z)
+{
+  if (!urbpoi) {
     for (int iv = 0; iv < nrad; ++iv) {
       fabd_sun_z(iv) = 0.0;
       fabd_sha_z(iv) = 0.0;
@@ -301,375 +354,627 @@ void canopy_layer_lai(const int& urbpoi, const double& elai, const double& esai,
       fabi_sha_z(iv) = 0.0;
       fsun_z(iv) = 0.0;
     }
-  } // if !urbpoi
-} // canopy_layer_lai
+  }
+} // zero_canopy_layer_fluxes
 
-template <class ArrayD1>
+ACCELERATE
+int two_stream_path(const LandType& Land, const double& coszen, const double& elai, const double& esai)
+{
+  if (vegsol(Land, coszen, elai, esai)) {
+    return two_stream_canopy;
+  } else if (novegsol(Land, coszen, elai, esai)) {
+    return two_stream_bare;
+  }
+  return two_stream_skip;
+}
+
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void two_stream_solver(const LandType& Land, const int& nrad, const double& coszen, const double& t_veg,
                        const double& fwet, const double& elai, const double& esai, const ArrayD1 tlai_z,
-                       const ArrayD1 tsai_z, const ArrayD1 albgrd, const ArrayD1 albgri, const PFTDataAlb& alb_pft,
-                       double& vcmaxcintsun, double& vcmaxcintsha, ArrayD1 albd, ArrayD1 ftid, ArrayD1 ftdd,
-                       ArrayD1 fabd, ArrayD1 fabd_sun, ArrayD1 fabd_sha, ArrayD1 albi, ArrayD1 ftii, ArrayD1 fabi,
-                       ArrayD1 fabi_sun, ArrayD1 fabi_sha, ArrayD1 fsun_z, ArrayD1 fabd_sun_z, ArrayD1 fabd_sha_z,
-                       ArrayD1 fabi_sun_z, ArrayD1 fabi_sha_z)
+                       const ArrayD1 tsai_z, const ArrayRad1 albgrd, const ArrayRad1 albgri, const PFTDataAlb& alb_pft,
+                       double& vcmaxcintsun, double& vcmaxcintsha, ArrayRad1 albd, ArrayRad1 ftid, ArrayRad1 ftdd,
+                       ArrayRad1 fabd, ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 albi, ArrayRad1 ftii,
+                       ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                       ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z)
+{
+  const int path = two_stream_path(Land, coszen, elai, esai);
+  if (path == two_stream_canopy) {
+    two_stream_canopy_fluxes(nrad, coszen, t_veg, fwet, elai, esai, tlai_z, tsai_z, albgrd, albgri, alb_pft,
+                             vcmaxcintsun, vcmaxcintsha, albd, ftid, ftdd, fabd, fabd_sun, fabd_sha, albi, ftii, fabi,
+                             fabi_sun, fabi_sha, fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z);
+  } else if (path == two_stream_bare) {
+    two_stream_bare_fluxes(albgrd, albgri, albd, ftid, ftdd, fabd, fabd_sun, fabd_sha, albi, ftii, fabi, fabi_sun,
+                           fabi_sha);
+  }
+} // two_stream_solver
+
+template <class ArrayD1, class ArrayRad1>
+ACCELERATE
+void two_stream_canopy_fluxes(const int& nrad, const double& coszen, const double& t_veg, const double& fwet,
+                              const double& elai, const double& esai, const ArrayD1 tlai_z, const ArrayD1 tsai_z,
+                              const ArrayRad1 albgrd, const ArrayRad1 albgri, const PFTDataAlb& alb_pft,
+                              double& vcmaxcintsun, double& vcmaxcintsha, ArrayRad1 albd, ArrayRad1 ftid,
+                              ArrayRad1 ftdd, ArrayRad1 fabd, ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 albi,
+                              ArrayRad1 ftii, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha, ArrayRad1 fsun_z,
+                              ArrayRad1 fabd_sun_z, ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z)
+{
+  const auto canopy = two_stream_canopy_bands(coszen, t_veg, fwet, elai, esai, albgrd, albgri, alb_pft, albd, ftid,
+                                              ftdd, fabd, fabd_sun, fabd_sha, albi, ftii, fabi, fabi_sun, fabi_sha);
+
+  // number of canopy layers the arrays are sized for
+  const int nlevcan = static_cast<int>(fsun_z.extent(0));
+  if (nlevcan == 1) {
+    two_stream_big_leaf(canopy, elai, esai, fabd_sun, fabd_sha, fabi_sun, fabi_sha, vcmaxcintsun, vcmaxcintsha,
+                        fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z);
+  } else if (nlevcan > 1) {
+    double laisum;
+    for (int iv = 0; iv < nrad; iv++) {
+      // Cumulative lai+sai at center of layer
+      if (iv == 0) {
+        laisum = 0.5 * (tlai_z(iv) + tsai_z(iv));
+      } else {
+        laisum += 0.5 * ((tlai_z(iv - 1) + tsai_z(iv - 1)) + (tlai_z(iv) + tsai_z(iv)));
+      }
+      two_stream_layer_fluxes(canopy, iv, laisum, albgrd, albgri, fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z,
+                              fabi_sha_z);
+    }
+  }
+} // two_stream_canopy_fluxes
+
+template <class ArrayRad1>
+ACCELERATE
+detail::TwoStreamCanopy two_stream_canopy_bands(const double& coszen, const double& t_veg, const double& fwet,
+                                                const double& elai, const double& esai, const ArrayRad1 albgrd,
+                                                const ArrayRad1 albgri, const PFTDataAlb& alb_pft, ArrayRad1 albd,
+                                                ArrayRad1 ftid, ArrayRad1 ftdd, ArrayRad1 fabd, ArrayRad1 fabd_sun,
+                                                ArrayRad1 fabd_sha, ArrayRad1 albi, ArrayRad1 ftii, ArrayRad1 fabi,
+                                                ArrayRad1 fabi_sun, ArrayRad1 fabi_sha)
 {
   static constexpr double omegas[numrad] = {0.8, 0.4}; // two-stream parameter omega for snow by band
   static constexpr double betads = 0.5;                // two-stream parameter betad for snow
   static constexpr double betais = 0.5;                // two-stream parameter betai for snow
 
-  if (vegsol(Land, coszen, elai, esai)) {
-
-    double omega[numrad]; // fraction of intercepted radiation that is scattered (0 to 1)
-    double rho[numrad], tau[numrad];
+  // Weight reflectance/transmittance by lai and sai
+  const double wl = elai / std::max(elai + esai, detail::mpe);
+  const double ws = esai / std::max(elai + esai, detail::mpe);
 
-    // Weight reflectance/transmittance by lai and sai
-    const double wl = elai / std::max(elai + esai, detail::mpe);
-    const double ws = esai / std::max(elai + esai, detail::mpe);
+  // Calculate two-stream parameters that are independent of waveband:
+  // chil, gdir, twostext, avmu, and temp0 and temp2 (used for asu)
+  const double cosz = std::max(0.001, coszen);
+  double chil = std::min(std::max(alb_pft.xl, -0.4), 0.6);
+  if (std::abs(chil) <= 0.01) {
+    chil = 0.01;
+  }
 
-    // Calculate two-stream parameters that are independent of waveband:
-    // chil, gdir, twostext, avmu, and temp0 and temp2 (used for asu)
-    const double cosz = std::max(0.001, coszen);
-    double chil = std::min(std::max(alb_pft.xl, -0.4), 0.6);
-    if (std::abs(chil) <= 0.01) {
-      chil = 0.01;
+  const double phi1 = 0.5 - 0.633 * chil - 0.330 * chil * chil;
+  const double phi2 = 0.877 * (1.0 - 2.0 * phi1);
+  const double gdir = phi1 + phi2 * cosz;
+  const double twostext = gdir / cosz;
+  const double avmu = (1.0 - phi1 / phi2 * std::log((phi1 + phi2) / phi1)) / phi2;
+  const double temp0 = gdir + phi2 * cosz;
+  const double temp1 = phi1 * cosz;
+  const double temp2 = (1.0 - temp1 / temp0 * std::log((temp1 + temp0) / temp1));
+  const double tmp0 = avmu * twostext;
+
+  // Transmitted direct beam through the full canopy, the same in both wavebands
+  const double t2 = std::min(twostext * (elai + esai), 40.0);
+  const double s2 = exp(-t2);
+  // Calculate for the full canopy the scattered fluxes reflected upward and transmitted downward
+  // by the canopy and the flux absorbed by the canopy for a unit incoming direct beam and diffuse
+  // flux at the top of the canopy given an underlying surface of known albedo.
+  // Both wavebands and both beam types are evaluated in one pass over a fixed number of bands, without
+  // branches on the cell state other than the snow adjustment, so the loop unrolls and the cell loop
+  // of the batched solver can vectorize through it.
+  // Output:
+  // ------------------
+  // Direct beam fluxes
+  // ------------------
+  // albd       - Upward scattered flux above canopy (per unit direct beam flux)
+  // ftid       - Downward scattered flux below canopy (per unit direct beam flux)
+  // ftdd       - Transmitted direct beam flux below canopy (per unit direct beam flux)
+  // fabd       - Flux absorbed by canopy (per unit direct beam flux)
+  // fabd_sun   - Sunlit portion of fabd
+  // fabd_sha   - Shaded portion of fabd
+  // ------------------
+  // Diffuse fluxes
+  // ------------------
+  // albi       - Upward scattered flux above canopy (per unit diffuse flux)
+  // ftii       - Downward scattered flux below canopy (per unit diffuse flux)
+  // fabi       - Flux absorbed by canopy (per unit diffuse flux)
+  // fabi_sun   - Sunlit portion of fabi
+  // fabi_sha   - Shaded portion of fabi
+  detail::TwoStreamBand band[numrad];
+  for (int ib = 0; ib < numrad; ib++) {
+
+    const double rho = std::max(alb_pft.rhol[ib] * wl + alb_pft.rhos[ib] * ws, detail::mpe);
+    const double tau = std::max(alb_pft.taul[ib] * wl + alb_pft.taus[ib] * ws, detail::mpe);
+
+    // Calculate two-stream parameters omega, betad, and betai.
+    // Omega, betad, betai are adjusted for snow. Values for omega*betad
+    // and omega*betai are calculated and then divided by the new omega
+    // because the product omega*betai, omega*betad is used in solution.
+    // Also, the transmittances and reflectances (tau, rho) are linear
+    // weights of leaf and stem values.
+    const double omegal = rho + tau;
+    const double asu = 0.5 * omegal * gdir / temp0 * temp2;
+    const double betadl = (1.0 + avmu * twostext) / (omegal * avmu * twostext) * asu;
+    const double betail = 0.5 * ((rho + tau) + (rho - tau) * pow(((1.0 + chil) / 2.0), 2.0)) / omegal;
+
+    // Adjust omega, betad, and betai for intercepted snow
+    double omega, betad, betai;
+    if (t_veg > ELMconst::TFRZ) { // no snow
+      omega = omegal;
+      betad = betadl;
+      betai = betail;
+    } else {
+      omega = (1.0 - fwet) * omegal + fwet * omegas[ib];
+      betad = ((1.0 - fwet) * omegal * betadl + fwet * omegas[ib] * betads) / omega;
+      betai = ((1.0 - fwet) * omegal * betail + fwet * omegas[ib] * betais) / omega;
     }
 
-    const double phi1 = 0.5 - 0.633 * chil - 0.330 * chil * chil;
-    const double phi2 = 0.877 * (1.0 - 2.0 * phi1);
-    const double gdir = phi1 + phi2 * cosz;
-    const double twostext = gdir / cosz;
-    const double avmu = (1.0 - phi1 / phi2 * std::log((phi1 + phi2) / phi1)) / phi2;
-    const double temp0 = gdir + phi2 * cosz;
-    const double temp1 = phi1 * cosz;
-    const double temp2 = (1.0 - temp1 / temp0 * std::log((temp1 + temp0) / temp1));
-
-    // Loop over all wavebands to calculate for the full canopy the scattered fluxes
-    // reflected upward and transmitted downward by the canopy and the flux absorbed by the
-    // canopy for a unit incoming direct beam and diffuse flux at the top of the canopy given
-    // an underlying surface of known albedo.
-    // Output:
-    // ------------------
-    // Direct beam fluxes
-    // ------------------
-    // albd       - Upward scattered flux above canopy (per unit direct beam flux)
-    // ftid       - Downward scattered flux below canopy (per unit direct beam flux)
-    // ftdd       - Transmitted direct beam flux below canopy (per unit direct beam flux)
-    // fabd       - Flux absorbed by canopy (per unit direct beam flux)
-    // fabd_sun   - Sunlit portion of fabd
-    // fabd_sha   - Shaded portion of fabd
-    // fabd_sun_z - absorbed sunlit leaf direct PAR (per unit sunlit lai+sai) for each canopy layer
-    // fabd_sha_z - absorbed shaded leaf direct PAR (per unit shaded lai+sai) for each canopy layer
-    // ------------------
-    // Diffuse fluxes
-    // ------------------
-    // albi       - Upward scattered flux above canopy (per unit diffuse flux)
-    // ftii       - Downward scattered flux below canopy (per unit diffuse flux)
-    // fabi       - Flux absorbed by canopy (per unit diffuse flux)
-    // fabi_sun   - Sunlit portion of fabi
-    // fabi_sha   - Shaded portion of fabi
-    // fabi_sun_z - absorbed sunlit leaf diffuse PAR (per unit sunlit lai+sai) for each canopy layer
-    // fabi_sha_z - absorbed shaded leaf diffuse PAR (per unit shaded lai+sai) for each canopy layer
-
-    for (int ib = 0; ib < numrad; ib++) {
-
-      rho[ib] = std::max(alb_pft.rhol[ib] * wl + alb_pft.rhos[ib] * ws, detail::mpe);
-      tau[ib] = std::max(alb_pft.taul[ib] * wl + alb_pft.taus[ib] * ws, detail::mpe);
-
-      // Calculate two-stream parameters omega, betad, and betai.
-      // Omega, betad, betai are adjusted for snow. Values for omega*betad
-      // and omega*betai are calculated and then divided by the new omega
-      // because the product omega*betai, omega*betad is used in solution.
-      // Also, the transmittances and reflectances (tau, rho) are linear
-      // weights of leaf and stem values.
-      const double omegal = rho[ib] + tau[ib];
-      const double asu = 0.5 * omegal * gdir / temp0 * temp2;
-      const double betadl = (1.0 + avmu * twostext) / (omegal * avmu * twostext) * asu;
-      const double betail = 0.5 * ((rho[ib] + tau[ib]) + (rho[ib] - tau[ib]) * pow(((1.0 + chil) / 2.0), 2.0)) / omegal;
-
-      // Adjust omega, betad, and betai for intercepted snow
-      double tmp0, tmp1, tmp2;
-      if (t_veg > ELMconst::TFRZ) { // no snow
-        tmp0 = omegal;
-        tmp1 = betadl;
-        tmp2 = betail;
-      } else {
-        tmp0 = (1.0 - fwet) * omegal + fwet * omegas[ib];
-        tmp1 = ((1.0 - fwet) * omegal * betadl + fwet * omegas[ib] * betads) / tmp0;
-        tmp2 = ((1.0 - fwet) * omegal * betail + fwet * omegas[ib] * betais) / tmp0;
+    // Common terms
+    const double b = 1.0 - omega + omega * betai;
+    const double c1 = omega * betai;
+    const double d = tmp0 * omega * betad;
+    const double f = tmp0 * omega * (1.0 - betad);
+    const double tmp1 = b * b - c1 * c1;
+    const double h = sqrt(tmp1) / avmu;
+    const double sigma = tmp0 * tmp0 - tmp1;
+    const double p1 = b + avmu * h;
+    const double p2 = b - avmu * h;
+    const double p3 = b + tmp0;
+    const double p4 = b - tmp0;
+    band[ib] = {omega, b, c1, d, f, h, sigma, p1, p2, p3, p4};
+
+    // Absorbed, reflected, transmitted fluxes per unit incoming radiation for full canopy
+    const double t1 = std::min(h * (elai + esai), 40.0);
+    const double s1 = exp(-t1);
+
+    // Direct beam
+    double u1 = b - c1 / albgrd(ib);
+    double u2 = b - c1 * albgrd(ib);
+    const double u3 = f + c1 * albgrd(ib);
+    double tmp2 = u1 - avmu * h;
+    double tmp3 = u1 + avmu * h;
+    double d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
+    double tmp4 = u2 + avmu * h;
+    double tmp5 = u2 - avmu * h;
+    double d2 = tmp4 / s1 - tmp5 * s1;
+    const double h1 = -d * p4 - c1 * f;
+    const double tmp6 = d - h1 * p3 / sigma;
+    const double tmp7 = (d - c1 - h1 / sigma * (u1 + tmp0)) * s2;
+    const double h2 = (tmp6 * tmp2 / s1 - p2 * tmp7) / d1;
+    const double h3 = -(tmp6 * tmp3 * s1 - p1 * tmp7) / d1;
+    const double h4 = -f * p3 - c1 * d;
+    const double tmp8 = h4 / sigma;
+    const double tmp9 = (u3 - tmp8 * (u2 - tmp0)) * s2;
+    const double h5 = -(tmp8 * tmp4 / s1 + tmp9) / d2;
+    const double h6 = (tmp8 * tmp5 * s1 + tmp9) / d2;
+
+    albd(ib) = h1 / sigma + h2 + h3;
+    ftid(ib) = h4 * s2 / sigma + h5 * s1 + h6 / s1;
+    ftdd(ib) = s2;
+    fabd(ib) = 1.0 - albd(ib) - (1.0 - albgrd(ib)) * ftdd(ib) - (1.0 - albgri(ib)) * ftid(ib);
+
+    double a1 = h1 / sigma * (1.0 - s2 * s2) / (2.0 * twostext) + h2 * (1.0 - s2 * s1) / (twostext + h) +
+                h3 * (1.0 - s2 / s1) / (twostext - h);
+    double a2 = h4 / sigma * (1.0 - s2 * s2) / (2.0 * twostext) + h5 * (1.0 - s2 * s1) / (twostext + h) +
+                h6 * (1.0 - s2 / s1) / (twostext - h);
+
+    fabd_sun(ib) = (1.0 - omega) * (1.0 - s2 + 1.0 / avmu * (a1 + a2));
+    fabd_sha(ib) = fabd(ib) - fabd_sun(ib);
+
+    // Diffuse
+    u1 = b - c1 / albgri(ib);
+    u2 = b - c1 * albgri(ib);
+    tmp2 = u1 - avmu * h;
+    tmp3 = u1 + avmu * h;
+    d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
+    tmp4 = u2 + avmu * h;
+    tmp5 = u2 - avmu * h;
+    d2 = tmp4 / s1 - tmp5 * s1;
+    const double h7 = (c1 * tmp2) / (d1 * s1);
+    const double h8 = (-c1 * tmp3 * s1) / d1;
+    const double h9 = tmp4 / (d2 * s1);
+    const double h10 = (-tmp5 * s1) / d2;
+
+    albi(ib) = h7 + h8;
+    ftii(ib) = h9 * s1 + h10 / s1;
+    fabi(ib) = 1.0 - albi(ib) - (1.0 - albgri(ib)) * ftii(ib);
+
+    a1 = h7 * (1.0 - s2 * s1) / (twostext + h) + h8 * (1.0 - s2 / s1) / (twostext - h);
+    a2 = h9 * (1.0 - s2 * s1) / (twostext + h) + h10 * (1.0 - s2 / s1) / (twostext - h);
+
+    fabi_sun(ib) = (1.0 - omega) / avmu * (a1 + a2);
+    fabi_sha(ib) = fabi(ib) - fabi_sun(ib);
+  } // for numrad
+
+  return detail::TwoStreamCanopy{two_stream_canopy, avmu, twostext, tmp0, s2, t2, band[0]};
+} // two_stream_canopy_bands
+
+template <class ArrayRad1>
+ACCELERATE
+void two_stream_big_leaf(const detail::TwoStreamCanopy& canopy, const double& elai, const double& esai,
+                         const ArrayRad1 fabd_sun, const ArrayRad1 fabd_sha, const ArrayRad1 fabi_sun,
+                         const ArrayRad1 fabi_sha, double& vcmaxcintsun, double& vcmaxcintsha, ArrayRad1 fsun_z,
+                         ArrayRad1 fabd_sun_z, ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z)
+{
+  // Sun/shade big leaf code uses only one layer, with canopy integrated values from above
+  // and also canopy-integrated scaling coefficients
+  const int ib = 0;
+
+  // sunlit fraction of canopy
+  fsun_z(0) = (1.0 - canopy.s2) / canopy.t2;
+
+  // absorbed PAR (per unit sun/shade lai+sai)
+  const double laisum = elai + esai;
+  fabd_sun_z(0) = fabd_sun(ib) / (fsun_z(0) * laisum);
+  fabi_sun_z(0) = fabi_sun(ib) / (fsun_z(0) * laisum);
+  fabd_sha_z(0) = fabd_sha(ib) / ((1.0 - fsun_z(0)) * laisum);
+  fabi_sha_z(0) = fabi_sha(ib) / ((1.0 - fsun_z(0)) * laisum);
+
+  // leaf to canopy scaling coefficients
+  const double extkb = canopy.twostext;
+  vcmaxcintsun = (1.0 - exp(-(detail::extkn + extkb) * elai)) / (detail::extkn + extkb);
+  vcmaxcintsha = (1.0 - exp(-detail::extkn * elai)) / detail::extkn - vcmaxcintsun;
+  if (elai > 0.0) {
+    vcmaxcintsun = vcmaxcintsun / (fsun_z(0) * elai);
+    vcmaxcintsha = vcmaxcintsha / ((1.0 - fsun_z(0)) * elai);
+  } else {
+    vcmaxcintsun = 0.0;
+    vcmaxcintsha = 0.0;
+  }
+} // two_stream_big_leaf
+
+template <class ArrayRad1>
+ACCELERATE
+void two_stream_layer_fluxes(const detail::TwoStreamCanopy& canopy, const int& iv, const double& laisum,
+                             const ArrayRad1 albgrd, const ArrayRad1 albgri, ArrayRad1 fsun_z, ArrayRad1 fabd_sun_z,
+                             ArrayRad1 fabd_sha_z, ArrayRad1 fabi_sun_z, ArrayRad1 fabi_sha_z)
+{
+  // Repeat two-stream calculations for canopy layer iv to calculate derivatives.
+  // laisum is the cumulative leaf+stem area at the center of the layer, where derivatives are
+  // calculated. Derivatives are needed only for the
+  // visible waveband to calculate absorbed PAR (per unit lai+sai) for each canopy layer.
+  // Derivatives are calculated first per unit lai+sai and then normalized for sunlit
+  // or shaded fraction of canopy layer.
+  const int ib = 0;
+  const double avmu = canopy.avmu;
+  const double twostext = canopy.twostext;
+  const double tmp0 = canopy.tmp0;
+  const auto& [omega, b, c1, d, f, h, sigma, p1, p2, p3, p4] = canopy.vis;
+
+  // Coefficients s1 and s2 depend on cumulative lai+sai. s2 is the sunlit fraction
+  double t1 = std::min(h * laisum, 40.0);
+  const double s1 = exp(-t1);
+  t1 = std::min(twostext * laisum, 40.0);
+  const double s2 = exp(-t1);
+  fsun_z(iv) = s2;
+
+  // Direct beam
+  // Coefficients h1-h6 and a1,a2 depend of cumulative lai+sai
+  double u1 = b - c1 / albgrd(ib);
+  double u2 = b - c1 * albgrd(ib);
+  const double u3 = f + c1 * albgrd(ib);
+  double tmp2 = u1 - avmu * h;
+  double tmp3 = u1 + avmu * h;
+  double d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
+  double tmp4 = u2 + avmu * h;
+  double tmp5 = u2 - avmu * h;
+  double d2 = tmp4 / s1 - tmp5 * s1;
+  const double h1 = -d * p4 - c1 * f;
+  const double tmp6 = d - h1 * p3 / sigma;
+  const double tmp7 = (d - c1 - h1 / sigma * (u1 + tmp0)) * s2;
+  const double h2 = (tmp6 * tmp2 / s1 - p2 * tmp7) / d1;
+  const double h3 = -(tmp6 * tmp3 * s1 - p1 * tmp7) / d1;
+  const double h4 = -f * p3 - c1 * d;
+  const double tmp8 = h4 / sigma;
+  const double tmp9 = (u3 - tmp8 * (u2 - tmp0)) * s2;
+  const double h5 = -(tmp8 * tmp4 / s1 + tmp9) / d2;
+  const double h6 = (tmp8 * tmp5 * s1 + tmp9) / d2;
+
+  // Derivatives for h2, h3, h5, h6 and a1, a2
+  double v = d1;
+  double dv = h * p1 * tmp2 / s1 + h * p2 * tmp3 * s1;
+  double u = tmp6 * tmp2 / s1 - p2 * tmp7;
+  double du = h * tmp6 * tmp2 / s1 + twostext * p2 * tmp7;
+  const double dh2 = (v * du - u * dv) / (v * v);
+  u = -tmp6 * tmp3 * s1 + p1 * tmp7;
+  du = h * tmp6 * tmp3 * s1 - twostext * p1 * tmp7;
+  const double dh3 = (v * du - u * dv) / (v * v);
+  v = d2;
+  dv = h * tmp4 / s1 + h * tmp5 * s1;
+  u = -h4 / sigma * tmp4 / s1 - tmp9;
+  du = -h * h4 / sigma * tmp4 / s1 + twostext * tmp9;
+  const double dh5 = (v * du - u * dv) / (v * v);
+  u = h4 / sigma * tmp5 * s1 + tmp9;
+  du = -h * h4 / sigma * tmp5 * s1 - twostext * tmp9;
+  const double dh6 = (v * du - u * dv) / (v * v);
+
+  double da1 = h1 / sigma * s2 * s2 + h2 * s2 * s1 + h3 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh2 +
+               (1.0 - s2 / s1) / (twostext - h) * dh3;
+  double da2 = h4 / sigma * s2 * s2 + h5 * s2 * s1 + h6 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh5 +
+               (1.0 - s2 / s1) / (twostext - h) * dh6;
+
+  // Flux derivatives
+  const double d_ftid = -twostext * h4 / sigma * s2 - h * h5 * s1 + h * h6 / s1 + dh5 * s1 + dh6 / s1;
+  const double d_fabd = -(dh2 + dh3) + (1.0 - albgrd(ib)) * twostext * s2 - (1.0 - albgri(ib)) * d_ftid;
+  const double d_fabd_sun = (1.0 - omega) * (twostext * s2 + 1.0 / avmu * (da1 + da2));
+  const double d_fabd_sha = d_fabd - d_fabd_sun;
+  fabd_sun_z(iv) = std::max(d_fabd_sun, 0.0);
+  fabd_sha_z(iv) = std::max(d_fabd_sha, 0.0);
+
+  // Flux derivatives are APARsun and APARsha per unit (LAI+SAI). Need
+  // to normalize derivatives by sunlit or shaded fraction to get
+  // APARsun per unit (LAI+SAI)sun and APARsha per unit (LAI+SAI)sha
+  fabd_sun_z(iv) = fabd_sun_z(iv) / fsun_z(iv);
+  fabd_sha_z(iv) = fabd_sha_z(iv) / (1.0 - fsun_z(iv));
+
+  // Diffuse
+  // Coefficients h7-h10 and a1,a2 depend of cumulative lai+sai
+  u1 = b - c1 / albgri(ib);
+  u2 = b - c1 * albgri(ib);
+  tmp2 = u1 - avmu * h;
+  tmp3 = u1 + avmu * h;
+  d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
+  tmp4 = u2 + avmu * h;
+  tmp5 = u2 - avmu * h;
+  d2 = tmp4 / s1 - tmp5 * s1;
+  const double h7 = (c1 * tmp2) / (d1 * s1);
+  const double h8 = (-c1 * tmp3 * s1) / d1;
+  const double h9 = tmp4 / (d2 * s1);
+  const double h10 = (-tmp5 * s1) / d2;
+
+  // Derivatives for h7, h8, h9, h10 and a1, a2
+  v = d1;
+  dv = h * p1 * tmp2 / s1 + h * p2 * tmp3 * s1;
+  u = c1 * tmp2 / s1;
+  du = h * c1 * tmp2 / s1;
+  const double dh7 = (v * du - u * dv) / (v * v);
+  u = -c1 * tmp3 * s1;
+  du = h * c1 * tmp3 * s1;
+  const double dh8 = (v * du - u * dv) / (v * v);
+  v = d2;
+  dv = h * tmp4 / s1 + h * tmp5 * s1;
+  u = tmp4 / s1;
+  du = h * tmp4 / s1;
+  const double dh9 = (v * du - u * dv) / (v * v);
+  u = -tmp5 * s1;
+  du = h * tmp5 * s1;
+  const double dh10 = (v * du - u * dv) / (v * v);
+
+  da1 = h7 * s2 * s1 + h8 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh7 +
+        (1.0 - s2 / s1) / (twostext - h) * dh8;
+  da2 = h9 * s2 * s1 + h10 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh9 +
+        (1.0 - s2 / s1) / (twostext - h) * dh10;
+
+  // Flux derivatives
+  const double d_ftii = -h * h9 * s1 + h * h10 / s1 + dh9 * s1 + dh10 / s1;
+  const double d_fabi = -(dh7 + dh8) - (1.0 - albgri(ib)) * d_ftii;
+  const double d_fabi_sun = (1.0 - omega) / avmu * (da1 + da2);
+  const double d_fabi_sha = d_fabi - d_fabi_sun;
+  fabi_sun_z(iv) = std::max(d_fabi_sun, 0.0);
+  fabi_sha_z(iv) = std::max(d_fabi_sha, 0.0);
+
+  // Flux derivatives are APARsun and APARsha per unit (LAI+SAI). Need
+  // to normalize derivatives by sunlit or shaded fraction to get
+  // APARsun per unit (LAI+SAI)sun and APARsha per unit (LAI+SAI)sha
+  fabi_sun_z(iv) = fabi_sun_z(iv) / fsun_z(iv);
+  fabi_sha_z(iv) = fabi_sha_z(iv) / (1.0 - fsun_z(iv));
+} // two_stream_layer_fluxes
+
+template <class ArrayD1>
+ACCELERATE
+double canopy_layer_center_lai(const int& iv, const ArrayD1 tlai_z, const ArrayD1 tsai_z)
+{
+  // same summation order as the sweep in two_stream_canopy_fluxes(), so results are bit for bit identical
+  double laisum = 0.5 * (tlai_z(0) + tsai_z(0));
+  for (int jv = 1; jv <= iv; jv++) {
+    laisum += 0.5 * ((tlai_z(jv - 1) + tsai_z(jv - 1)) + (tlai_z(jv) + tsai_z(jv)));
+  }
+  return laisum;
+} // canopy_layer_center_lai
+
+template <class ArrayRad1>
+ACCELERATE
+void two_stream_bare_fluxes(const ArrayRad1 albgrd, const ArrayRad1 albgri, ArrayRad1 albd, ArrayRad1 ftid,
+                            ArrayRad1 ftdd, ArrayRad1 fabd, ArrayRad1 fabd_sun, ArrayRad1 fabd_sha, ArrayRad1 albi,
+                            ArrayRad1 ftii, ArrayRad1 fabi, ArrayRad1 fabi_sun, ArrayRad1 fabi_sha)
+{
+  for (int ib = 0; ib < numrad; ++ib) {
+    fabd(ib) = 0.0;
+    fabd_sun(ib) = 0.0;
+    fabd_sha(ib) = 0.0;
+    fabi(ib) = 0.0;
+    fabi_sun(ib) = 0.0;
+    fabi_sha(ib) = 0.0;
+    ftdd(ib) = 1.0;
+    ftid(ib) = 0.0;
+    ftii(ib) = 1.0;
+    albd(ib) = albgrd(ib);
+    albi(ib) = albgri(ib);
+  }
+} // two_stream_bare_fluxes
+
+namespace detail {
+// row i of a (ncells, n) array
+template <class Array_t>
+ACCELERATE
+auto cell_row(const Array_t& arr, const int i)
+{
+#ifdef ENABLE_KOKKOS
+  return Kokkos::subview(arr, i, Kokkos::ALL);
+#else
+  return arr[i];
+#endif
+}
+} // namespace detail
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::
+ComputeTwoStream(const LandType& Land, const PFTData<ArrayD1, ArrayD2>& cell_pft, const ArrayI1 nrad,
+                 const ArrayD1 coszen, const ArrayD1 t_veg, const ArrayD1 fwet, const ArrayD1 elai,
+                 const ArrayD1 esai, const ArrayD2 tlai_z, const ArrayD2 tsai_z, const ArrayRad2 albgrd,
+                 const ArrayRad2 albgri, ArrayI1 path, ArrayD1 vcmaxcintsun, ArrayD1 vcmaxcintsha, ArrayRad2 albd,
+                 ArrayRad2 ftid, ArrayRad2 ftdd, ArrayRad2 fabd, ArrayRad2 fabd_sun, ArrayRad2 fabd_sha,
+                 ArrayRad2 albi, ArrayRad2 ftii, ArrayRad2 fabi, ArrayRad2 fabi_sun, ArrayRad2 fabi_sha,
+                 ArrayRad2 fsun_z, ArrayRad2 fabd_sun_z, ArrayRad2 fabd_sha_z, ArrayRad2 fabi_sun_z,
+                 ArrayRad2 fabi_sha_z)
+    : Land_{Land}, cell_pft_{cell_pft}, nrad_{nrad}, coszen_{coszen}, t_veg_{t_veg}, fwet_{fwet}, elai_{elai},
+      esai_{esai}, tlai_z_{tlai_z}, tsai_z_{tsai_z}, albgrd_{albgrd}, albgri_{albgri}, path_{path},
+      vcmaxcintsun_{vcmaxcintsun}, vcmaxcintsha_{vcmaxcintsha}, albd_{albd}, ftid_{ftid}, ftdd_{ftdd}, fabd_{fabd},
+      fabd_sun_{fabd_sun}, fabd_sha_{fabd_sha}, albi_{albi}, ftii_{ftii}, fabi_{fabi}, fabi_sun_{fabi_sun},
+      fabi_sha_{fabi_sha}, fsun_z_{fsun_z}, fabd_sun_z_{fabd_sun_z}, fabd_sha_z_{fabd_sha_z},
+      fabi_sun_z_{fabi_sun_z}, fabi_sha_z_{fabi_sha_z} {}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+ACCELERATE
+void ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::operator()(const int i) const
+{
+  route(i);
+  if (path_(i) == two_stream_canopy) {
+    canopy(i);
+  } else if (path_(i) == two_stream_bare) {
+    bare(i);
+  }
+}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+ACCELERATE
+void ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::operator()(const TeamMember& member) const
+{
+  using detail::cell_row;
+  const int i = member.league_rank();
+  const auto albgrd = cell_row(albgrd_, i);
+  const auto albgri = cell_row(albgri_, i);
+  const auto fsun_z = cell_row(fsun_z_, i);
+  const auto fabd_sun_z = cell_row(fabd_sun_z_, i);
+  const auto fabd_sha_z = cell_row(fabd_sha_z_, i);
+  const auto fabi_sun_z = cell_row(fabi_sun_z_, i);
+  const auto fabi_sha_z = cell_row(fabi_sha_z_, i);
+
+  // full canopy, once per cell
+  detail::TwoStreamCanopy canopy{};
+  team_single(member, [&](detail::TwoStreamCanopy& cell) {
+    route(i);
+    cell.path = path_(i);
+    if (cell.path == two_stream_canopy) {
+      const auto fabd_sun = cell_row(fabd_sun_, i);
+      const auto fabd_sha = cell_row(fabd_sha_, i);
+      const auto fabi_sun = cell_row(fabi_sun_, i);
+      const auto fabi_sha = cell_row(fabi_sha_, i);
+      cell = two_stream_canopy_bands(coszen_(i), t_veg_(i), fwet_(i), elai_(i), esai_(i), albgrd, albgri,
+                                     cell_pft_.get_pft_alb(i), cell_row(albd_, i), cell_row(ftid_, i),
+                                     cell_row(ftdd_, i), cell_row(fabd_, i), fabd_sun, fabd_sha, cell_row(albi_, i),
+                                     cell_row(ftii_, i), cell_row(fabi_, i), fabi_sun, fabi_sha);
+      if (nlevcan() == 1) {
+        two_stream_big_leaf(cell, elai_(i), esai_(i), fabd_sun, fabd_sha, fabi_sun, fabi_sha, vcmaxcintsun_(i),
+                            vcmaxcintsha_(i), fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z);
       }
-      omega[ib] = tmp0;
-      const double betad = tmp1;
-      const double betai = tmp2;
-
-      // Common terms
-      const double b = 1.0 - omega[ib] + omega[ib] * betai;
-      const double c1 = omega[ib] * betai;
-      tmp0 = avmu * twostext;
-      const double d = tmp0 * omega[ib] * betad;
-      const double f = tmp0 * omega[ib] * (1.0 - betad);
-      tmp1 = b * b - c1 * c1;
-      const double h = sqrt(tmp1) / avmu;
-      const double sigma = tmp0 * tmp0 - tmp1;
-      const double p1 = b + avmu * h;
-      const double p2 = b - avmu * h;
-      const double p3 = b + tmp0;
-      const double p4 = b - tmp0;
-
-      // Absorbed, reflected, transmitted fluxes per unit incoming radiation for full canopy
-      double t1 = std::min(h * (elai + esai), 40.0);
-      double s1 = exp(-t1);
-      t1 = std::min(twostext * (elai + esai), 40.0);
-      double s2 = exp(-t1);
-
-      // Direct beam
-      double u1 = b - c1 / albgrd(ib);
-      double u2 = b - c1 * albgrd(ib);
-      double u3 = f + c1 * albgrd(ib);
-      tmp2 = u1 - avmu * h;
-      double tmp3 = u1 + avmu * h;
-      double d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
-      double tmp4 = u2 + avmu * h;
-      double tmp5 = u2 - avmu * h;
-      double d2 = tmp4 / s1 - tmp5 * s1;
-      double h1 = -d * p4 - c1 * f;
-      double tmp6 = d - h1 * p3 / sigma;
-      double tmp7 = (d - c1 - h1 / sigma * (u1 + tmp0)) * s2;
-      double h2 = (tmp6 * tmp2 / s1 - p2 * tmp7) / d1;
-      double h3 = -(tmp6 * tmp3 * s1 - p1 * tmp7) / d1;
-      double h4 = -f * p3 - c1 * d;
-      double tmp8 = h4 / sigma;
-      double tmp9 = (u3 - tmp8 * (u2 - tmp0)) * s2;
-      double h5 = -(tmp8 * tmp4 / s1 + tmp9) / d2;
-      double h6 = (tmp8 * tmp5 * s1 + tmp9) / d2;
-
-      albd(ib) = h1 / sigma + h2 + h3;
-      ftid(ib) = h4 * s2 / sigma + h5 * s1 + h6 / s1;
-      ftdd(ib) = s2;
-      fabd(ib) = 1.0 - albd(ib) - (1.0 - albgrd(ib)) * ftdd(ib) - (1.0 - albgri(ib)) * ftid(ib);
-
-      double a1 = h1 / sigma * (1.0 - s2 * s2) / (2.0 * twostext) + h2 * (1.0 - s2 * s1) / (twostext + h) +
-                  h3 * (1.0 - s2 / s1) / (twostext - h);
-      double a2 = h4 / sigma * (1.0 - s2 * s2) / (2.0 * twostext) + h5 * (1.0 - s2 * s1) / (twostext + h) +
-                  h6 * (1.0 - s2 / s1) / (twostext - h);
-
-      fabd_sun(ib) = (1.0 - omega[ib]) * (1.0 - s2 + 1.0 / avmu * (a1 + a2));
-      fabd_sha(ib) = fabd(ib) - fabd_sun(ib);
-
-      // Diffuse
-      u1 = b - c1 / albgri(ib);
-      u2 = b - c1 * albgri(ib);
-      tmp2 = u1 - avmu * h;
-      tmp3 = u1 + avmu * h;
-      d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
-      tmp4 = u2 + avmu * h;
-      tmp5 = u2 - avmu * h;
-      d2 = tmp4 / s1 - tmp5 * s1;
-      double h7 = (c1 * tmp2) / (d1 * s1);
-      double h8 = (-c1 * tmp3 * s1) / d1;
-      double h9 = tmp4 / (d2 * s1);
-      double h10 = (-tmp5 * s1) / d2;
-
-      albi(ib) = h7 + h8;
-      ftii(ib) = h9 * s1 + h10 / s1;
-      fabi(ib) = 1.0 - albi(ib) - (1.0 - albgri(ib)) * ftii(ib);
-
-      a1 = h7 * (1.0 - s2 * s1) / (twostext + h) + h8 * (1.0 - s2 / s1) / (twostext - h);
-      a2 = h9 * (1.0 - s2 * s1) / (twostext + h) + h10 * (1.0 - s2 / s1) / (twostext - h);
-
-      fabi_sun(ib) = (1.0 - omega[ib]) / avmu * (a1 + a2);
-      fabi_sha(ib) = fabi(ib) - fabi_sun(ib);
-
-      // Repeat two-stream calculations for each canopy layer to calculate derivatives.
-      // tlai_z and tsai_z are the leaf+stem area increment for a layer. Derivatives are
-      // calculated at the center of the layer. Derivatives are needed only for the
-      // visible waveband to calculate absorbed PAR (per unit lai+sai) for each canopy layer.
-      // Derivatives are calculated first per unit lai+sai and then normalized for sunlit
-      // or shaded fraction of canopy layer.
-      // Sun/shade big leaf code uses only one layer, with canopy integrated values from above
-      // and also canopy-integrated scaling coefficients
-
-      if (ib == 0) {
-        double laisum;
-        if (nlevcan == 1) {
-          // sunlit fraction of canopy
-          fsun_z(0) = (1.0 - s2) / t1;
-
-          // absorbed PAR (per unit sun/shade lai+sai)
-          laisum = elai + esai;
-          fabd_sun_z(0) = fabd_sun(ib) / (fsun_z(0) * laisum);
-          fabi_sun_z(0) = fabi_sun(ib) / (fsun_z(0) * laisum);
-          fabd_sha_z(0) = fabd_sha(ib) / ((1.0 - fsun_z(0)) * laisum);
-          fabi_sha_z(0) = fabi_sha(ib) / ((1.0 - fsun_z(0)) * laisum);
-
-          // leaf to canopy scaling coefficients
-          double extkb = twostext;
-          vcmaxcintsun = (1.0 - exp(-(detail::extkn + extkb) * elai)) / (detail::extkn + extkb);
-          vcmaxcintsha = (1.0 - exp(-detail::extkn * elai)) / detail::extkn - vcmaxcintsun;
-          if (elai > 0.0) {
-            vcmaxcintsun = vcmaxcintsun / (fsun_z(0) * elai);
-            vcmaxcintsha = vcmaxcintsha / ((1.0 - fsun_z(0)) * elai);
-          } else {
-            vcmaxcintsun = 0.0;
-            vcmaxcintsha = 0.0;
-          }
+    } else if (cell.path == two_stream_bare) {
+      bare(i);
+    }
+  }, canopy);
+
+  // canopy layers are independent of each other
+  if (canopy.path == two_stream_canopy && nlevcan() > 1) {
+    const auto tlai_z = cell_row(tlai_z_, i);
+    const auto tsai_z = cell_row(tsai_z_, i);
+    team_for(member, nrad_(i), [&](const int iv) {
+      two_stream_layer_fluxes(canopy, iv, canopy_layer_center_lai(iv, tlai_z, tsai_z), albgrd, albgri, fsun_z,
+                              fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z);
+    });
+  }
+}
 
-        } else if (nlevcan > 1) {
-          for (int iv = 0; iv < nrad; iv++) {
-            // Cumulative lai+sai at center of layer
-            if (iv == 0) {
-              laisum = 0.5 * (tlai_z(iv) + tsai_z(iv));
-            } else {
-              laisum += 0.5 * ((tlai_z(iv - 1) + tsai_z(iv - 1)) + (tlai_z(iv) + tsai_z(iv)));
-            }
-
-            // Coefficients s1 and s2 depend on cumulative lai+sai. s2 is the sunlit fraction
-            t1 = std::min(h * laisum, 40.0);
-            s1 = exp(-t1);
-            t1 = std::min(twostext * laisum, 40.0);
-            s2 = exp(-t1);
-            fsun_z(iv) = s2;
-
-            // Direct beam
-            // Coefficients h1-h6 and a1,a2 depend of cumulative lai+sai
-            u1 = b - c1 / albgrd(ib);
-            u2 = b - c1 * albgrd(ib);
-            u3 = f + c1 * albgrd(ib);
-            tmp2 = u1 - avmu * h;
-            tmp3 = u1 + avmu * h;
-            d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
-            tmp4 = u2 + avmu * h;
-            tmp5 = u2 - avmu * h;
-            d2 = tmp4 / s1 - tmp5 * s1;
-            h1 = -d * p4 - c1 * f;
-            tmp6 = d - h1 * p3 / sigma;
-            tmp7 = (d - c1 - h1 / sigma * (u1 + tmp0)) * s2;
-            h2 = (tmp6 * tmp2 / s1 - p2 * tmp7) / d1;
-            h3 = -(tmp6 * tmp3 * s1 - p1 * tmp7) / d1;
-            h4 = -f * p3 - c1 * d;
-            tmp8 = h4 / sigma;
-            tmp9 = (u3 - tmp8 * (u2 - tmp0)) * s2;
-            h5 = -(tmp8 * tmp4 / s1 + tmp9) / d2;
-            h6 = (tmp8 * tmp5 * s1 + tmp9) / d2;
-
-            a1 = h1 / sigma * (1.0 - s2 * s2) / (2.0 * twostext) + h2 * (1.0 - s2 * s1) / (twostext + h) +
-                 h3 * (1.0 - s2 / s1) / (twostext - h);
-            a2 = h4 / sigma * (1.0 - s2 * s2) / (2.0 * twostext) + h5 * (1.0 - s2 * s1) / (twostext + h) +
-                 h6 * (1.0 - s2 / s1) / (twostext - h);
-
-            // Derivatives for h2, h3, h5, h6 and a1, a2
-            double v = d1;
-            double dv = h * p1 * tmp2 / s1 + h * p2 * tmp3 * s1;
-            double u = tmp6 * tmp2 / s1 - p2 * tmp7;
-            double du = h * tmp6 * tmp2 / s1 + twostext * p2 * tmp7;
-            double dh2 = (v * du - u * dv) / (v * v);
-            u = -tmp6 * tmp3 * s1 + p1 * tmp7;
-            du = h * tmp6 * tmp3 * s1 - twostext * p1 * tmp7;
-            double dh3 = (v * du - u * dv) / (v * v);
-            v = d2;
-            dv = h * tmp4 / s1 + h * tmp5 * s1;
-            u = -h4 / sigma * tmp4 / s1 - tmp9;
-            du = -h * h4 / sigma * tmp4 / s1 + twostext * tmp9;
-            double dh5 = (v * du - u * dv) / (v * v);
-            u = h4 / sigma * tmp5 * s1 + tmp9;
-            du = -h * h4 / sigma * tmp5 * s1 - twostext * tmp9;
-            double dh6 = (v * du - u * dv) / (v * v);
-
-            double da1 = h1 / sigma * s2 * s2 + h2 * s2 * s1 + h3 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh2 +
-                         (1.0 - s2 / s1) / (twostext - h) * dh3;
-            double da2 = h4 / sigma * s2 * s2 + h5 * s2 * s1 + h6 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh5 +
-                         (1.0 - s2 / s1) / (twostext - h) * dh6;
-
-            // Flux derivatives
-            double d_ftid = -twostext * h4 / sigma * s2 - h * h5 * s1 + h * h6 / s1 + dh5 * s1 + dh6 / s1;
-            double d_fabd = -(dh2 + dh3) + (1.0 - albgrd(ib)) * twostext * s2 - (1.0 - albgri(ib)) * d_ftid;
-            double d_fabd_sun = (1.0 - omega[ib]) * (twostext * s2 + 1.0 / avmu * (da1 + da2));
-            double d_fabd_sha = d_fabd - d_fabd_sun;
-            fabd_sun_z(iv) = std::max(d_fabd_sun, 0.0);
-            fabd_sha_z(iv) = std::max(d_fabd_sha, 0.0);
-
-            // Flux derivatives are APARsun and APARsha per unit (LAI+SAI). Need
-            // to normalize derivatives by sunlit or shaded fraction to get
-            // APARsun per unit (LAI+SAI)sun and APARsha per unit (LAI+SAI)sha
-            fabd_sun_z(iv) = fabd_sun_z(iv) / fsun_z(iv);
-            fabd_sha_z(iv) = fabd_sha_z(iv) / (1.0 - fsun_z(iv));
-
-            // Diffuse
-            // Coefficients h7-h10 and a1,a2 depend of cumulative lai+sai
-            u1 = b - c1 / albgri(ib);
-            u2 = b - c1 * albgri(ib);
-            tmp2 = u1 - avmu * h;
-            tmp3 = u1 + avmu * h;
-            d1 = p1 * tmp2 / s1 - p2 * tmp3 * s1;
-            tmp4 = u2 + avmu * h;
-            tmp5 = u2 - avmu * h;
-            d2 = tmp4 / s1 - tmp5 * s1;
-            h7 = (c1 * tmp2) / (d1 * s1);
-            h8 = (-c1 * tmp3 * s1) / d1;
-            h9 = tmp4 / (d2 * s1);
-            h10 = (-tmp5 * s1) / d2;
-
-            a1 = h7 * (1.0 - s2 * s1) / (twostext + h) + h8 * (1.0 - s2 / s1) / (twostext - h);
-            a2 = h9 * (1.0 - s2 * s1) / (twostext + h) + h10 * (1.0 - s2 / s1) / (twostext - h);
-
-            // Derivatives for h7, h8, h9, h10 and a1, a2
-            v = d1;
-            dv = h * p1 * tmp2 / s1 + h * p2 * tmp3 * s1;
-            u = c1 * tmp2 / s1;
-            du = h * c1 * tmp2 / s1;
-            double dh7 = (v * du - u * dv) / (v * v);
-            u = -c1 * tmp3 * s1;
-            du = h * c1 * tmp3 * s1;
-            double dh8 = (v * du - u * dv) / (v * v);
-            v = d2;
-            dv = h * tmp4 / s1 + h * tmp5 * s1;
-            u = tmp4 / s1;
-            du = h * tmp4 / s1;
-            double dh9 = (v * du - u * dv) / (v * v);
-            u = -tmp5 * s1;
-            du = h * tmp5 * s1;
-            double dh10 = (v * du - u * dv) / (v * v);
-
-            da1 = h7 * s2 * s1 + h8 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh7 +
-                  (1.0 - s2 / s1) / (twostext - h) * dh8;
-            da2 = h9 * s2 * s1 + h10 * s2 / s1 + (1.0 - s2 * s1) / (twostext + h) * dh9 +
-                  (1.0 - s2 / s1) / (twostext - h) * dh10;
-
-            // Flux derivatives
-            double d_ftii = -h * h9 * s1 + h * h10 / s1 + dh9 * s1 + dh10 / s1;
-            double d_fabi = -(dh7 + dh8) - (1.0 - albgri(ib)) * d_ftii;
-            double d_fabi_sun = (1.0 - omega[ib]) / avmu * (da1 + da2);
-            double d_fabi_sha = d_fabi - d_fabi_sun;
-            fabi_sun_z(iv) = std::max(d_fabi_sun, 0.0);
-            fabi_sha_z(iv) = std::max(d_fabi_sha, 0.0);
-
-            // Flux derivatives are APARsun and APARsha per unit (LAI+SAI). Need
-            // to normalize derivatives by sunlit or shaded fraction to get
-            // APARsun per unit (LAI+SAI)sun and APARsha per unit (LAI+SAI)sha
-            fabi_sun_z(iv) = fabi_sun_z(iv) / fsun_z(iv);
-            fabi_sha_z(iv) = fabi_sha_z(iv) / (1.0 - fsun_z(iv));
-          } // for nrad
-        }   // if nlevcan > 1
-      }     // if ib == 0
-    }       // for numrad
-  } else if (novegsol(Land, coszen, elai, esai)) {
-    for (int ib = 0; ib < numrad; ++ib) {
-      fabd(ib) = 0.0;
-      fabd_sun(ib) = 0.0;
-      fabd_sha(ib) = 0.0;
-      fabi(ib) = 0.0;
-      fabi_sun(ib) = 0.0;
-      fabi_sha(ib) = 0.0;
-      ftdd(ib) = 1.0;
-      ftid(ib) = 0.0;
-      ftii(ib) = 1.0;
-      albd(ib) = albgrd(ib);
-      albi(ib) = albgri(ib);
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+ACCELERATE
+void ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::route(const int i) const
+{
+  path_(i) = two_stream_path(Land_, coszen_(i), elai_(i), esai_(i));
+}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+ACCELERATE
+void ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::canopy(const int i) const
+{
+  using detail::cell_row;
+  two_stream_canopy_fluxes(nrad_(i), coszen_(i), t_veg_(i), fwet_(i), elai_(i), esai_(i), cell_row(tlai_z_, i),
+                           cell_row(tsai_z_, i), cell_row(albgrd_, i), cell_row(albgri_, i), cell_pft_.get_pft_alb(i),
+                           vcmaxcintsun_(i), vcmaxcintsha_(i), cell_row(albd_, i), cell_row(ftid_, i),
+                           cell_row(ftdd_, i), cell_row(fabd_, i), cell_row(fabd_sun_, i), cell_row(fabd_sha_, i),
+                           cell_row(albi_, i), cell_row(ftii_, i), cell_row(fabi_, i), cell_row(fabi_sun_, i),
+                           cell_row(fabi_sha_, i), cell_row(fsun_z_, i), cell_row(fabd_sun_z_, i),
+                           cell_row(fabd_sha_z_, i), cell_row(fabi_sun_z_, i), cell_row(fabi_sha_z_, i));
+}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+ACCELERATE
+void ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::bare(const int i) const
+{
+  using detail::cell_row;
+  two_stream_bare_fluxes(cell_row(albgrd_, i), cell_row(albgri_, i), cell_row(albd_, i), cell_row(ftid_, i),
+                         cell_row(ftdd_, i), cell_row(fabd_, i), cell_row(fabd_sun_, i), cell_row(fabd_sha_, i),
+                         cell_row(albi_, i), cell_row(ftii_, i), cell_row(fabi_, i), cell_row(fabi_sun_, i),
+                         cell_row(fabi_sha_, i));
+}
+
+#ifndef ENABLE_KOKKOS
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+void ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::solve_block(const int begin, const int end) const
+{
+  // the mask of the whole block first, then dense lists of the cells on each path
+  int canopy_cells[block_size], bare_cells[block_size];
+  int ncanopy = 0, nbare = 0;
+  for (int i = begin; i < end; ++i) {
+    route(i);
+    if (path_(i) == two_stream_canopy) {
+      canopy_cells[ncanopy++] = i;
+    } else if (path_(i) == two_stream_bare) {
+      bare_cells[nbare++] = i;
     }
   }
-} // two_stream_solver
+
+  simd_for(0, ncanopy, [&](const int k) { canopy(canopy_cells[k]); });
+  for (int k = 0; k < nbare; ++k) {
+    bare(bare_cells[k]);
+  }
+}
+#endif
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+void invoke_two_stream_solver(const ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>& two_stream,
+                              const size_t& ncells)
+{
+  invoke_two_stream_solver(ExecSpace(), two_stream, ncells);
+}
+
+template <typename ArrayI1, typename ArrayD1, typename ArrayD2, typename ArrayRad2>
+void invoke_two_stream_solver(const ExecSpace& space,
+                              const ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>& two_stream,
+                              const size_t& ncells)
+{
+  // multi-layer canopy - one team per cell, layers across the team
+  if (two_stream.nlevcan() > 1) {
+    invoke_team_kernel(space, two_stream, std::make_tuple(ncells), "ComputeTwoStream");
+    return;
+  }
+#ifdef ENABLE_KOKKOS
+  invoke_kernel(space, two_stream, std::make_tuple(ncells), "ComputeTwoStream");
+#else
+  // one launch index per block of cells
+  constexpr int block_size = ComputeTwoStream<ArrayI1, ArrayD1, ArrayD2, ArrayRad2>::block_size;
+  const int nblocks = (static_cast<int>(ncells) + block_size - 1) / block_size;
+  const auto solve_block = [&two_stream, ncells](const int b) {
+    two_stream.solve_block(b * block_size, std::min((b + 1) * block_size, static_cast<int>(ncells)));
+  };
+  invoke_kernel(space, solve_block, std::make_tuple(nblocks), "ComputeTwoStream");
+#endif
+}
 
 template <class ArrayD1>
+ACCELERATE
 void soil_albedo(const LandType& Land, const int& snl, const double& t_grnd, const double& coszen,
                  const ArrayD1 h2osoi_vol, const ArrayD1 albsat, const ArrayD1 albdry, ArrayD1 albsod, ArrayD1 albsoi)
 {
@@ -59,13 +59,13 @@ void initialize_flux(const LandType& Land, double& sabg_soil, double& sabg_snow,
 \param[out] trd[numrad]       [double] transmitted solar radiation: direct (W/m**2)
 \param[out] tri[numrad]       [double] transmitted solar radiation: diffuse (W/m**2)
 */
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
-void total_absorbed_radiation(const LandType& Land, const int& snl, const ArrayD1 ftdd, const ArrayD1 ftid,
-                              const ArrayD1 ftii, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
-                              const ArrayD1 fabd, const ArrayD1 fabi, const ArrayD1 albsod, const ArrayD1 albsoi,
-                              const ArrayD1 albsnd_hst, const ArrayD1 albsni_hst, const ArrayD1 albgrd,
-                              const ArrayD1 albgri, double& sabv, double& fsa, double& sabg, double& sabg_soil,
+void total_absorbed_radiation(const LandType& Land, const int& snl, const ArrayRad1 ftdd, const ArrayRad1 ftid,
+                              const ArrayRad1 ftii, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
+                              const ArrayRad1 fabd, const ArrayRad1 fabi, const ArrayD1 albsod, const ArrayD1 albsoi,
+                              const ArrayD1 albsnd_hst, const ArrayD1 albsni_hst, const ArrayRad1 albgrd,
+                              const ArrayRad1 albgri, double& sabv, double& fsa, double& sabg, double& sabg_soil,
                               double& sabg_snow, double trd[numrad], double tri[numrad]);
 
 /*! Compute absorbed flux in each snow layer and top soil layer.
@@ -99,9 +99,9 @@ void layer_absorbed_radiation(const LandType& Land, const int& snl, const double
 \param[in]  forc_solai[numrad] [double] diffuse radiation (W/m**2)
 \param[out] fsr                [double] solar radiation reflected (W/m**2)
 */
-template <class ArrayD1>
+template <class ArrayRad1, class ArrayD1>
 ACCELERATE
-void reflected_radiation(const LandType& Land, const ArrayD1 albd, const ArrayD1 albi, const ArrayD1 forc_solad,
+void reflected_radiation(const LandType& Land, const ArrayRad1 albd, const ArrayRad1 albi, const ArrayD1 forc_solad,
                          const ArrayD1 forc_solai, double& fsr);
 
 /*!
@@ -131,12 +131,12 @@ This subroutine calculates and returns:
 \param[out] laisun              [double] sunlit leaf area
 \param[out] laisha              [double] shaded  leaf area
 */
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void canopy_sunshade_fractions(const LandType& Land, const int& nrad, const double& elai, const ArrayD1 tlai_z,
-                               const ArrayD1 fsun_z, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
-                               const ArrayD1 fabd_sun_z, const ArrayD1 fabd_sha_z, const ArrayD1 fabi_sun_z,
-                               const ArrayD1 fabi_sha_z, ArrayD1 parsun_z, ArrayD1 parsha_z, ArrayD1 laisun_z,
+                               const ArrayRad1 fsun_z, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
+                               const ArrayRad1 fabd_sun_z, const ArrayRad1 fabd_sha_z, const ArrayRad1 fabi_sun_z,
+                               const ArrayRad1 fabi_sha_z, ArrayD1 parsun_z, ArrayD1 parsha_z, ArrayD1 laisun_z,
                                ArrayD1 laisha_z, double& laisun, double& laisha);
 
 } // namespace ELM::surface_radiation
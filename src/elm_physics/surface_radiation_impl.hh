@@ -23,13 +23,13 @@ void initialize_flux(const LandType& Land, double& sabg_soil, double& sabg_snow,
   }
 }
 
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
-void total_absorbed_radiation(const LandType& Land, const int& snl, const ArrayD1 ftdd, const ArrayD1 ftid,
-                              const ArrayD1 ftii, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
-                              const ArrayD1 fabd, const ArrayD1 fabi, const ArrayD1 albsod, const ArrayD1 albsoi,
-                              const ArrayD1 albsnd_hst, const ArrayD1 albsni_hst, const ArrayD1 albgrd,
-                              const ArrayD1 albgri, double& sabv, double& fsa, double& sabg, double& sabg_soil,
+void total_absorbed_radiation(const LandType& Land, const int& snl, const ArrayRad1 ftdd, const ArrayRad1 ftid,
+                              const ArrayRad1 ftii, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
+                              const ArrayRad1 fabd, const ArrayRad1 fabi, const ArrayD1 albsod, const ArrayD1 albsoi,
+                              const ArrayD1 albsnd_hst, const ArrayD1 albsni_hst, const ArrayRad1 albgrd,
+                              const ArrayRad1 albgri, double& sabv, double& fsa, double& sabg, double& sabg_soil,
                               double& sabg_snow, double trd[numrad], double tri[numrad]) {
 
   double absrad, cad[numrad], cai[numrad];
@@ -166,9 +166,9 @@ void layer_absorbed_radiation(const LandType& Land, const int& snl, const double
   }
 }
 
-template <class ArrayD1>
+template <class ArrayRad1, class ArrayD1>
 ACCELERATE
-void reflected_radiation(const LandType& Land, const ArrayD1 albd, const ArrayD1 albi, const ArrayD1 forc_solad,
+void reflected_radiation(const LandType& Land, const ArrayRad1 albd, const ArrayRad1 albi, const ArrayD1 forc_solad,
                          const ArrayD1 forc_solai, double& fsr) {
 
   double fsr_vis_d, fsr_nir_d, fsr_vis_i, fsr_nir_i, rvis, rnir;
@@ -189,12 +189,12 @@ void reflected_radiation(const LandType& Land, const ArrayD1 albd, const ArrayD1
   }
 }
 
-template <class ArrayD1>
+template <class ArrayD1, class ArrayRad1>
 ACCELERATE
 void canopy_sunshade_fractions(const LandType& Land, const int& nrad, const double& elai, const ArrayD1 tlai_z,
-                               const ArrayD1 fsun_z, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
-                               const ArrayD1 fabd_sun_z, const ArrayD1 fabd_sha_z, const ArrayD1 fabi_sun_z,
-                               const ArrayD1 fabi_sha_z, ArrayD1 parsun_z, ArrayD1 parsha_z, ArrayD1 laisun_z,
+                               const ArrayRad1 fsun_z, const ArrayD1 forc_solad, const ArrayD1 forc_solai,
+                               const ArrayRad1 fabd_sun_z, const ArrayRad1 fabd_sha_z, const ArrayRad1 fabi_sun_z,
+                               const ArrayRad1 fabi_sha_z, ArrayD1 parsun_z, ArrayD1 parsha_z, ArrayD1 laisun_z,
                                ArrayD1 laisha_z, double& laisun, double& laisha) {
 
   if (!Land.urbpoi) {
@@ -6,13 +6,174 @@
 #include <algorithm>
 #include <array>
 #include <assert.h>
+#include <cstdlib>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <numeric>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace ELM {
+
+// storage order tags, named after the Kokkos layouts
+// LayoutRight - last index is contiguous, row-major, a(cell, lev) stores a cell's levels together
+// LayoutLeft  - first index is contiguous, column-major, a(cell, lev) stores a level's cells together
+struct LayoutRight {};
+struct LayoutLeft {};
+
 namespace Impl {
 
+// alignment of owning allocations - a cache line, and wide enough for any SIMD load
+constexpr size_t ARRAY_ALIGNMENT = 64;
+
+//
+// Cache of aligned blocks.
+//
+// Owning Arrays are frequently created and destroyed with the same shape
+// (per-timestep temporaries, reader buffers).  Freed blocks are kept in a
+// free list keyed by size and handed back to the next allocation of that
+// size instead of going through the system allocator.  The free lists hold
+// at most max_cached_bytes(), a freed block that doesn't fit is returned to
+// the system, so a run allocating many distinct sizes doesn't grow without
+// bound.  release() returns all cached blocks to the system.
+//
+class MemoryPool {
+public:
+  static constexpr size_t default_max_cached_bytes = size_t(256) << 20;
+
+  static MemoryPool &instance() {
+    static MemoryPool pool;
+    return pool;
+  }
+
+  ~MemoryPool() { release(); }
+
+  // bytes is rounded up to a multiple of ARRAY_ALIGNMENT
+  static size_t block_size(size_t bytes) {
+    return std::max(ARRAY_ALIGNMENT, (bytes + ARRAY_ALIGNMENT - 1) / ARRAY_ALIGNMENT * ARRAY_ALIGNMENT);
+  }
+
+  void *allocate(size_t bytes) {
+    bytes = block_size(bytes);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto itr = free_.find(bytes);
+      if (itr != free_.end()) {
+        void *p = itr->second.back();
+        itr->second.pop_back();
+        if (itr->second.empty()) {
+          free_.erase(itr);
+        }
+        cached_bytes_ -= bytes;
+        return p;
+      }
+    }
+    void *p = std::aligned_alloc(ARRAY_ALIGNMENT, bytes);
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+  void deallocate(void *p, size_t bytes) {
+    bytes = block_size(bytes);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (cached_bytes_ + bytes <= max_cached_bytes_) {
+        free_[bytes].push_back(p);
+        cached_bytes_ += bytes;
+        return;
+      }
+    }
+    std::free(p);
+  }
+
+  // free all cached blocks
+  void release() { trim(0); }
+
+  // free cached blocks, largest first, until at most bytes are cached
+  void trim(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (cached_bytes_ > bytes) {
+      auto itr = std::prev(free_.end());
+      std::free(itr->second.back());
+      itr->second.pop_back();
+      cached_bytes_ -= itr->first;
+      if (itr->second.empty()) {
+        free_.erase(itr);
+      }
+    }
+  }
+
+  // bytes held in the free lists
+  size_t cached_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cached_bytes_;
+  }
+
+  // cap on the bytes held in the free lists, lowering it trims the cache
+  size_t max_cached_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_cached_bytes_;
+  }
+  void set_max_cached_bytes(size_t bytes) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      max_cached_bytes_ = bytes;
+    }
+    trim(bytes);
+  }
+
+private:
+  MemoryPool() = default;
+
+  mutable std::mutex mutex_;
+  // non-empty free lists only
+  std::map<size_t, std::vector<void *>> free_;
+  size_t cached_bytes_{0};
+  size_t max_cached_bytes_{default_max_cached_bytes};
+};
+
+//
+// Array labels, interned - every Array and view with the same label points
+// at one shared string, so labelling an Array, or a view of external data,
+// doesn't allocate once the label exists.  Labels are variable names, a
+// small set, and are kept for the life of the program.  nullptr for "".
+//
+inline const std::string *intern_label(const std::string &name) {
+  if (name.empty()) {
+    return nullptr;
+  }
+  static std::mutex mutex;
+  static std::set<std::string> labels;
+  std::lock_guard<std::mutex> lock(mutex);
+  return &*labels.insert(name).first;
+}
+
+//
+// Owning allocation - pooled, aligned, value-initialized data.
+//
+template <typename T> struct Block_ {
+  explicit Block_(size_t len_) : len(len_) {
+    data = static_cast<T *>(MemoryPool::instance().allocate(len * sizeof(T)));
+    std::uninitialized_value_construct_n(data, len);
+  }
+
+  ~Block_() {
+    std::destroy_n(data, len);
+    MemoryPool::instance().deallocate(data, len * sizeof(T));
+  }
+
+  Block_(const Block_ &) = delete;
+  Block_ &operator=(const Block_ &) = delete;
+
+  size_t len;
+  T *data;
+};
+
 template <typename T> class Data_ {
 public:
   // assigment operator
@@ -31,18 +192,25 @@ public:
   T const *data() const { return d_; }
   T *data() { return d_; }
 
+  // get variable name
+  std::string label() const { return name_ ? *name_ : std::string(); }
+
 protected:
   //
   // Constructors are all protected -- do not use this class directly!
   //
   // construct from a total length
-  Data_(int len) : len_(len), do_(std::shared_ptr<T>(new T[len], std::default_delete<T[]>())) { d_ = do_.get(); }
+  Data_(const std::string &name, int len)
+      : len_(len), do_(std::make_shared<Block_<T>>(len)), d_(do_->data), name_(intern_label(name)) {}
 
   // construct and initialize
-  Data_(int len, T d) : Data_(len) { *this = d; }
+  Data_(const std::string &name, int len, T d) : Data_(name, len) { *this = d; }
 
-  // construct non-owning view
-  Data_(int len, T *d) : len_(len), d_(d) {}
+  // construct non-owning view of external data
+  Data_(const std::string &name, int len, T *d) : len_(len), d_(d), name_(intern_label(name)) {}
+
+  // construct non-owning view that shares the label of another Array - no allocation or refcount
+  Data_(const std::string *name, int len, T *d) : len_(len), d_(d), name_(name) {}
 
   // copy construct
   Data_(const Data_ &other) = default;
@@ -51,8 +219,8 @@ protected:
   // destructive
   void Data_resize(int N) {
     len_ = N;
-    do_.reset(new T[N](), std::default_delete<T[]>());
-    d_ = do_.get();
+    do_ = std::make_shared<Block_<T>>(N);
+    d_ = do_->data;
   }
 
 protected:
@@ -60,10 +228,13 @@ protected:
   int len_;
 
   // owning data
-  std::shared_ptr<T> do_;
+  std::shared_ptr<Block_<T>> do_;
 
   // non-owning data
   T *d_;
+
+  // interned label, see intern_label()
+  const std::string *name_;
 };
 
 } // namespace Impl
@@ -77,22 +248,22 @@ template <typename T> class Array<T, 1> : public Impl::Data_<T> {
 
 public:
   // forward construction
-  Array(int N) : Impl::Data_<T>(N), name_("") {}
-  Array(const std::string& name, int N) : Impl::Data_<T>(N), name_(name) {}
-  Array(std::array<int, 1> N) : Impl::Data_<T>(std::get<0>(N)), name_("") {}
-  Array(const std::string& name, std::array<int, 1> N) : Impl::Data_<T>(std::get<0>(N)), name_(name) {}
+  Array(int N) : Impl::Data_<T>("", N) {}
+  Array(const std::string& name, int N) : Impl::Data_<T>(name, N) {}
+  Array(std::array<int, 1> N) : Impl::Data_<T>("", std::get<0>(N)) {}
+  Array(const std::string& name, std::array<int, 1> N) : Impl::Data_<T>(name, std::get<0>(N)) {}
 
   // forward construction
-  Array(int N, T t) : Impl::Data_<T>(N, t), name_("") {}
-  Array(const std::string& name, int N, T t) : Impl::Data_<T>(N, t), name_(name) {}
-  Array(std::array<int, 1> N, T t) : Impl::Data_<T>(std::get<0>(N), t), name_("") {}
-  Array(const std::string& name, std::array<int, 1> N, T t) : Impl::Data_<T>(std::get<0>(N), t), name_(name) {}
+  Array(int N, T t) : Impl::Data_<T>("", N, t) {}
+  Array(const std::string& name, int N, T t) : Impl::Data_<T>(name, N, t) {}
+  Array(std::array<int, 1> N, T t) : Impl::Data_<T>("", std::get<0>(N), t) {}
+  Array(const std::string& name, std::array<int, 1> N, T t) : Impl::Data_<T>(name, std::get<0>(N), t) {}
 
   // forward construction
-  Array(int N, T *d) : Impl::Data_<T>(N, d), name_("") {}
-  Array(const std::string& name, int N, T *d) : Impl::Data_<T>(N, d), name_(name) {}
-  Array(std::array<int, 1> N, T *d) : Impl::Data_<T>(std::get<0>(N), d), name_("") {}
-  Array(const std::string& name, std::array<int, 1> N, T *d) : Impl::Data_<T>(std::get<0>(N), d), name_(name) {}
+  Array(int N, T *d) : Impl::Data_<T>("", N, d) {}
+  Array(const std::string& name, int N, T *d) : Impl::Data_<T>(name, N, d) {}
+  Array(std::array<int, 1> N, T *d) : Impl::Data_<T>("", std::get<0>(N), d) {}
+  Array(const std::string& name, std::array<int, 1> N, T *d) : Impl::Data_<T>(name, std::get<0>(N), d) {}
 
   // forward construction
   Array(const Array<T, 1> &other) = default;
@@ -130,15 +301,18 @@ public:
 
   std::array<int, 1> dimension() const { return {len_}; }
 
-  // get variable name
-  std::string label() const { return {name_}; }
-
   typedef T value_type;
+  typedef LayoutRight array_layout;
 
 protected:
   using Impl::Data_<T>::len_;
   using Impl::Data_<T>::d_;
-  std::string name_;
+
+private:
+  template <typename U, size_t E> friend class Array;
+
+  // non-owning view sharing the label of a parent Array
+  Array(const std::string *name, int N, T *d) : Impl::Data_<T>(name, N, d) {}
 };
 
 // 2D specialization
@@ -147,28 +321,28 @@ template <typename T> class Array<T, 2> : public Impl::Data_<T> {
 
 public:
   // forward construction
-  Array(int M, int N) : Impl::Data_<T>(N * M), M_(M), N_(N), name_("") {}
-  Array(const std::string& name, int M, int N) : Impl::Data_<T>(N * M), M_(M), N_(N), name_(name) {}
+  Array(int M, int N) : Impl::Data_<T>("", N * M), M_(M), N_(N) {}
+  Array(const std::string& name, int M, int N) : Impl::Data_<T>(name, N * M), M_(M), N_(N) {}
   Array(std::array<int, 2> N)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)), name_("") {}
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)) {}
   Array(const std::string& name, std::array<int, 2> N)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)), name_(name) {}
+      : Impl::Data_<T>(name, std::get<0>(N) * std::get<1>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)) {}
 
   // forward construction
-  Array(int M, int N, T t) : Impl::Data_<T>(N * M, t), M_(M), N_(N), name_("") {}
-  Array(const std::string& name, int M, int N, T t) : Impl::Data_<T>(N * M, t), M_(M), N_(N), name_(name) {}
+  Array(int M, int N, T t) : Impl::Data_<T>("", N * M, t), M_(M), N_(N) {}
+  Array(const std::string& name, int M, int N, T t) : Impl::Data_<T>(name, N * M, t), M_(M), N_(N) {}
   Array(std::array<int, 2> N, T t)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)), name_("") {}
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)) {}
   Array(const std::string& name, std::array<int, 2> N, T t)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)), name_(name) {}
+      : Impl::Data_<T>(name, std::get<0>(N) * std::get<1>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)) {}
 
   // forward construction
-  Array(int M, int N, T *d) : Impl::Data_<T>(N * M, d), M_(M), N_(N), name_("") {}
-  Array(const std::string& name, int M, int N, T *d) : Impl::Data_<T>(N * M, d), M_(M), N_(N), name_(name) {}
+  Array(int M, int N, T *d) : Impl::Data_<T>("", N * M, d), M_(M), N_(N) {}
+  Array(const std::string& name, int M, int N, T *d) : Impl::Data_<T>(name, N * M, d), M_(M), N_(N) {}
   Array(std::array<int, 2> N, T *d)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)), name_("") {}
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)) {}
   Array(const std::string& name, std::array<int, 2> N, T *d)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)), name_(name) {}
+      : Impl::Data_<T>(name, std::get<0>(N) * std::get<1>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)) {}
 
   // forward construction
   Array(const Array<T, 2> &other) = default;
@@ -182,14 +356,12 @@ public:
     return d_[j + i * N_];
   }
 
-  Array<T, 1> operator[](int i) {
-    assert(0 <= i && i < M_);
-    return Array<T, 1>(name_, N_, &d_[i * N_]);
-  }
+  // non-owning view of row i - no allocation, label copy, or refcount
   Array<T, 1> operator[](int i) const {
     assert(0 <= i && i < M_);
     return Array<T, 1>(name_, N_, &d_[i * N_]);
   }
+  Array<T, 1> subview(int i) const { return (*this)[i]; }
 
   // resize accessor - destructive
   Array<T, 2>& resize(const int M, const int N) {
@@ -207,15 +379,19 @@ public:
 
   std::array<int, 2> dimension() const { return {M_, N_}; }
 
-  // get variable name
-  std::string label() const { return {name_}; }
-
   typedef T value_type;
+  typedef LayoutRight array_layout;
 
 protected:
   int M_, N_;
   using Impl::Data_<T>::d_;
-  std::string name_;
+  using Impl::Data_<T>::name_;
+
+private:
+  template <typename U, size_t E> friend class Array;
+
+  // non-owning view sharing the label of a parent Array
+  Array(const std::string *name, int M, int N, T *d) : Impl::Data_<T>(name, N * M, d), M_(M), N_(N) {}
 };
 
 // 3D specialization
@@ -224,34 +400,34 @@ template <typename T> class Array<T, 3> : public Impl::Data_<T> {
 
 public:
   // forward construction
-  Array(int M, int N, int P) : Impl::Data_<T>(N * M * P), M_(M), N_(N), P_(P), name_("") {}
-  Array(const std::string& name, int M, int N, int P) : Impl::Data_<T>(N * M * P), M_(M), N_(N), P_(P), name_(name) {}
+  Array(int M, int N, int P) : Impl::Data_<T>("", N * M * P), M_(M), N_(N), P_(P) {}
+  Array(const std::string& name, int M, int N, int P) : Impl::Data_<T>(name, N * M * P), M_(M), N_(N), P_(P) {}
   Array(std::array<int, 3> N)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)),
-        P_(std::get<2>(N)), name_("") {}
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N) * std::get<2>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)),
+        P_(std::get<2>(N)) {}
   Array(const std::string& name, std::array<int, 3> N)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)),
-        P_(std::get<2>(N)), name_(name) {}
+      : Impl::Data_<T>(name, std::get<0>(N) * std::get<1>(N) * std::get<2>(N)), M_(std::get<0>(N)), N_(std::get<1>(N)),
+        P_(std::get<2>(N)) {}
 
   // forward construction
-  Array(int M, int N, int P, T t) : Impl::Data_<T>(N * M * P, t), M_(M), N_(N), P_(P), name_("") {}
-  Array(const std::string& name, int M, int N, int P, T t) : Impl::Data_<T>(N * M * P, t), M_(M), N_(N), P_(P), name_(name) {}
+  Array(int M, int N, int P, T t) : Impl::Data_<T>("", N * M * P, t), M_(M), N_(N), P_(P) {}
+  Array(const std::string& name, int M, int N, int P, T t) : Impl::Data_<T>(name, N * M * P, t), M_(M), N_(N), P_(P) {}
   Array(std::array<int, 3> N, T t)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)),
-        P_(std::get<2>(N)), name_("") {}
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N) * std::get<2>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)),
+        P_(std::get<2>(N)) {}
   Array(const std::string& name, std::array<int, 3> N, T t)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)),
-        P_(std::get<2>(N)), name_(name) {}
+      : Impl::Data_<T>(name, std::get<0>(N) * std::get<1>(N) * std::get<2>(N), t), M_(std::get<0>(N)), N_(std::get<1>(N)),
+        P_(std::get<2>(N)) {}
 
   // forward construction
-  Array(int M, int N, int P, T *d) : Impl::Data_<T>(N * M * P, d), M_(M), N_(N), P_(P), name_("") {}
-  Array(const std::string& name, int M, int N, int P, T *d) : Impl::Data_<T>(N * M * P, d), M_(M), N_(N), P_(P), name_(name) {}
+  Array(int M, int N, int P, T *d) : Impl::Data_<T>("", N * M * P, d), M_(M), N_(N), P_(P) {}
+  Array(const std::string& name, int M, int N, int P, T *d) : Impl::Data_<T>(name, N * M * P, d), M_(M), N_(N), P_(P) {}
   Array(std::array<int, 3> N, T *d)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)),
-        P_(std::get<2>(N)), name_("") {}
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N) * std::get<2>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)),
+        P_(std::get<2>(N)) {}
   Array(const std::string& name, std::array<int, 3> N, T *d)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)),
-        P_(std::get<2>(N)), name_(name) {}
+      : Impl::Data_<T>(name, std::get<0>(N) * std::get<1>(N) * std::get<2>(N), d), M_(std::get<0>(N)), N_(std::get<1>(N)),
+        P_(std::get<2>(N)) {}
 
 
   // forward construction
@@ -266,14 +442,12 @@ public:
     return d_[k + P_ * (j + i * N_)];
   }
 
-  Array<T, 2> operator[](int i) {
-    assert(0 <= i && i < M_);
-    return Array<T, 2>(name_, N_, P_, &d_[i * N_ * P_]);
-  }
+  // non-owning view of slab i - no allocation, label copy, or refcount
   Array<T, 2> operator[](int i) const {
     assert(0 <= i && i < M_);
     return Array<T, 2>(name_, N_, P_, &d_[i * N_ * P_]);
   }
+  Array<T, 2> subview(int i) const { return (*this)[i]; }
 
   // resize accessor - destructive
   Array<T, 3>& resize(int M, int N, int P) {
@@ -292,15 +466,20 @@ public:
 
   std::array<int, 3> dimension() const { return {M_, N_, P_}; }
 
-  // get variable name
-  std::string label() const { return {name_}; }
-
   typedef T value_type;
+  typedef LayoutRight array_layout;
 
 protected:
   int M_, N_, P_;
   using Impl::Data_<T>::d_;
-  std::string name_;
+  using Impl::Data_<T>::name_;
+
+private:
+  template <typename U, size_t E> friend class Array;
+
+  // non-owning view sharing the label of a parent Array
+  Array(const std::string *name, int M, int N, int P, T *d)
+      : Impl::Data_<T>(name, N * M * P, d), M_(M), N_(N), P_(P) {}
 };
 
 // 4D specialization
@@ -309,21 +488,21 @@ template <typename T> class Array<T, 4> : public Impl::Data_<T> {
 
 public:
   // forward construction
-  Array(int M, int N, int P, int Q) : Impl::Data_<T>(N * M * P * Q), M_(M), N_(N), P_(P), Q_(Q) {}
+  Array(int M, int N, int P, int Q) : Impl::Data_<T>("", N * M * P * Q), M_(M), N_(N), P_(P), Q_(Q) {}
   Array(std::array<int, 4> N)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N) * std::get<3>(N)), M_(std::get<0>(N)),
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N) * std::get<2>(N) * std::get<3>(N)), M_(std::get<0>(N)),
         N_(std::get<1>(N)), P_(std::get<2>(N)), Q_(std::get<3>(N)) {}
 
   // forward construction
-  Array(int M, int N, int P, int Q, T t) : Impl::Data_<T>(N * M * P * Q, t), M_(M), N_(N), P_(P), Q_(Q) {}
+  Array(int M, int N, int P, int Q, T t) : Impl::Data_<T>("", N * M * P * Q, t), M_(M), N_(N), P_(P), Q_(Q) {}
   Array(std::array<int, 4> N, T t)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N) * std::get<3>(N), t), M_(std::get<0>(N)),
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N) * std::get<2>(N) * std::get<3>(N), t), M_(std::get<0>(N)),
         N_(std::get<1>(N)), P_(std::get<2>(N)), Q_(std::get<3>(N)) {}
 
   // forward construction
-  Array(int M, int N, int P, int Q, T *d) : Impl::Data_<T>(N * M * P * Q, d), M_(M), N_(N), P_(P), Q_(Q) {}
+  Array(int M, int N, int P, int Q, T *d) : Impl::Data_<T>("", N * M * P * Q, d), M_(M), N_(N), P_(P), Q_(Q) {}
   Array(std::array<int, 4> N, T *d)
-      : Impl::Data_<T>(std::get<0>(N) * std::get<1>(N) * std::get<2>(N) * std::get<3>(N), d), M_(std::get<0>(N)),
+      : Impl::Data_<T>("", std::get<0>(N) * std::get<1>(N) * std::get<2>(N) * std::get<3>(N), d), M_(std::get<0>(N)),
         N_(std::get<1>(N)), P_(std::get<2>(N)), Q_(std::get<3>(N)) {}
 
   // forward construction
@@ -338,14 +517,12 @@ public:
     return d_[l + Q_ * (k + P_ * (j + i * N_))];
   }
 
-  Array<T, 3> operator[](int i) {
-    assert(0 <= i && i < M_);
-    return Array<T, 3>(N_, P_, Q_, &d_[i * N_ * P_ * Q_]);
-  }
+  // non-owning view of block i - no allocation, label copy, or refcount
   Array<T, 3> operator[](int i) const {
     assert(0 <= i && i < M_);
-    return Array<T, 3>(N_, P_, Q_, &d_[i * N_ * P_ * Q_]);
+    return Array<T, 3>(name_, N_, P_, Q_, &d_[i * N_ * P_ * Q_]);
   }
+  Array<T, 3> subview(int i) const { return (*this)[i]; }
 
   // resize accessor - destructive
   Array<T, 4>& resize(int M, int N, int P, int Q) {
@@ -365,9 +542,13 @@ public:
 
   std::array<int, 4> dimension() const { return {M_, N_, P_, Q_}; }
 
+  typedef T value_type;
+  typedef LayoutRight array_layout;
+
 protected:
   int M_, N_, P_, Q_;
   using Impl::Data_<T>::d_;
+  using Impl::Data_<T>::name_;
 };
 
 //
@@ -386,6 +567,30 @@ Array<T, D2> reshape(Array<T, D1> &arr_in, const std::array<int, D2> &new_shape)
 }
 
 
+//
+// Non-owning view of the leading-index slice i of arr, the analogue of
+// Kokkos::subview(arr, i, Kokkos::ALL, ...).
+//
+template <typename T, size_t D> Array<T, D - 1> subview(const Array<T, D> &arr, int i) { return arr.subview(i); }
+
+//
+// Unlabelled, non-owning copy of arr - same shape and data, but does not hold
+// a reference to the allocation.  Cheap to copy into functors; arr must
+// outlive it.
+//
+template <typename T> Array<T, 1> unmanaged(const Array<T, 1> &arr) {
+  return Array<T, 1>(arr.extent(0), const_cast<T *>(arr.data()));
+}
+template <typename T> Array<T, 2> unmanaged(const Array<T, 2> &arr) {
+  return Array<T, 2>(arr.extent(0), arr.extent(1), const_cast<T *>(arr.data()));
+}
+template <typename T> Array<T, 3> unmanaged(const Array<T, 3> &arr) {
+  return Array<T, 3>(arr.extent(0), arr.extent(1), arr.extent(2), const_cast<T *>(arr.data()));
+}
+
+// return all cached blocks in the Array memory pool to the system
+inline void release_memory_pool() { Impl::MemoryPool::instance().release(); }
+
 //
 // resize array
 // NOTE, this does not change the Array type or number of dimensions, only the extent of the dimensions!
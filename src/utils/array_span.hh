@@ -0,0 +1,220 @@
+//! Restrict-qualified spans, layout-tagged storage and cell-blocked loops for the host backend
+#ifndef ELM_KERNEL_TEST_ARRAY_SPAN_HH_
+#define ELM_KERNEL_TEST_ARRAY_SPAN_HH_
+
+#include <algorithm>
+#include <array>
+#include <assert.h>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "array.hh"
+
+// no-alias qualifier for raw pointers
+#if defined(__GNUC__) || defined(__clang__)
+#define ELM_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define ELM_RESTRICT __restrict
+#else
+#define ELM_RESTRICT
+#endif
+
+// ask the compiler to vectorize the following loop and to ignore assumed dependencies
+// omp simd when OpenMP (or -fopenmp-simd) is enabled, otherwise the compiler-specific pragma
+#if defined(_OPENMP)
+#define ELM_SIMD _Pragma("omp simd")
+#elif defined(__clang__)
+#define ELM_SIMD _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define ELM_SIMD _Pragma("GCC ivdep")
+#else
+#define ELM_SIMD
+#endif
+
+namespace ELM {
+
+// p is aligned to N bytes - lets the compiler use aligned vector loads
+template <size_t N, typename T> inline T *assume_aligned(T *p) {
+  assert(reinterpret_cast<std::uintptr_t>(p) % N == 0 && "assume_aligned: pointer is not aligned");
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<T *>(__builtin_assume_aligned(p, N));
+#else
+  return p;
+#endif
+}
+
+//
+// Non-owning, restrict-qualified view of D-dimensional data in layout Layout.
+//
+// Spans are trivially copyable (pointer plus extents), carry no label or
+// reference count, and promise the compiler that no other span or pointer
+// used in the same loop aliases the data.  Only build spans over distinct
+// arrays when using them together.
+//
+template <typename T, size_t D, typename Layout = LayoutRight> class Span {
+  static_assert(D >= 1 && D <= 3, "ELM::Span supports 1, 2 or 3 dimensions");
+
+public:
+  Span(T *d, const std::array<int, D> &n) : d_(d), n_(n) {}
+
+  template <typename... Idx> T &operator()(Idx... idx) const {
+    static_assert(sizeof...(Idx) == D, "ELM::Span index count does not match rank");
+    return d_[offset(idx...)];
+  }
+
+  int extent(size_t d) const {
+    assert(d < D && "Span::extent requested for dimension greater than is stored.");
+    return n_[d];
+  }
+  size_t size() const {
+    size_t len = 1;
+    for (const auto &n : n_) {
+      len *= n;
+    }
+    return len;
+  }
+  T *data() const { return d_; }
+
+  typedef T value_type;
+  typedef Layout array_layout;
+
+private:
+  int offset(int i) const { return i; }
+  int offset(int i, int j) const {
+    if constexpr (std::is_same_v<Layout, LayoutLeft>) {
+      return i + n_[0] * j;
+    } else {
+      return j + n_[1] * i;
+    }
+  }
+  int offset(int i, int j, int k) const {
+    if constexpr (std::is_same_v<Layout, LayoutLeft>) {
+      return i + n_[0] * (j + n_[1] * k);
+    } else {
+      return k + n_[2] * (j + n_[1] * i);
+    }
+  }
+
+  T *ELM_RESTRICT d_;
+  std::array<int, D> n_;
+};
+
+// span over the data of an ELM::Array
+template <typename T, size_t D> Span<T, D, LayoutRight> make_span(const Array<T, D> &arr) {
+  return Span<T, D, LayoutRight>(const_cast<T *>(arr.data()), arr.dimension());
+}
+
+//
+// Owning, pooled and aligned D-dimensional storage in layout Layout.
+//
+// LayoutArray<T, 2, LayoutLeft> stores a(cell, lev) with cells contiguous,
+// so a loop over cells at fixed lev is unit stride and vectorizes.  Copies
+// are shallow, like ELM::Array.  Use span() inside loops.
+//
+template <typename T, size_t D, typename Layout = LayoutRight> class LayoutArray {
+public:
+  LayoutArray(const std::string &name, const std::array<int, D> &n) : data_(name, length(n)), n_(n) {}
+  LayoutArray(const std::string &name, const std::array<int, D> &n, T t) : data_(name, length(n), t), n_(n) {}
+
+  template <typename... Idx> T &operator()(Idx... idx) const { return span()(idx...); }
+
+  // owning allocations come from the Array memory pool and are always aligned
+  Span<T, D, Layout> span() const {
+    return Span<T, D, Layout>(assume_aligned<Impl::ARRAY_ALIGNMENT>(const_cast<T *>(data_.data())), n_);
+  }
+
+  int extent(size_t d) const {
+    assert(d < D && "LayoutArray::extent requested for dimension greater than is stored.");
+    return n_[d];
+  }
+  std::array<int, D> dimension() const { return n_; }
+  size_t size() const { return data_.size(); }
+  T *data() const { return const_cast<T *>(data_.data()); }
+  std::string label() const { return data_.label(); }
+
+  typedef T value_type;
+  typedef Layout array_layout;
+
+private:
+  static int length(const std::array<int, D> &n) {
+    int len = 1;
+    for (const auto &d : n) {
+      len *= d;
+    }
+    return len;
+  }
+
+  Array<T, 1> data_;
+  std::array<int, D> n_;
+};
+
+//
+// Copies from a layout-tagged array into an Array-like object, e.g. to move
+// LayoutLeft data back into an ELM::Array.
+//
+template <typename T, typename Layout, typename Array_type>
+void deep_copy(Array_type &arr, const LayoutArray<T, 1, Layout> &arr_in) {
+  assert(arr.extent(0) == arr_in.extent(0));
+  for (int i = 0; i != arr_in.extent(0); ++i) {
+    arr(i) = arr_in(i);
+  }
+}
+
+template <typename T, typename Layout, typename Array_type>
+void deep_copy(Array_type &arr, const LayoutArray<T, 2, Layout> &arr_in) {
+  assert(arr.extent(0) == arr_in.extent(0));
+  assert(arr.extent(1) == arr_in.extent(1));
+  for (int i = 0; i != arr_in.extent(0); ++i) {
+    for (int j = 0; j != arr_in.extent(1); ++j) {
+      arr(i, j) = arr_in(i, j);
+    }
+  }
+}
+
+template <typename T, typename Layout, typename Array_type>
+void deep_copy(Array_type &arr, const LayoutArray<T, 3, Layout> &arr_in) {
+  assert(arr.extent(0) == arr_in.extent(0));
+  assert(arr.extent(1) == arr_in.extent(1));
+  assert(arr.extent(2) == arr_in.extent(2));
+  for (int i = 0; i != arr_in.extent(0); ++i) {
+    for (int j = 0; j != arr_in.extent(1); ++j) {
+      for (int k = 0; k != arr_in.extent(2); ++k) {
+        arr(i, j, k) = arr_in(i, j, k);
+      }
+    }
+  }
+}
+
+//
+// Cell-blocked iteration.
+//
+// for_cell_blocks calls f(begin, end) on consecutive blocks of at most
+// BlockSize cells.  Inside a block, simd_for runs f(i) for each cell under
+// ELM_SIMD, so a per-cell kernel that is inlined into f vectorizes across
+// the cells of the block:
+//
+//   for_cell_blocks(ncells, [&](int begin, int end) {
+//     simd_for(begin, end, [&](int i) { qsat(t(i), p(i), es(i), ...); });
+//   });
+//
+// BlockSize bounds the working set of a block so that the fields it touches
+// stay in L1/L2 across several kernels applied to the same block.
+//
+template <int BlockSize = 256, class F> inline void for_cell_blocks(const int ncells, F &&f) {
+  static_assert(BlockSize > 0, "for_cell_blocks: BlockSize must be positive");
+  for (int begin = 0; begin < ncells; begin += BlockSize) {
+    f(begin, std::min(begin + BlockSize, ncells));
+  }
+}
+
+template <class F> inline void simd_for(const int begin, const int end, F &&f) {
+  ELM_SIMD
+  for (int i = begin; i < end; ++i) {
+    f(i);
+  }
+}
+
+} // namespace ELM
+
+#endif
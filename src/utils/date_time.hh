@@ -1,8 +1,10 @@
 #ifndef ELM_UTILS_DATE_TIME_HH_
 #define ELM_UTILS_DATE_TIME_HH_
 
-#include <iomanip>
+#include <array>
 #include <cassert>
+#include <iomanip>
+#include <tuple>
 
 namespace ELM {
 namespace Utils {
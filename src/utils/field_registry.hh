@@ -0,0 +1,285 @@
+//! Registry of device arrays that are read on the host and transferred as a single packed buffer
+
+#pragma once
+
+#include "Kokkos_Core.hpp"
+#include "profiler.hh"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/*
+Data structs register their device arrays under the name of the file variable that fills them,
+in a named group:
+
+  registry.add("snicar", "ss_alb_bc_mam", ss_alb_bc1);
+
+create_mirrors() then allocates one host and one device buffer that hold every registered variable,
+each at a 64 byte aligned offset, with each group contiguous. host_views() returns name keyed maps of
+unmanaged host views into the host buffer, in the form the file readers (read_pft_data, read_snicar_data,
+etc) expect. copy_to_device() moves the whole buffer (or one group) in a single deep_copy and unpacks it
+into the registered arrays with device-side copies; copy_to_host() is the reverse. Both take an optional
+execution space instance, as the phenology data is updated on its own instance.
+
+Several arrays may register the same variable (the two bc species in SnicarData), the variable is read
+and transferred once and unpacked into each of them.
+
+By default (Storage::separate) the registered arrays keep their own storage - the registry only needs to
+live as long as transfers are needed, host views returned by host_views() are valid as long as the
+registry is.
+
+With Storage::packed, create_mirrors() rebinds every registered array to an unmanaged view of its slot in
+the device buffer and releases the array's own allocation. All of the registered tables then live in one
+contiguous, aligned block that copy_to_device() fills with a single transfer and no unpacking, and arrays
+registered to the same variable share a slot. This is meant for the time-invariant parameter tables:
+- the registry owns the storage and must outlive every copy of the registered arrays
+- create_mirrors() must be called before the arrays are copied anywhere (functors, other structs), copies
+  made earlier keep pointing to the released allocations
+- packed arrays are read-only on the device, copy_to_host() copies the buffer back as is
+*/
+
+namespace ELM {
+
+class FieldRegistry {
+
+public:
+  using ExecSpace = Kokkos::DefaultExecutionSpace;
+  using DeviceBuffer = Kokkos::View<char*, ExecSpace::memory_space>;
+  using HostBuffer = DeviceBuffer::HostMirror;
+
+  // where registered arrays keep their data after create_mirrors()
+  enum class Storage { separate, packed };
+
+  // register array under file variable varname in group
+  // all arrays registered to one varname must have the same value type and extents
+  // view is only rebound (Storage::packed) during create_mirrors()
+  template <typename ViewT>
+  void add(const std::string& group, const std::string& varname, ViewT& view);
+
+  // allocate packed host and device buffers - no add() after this
+  void create_mirrors(const Storage storage = Storage::separate);
+
+  // byte offset of varname in the packed buffers
+  size_t offset(const std::string& varname) const;
+
+  // unmanaged host views of all variables in group with the rank and value type of h_ViewT
+  template <typename h_ViewT>
+  std::map<std::string, h_ViewT> host_views(const std::string& group) const;
+
+  // single host to device transfer of all variables, or of one group, then unpack on device
+  void copy_to_device(const ExecSpace& space = ExecSpace());
+  void copy_to_device(const std::string& group, const ExecSpace& space = ExecSpace());
+
+  // pack on device, then single device to host transfer of one group
+  void copy_to_host(const std::string& group, const ExecSpace& space = ExecSpace());
+
+  // total bytes of packed storage
+  size_t bytes() const { return bytes_; }
+
+private:
+  static constexpr size_t alignment_{64};
+
+  struct Variable {
+    std::string group;
+    std::type_index value_type;
+    size_t rank, bytes, offset;
+    std::array<size_t, 8> extents;
+    // copy from/to the device buffer at offset, into/from each registered array
+    std::vector<std::function<void(const ExecSpace&, const DeviceBuffer&, const size_t&)>> unpack;
+    std::function<void(const ExecSpace&, const DeviceBuffer&, const size_t&)> pack;
+    // point each registered array at the device buffer at offset
+    std::vector<std::function<void(const DeviceBuffer&, const size_t&)>> bind;
+  };
+
+  // [begin, end) byte range of group in the packed buffers
+  std::pair<size_t, size_t> group_range(const std::string& group) const;
+
+  void transfer_to_device(const ExecSpace& space, const size_t& begin, const size_t& end);
+  void transfer_to_host(const ExecSpace& space, const size_t& begin, const size_t& end);
+
+  std::vector<std::string> groups_;
+  std::map<std::string, Variable> vars_;
+  HostBuffer h_buffer_;
+  DeviceBuffer d_buffer_;
+  size_t bytes_{0};
+  bool mirrored_{false};
+  Storage storage_{Storage::separate};
+};
+
+} // namespace ELM
+
+template <typename ViewT>
+void ELM::FieldRegistry::add(const std::string& group, const std::string& varname, ViewT& view)
+{
+  using T = typename ViewT::non_const_value_type;
+  if (mirrored_) {
+    throw std::runtime_error("ELM ERROR: FieldRegistry::add() after create_mirrors() for " + varname);
+  }
+  if (!view.span_is_contiguous()) {
+    throw std::runtime_error("ELM ERROR: FieldRegistry::add() non-contiguous array for " + varname);
+  }
+
+  std::array<size_t, 8> extents{};
+  for (size_t i = 0; i != ViewT::rank; ++i) {
+    extents[i] = view.extent(i);
+  }
+
+  // copy between a device array and the packed buffer at offset
+  const auto unpack = [view](const ExecSpace& space, const DeviceBuffer& buf, const size_t& offset) {
+    ViewT src(reinterpret_cast<T*>(buf.data() + offset), view.layout());
+    Kokkos::deep_copy(space, view, src);
+  };
+  const auto bind = [&view](const DeviceBuffer& buf, const size_t& offset) {
+    view = ViewT(reinterpret_cast<T*>(buf.data() + offset), view.layout());
+  };
+
+  auto itr = vars_.find(varname);
+  if (itr == vars_.end()) {
+    if (std::find(groups_.begin(), groups_.end(), group) == groups_.end()) {
+      groups_.push_back(group);
+    }
+    const auto pack = [view](const ExecSpace& space, const DeviceBuffer& buf, const size_t& offset) {
+      ViewT dst(reinterpret_cast<T*>(buf.data() + offset), view.layout());
+      Kokkos::deep_copy(space, dst, view);
+    };
+    vars_.emplace(varname, Variable{group, std::type_index(typeid(T)), ViewT::rank, view.span() * sizeof(T), 0,
+                                    extents, {unpack}, pack, {bind}});
+  } else {
+    auto& var = itr->second;
+    if (var.group != group || var.value_type != std::type_index(typeid(T)) || var.rank != ViewT::rank ||
+        var.extents != extents) {
+      throw std::runtime_error("ELM ERROR: FieldRegistry::add() mismatched registration for " + varname);
+    }
+    var.unpack.push_back(unpack);
+    var.bind.push_back(bind);
+  }
+}
+
+inline void ELM::FieldRegistry::create_mirrors(const Storage storage)
+{
+  // lay out groups contiguously, in registration order
+  bytes_ = 0;
+  for (const auto& group : groups_) {
+    for (auto& [varname, var] : vars_) {
+      if (var.group == group) {
+        var.offset = bytes_;
+        bytes_ += (var.bytes + alignment_ - 1) / alignment_ * alignment_;
+      }
+    }
+  }
+  h_buffer_ = HostBuffer("FieldRegistry::h_buffer", bytes_);
+  d_buffer_ = DeviceBuffer("FieldRegistry::d_buffer", bytes_);
+  mirrored_ = true;
+  storage_ = storage;
+
+  for (auto& [varname, var] : vars_) {
+    if (storage_ == Storage::packed) {
+      for (const auto& bind : var.bind) {
+        bind(d_buffer_, var.offset);
+      }
+      // unpack and pack hold copies of the original arrays, dropping them releases the allocations
+      var.unpack.clear();
+      var.pack = nullptr;
+    }
+    // the registered references are not used again
+    var.bind.clear();
+  }
+}
+
+inline size_t ELM::FieldRegistry::offset(const std::string& varname) const
+{
+  auto itr = vars_.find(varname);
+  if (itr == vars_.end()) {
+    throw std::runtime_error("ELM ERROR: FieldRegistry has no variable " + varname);
+  }
+  return itr->second.offset;
+}
+
+template <typename h_ViewT>
+std::map<std::string, h_ViewT> ELM::FieldRegistry::host_views(const std::string& group) const
+{
+  using T = typename h_ViewT::non_const_value_type;
+  if (!mirrored_) {
+    throw std::runtime_error("ELM ERROR: FieldRegistry::host_views() before create_mirrors()");
+  }
+
+  std::map<std::string, h_ViewT> views;
+  for (const auto& [varname, var] : vars_) {
+    if (var.group == group && var.rank == h_ViewT::rank && var.value_type == std::type_index(typeid(T))) {
+      typename h_ViewT::array_layout layout(var.extents[0], var.extents[1], var.extents[2], var.extents[3],
+                                            var.extents[4], var.extents[5], var.extents[6], var.extents[7]);
+      views.emplace(varname, h_ViewT(reinterpret_cast<T*>(h_buffer_.data() + var.offset), layout));
+    }
+  }
+  return views;
+}
+
+inline std::pair<size_t, size_t> ELM::FieldRegistry::group_range(const std::string& group) const
+{
+  size_t begin = bytes_, end = 0;
+  for (const auto& [varname, var] : vars_) {
+    if (var.group == group) {
+      begin = std::min(begin, var.offset);
+      end = std::max(end, var.offset + var.bytes);
+    }
+  }
+  if (end == 0) {
+    throw std::runtime_error("ELM ERROR: FieldRegistry has no group " + group);
+  }
+  return {begin, end};
+}
+
+inline void ELM::FieldRegistry::transfer_to_device(const ExecSpace& space, const size_t& begin, const size_t& end)
+{
+  const auto range = std::make_pair(begin, end);
+  Kokkos::deep_copy(space, Kokkos::subview(d_buffer_, range), Kokkos::subview(h_buffer_, range));
+  ELM::Utils::add_bytes("deep_copy", end - begin);
+  if (storage_ == Storage::packed) {
+    return;
+  }
+  for (const auto& [varname, var] : vars_) {
+    if (var.offset >= begin && var.offset < end) {
+      for (const auto& unpack : var.unpack) {
+        unpack(space, d_buffer_, var.offset);
+      }
+    }
+  }
+}
+
+inline void ELM::FieldRegistry::transfer_to_host(const ExecSpace& space, const size_t& begin, const size_t& end)
+{
+  for (const auto& [varname, var] : vars_) {
+    if (storage_ == Storage::separate && var.offset >= begin && var.offset < end) {
+      var.pack(space, d_buffer_, var.offset);
+    }
+  }
+  const auto range = std::make_pair(begin, end);
+  Kokkos::deep_copy(space, Kokkos::subview(h_buffer_, range), Kokkos::subview(d_buffer_, range));
+  ELM::Utils::add_bytes("deep_copy", end - begin);
+}
+
+inline void ELM::FieldRegistry::copy_to_device(const ExecSpace& space)
+{
+  transfer_to_device(space, 0, bytes_);
+}
+
+inline void ELM::FieldRegistry::copy_to_device(const std::string& group, const ExecSpace& space)
+{
+  const auto [begin, end] = group_range(group);
+  transfer_to_device(space, begin, end);
+}
+
+inline void ELM::FieldRegistry::copy_to_host(const std::string& group, const ExecSpace& space)
+{
+  const auto [begin, end] = group_range(group);
+  transfer_to_host(space, begin, end);
+}
@@ -0,0 +1,113 @@
+//! Land-only compaction of the local grid
+#ifndef ELM_LAND_MASK_HH_
+#define ELM_LAND_MASK_HH_
+
+#include <string>
+#include <vector>
+
+#include "array.hh"
+#include "mpi_types.hh"
+#include "read_input.hh"
+#include "utils.hh"
+
+namespace ELM {
+namespace Utils {
+
+//
+// Compact index of the land points in a 2D domain decomposition.
+//
+// Grid points are numbered as everywhere else, g = i * dd.n_local[1] + j.
+// Land points are numbered contiguously c = 0..n_land()-1 in grid order.
+//
+//   grid_idx[c] -- grid point of compute cell c
+//   cell_idx[g] -- compute cell of grid point g, or -1 for non-land points
+//
+// Per-cell arrays are sized n_land(); readers gather land points straight
+// into them and writers scatter back to the full rectangle.
+//
+struct LandMask {
+  std::vector<int> grid_idx;
+  std::vector<int> cell_idx;
+
+  size_t n_land() const { return grid_idx.size(); }
+  size_t n_grid() const { return cell_idx.size(); }
+  bool is_land(size_t g) const { return cell_idx[g] >= 0; }
+};
+
+//
+// Mask that treats every grid point as land - the layout used when no mask is given.
+//
+inline LandMask all_land(const DomainDecomposition<2> &dd) {
+  const size_t n_grid = dd.n_local[0] * dd.n_local[1];
+  LandMask mask;
+  mask.grid_idx.resize(n_grid);
+  mask.cell_idx.resize(n_grid);
+  for (size_t g = 0; g != n_grid; ++g) {
+    mask.grid_idx[g] = static_cast<int>(g);
+    mask.cell_idx[g] = static_cast<int>(g);
+  }
+  return mask;
+}
+
+//
+// Build a mask from a field laid out as arr(i, j) over the local rectangle.
+// Points with arr(i, j) > threshold are land.
+//
+template <class Array_t>
+inline LandMask create_land_mask(const DomainDecomposition<2> &dd, const Array_t &arr, double threshold = 0.0) {
+  LandMask mask;
+  mask.cell_idx.assign(dd.n_local[0] * dd.n_local[1], -1);
+  for (int i = 0; i != static_cast<int>(dd.n_local[0]); ++i) {
+    for (int j = 0; j != static_cast<int>(dd.n_local[1]); ++j) {
+      const int g = i * dd.n_local[1] + j;
+      if (arr(i, j) > threshold) {
+        mask.cell_idx[g] = static_cast<int>(mask.grid_idx.size());
+        mask.grid_idx.push_back(g);
+      }
+    }
+  }
+  return mask;
+}
+
+} // namespace Utils
+
+namespace IO {
+
+//
+// Read a land mask from surface data.
+//
+// varname is a (lsmlat, lsmlon) field, e.g. "LANDFRAC_PFT" or "PFTDATA_MASK";
+// points with a value > threshold are land.
+//
+inline Utils::LandMask read_land_mask(const Utils::DomainDecomposition<2> &dd, const std::string &filename,
+                                      const std::string &varname = "PFTDATA_MASK", double threshold = 0.0) {
+  std::array<GO, 2> start = {dd.start[0], dd.start[1]};
+  std::array<GO, 2> count = {dd.n_local[0], dd.n_local[1]};
+  Array<double, 2> arr_for_read(dd.n_local[0], dd.n_local[1]);
+  read_netcdf(dd.comm, filename, varname, start, count, arr_for_read.data());
+  return Utils::create_land_mask(dd, arr_for_read, threshold);
+}
+
+//
+// Writers by land cell
+// -----------------------------------------------------------------------------
+
+//
+// Assumes shape(arr) == { N_LAND_CELLS_LOCAL }; non-land points are written as fill.
+//
+template <typename Array_t>
+inline void reshape_and_write_grid_cell(const std::string &filename, const std::string &varname,
+                                        const Utils::DomainDecomposition<2> &dd, const Utils::LandMask &mask,
+                                        const Array_t &arr, double fill = 1.e36) {
+  Array<double, 2> arr_for_write(dd.n_local[0], dd.n_local[1], fill);
+  for (size_t c = 0; c != mask.n_land(); ++c) {
+    const int g = mask.grid_idx[c];
+    arr_for_write(g / dd.n_local[1], g % dd.n_local[1]) = arr[c];
+  }
+  write<2>(filename, varname, dd, arr_for_write);
+}
+
+} // namespace IO
+} // namespace ELM
+
+#endif
@@ -0,0 +1,351 @@
+#include "profiler.hh"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+
+namespace ELM {
+namespace Utils {
+
+Profiler::Profiler() { reset(); }
+
+Profiler &Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+void Profiler::set_hooks(hook_type push, hook_type pop) {
+  push_hook_ = std::move(push);
+  pop_hook_ = std::move(pop);
+}
+
+void Profiler::start(const std::string &name) {
+  if (!enabled()) {
+    return;
+  }
+  auto &node = nodes_[current_];
+  auto itr = node.children.find(name);
+  int child;
+  if (itr == node.children.end()) {
+    child = static_cast<int>(nodes_.size());
+    nodes_[current_].children[name] = child;
+    nodes_.push_back(Node{name, current_});
+  } else {
+    child = itr->second;
+  }
+  current_ = child;
+  if (push_hook_) {
+    push_hook_(name);
+  }
+  stack_.emplace_back(child, clock_type::now());
+}
+
+void Profiler::stop() {
+  if (std::this_thread::get_id() != owner_ || stack_.empty()) {
+    return;
+  }
+  if (fence_) {
+    fence_();
+  }
+  const auto [node, t0] = stack_.back();
+  const std::chrono::duration<double> elapsed = clock_type::now() - t0;
+  stack_.pop_back();
+  nodes_[node].count += 1;
+  nodes_[node].inclusive += elapsed.count();
+  current_ = nodes_[node].parent;
+  if (pop_hook_) {
+    pop_hook_(nodes_[node].name);
+  }
+}
+
+void Profiler::add_bytes(const std::string &counter, double nbytes) {
+  if (enabled()) {
+    nodes_[current_].bytes[counter] += nbytes;
+  }
+}
+
+void Profiler::add_count(const std::string &counter, double n) {
+  if (enabled()) {
+    nodes_[current_].counts[counter] += n;
+  }
+}
+
+void Profiler::reset() {
+  nodes_.clear();
+  stack_.clear();
+  nodes_.push_back(Node{"root", -1});
+  current_ = 0;
+}
+
+double Profiler::exclusive(int node) const {
+  double t = nodes_[node].inclusive;
+  for (const auto &[name, child] : nodes_[node].children) {
+    t -= nodes_[child].inclusive;
+  }
+  return std::max(t, 0.0);
+}
+
+namespace {
+
+// depth-first walk of the region tree, skipping the root
+template <typename F> void walk(const std::vector<Profiler::Node> &nodes, int node, int depth, F &&f) {
+  if (node != 0) {
+    f(node, depth);
+  }
+  for (const auto &[name, child] : nodes[node].children) {
+    walk(nodes, child, node == 0 ? 0 : depth + 1, f);
+  }
+}
+
+void write_table(std::ostream &os, const std::vector<Profiler::Node> &nodes, const std::vector<double> &incl,
+                 const std::vector<double> &excl, const std::vector<double> *incl_min,
+                 const std::vector<double> *incl_max) {
+  os << std::left << std::setw(48) << "region" << std::right << std::setw(10) << "count" << std::setw(14)
+     << "incl [s]" << std::setw(14) << "excl [s]";
+  if (incl_min) {
+    os << std::setw(14) << "incl min" << std::setw(14) << "incl max";
+  }
+  os << "  counters\n";
+
+  walk(nodes, 0, 0, [&](int n, int depth) {
+    os << std::left << std::setw(48) << (std::string(2 * depth, ' ') + nodes[n].name) << std::right
+       << std::setw(10) << nodes[n].count << std::setw(14) << std::scientific << std::setprecision(4) << incl[n]
+       << std::setw(14) << excl[n];
+    if (incl_min) {
+      os << std::setw(14) << (*incl_min)[n] << std::setw(14) << (*incl_max)[n];
+    }
+    os << std::defaultfloat;
+    for (const auto &[counter, nbytes] : nodes[n].bytes) {
+      os << "  " << counter << "=" << nbytes;
+    }
+    for (const auto &[counter, count] : nodes[n].counts) {
+      os << "  " << counter << "=" << count;
+    }
+    os << '\n';
+  });
+}
+
+// s as a quoted JSON string
+void write_json_string(std::ostream &os, const std::string &s) {
+  os << '"';
+  for (const char c : s) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      const char *hex = "0123456789abcdef";
+      os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+void write_json(std::ostream &os, const std::vector<Profiler::Node> &nodes, int node, const std::vector<double> &incl,
+                const std::vector<double> &excl, const std::vector<double> *incl_min,
+                const std::vector<double> *incl_max) {
+  os << "{\"name\":";
+  write_json_string(os, nodes[node].name);
+  os << ",\"count\":" << nodes[node].count << ",\"inclusive\":" << incl[node] << ",\"exclusive\":" << excl[node];
+  if (incl_min) {
+    os << ",\"inclusive_min\":" << (*incl_min)[node] << ",\"inclusive_max\":" << (*incl_max)[node];
+  }
+  os << ",\"bytes\":{";
+  bool first = true;
+  for (const auto &[counter, nbytes] : nodes[node].bytes) {
+    os << (first ? "" : ",");
+    write_json_string(os, counter);
+    os << ":" << nbytes;
+    first = false;
+  }
+  os << "},\"counts\":{";
+  first = true;
+  for (const auto &[counter, count] : nodes[node].counts) {
+    os << (first ? "" : ",");
+    write_json_string(os, counter);
+    os << ":" << count;
+    first = false;
+  }
+  os << "},\"children\":[";
+  first = true;
+  for (const auto &[name, child] : nodes[node].children) {
+    os << (first ? "" : ",");
+    write_json(os, nodes, child, incl, excl, incl_min, incl_max);
+    first = false;
+  }
+  os << "]}";
+}
+
+} // namespace
+
+void Profiler::report(std::ostream &os) const {
+  std::vector<double> incl(nodes_.size()), excl(nodes_.size());
+  for (size_t n = 0; n != nodes_.size(); ++n) {
+    incl[n] = nodes_[n].inclusive;
+    excl[n] = exclusive(n);
+  }
+  write_table(os, nodes_, incl, excl, nullptr, nullptr);
+}
+
+void Profiler::report_json(std::ostream &os) const {
+  std::vector<double> incl(nodes_.size()), excl(nodes_.size());
+  for (size_t n = 0; n != nodes_.size(); ++n) {
+    incl[n] = nodes_[n].inclusive;
+    excl[n] = exclusive(n);
+  }
+  write_json(os, nodes_, 0, incl, excl, nullptr, nullptr);
+  os << '\n';
+}
+
+#ifdef HAVE_MPI
+
+namespace {
+
+// separators of the serialized region paths - between the names of a path, and after each path
+constexpr char name_sep = '\x1f';
+constexpr char path_sep = '\x1e';
+
+// region trees of every rank merged by region path, reduced to rank 0
+struct MergedTimes {
+  // union of the region trees, with the maximum count across ranks and the counters of rank 0
+  std::vector<Profiler::Node> nodes;
+  // inclusive mean, min and max, and exclusive mean across the ranks that have the region
+  std::vector<double> mean, excl, min, max;
+};
+
+// path of each node from the root, "" for the root
+std::vector<std::string> node_paths(const std::vector<Profiler::Node> &nodes) {
+  std::vector<std::string> paths(nodes.size());
+  walk(nodes, 0, 0, [&](int n, int) {
+    const int parent = nodes[n].parent;
+    paths[n] = parent == 0 ? nodes[n].name : paths[parent] + name_sep + nodes[n].name;
+  });
+  return paths;
+}
+
+// regions are matched by path, so ranks may create them in any order and need not all have the same regions
+// the result is only complete on rank 0
+MergedTimes reduce_times(const MPI_Comm &comm, const Profiler &prof) {
+  int rank, numprocs;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &numprocs);
+  const auto &nodes = prof.nodes();
+  const auto paths = node_paths(nodes);
+
+  // union of the paths of all ranks, sorted, so every parent precedes its children
+  std::string local;
+  for (size_t n = 1; n != paths.size(); ++n) {
+    local += paths[n] + path_sep;
+  }
+  const int local_len = static_cast<int>(local.size());
+  std::vector<int> lens(numprocs), displs(numprocs);
+  MPI_Gather(&local_len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, comm);
+  int total = 0;
+  for (int r = 0; r != numprocs; ++r) {
+    displs[r] = total;
+    total += lens[r];
+  }
+  std::string all(rank == 0 ? total : 0, '\0');
+  MPI_Gatherv(local.data(), local_len, MPI_CHAR, all.data(), lens.data(), displs.data(), MPI_CHAR, 0, comm);
+
+  std::string merged;
+  if (rank == 0) {
+    std::set<std::string> unique;
+    for (size_t begin = 0, end; (end = all.find(path_sep, begin)) != std::string::npos; begin = end + 1) {
+      unique.insert(all.substr(begin, end - begin));
+    }
+    for (const auto &path : unique) {
+      merged += path + path_sep;
+    }
+  }
+  int merged_len = static_cast<int>(merged.size());
+  MPI_Bcast(&merged_len, 1, MPI_INT, 0, comm);
+  merged.resize(merged_len);
+  MPI_Bcast(merged.data(), merged_len, MPI_CHAR, 0, comm);
+
+  // merged tree, identical on every rank
+  MergedTimes result;
+  result.nodes.push_back(Profiler::Node{"root", -1});
+  std::map<std::string, int> index{{"", 0}};
+  for (size_t begin = 0, end; (end = merged.find(path_sep, begin)) != std::string::npos; begin = end + 1) {
+    const std::string path = merged.substr(begin, end - begin);
+    const size_t split = path.rfind(name_sep);
+    const int parent = index.at(split == std::string::npos ? "" : path.substr(0, split));
+    const std::string name = split == std::string::npos ? path : path.substr(split + 1);
+    const int node = static_cast<int>(result.nodes.size());
+    result.nodes.push_back(Profiler::Node{name, parent});
+    result.nodes[parent].children[name] = node;
+    index[path] = node;
+  }
+
+  // local times by merged node, regions this rank doesn't have don't contribute
+  const size_t n_merged = result.nodes.size();
+  std::vector<double> incl(n_merged, 0.0), excl(n_merged, 0.0), min(n_merged, std::numeric_limits<double>::max()),
+      max(n_merged, 0.0), have(n_merged, 0.0);
+  std::vector<long> count(n_merged, 0);
+  std::vector<int> local_node(n_merged, -1);
+  for (size_t n = 0; n != nodes.size(); ++n) {
+    const int m = index.at(paths[n]);
+    local_node[m] = static_cast<int>(n);
+    incl[m] = min[m] = max[m] = nodes[n].inclusive;
+    excl[m] = prof.exclusive(n);
+    count[m] = nodes[n].count;
+    have[m] = 1.0;
+  }
+
+  const int len = static_cast<int>(n_merged);
+  result.mean.resize(n_merged);
+  result.excl.resize(n_merged);
+  result.min.resize(n_merged);
+  result.max.resize(n_merged);
+  std::vector<double> nranks(n_merged);
+  std::vector<long> max_count(n_merged);
+  MPI_Reduce(incl.data(), result.mean.data(), len, MPI_DOUBLE, MPI_SUM, 0, comm);
+  MPI_Reduce(excl.data(), result.excl.data(), len, MPI_DOUBLE, MPI_SUM, 0, comm);
+  MPI_Reduce(min.data(), result.min.data(), len, MPI_DOUBLE, MPI_MIN, 0, comm);
+  MPI_Reduce(max.data(), result.max.data(), len, MPI_DOUBLE, MPI_MAX, 0, comm);
+  MPI_Reduce(have.data(), nranks.data(), len, MPI_DOUBLE, MPI_SUM, 0, comm);
+  MPI_Reduce(count.data(), max_count.data(), len, MPI_LONG, MPI_MAX, 0, comm);
+
+  if (rank == 0) {
+    for (size_t m = 0; m != n_merged; ++m) {
+      result.mean[m] /= nranks[m];
+      result.excl[m] /= nranks[m];
+      auto &node = result.nodes[m];
+      node.count = max_count[m];
+      if (local_node[m] >= 0) {
+        node.bytes = nodes[local_node[m]].bytes;
+        node.counts = nodes[local_node[m]].counts;
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+void Profiler::report(const MPI_Comm &comm, std::ostream &os) const {
+  const auto merged = reduce_times(comm, *this);
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0) {
+    write_table(os, merged.nodes, merged.mean, merged.excl, &merged.min, &merged.max);
+  }
+}
+
+void Profiler::report_json(const MPI_Comm &comm, std::ostream &os) const {
+  const auto merged = reduce_times(comm, *this);
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0) {
+    write_json(os, merged.nodes, 0, merged.mean, merged.excl, &merged.min, &merged.max);
+    os << '\n';
+  }
+}
+
+#endif
+
+} // namespace Utils
+} // namespace ELM
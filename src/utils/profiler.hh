@@ -0,0 +1,146 @@
+//! Hierarchical region timers and counters
+#ifndef ELM_PROFILER_HH_
+#define ELM_PROFILER_HH_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mpi_types.hh"
+
+namespace ELM {
+namespace Utils {
+
+//
+// Region profiler.
+//
+// Regions nest: start("a"); start("b"); stop(); stop(); records b as a child
+// of a.  Each node of the call tree keeps a call count, inclusive time,
+// named byte counters (e.g. "read", "deep_copy") and named event counters
+// (e.g. "skipped" cells of an incremental stage).  Exclusive time is
+// inclusive time less the inclusive time of the children.
+//
+// The profiler is off by default and start/stop are a single branch when
+// off.  External tools (Kokkos Tools) can be attached with set_hooks, which
+// are called with the region name on every start/stop.  With asynchronous
+// backends set_fence supplies a barrier that is called before a region is
+// stopped, so device work is charged to the region that launched it.
+//
+// The region tree is not locked - only the thread that last called
+// set_enabled records, calls from any other thread (e.g. a background file
+// read) are ignored, as if the profiler were off.
+//
+class Profiler {
+public:
+  using clock_type = std::chrono::steady_clock;
+  using hook_type = std::function<void(const std::string &)>;
+
+  struct Node {
+    std::string name{};
+    int parent{-1};
+    std::map<std::string, int> children{};
+    long count{0};
+    double inclusive{0.0};
+    std::map<std::string, double> bytes{};
+    std::map<std::string, double> counts{};
+  };
+
+  static Profiler &instance();
+
+  // true when enabled and called from the recording thread
+  bool enabled() const { return enabled_ && std::this_thread::get_id() == owner_; }
+  void set_enabled(bool enabled) {
+    owner_ = std::this_thread::get_id();
+    enabled_ = enabled;
+  }
+
+  // call push on region start and pop on region stop, e.g. Kokkos::Profiling::pushRegion/popRegion
+  void set_hooks(hook_type push, hook_type pop);
+
+  // called before the clock is read in stop(), e.g. Kokkos::fence
+  void set_fence(std::function<void()> fence) { fence_ = std::move(fence); }
+
+  void start(const std::string &name);
+  void stop();
+
+  // attribute nbytes of traffic of kind counter to the current region
+  void add_bytes(const std::string &counter, double nbytes);
+
+  // add n events of kind counter to the current region
+  void add_count(const std::string &counter, double n);
+
+  // discard all timings
+  void reset();
+
+  // inclusive time less child inclusive time
+  double exclusive(int node) const;
+
+  const std::vector<Node> &nodes() const { return nodes_; }
+
+  // text table and JSON tree of the local timings
+  void report(std::ostream &os) const;
+  void report_json(std::ostream &os) const;
+
+#ifdef HAVE_MPI
+  // min/max/mean across ranks of inclusive and exclusive time, written by rank 0
+  // regions are matched by path, a region missing on some ranks is reduced over the ranks that have it
+  // counts are the maximum across ranks, byte and event counters those of rank 0
+  void report(const MPI_Comm &comm, std::ostream &os) const;
+  void report_json(const MPI_Comm &comm, std::ostream &os) const;
+#endif
+
+private:
+  Profiler();
+
+  std::atomic<bool> enabled_{false};
+  std::thread::id owner_;
+  std::vector<Node> nodes_;
+  std::vector<std::pair<int, clock_type::time_point>> stack_;
+  int current_{0};
+  hook_type push_hook_, pop_hook_;
+  std::function<void()> fence_;
+};
+
+//
+// RAII region - starts on construction, stops on destruction.
+//
+class ScopedRegion {
+public:
+  explicit ScopedRegion(const std::string &name) : active_(Profiler::instance().enabled()) {
+    if (active_) {
+      Profiler::instance().start(name);
+    }
+  }
+  ~ScopedRegion() {
+    if (active_) {
+      Profiler::instance().stop();
+    }
+  }
+  ScopedRegion(const ScopedRegion &) = delete;
+  ScopedRegion &operator=(const ScopedRegion &) = delete;
+
+private:
+  bool active_;
+};
+
+inline void add_bytes(const std::string &counter, double nbytes) {
+  if (Profiler::instance().enabled()) {
+    Profiler::instance().add_bytes(counter, nbytes);
+  }
+}
+
+inline void add_count(const std::string &counter, double n) {
+  if (Profiler::instance().enabled()) {
+    Profiler::instance().add_count(counter, n);
+  }
+}
+
+} // namespace Utils
+} // namespace ELM
+
+#endif
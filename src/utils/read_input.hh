@@ -132,6 +132,15 @@ template <typename Array_t>
 inline void reshape_and_write_grid_cell(const std::string &filename, const std::string &varname,
                                         const Utils::DomainDecomposition<2> &dd, const Array_t &arr);
 
+//
+// Assumes shape(arr) == shape(inv) == { N_GRID_CELLS_LOCAL }, with arr stored in a
+// permuted cell order and inv(g) the position in arr of grid-order cell g
+//
+template <typename Array_t, typename Index_t>
+inline void reshape_and_write_grid_cell(const std::string &filename, const std::string &varname,
+                                        const Utils::DomainDecomposition<2> &dd, const Array_t &arr,
+                                        const Index_t &inv);
+
 //
 // IMPLEMENTATION
 //
@@ -308,6 +317,23 @@ inline void reshape_and_write_grid_cell(const std::string &filename, const std::
   write<2>(filename, varname, dd, arr_for_write);
 }
 
+//
+// Assumes shape(arr) == shape(inv) == { N_GRID_CELLS_LOCAL }, with arr stored in a
+// permuted cell order and inv(g) the position in arr of grid-order cell g
+//
+template <typename Array_t, typename Index_t>
+inline void reshape_and_write_grid_cell(const std::string &filename, const std::string &varname,
+                                        const Utils::DomainDecomposition<2> &dd, const Array_t &arr,
+                                        const Index_t &inv) {
+  Array<double, 2> arr_for_write(dd.n_local[0], dd.n_local[1]);
+  for (int i = 0; i != dd.n_local[0]; ++i) {
+    for (int j = 0; j != dd.n_local[1]; ++j) {
+      arr_for_write(i, j) = arr[inv[i * dd.n_local[1] + j]];
+    }
+  }
+  write<2>(filename, varname, dd, arr_for_write);
+}
+
 } // namespace IO
 } // namespace ELM
 
@@ -9,12 +9,15 @@
 // in this file.
 
 #include <array>
+#include <functional>
 #include <iostream>
+#include <numeric>
 #include <string>
 
 #include "array.hh"
 #include "mpi_types.hh"
 #include "netcdf.h"
+#include "profiler.hh"
 #include "utils.hh"
 
 #define NC_HANDLE_ERROR(status, what)                                                                                  \
@@ -152,6 +155,9 @@ inline void read(const Comm_type &comm, const std::string &filename, const std::
 template <size_t D>
 inline void read(const Comm_type &comm, const std::string &filename, const std::string &varname,
                  const std::array<size_t, D> &start, const std::array<size_t, D> &count, double *arr) {
+  Utils::ScopedRegion region("IO::read " + varname);
+  Utils::add_bytes("read", sizeof(double) * std::accumulate(count.begin(), count.end(), 1.0, std::multiplies<double>()));
+
   int nc_id = -1;
   auto status = nc_open(filename.c_str(), NC_NOWRITE, &nc_id);
   error(status, "nc_open", filename);
@@ -173,6 +179,9 @@ inline void read(const Comm_type &comm, const std::string &filename, const std::
 template <size_t D>
 inline void read(const Comm_type &comm, const std::string &filename, const std::string &varname,
                  const std::array<size_t, D> &start, const std::array<size_t, D> &count, int *arr) {
+  Utils::ScopedRegion region("IO::read " + varname);
+  Utils::add_bytes("read", sizeof(int) * std::accumulate(count.begin(), count.end(), 1.0, std::multiplies<double>()));
+
   int nc_id = -1;
   auto status = nc_open(filename.c_str(), NC_NOWRITE, &nc_id);
   error(status, "nc_open", filename);
@@ -194,6 +203,9 @@ inline void read(const Comm_type &comm, const std::string &filename, const std::
 template <size_t D>
 inline void read(const Comm_type &comm, const std::string &filename, const std::string &varname,
                            const std::array<size_t, D> &start, const std::array<size_t, D> &count, char data[]) {
+  Utils::ScopedRegion region("IO::read " + varname);
+  Utils::add_bytes("read", sizeof(char) * std::accumulate(count.begin(), count.end(), 1.0, std::multiplies<double>()));
+
   int nc_id = -1;
   auto status = nc_open(filename.c_str(), NC_NOWRITE, &nc_id);
   error(status, "nc_open", filename);
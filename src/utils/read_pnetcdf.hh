@@ -6,12 +6,15 @@
 //
 
 #include <array>
+#include <functional>
 #include <iostream>
+#include <numeric>
 #include <string>
 
 #include "array.hh"
 #include "mpi.h"
 #include "pnetcdf.h"
+#include "profiler.hh"
 #include "utils.hh"
 
 #define NC_HANDLE_ERROR(status, what)                                                                                  \
@@ -151,6 +154,9 @@ inline std::array<int, D> get_var_dimids(const MPI_Comm &comm, const std::string
 template <size_t D>
 inline void read(const MPI_Comm &comm, const std::string &filename, const std::string &varname,
                  const std::array<MPI_Offset, D> &start, const std::array<MPI_Offset, D> &count, double *arr) {
+  Utils::ScopedRegion region("IO::read " + varname);
+  Utils::add_bytes("read", sizeof(double) * std::accumulate(count.begin(), count.end(), 1.0, std::multiplies<double>()));
+
   int nc_id = -1;
   MPI_Info info;
   MPI_Info_create(&info);
@@ -4,6 +4,10 @@
 
 #include <iostream>
 #include <iterator>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
 #include <assert.h>
 
 #include "array.hh"
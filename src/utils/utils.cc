@@ -1,5 +1,8 @@
 #include "utils.hh"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <numeric>
 
 namespace ELM {
 namespace Utils {
@@ -67,6 +70,214 @@ DomainDecomposition<2> create_domain_decomposition_2D(std::array<int, 2> n_procs
   return d;
 }
 
+namespace {
+
+// recursively bisect the rectangle held in dd (start, n_local) across
+// nprocs ranks, starting at rank p0
+void rcb_bisect(const DomainDecomposition<2> &dd, int p0, int nprocs, const std::vector<double> &weights,
+                std::vector<DomainDecomposition<2>> &parts) {
+  if (nprocs == 1) {
+    parts[p0].start = dd.start;
+    parts[p0].n_local = dd.n_local;
+    return;
+  }
+
+  // cut across the longer side, unless it cannot be split
+  int axis = dd.n_local[0] >= dd.n_local[1] ? 0 : 1;
+  if (dd.n_local[axis] < 2) {
+    axis = 1 - axis;
+  }
+
+  const int n_left = nprocs / 2;
+  DomainDecomposition<2> left(dd), right(dd);
+
+  if (dd.n_local[axis] < 2) {
+    // a single cell - the left half keeps it, the right half is empty
+    right.n_local = {0, 0};
+  } else {
+    // cost of each line perpendicular to the cut axis
+    const int other = 1 - axis;
+    std::vector<double> line_cost(dd.n_local[axis], 0.0);
+    for (GO a = 0; a != dd.n_local[axis]; ++a) {
+      for (GO b = 0; b != dd.n_local[other]; ++b) {
+        const GO i = (axis == 0 ? a : b) + dd.start[0];
+        const GO j = (axis == 0 ? b : a) + dd.start[1];
+        line_cost[a] += weights[i * dd.n_global[1] + j];
+      }
+    }
+
+    const double total = std::accumulate(line_cost.begin(), line_cost.end(), 0.0);
+    const double frac = static_cast<double>(n_left) / nprocs;
+
+    // choose the cut that best matches the cost share of the left ranks
+    // with no cost information, cut by area
+    GO cut = std::max<GO>(1, std::min<GO>(dd.n_local[axis] - 1, std::lround(frac * dd.n_local[axis])));
+    if (total > 0.0) {
+      const double target = frac * total;
+      double prefix = line_cost[0];
+      double best = std::abs(prefix - target);
+      cut = 1;
+      for (GO c = 2; c < dd.n_local[axis]; ++c) {
+        prefix += line_cost[c - 1];
+        if (std::abs(prefix - target) < best) {
+          best = std::abs(prefix - target);
+          cut = c;
+        }
+      }
+    }
+
+    left.n_local[axis] = cut;
+    right.start[axis] = dd.start[axis] + cut;
+    right.n_local[axis] = dd.n_local[axis] - cut;
+  }
+
+  rcb_bisect(left, p0, n_left, weights, parts);
+  rcb_bisect(right, p0 + n_left, nprocs - n_left, weights, parts);
+}
+
+// overlap of two rectangles, as {start, count}
+std::array<std::array<GO, 2>, 2> intersect(const DomainDecomposition<2> &a, const DomainDecomposition<2> &b) {
+  std::array<std::array<GO, 2>, 2> ov;
+  for (int d = 0; d != 2; ++d) {
+    const GO lo = std::max(a.start[d], b.start[d]);
+    const GO hi = std::min(a.start[d] + a.n_local[d], b.start[d] + b.n_local[d]);
+    ov[0][d] = lo;
+    ov[1][d] = hi > lo ? hi - lo : 0;
+  }
+  return ov;
+}
+
+} // namespace
+
+std::vector<DomainDecomposition<2>> rcb_partition(int nprocs, std::array<GO, 2> n_global,
+                                                  const std::vector<double> &weights) {
+  assert(weights.size() == n_global[0] * n_global[1] && "rcb_partition: weights must cover the global grid");
+
+  DomainDecomposition<2> whole;
+  whole.n_procs = {nprocs, 1};
+  whole.n_global = n_global;
+  whole.start = {0, 0};
+  whole.n_local = n_global;
+
+  std::vector<DomainDecomposition<2>> parts(nprocs, whole);
+  for (int p = 0; p != nprocs; ++p) {
+    parts[p].proc_index = {p, 0};
+  }
+  rcb_bisect(whole, 0, nprocs, weights, parts);
+  return parts;
+}
+
+DomainDecomposition<2> create_domain_decomposition_2D_weighted(int nprocs, std::array<GO, 2> n_global, int rank,
+                                                               const std::vector<double> &weights) {
+  return rcb_partition(nprocs, n_global, weights)[rank];
+}
+
+std::vector<double> gather_cell_costs(const DomainDecomposition<2> &dd, const std::vector<double> &local_costs,
+                                      double elapsed) {
+  assert(local_costs.size() == static_cast<size_t>(dd.n_local[0] * dd.n_local[1]) &&
+         "gather_cell_costs: one cost per local cell required");
+
+  std::vector<double> costs(local_costs);
+  const double local_sum = std::accumulate(costs.begin(), costs.end(), 0.0);
+  if (elapsed > 0.0 && local_sum > 0.0) {
+    for (auto &c : costs) {
+      c *= elapsed / local_sum;
+    }
+  }
+
+  std::vector<double> global_costs(dd.n_global[0] * dd.n_global[1], 0.0);
+  for (GO i = 0; i != dd.n_local[0]; ++i) {
+    for (GO j = 0; j != dd.n_local[1]; ++j) {
+      global_costs[(dd.start[0] + i) * dd.n_global[1] + dd.start[1] + j] = costs[i * dd.n_local[1] + j];
+    }
+  }
+
+#ifdef HAVE_MPI
+  // rectangles are disjoint, so a sum assembles the map
+  MPI_Allreduce(MPI_IN_PLACE, global_costs.data(), static_cast<int>(global_costs.size()), MPI_DOUBLE, MPI_SUM,
+                dd.comm);
+#endif
+  return global_costs;
+}
+
+std::vector<double> migrate_cells(const DomainDecomposition<2> &old_dd, const DomainDecomposition<2> &new_dd,
+                                  const std::vector<double> &data, int nfields) {
+  assert(data.size() == old_dd.n_local[0] * old_dd.n_local[1] * nfields &&
+         "migrate_cells: data must hold nfields values per local cell");
+
+  std::vector<double> new_data(new_dd.n_local[0] * new_dd.n_local[1] * nfields, 0.0);
+
+  // copy the overlap of src_dd (laid out in src) into dst_dd (laid out in dst)
+  auto copy_overlap = [nfields](const DomainDecomposition<2> &src_dd, const DomainDecomposition<2> &dst_dd,
+                                const double *src, double *dst) {
+    const auto ov = intersect(src_dd, dst_dd);
+    for (GO i = ov[0][0]; i != ov[0][0] + ov[1][0]; ++i) {
+      for (GO j = ov[0][1]; j != ov[0][1] + ov[1][1]; ++j) {
+        const GO s = (i - src_dd.start[0]) * src_dd.n_local[1] + j - src_dd.start[1];
+        const GO d = (i - dst_dd.start[0]) * dst_dd.n_local[1] + j - dst_dd.start[1];
+        std::copy_n(src + s * nfields, nfields, dst + d * nfields);
+      }
+    }
+  };
+
+#ifdef HAVE_MPI
+  int nprocs, rank;
+  MPI_Comm_size(old_dd.comm, &nprocs);
+  MPI_Comm_rank(old_dd.comm, &rank);
+
+  // everyone needs every rank's old and new rectangle
+  std::array<long long, 8> mine = {(long long)old_dd.start[0], (long long)old_dd.start[1],
+                                   (long long)old_dd.n_local[0], (long long)old_dd.n_local[1],
+                                   (long long)new_dd.start[0], (long long)new_dd.start[1],
+                                   (long long)new_dd.n_local[0], (long long)new_dd.n_local[1]};
+  std::vector<long long> all(8 * nprocs);
+  MPI_Allgather(mine.data(), 8, MPI_LONG_LONG, all.data(), 8, MPI_LONG_LONG, old_dd.comm);
+
+  std::vector<DomainDecomposition<2>> old_parts(nprocs, old_dd), new_parts(nprocs, new_dd);
+  for (int p = 0; p != nprocs; ++p) {
+    old_parts[p].start = {(GO)all[8 * p], (GO)all[8 * p + 1]};
+    old_parts[p].n_local = {(GO)all[8 * p + 2], (GO)all[8 * p + 3]};
+    new_parts[p].start = {(GO)all[8 * p + 4], (GO)all[8 * p + 5]};
+    new_parts[p].n_local = {(GO)all[8 * p + 6], (GO)all[8 * p + 7]};
+  }
+
+  // pack each outgoing overlap in row-major order of the overlap rectangle
+  std::vector<int> send_counts(nprocs), send_displs(nprocs), recv_counts(nprocs), recv_displs(nprocs);
+  for (int p = 0; p != nprocs; ++p) {
+    const auto ov_send = intersect(old_dd, new_parts[p]);
+    const auto ov_recv = intersect(old_parts[p], new_dd);
+    send_counts[p] = static_cast<int>(ov_send[1][0] * ov_send[1][1] * nfields);
+    recv_counts[p] = static_cast<int>(ov_recv[1][0] * ov_recv[1][1] * nfields);
+  }
+  std::exclusive_scan(send_counts.begin(), send_counts.end(), send_displs.begin(), 0);
+  std::exclusive_scan(recv_counts.begin(), recv_counts.end(), recv_displs.begin(), 0);
+
+  std::vector<double> send_buf(send_displs.back() + send_counts.back());
+  std::vector<double> recv_buf(recv_displs.back() + recv_counts.back());
+  for (int p = 0; p != nprocs; ++p) {
+    auto ov = intersect(old_dd, new_parts[p]);
+    DomainDecomposition<2> ov_dd;
+    ov_dd.start = ov[0];
+    ov_dd.n_local = ov[1];
+    copy_overlap(old_dd, ov_dd, data.data(), send_buf.data() + send_displs[p]);
+  }
+
+  MPI_Alltoallv(send_buf.data(), send_counts.data(), send_displs.data(), MPI_DOUBLE, recv_buf.data(),
+                recv_counts.data(), recv_displs.data(), MPI_DOUBLE, old_dd.comm);
+
+  for (int p = 0; p != nprocs; ++p) {
+    auto ov = intersect(old_parts[p], new_dd);
+    DomainDecomposition<2> ov_dd;
+    ov_dd.start = ov[0];
+    ov_dd.n_local = ov[1];
+    copy_overlap(ov_dd, new_dd, recv_buf.data() + recv_displs[p], new_data.data());
+  }
+#else
+  copy_overlap(old_dd, new_dd, data.data(), new_data.data());
+#endif
+  return new_data;
+}
+
 #ifdef HAVE_MPI
 
 namespace Clock {
@@ -3,6 +3,7 @@
 #define ELM_UTILS_HH_
 
 #include <chrono>
+#include <vector>
 
 #include "array.hh"
 #include "mpi_types.hh"
@@ -34,6 +35,43 @@ DomainDecomposition<1> create_domain_decomposition_1D(int nprocs, GO n_global, i
 DomainDecomposition<2> create_domain_decomposition_2D(std::array<int, 2> n_procs, std::array<GO, 2> n_global,
                                                       std::array<int, 2> proc_index);
 
+//
+// Weighted decomposition by recursive coordinate bisection.
+//
+// weights holds a per-cell cost for the full grid in row-major order,
+// weights[i * n_global[1] + j], with zero cost for cells that are not
+// computed (e.g. ocean).  Each rank still owns a single rectangle, so the
+// (start, n_local) hyperslab readers are unchanged, but rectangles are
+// sized by cost rather than area.  n_procs = {nprocs, 1} and
+// proc_index = {rank, 0} for the result.
+//
+std::vector<DomainDecomposition<2>> rcb_partition(int nprocs, std::array<GO, 2> n_global,
+                                                  const std::vector<double> &weights);
+
+DomainDecomposition<2> create_domain_decomposition_2D_weighted(int nprocs, std::array<GO, 2> n_global, int rank,
+                                                               const std::vector<double> &weights);
+
+//
+// Assemble the global cost map from each rank's local costs.
+//
+// local_costs is indexed by local cell, i * dd.n_local[1] + j.  If
+// elapsed > 0 the local costs are first rescaled so that they sum to the
+// measured elapsed time on this rank, turning a static cost model into
+// measured per-cell cost for rebalancing.
+//
+std::vector<double> gather_cell_costs(const DomainDecomposition<2> &dd, const std::vector<double> &local_costs,
+                                      double elapsed = 0.0);
+
+//
+// Move per-cell state from one decomposition to another.
+//
+// data is laid out cell-major with nfields values per cell,
+// data[(i * n_local[1] + j) * nfields + f], in the old decomposition.
+// Returns the same layout for the new decomposition.
+//
+std::vector<double> migrate_cells(const DomainDecomposition<2> &old_dd, const DomainDecomposition<2> &new_dd,
+                                  const std::vector<double> &data, int nfields);
+
 //
 // { min, max, sum } of arrays
 //
@@ -0,0 +1,1620 @@
+#include "array.hh"
+#include "read_test_input.hh"
+
+#include "elm_constants.h"
+#include "land_data.h"
+#include "pft_data.h"
+
+#include "bareground_fluxes.h"
+#include "canopy_fluxes.h"
+#include "change_tracker.h"
+#include "photosynthesis.h"
+#include "snicar_data.h"
+#include "snow_bins.h"
+#include "snow_snicar.h"
+#include "soil_suction_table.h"
+#include "state_validation.h"
+#include "surface_albedo.h"
+
+#include "invoke_kernel.hh"
+#include "kokkos_includes.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+
+microbenchmarks for the physics kernels
+
+each benchmark loads one NSTEP of a single-column fixture from test/data, replicates it to N cells
+and times one kernel launched through invoke_kernel over all cells
+state variables (forcing, temperatures, lai, ...) are perturbed per cell by a deterministic relative
+noise so iterative kernels do not converge in lockstep - cell 0 is never perturbed
+
+before every repetition the replicated state is restored and the kernels upstream of the one being
+timed are run (untimed), so each kernel always sees the same inputs
+
+the backend is the one the tree was built with - serial ELM::Array, or Kokkos with whatever default
+execution space Kokkos was configured for (OpenMP, CUDA, ...)
+
+kernels timed:
+surface_albedo::canopy_layer_lai()       SurfaceAlbedo_OUT.txt
+surface_albedo::canopy_layer_lai (tracked) as above, only cells whose lai/sai changed, see below
+surface_albedo::two_stream_solver()      SurfaceAlbedo_OUT.txt
+surface_albedo::ComputeTwoStream         SurfaceAlbedo_OUT.txt, batched solver over the same cells
+photosynthesis::photosynthesis()         CanopyFluxes_IN.txt, sun and shade
+photosynthesis::photosynthesis (team)    CanopyFluxes_IN.txt, one team per cell, layers across the team
+canopy_fluxes::initialize_flux()         CanopyFluxes_IN.txt
+canopy_fluxes::initialize_flux (table)   as above, soil suction from a per-column SuctionTable (--suction-table)
+canopy_fluxes::stability_iteration()     CanopyFluxes_IN.txt
+canopy_fluxes::compute_flux()            CanopyFluxes_IN.txt
+bareground_fluxes::initialize_flux()     BareGroundFluxes_IN.txt
+bareground_fluxes::stability_iteration() BareGroundFluxes_IN.txt
+bareground_fluxes::compute_flux()        BareGroundFluxes_IN.txt
+state_validation::check                  CanopyFluxes_IN.txt, fused NaN/Inf and bounds checks of the canopy_fluxes state
+snow_snicar::snicar (static)             SurfaceAlbedo_IN.txt and SnowOptics_IN.txt, synthetic snowpack
+snow_snicar::snicar (dynamic)            as above, dynamic host schedule (host backend only)
+snow_snicar::snicar (snl bins)           as above, cells binned by snl with SnowBins, one launch per bin
+
+usage:
+bench_kernels [--data-dir dir] [--cells N] [--reps N] [--perturb amp] [--filter substr]
+              [--baseline file] [--tolerance frac] [--write-baseline file] [--nlevcan N] [--suction-table npts]
+
+--baseline compares median ns/cell against a file written by --write-baseline and exits with 1
+if any kernel is slower than baseline * (1 + tolerance)
+baseline files hold one "kernel ns_per_cell" pair per line, # starts a comment
+
+--nlevcan sizes the canopy layer arrays of the surface_albedo kernels (default ELMdims::nlevcan, the fixture's
+sun/shade big leaf) - with more layers the multi-layer canopy path is timed and checked, ComputeTwoStream then
+runs one team per cell with the layers spread over the team - N is 1 or at least 4, and enough layers for the
+largest fixture lai+sai, see surface_albedo::canopy_layers_needed()
+
+--suction-table builds a SuctionTable of npts nodes per layer (default 0, no table) and adds the initialize_flux
+(table) benchmark, and a check that btran and rootr match soil_suction() - the tables take
+8 * nlevgrnd * (2 + 2 * npts) bytes per cell, about 15.6 KB with 64 nodes, so they are opt-in
+
+the tracked canopy_layer_lai benchmark includes the per-step ChangeTracker::update() of elai, esai, tlai and tsai
+every repetition restores the same lai, so after the warm-up no cell is dirty - this is the cost of a step within
+a day, when phenology hasn't changed lai, and only the layer fluxes canopy_layer_lai() zeros are refreshed
+the check recomputes half of the cells after a change of lai and compares with a full canopy_layer_lai()
+
+the state_validation benchmark times one StateValidator::check() of the canopy_fluxes outputs, a single
+reduction over cells - the check makes sure a NaN and a negative h2osoi_liq are reported at the right cells
+
+the snow_snicar benchmarks run the direct-beam SNICAR sequence (init_timestep, snow_aerosol_mie_params,
+snow_radiative_transfer_solver, snow_albedo_radiation_factor) over a synthetic domain with 50% snow cover -
+the first half of the cells is snow-free, the snowpack in the second half deepens from 1 to nlevsno layers
+along the cell index, like a latitudinal gradient in grid order - so a static schedule leaves the threads
+that own snow-free cells idle while the deep snowpacks finish
+the snl bins benchmark includes the per-step SnowBins::update(), and all three must give identical results
+
+*/
+
+#ifndef ELM_TEST_DATA_DIR
+#define ELM_TEST_DATA_DIR "data"
+#endif
+
+#ifdef ENABLE_KOKKOS
+using ViewI1 = Kokkos::View<int *>;
+using ViewD1 = Kokkos::View<double *>;
+using ViewD2 = Kokkos::View<double **>;
+using ViewI2 = Kokkos::View<int **>;
+using ViewD3 = Kokkos::View<double ***>;
+#else
+using ViewI1 = ELM::Array<int, 1>;
+using ViewD1 = ELM::Array<double, 1>;
+using ViewD2 = ELM::Array<double, 2>;
+using ViewI2 = ELM::Array<int, 2>;
+using ViewD3 = ELM::Array<double, 3>;
+#endif
+
+namespace {
+
+// row i of a (ncells, n) view
+template <class View_t>
+ACCELERATE
+auto cell_row(const View_t& v, const int i) {
+#ifdef ENABLE_KOKKOS
+  return Kokkos::subview(v, i, Kokkos::ALL);
+#else
+  return v[i];
+#endif
+}
+
+// (n1, n2) slab i of a (ncells, n1, n2) view
+template <class View_t>
+ACCELERATE
+auto cell_slab(const View_t& v, const int i) {
+#ifdef ENABLE_KOKKOS
+  return Kokkos::subview(v, i, Kokkos::ALL, Kokkos::ALL);
+#else
+  return v[i];
+#endif
+}
+
+// host view holding the current contents of v
+template <class View_t>
+auto host_copy(const View_t& v) {
+#ifdef ENABLE_KOKKOS
+  auto h_v = Kokkos::create_mirror_view(v);
+  Kokkos::deep_copy(h_v, v);
+  return h_v;
+#else
+  return v;
+#endif
+}
+
+void fence() {
+#ifdef ENABLE_KOKKOS
+  Kokkos::fence();
+#endif
+}
+
+std::string backend_name() {
+#ifdef ENABLE_KOKKOS
+  return std::string("kokkos/") + Kokkos::DefaultExecutionSpace::name();
+#elif defined(ENABLE_OPENMP)
+  return "openmp/" + std::to_string(ELM::host_concurrency());
+#else
+  return "serial";
+#endif
+}
+
+// vegetation of the fixture column
+ELM::LandType fixture_land() {
+  ELM::LandType Land;
+  Land.ltype = 1;
+  Land.ctype = 1;
+  Land.vtype = 12;
+  return Land;
+}
+
+// photosynthesis parameters are not part of the fixtures
+// representative c3 arctic grass values, in PFTDataPSN order
+constexpr ELM::PFTDataPSN fixture_psn_pft{
+    7.16,     3.6,      79430.0,  36380.0,  37830.0, 72000.0, 50000.0, 72000.0, 46390.0,
+    200000.0, 200000.0, 200000.0, 150650.0, 490.0,   0.05,    0.98,    10000.0, 9.0,
+    1.0,      0.04,     25.0,     0.1365,   0.61,    0.04,    -74000.0, -275000.0, -2.0};
+
+// deterministic noise in [-1, 1) from (cell, field)
+double cell_noise(const std::uint64_t cell, const std::string& field) {
+  std::uint64_t z = cell * 0x9e3779b97f4a7c15ULL + std::hash<std::string>{}(field);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z = z ^ (z >> 31);
+  return static_cast<double>(z >> 11) / static_cast<double>(1ULL << 52) - 1.0;
+}
+
+//
+// Replicated fixture state.
+//
+// Fields are created on request from the variable of the same name in one NSTEP of a
+// fixture file.  Each field keeps the host values it was created with, which reset()
+// copies back to the device.
+//
+class CellFields {
+public:
+  CellFields(const std::string& filename, const int nstep, const int ncells, const double perturb);
+
+  // value(s) of a fixture variable
+  const std::vector<double>& get(const std::string& name) const;
+
+  // ncells copies of a scalar fixture variable
+  ViewD1 d1(const std::string& name) { return make_d1(name, 0.0); }
+  ViewD1 d1_perturbed(const std::string& name) { return make_d1(name, perturb_); }
+  // perturbed by the noise of field noise_of, keeps related fields consistent (eg tlai >= elai)
+  ViewD1 d1_perturbed(const std::string& name, const std::string& noise_of) {
+    return make_d1(name, perturb_, noise_of);
+  }
+  ViewI1 i1(const std::string& name);
+
+  // (ncells, n) copies of a length n fixture variable
+  ViewD2 d2(const std::string& name) { return make_d2(name, 0.0); }
+  ViewD2 d2_perturbed(const std::string& name) { return make_d2(name, perturb_); }
+
+  // fields that are not taken from the fixture, reset to a constant
+  ViewI1 i1_fill(const std::string& name, const int val);
+  ViewD1 d1_zeros(const std::string& name);
+  ViewD2 d2_zeros(const std::string& name, const int n);
+  ViewI2 i2_zeros(const std::string& name, const int n);
+  ViewD3 d3_zeros(const std::string& name, const int n1, const int n2);
+
+  // synthetic fields, reset to val(i) or val(i, j) for cell i
+  ViewI1 i1_cells(const std::string& name, const std::function<int(int)>& val);
+  ViewD1 d1_cells(const std::string& name, const std::function<double(int)>& val);
+  ViewD2 d2_cells(const std::string& name, const int n, const std::function<double(int, int)>& val);
+
+  // restore every field to its replicated state
+  void reset();
+
+  int ncells() const { return ncells_; }
+
+private:
+  ViewD1 make_d1(const std::string& name, const double amp, const std::string& noise_of = "");
+  ViewD2 make_d2(const std::string& name, const double amp);
+
+  int ncells_;
+  double perturb_;
+  std::map<std::string, std::vector<double>> vars_;
+  std::vector<std::function<void()>> resets_;
+};
+
+CellFields::CellFields(const std::string& filename, const int nstep, const int ncells, const double perturb)
+    : ncells_(ncells), perturb_(perturb) {
+  ELM::IO::ELMtestinput input(filename);
+  std::istringstream state_ss(input.getState(nstep));
+  std::string line_str, name;
+  while (std::getline(state_ss, line_str)) {
+    std::istringstream line_ss(line_str);
+    line_ss >> name;
+    std::vector<double> values;
+    double val;
+    while (line_ss >> val) {
+      values.push_back(val);
+    }
+    vars_[name] = values;
+  }
+  if (vars_.find("NSTEP") == vars_.end()) {
+    throw std::runtime_error("ELM ERROR: can't find NSTEP " + std::to_string(nstep) + " in " + filename);
+  }
+}
+
+const std::vector<double>& CellFields::get(const std::string& name) const {
+  auto itr = vars_.find(name);
+  if (itr == vars_.end()) {
+    throw std::runtime_error("ELM ERROR: fixture does not contain variable " + name);
+  }
+  return itr->second;
+}
+
+ViewD1 CellFields::make_d1(const std::string& name, const double amp, const std::string& noise_of) {
+  ViewD1 d(name, ncells_);
+  auto h_d = std::make_shared<std::vector<double>>(ncells_);
+  const double val = get(name).at(0);
+  const std::string& noise_name = noise_of.empty() ? name : noise_of;
+  for (int i = 0; i < ncells_; ++i) {
+    (*h_d)[i] = i == 0 ? val : val * (1.0 + amp * cell_noise(i, noise_name));
+  }
+  resets_.push_back([d, h_d]() mutable {
+    auto h_v = host_copy(d);
+    for (int i = 0; i < static_cast<int>(h_d->size()); ++i) {
+      h_v(i) = (*h_d)[i];
+    }
+    NS::deep_copy(d, h_v);
+  });
+  return d;
+}
+
+ViewD2 CellFields::make_d2(const std::string& name, const double amp) {
+  const auto& vals = get(name);
+  const int n = vals.size();
+  ViewD2 d(name, ncells_, n);
+  auto h_d = std::make_shared<std::vector<double>>(ncells_ * n);
+  for (int i = 0; i < ncells_; ++i) {
+    for (int j = 0; j < n; ++j) {
+      (*h_d)[i * n + j] = i == 0 ? vals[j] : vals[j] * (1.0 + amp * cell_noise(i * n + j, name));
+    }
+  }
+  resets_.push_back([d, h_d, n]() mutable {
+    auto h_v = host_copy(d);
+    for (int i = 0; i < static_cast<int>(h_v.extent(0)); ++i) {
+      for (int j = 0; j < n; ++j) {
+        h_v(i, j) = (*h_d)[i * n + j];
+      }
+    }
+    NS::deep_copy(d, h_v);
+  });
+  return d;
+}
+
+ViewI1 CellFields::i1(const std::string& name) {
+  ViewI1 d(name, ncells_);
+  const int val = std::lround(get(name).at(0));
+  resets_.push_back([d, val]() mutable { NS::deep_copy(d, val); });
+  return d;
+}
+
+ViewI1 CellFields::i1_fill(const std::string& name, const int val) {
+  ViewI1 d(name, ncells_);
+  resets_.push_back([d, val]() mutable { NS::deep_copy(d, val); });
+  return d;
+}
+
+ViewD1 CellFields::d1_zeros(const std::string& name) {
+  ViewD1 d(name, ncells_);
+  resets_.push_back([d]() mutable { NS::deep_copy(d, 0.0); });
+  return d;
+}
+
+ViewD2 CellFields::d2_zeros(const std::string& name, const int n) {
+  ViewD2 d(name, ncells_, n);
+  resets_.push_back([d]() mutable { NS::deep_copy(d, 0.0); });
+  return d;
+}
+
+ViewI2 CellFields::i2_zeros(const std::string& name, const int n) {
+  ViewI2 d(name, ncells_, n);
+  resets_.push_back([d]() mutable { NS::deep_copy(d, 0); });
+  return d;
+}
+
+ViewD3 CellFields::d3_zeros(const std::string& name, const int n1, const int n2) {
+  ViewD3 d(name, ncells_, n1, n2);
+  resets_.push_back([d]() mutable { NS::deep_copy(d, 0.0); });
+  return d;
+}
+
+ViewI1 CellFields::i1_cells(const std::string& name, const std::function<int(int)>& val) {
+  ViewI1 d(name, ncells_);
+  resets_.push_back([d, val]() mutable {
+    auto h_v = host_copy(d);
+    for (int i = 0; i < static_cast<int>(h_v.extent(0)); ++i) {
+      h_v(i) = val(i);
+    }
+    NS::deep_copy(d, h_v);
+  });
+  return d;
+}
+
+ViewD1 CellFields::d1_cells(const std::string& name, const std::function<double(int)>& val) {
+  ViewD1 d(name, ncells_);
+  resets_.push_back([d, val]() mutable {
+    auto h_v = host_copy(d);
+    for (int i = 0; i < static_cast<int>(h_v.extent(0)); ++i) {
+      h_v(i) = val(i);
+    }
+    NS::deep_copy(d, h_v);
+  });
+  return d;
+}
+
+ViewD2 CellFields::d2_cells(const std::string& name, const int n, const std::function<double(int, int)>& val) {
+  ViewD2 d(name, ncells_, n);
+  resets_.push_back([d, val, n]() mutable {
+    auto h_v = host_copy(d);
+    for (int i = 0; i < static_cast<int>(h_v.extent(0)); ++i) {
+      for (int j = 0; j < n; ++j) {
+        h_v(i, j) = val(i, j);
+      }
+    }
+    NS::deep_copy(d, h_v);
+  });
+  return d;
+}
+
+void CellFields::reset() {
+  for (auto& f : resets_) {
+    f();
+  }
+}
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// surface_albedo kernels
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+// canopy layer arrays hold the fixture values for the default number of canopy layers,
+// otherwise they are zeroed and filled by canopy_layer_lai()
+ViewD2 layer_field(CellFields& c, const std::string& name, const int nlevcan) {
+  return nlevcan == ELM::ELMdims::nlevcan ? c.d2(name) : c.d2_zeros(name, nlevcan);
+}
+
+struct SurfaceAlbedoFields {
+  SurfaceAlbedoFields(CellFields& c, const int nlevcan)
+      : nrad{c.i1_fill("nrad", 0)}, ncan{c.i1_fill("ncan", 0)}, elai{c.d1_perturbed("elai")},
+        esai{c.d1_perturbed("esai")}, tlai{c.d1_perturbed("tlai", "elai")}, tsai{c.d1_perturbed("tsai", "esai")},
+        coszen{c.d1_perturbed("coszen")}, t_veg{c.d1_perturbed("t_veg")}, fwet{c.d1_perturbed("fwet")},
+        vcmaxcintsun{c.d1_zeros("vcmaxcintsun")}, vcmaxcintsha{c.d1_zeros("vcmaxcintsha")},
+        tlai_z{layer_field(c, "tlai_z", nlevcan)}, tsai_z{layer_field(c, "tsai_z", nlevcan)},
+        fsun_z{layer_field(c, "fsun_z", nlevcan)}, fabd_sun_z{layer_field(c, "fabd_sun_z", nlevcan)},
+        fabd_sha_z{layer_field(c, "fabd_sha_z", nlevcan)}, fabi_sun_z{layer_field(c, "fabi_sun_z", nlevcan)},
+        fabi_sha_z{layer_field(c, "fabi_sha_z", nlevcan)}, albgrd{c.d2_perturbed("albgrd")},
+        albgri{c.d2_perturbed("albgri")}, albd{c.d2("albd")}, ftid{c.d2("ftid")}, ftdd{c.d2("ftdd")},
+        fabd{c.d2("fabd")}, fabd_sun{c.d2("fabd_sun")}, fabd_sha{c.d2("fabd_sha")}, albi{c.d2("albi")},
+        ftii{c.d2("ftii")}, fabi{c.d2("fabi")}, fabi_sun{c.d2("fabi_sun")}, fabi_sha{c.d2("fabi_sha")} {}
+
+  ViewI1 nrad, ncan;
+  ViewD1 elai, esai, tlai, tsai, coszen, t_veg, fwet, vcmaxcintsun, vcmaxcintsha;
+  ViewD2 tlai_z, tsai_z, fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z;
+  ViewD2 albgrd, albgri, albd, ftid, ftdd, fabd, fabd_sun, fabd_sha, albi, ftii, fabi, fabi_sun, fabi_sha;
+};
+
+// the multi-layer canopy layer arrays must hold every fixture canopy - including the lai the
+// canopy_layer_lai (tracked) check raises by 10%
+void check_canopy_layers(const SurfaceAlbedoFields& f, const int nlevcan) {
+  if (nlevcan == 1) {
+    return;
+  }
+  const auto h_elai = host_copy(f.elai);
+  const auto h_esai = host_copy(f.esai);
+  const auto h_tlai = host_copy(f.tlai);
+  const auto h_tsai = host_copy(f.tsai);
+  int needed = 4;
+  for (int i = 0; i < static_cast<int>(h_elai.extent(0)); ++i) {
+    needed = std::max(needed, ELM::surface_albedo::canopy_layers_needed(1.1 * h_elai(i), h_esai(i), 1.1 * h_tlai(i),
+                                                                          h_tsai(i)));
+  }
+  if (nlevcan < needed) {
+    throw std::runtime_error("ELM ERROR: --nlevcan " + std::to_string(nlevcan) +
+                             " is too small for the fixture canopies, at least " + std::to_string(needed) +
+                             " layers are needed");
+  }
+}
+
+// albedo parameters are stored in the fixture as rows of numpft values, one row per band
+ELM::PFTDataAlb fixture_alb_pft(const CellFields& c, const int vtype) {
+  const int numpft = c.get("xl").size();
+  ELM::PFTDataAlb alb_pft;
+  for (int ib = 0; ib < ELM::ELMdims::numrad; ++ib) {
+    alb_pft.rhol[ib] = c.get("rhol").at(ib * numpft + vtype);
+    alb_pft.rhos[ib] = c.get("rhos").at(ib * numpft + vtype);
+    alb_pft.taul[ib] = c.get("taul").at(ib * numpft + vtype);
+    alb_pft.taus[ib] = c.get("taus").at(ib * numpft + vtype);
+  }
+  alb_pft.xl = c.get("xl").at(vtype);
+  return alb_pft;
+}
+
+struct CanopyLayerLAI {
+  CanopyLayerLAI(const ELM::LandType& Land, const SurfaceAlbedoFields& f) : Land_{Land}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    ELM::surface_albedo::canopy_layer_lai(
+        Land_.urbpoi, f_.elai(i), f_.esai(i), f_.tlai(i), f_.tsai(i), f_.nrad(i), f_.ncan(i), cell_row(f_.tlai_z, i),
+        cell_row(f_.tsai_z, i), cell_row(f_.fsun_z, i), cell_row(f_.fabd_sun_z, i), cell_row(f_.fabd_sha_z, i),
+        cell_row(f_.fabi_sun_z, i), cell_row(f_.fabi_sha_z, i));
+  }
+
+private:
+  ELM::LandType Land_;
+  SurfaceAlbedoFields f_;
+};
+
+// the part of canopy_layer_lai() that has to run every step, for cells ChangeTracker skips
+struct ZeroCanopyLayerFluxes {
+  ZeroCanopyLayerFluxes(const ELM::LandType& Land, const SurfaceAlbedoFields& f) : Land_{Land}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    ELM::surface_albedo::zero_canopy_layer_fluxes(Land_.urbpoi, f_.nrad(i), cell_row(f_.fsun_z, i),
+                                                  cell_row(f_.fabd_sun_z, i), cell_row(f_.fabd_sha_z, i),
+                                                  cell_row(f_.fabi_sun_z, i), cell_row(f_.fabi_sha_z, i));
+  }
+
+private:
+  ELM::LandType Land_;
+  SurfaceAlbedoFields f_;
+};
+
+struct TwoStreamSolver {
+  TwoStreamSolver(const ELM::LandType& Land, const ELM::PFTDataAlb& alb_pft, const SurfaceAlbedoFields& f)
+      : Land_{Land}, alb_pft_{alb_pft}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    ELM::surface_albedo::two_stream_solver(
+        Land_, f_.nrad(i), f_.coszen(i), f_.t_veg(i), f_.fwet(i), f_.elai(i), f_.esai(i), cell_row(f_.tlai_z, i),
+        cell_row(f_.tsai_z, i), cell_row(f_.albgrd, i), cell_row(f_.albgri, i), alb_pft_, f_.vcmaxcintsun(i),
+        f_.vcmaxcintsha(i), cell_row(f_.albd, i), cell_row(f_.ftid, i), cell_row(f_.ftdd, i), cell_row(f_.fabd, i),
+        cell_row(f_.fabd_sun, i), cell_row(f_.fabd_sha, i), cell_row(f_.albi, i), cell_row(f_.ftii, i),
+        cell_row(f_.fabi, i), cell_row(f_.fabi_sun, i), cell_row(f_.fabi_sha, i), cell_row(f_.fsun_z, i),
+        cell_row(f_.fabd_sun_z, i), cell_row(f_.fabd_sha_z, i), cell_row(f_.fabi_sun_z, i),
+        cell_row(f_.fabi_sha_z, i));
+  }
+
+private:
+  ELM::LandType Land_;
+  ELM::PFTDataAlb alb_pft_;
+  SurfaceAlbedoFields f_;
+};
+
+// fixture_alb_pft() in every cell, as GatherPFTData leaves it
+ELM::PFTData<ViewD1, ViewD2> fixture_cell_pft(const ELM::PFTDataAlb& alb_pft, const int ncells) {
+  ELM::PFTData<ViewD1, ViewD2> cell_pft(ncells);
+  NS::deep_copy(cell_pft.rholvis, alb_pft.rhol[0]);
+  NS::deep_copy(cell_pft.rholnir, alb_pft.rhol[1]);
+  NS::deep_copy(cell_pft.rhosvis, alb_pft.rhos[0]);
+  NS::deep_copy(cell_pft.rhosnir, alb_pft.rhos[1]);
+  NS::deep_copy(cell_pft.taulvis, alb_pft.taul[0]);
+  NS::deep_copy(cell_pft.taulnir, alb_pft.taul[1]);
+  NS::deep_copy(cell_pft.tausvis, alb_pft.taus[0]);
+  NS::deep_copy(cell_pft.tausnir, alb_pft.taus[1]);
+  NS::deep_copy(cell_pft.xl, alb_pft.xl);
+  return cell_pft;
+}
+
+using TwoStreamBatch = ELM::surface_albedo::ComputeTwoStream<ViewI1, ViewD1, ViewD2, ViewD2>;
+
+TwoStreamBatch two_stream_batch(const ELM::LandType& Land, const ELM::PFTData<ViewD1, ViewD2>& cell_pft,
+                                const ViewI1 path, const SurfaceAlbedoFields& f) {
+  return TwoStreamBatch(Land, cell_pft, f.nrad, f.coszen, f.t_veg, f.fwet, f.elai, f.esai, f.tlai_z, f.tsai_z,
+                        f.albgrd, f.albgri, path, f.vcmaxcintsun, f.vcmaxcintsha, f.albd, f.ftid, f.ftdd, f.fabd,
+                        f.fabd_sun, f.fabd_sha, f.albi, f.ftii, f.fabi, f.fabi_sun, f.fabi_sha, f.fsun_z,
+                        f.fabd_sun_z, f.fabd_sha_z, f.fabi_sun_z, f.fabi_sha_z);
+}
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// canopy_fluxes and photosynthesis kernels
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+// columns of the per-cell temporaries passed between the canopy_fluxes stages
+namespace canflux_tmp {
+enum : int {
+  wtg, wtgq, wtalq, wtlq0, wtaq0, wtl0, wta0, wtal, dayl_factor, air, bir, cir, el, qsatl, qsatldT, taf, qaf,
+  um, ur, dth, dqh, obu, zldis, temp1, temp2, temp12m, temp22m, tlbef, delq, dt_veg, count
+};
+} // namespace canflux_tmp
+
+struct CanopyFluxesFields {
+  explicit CanopyFluxesFields(CellFields& c)
+      : snl{c.i1("snl")}, frac_veg_nosno{c.i1("frac_veg_nosno")}, nrad{c.i1("nrad")},
+        altmax_indx{c.i1("altmax_indx")}, altmax_lastyear_indx{c.i1("altmax_lastyear_indx")},
+        frac_sno{c.d1("frac_sno")}, forc_hgt_u_patch{c.d1("forc_hgt_u_patch")},
+        forc_hgt_t_patch{c.d1("forc_hgt_t_patch")}, forc_hgt_q_patch{c.d1("forc_hgt_q_patch")},
+        thm{c.d1_perturbed("thm")}, thv{c.d1_perturbed("thv")}, max_dayl{c.d1("max_dayl")}, dayl{c.d1("dayl")},
+        elai{c.d1_perturbed("elai")}, esai{c.d1_perturbed("esai")}, emv{c.d1("emv")}, emg{c.d1("emg")},
+        qg{c.d1_perturbed("qg")}, t_grnd{c.d1_perturbed("t_grnd")}, forc_t{c.d1_perturbed("forc_t")},
+        forc_pbot{c.d1_perturbed("forc_pbot")}, forc_lwrad{c.d1_perturbed("forc_lwrad")},
+        forc_u{c.d1_perturbed("forc_u")}, forc_v{c.d1_perturbed("forc_v")}, forc_q{c.d1_perturbed("forc_q")},
+        forc_th{c.d1_perturbed("forc_th")}, forc_rho{c.d1("forc_rho")}, forc_pco2{c.d1("forc_pco2")},
+        forc_po2{c.d1("forc_po2")}, z0mg{c.d1("z0mg")}, btran{c.d1("btran")}, displa{c.d1("displa")},
+        z0mv{c.d1("z0mv")}, z0hv{c.d1("z0hv")}, z0qv{c.d1("z0qv")}, t_veg{c.d1_perturbed("t_veg")},
+        fwet{c.d1_perturbed("fwet")}, fdry{c.d1("fdry")}, laisun{c.d1_perturbed("laisun")},
+        laisha{c.d1_perturbed("laisha")}, snow_depth{c.d1("snow_depth")}, soilbeta{c.d1("soilbeta")},
+        frac_h2osfc{c.d1("frac_h2osfc")}, t_h2osfc{c.d1("t_h2osfc")}, sabv{c.d1_perturbed("sabv")},
+        h2ocan{c.d1_perturbed("h2ocan")}, htop{c.d1("htop")}, t10{c.d1_perturbed("t10")},
+        vcmaxcintsha{c.d1("vcmaxcintsha")}, vcmaxcintsun{c.d1("vcmaxcintsun")},
+        qflx_tran_veg{c.d1("qflx_tran_veg")}, qflx_evap_veg{c.d1("qflx_evap_veg")},
+        eflx_sh_veg{c.d1("eflx_sh_veg")}, qg_snow{c.d1("qg_snow")}, qg_soil{c.d1("qg_soil")},
+        qg_h2osfc{c.d1("qg_h2osfc")}, dqgdT{c.d1("dqgdT")}, htvp{c.d1("htvp")}, eflx_sh_grnd{c.d1("eflx_sh_grnd")},
+        eflx_sh_snow{c.d1("eflx_sh_snow")}, eflx_sh_soil{c.d1("eflx_sh_soil")},
+        eflx_sh_h2osfc{c.d1("eflx_sh_h2osfc")}, qflx_evap_soi{c.d1("qflx_evap_soi")},
+        qflx_ev_snow{c.d1("qflx_ev_snow")}, qflx_ev_soil{c.d1("qflx_ev_soil")},
+        qflx_ev_h2osfc{c.d1("qflx_ev_h2osfc")}, dlrad{c.d1("dlrad")}, ulrad{c.d1("ulrad")}, cgrnds{c.d1("cgrnds")},
+        cgrndl{c.d1("cgrndl")}, cgrnd{c.d1("cgrnd")}, t_ref2m{c.d1("t_ref2m")}, t_ref2m_r{c.d1("t_ref2m_r")},
+        q_ref2m{c.d1("q_ref2m")}, rh_ref2m{c.d1("rh_ref2m")}, rh_ref2m_r{c.d1("rh_ref2m_r")},
+        rssun{c.d1_zeros("rssun")}, rssha{c.d1_zeros("rssha")}, canopy_err{c.d1_zeros("canopy_err")},
+        rootr{c.d2("rootr")}, eff_porosity{c.d2("eff_porosity")}, tlai_z{c.d2("tlai_z")},
+        parsha_z{c.d2_perturbed("parsha_z")}, parsun_z{c.d2_perturbed("parsun_z")},
+        laisha_z{c.d2_perturbed("laisha_z")}, laisun_z{c.d2_perturbed("laisun_z")},
+        t_soisno{c.d2_perturbed("t_soisno")},
+        h2osoi_ice{c.d2("h2osoi_ice")}, h2osoi_liq{c.d2_perturbed("h2osoi_liq")}, dz{c.d2("dz")},
+        rootfr{c.d2("rootfr")}, sucsat{c.d2("sucsat")}, watsat{c.d2("watsat")}, bsw{c.d2("bsw")},
+        tmp{c.d2_zeros("canopy_fluxes_tmp", canflux_tmp::count)} {}
+
+  ViewI1 snl, frac_veg_nosno, nrad, altmax_indx, altmax_lastyear_indx;
+  ViewD1 frac_sno, forc_hgt_u_patch, forc_hgt_t_patch, forc_hgt_q_patch, thm, thv, max_dayl, dayl, elai, esai,
+      emv, emg, qg, t_grnd, forc_t, forc_pbot, forc_lwrad, forc_u, forc_v, forc_q, forc_th, forc_rho, forc_pco2,
+      forc_po2, z0mg, btran, displa, z0mv, z0hv, z0qv, t_veg, fwet, fdry, laisun, laisha, snow_depth, soilbeta,
+      frac_h2osfc, t_h2osfc, sabv, h2ocan, htop, t10, vcmaxcintsha, vcmaxcintsun, qflx_tran_veg, qflx_evap_veg,
+      eflx_sh_veg, qg_snow, qg_soil, qg_h2osfc, dqgdT, htvp, eflx_sh_grnd, eflx_sh_snow, eflx_sh_soil,
+      eflx_sh_h2osfc, qflx_evap_soi, qflx_ev_snow, qflx_ev_soil, qflx_ev_h2osfc, dlrad, ulrad, cgrnds, cgrndl,
+      cgrnd, t_ref2m, t_ref2m_r, q_ref2m, rh_ref2m, rh_ref2m_r, rssun, rssha, canopy_err;
+  ViewD2 rootr, eff_porosity, tlai_z, parsha_z, parsun_z, laisha_z, laisun_z, t_soisno, h2osoi_ice, h2osoi_liq,
+      dz, rootfr, sucsat, watsat, bsw;
+  ViewD2 tmp;
+};
+
+// soil suction is evaluated with pow(), or looked up in suction_tables (ncells, nlevgrnd, 2 + 2 * npts) if given
+struct CanopyFluxesInit {
+  CanopyFluxesInit(const ELM::LandType& Land, const ELM::PFTDataPSN& psn_pft, const CanopyFluxesFields& f,
+                   const ViewD3 suction_tables = ViewD3("no_suction_tables", 0, 0, 0))
+      : Land_{Land}, psn_pft_{psn_pft}, f_{f}, suction_tables_{suction_tables} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    if (suction_tables_.extent(0) > 0) {
+      initialize_flux(i, ELM::soil_moist_stress::TabulatedSuction(cell_slab(suction_tables_, i),
+                                                                  cell_row(f_.sucsat, i), cell_row(f_.bsw, i)));
+    } else {
+      initialize_flux(i, ELM::soil_moist_stress::ClappHornbergerSuction(cell_row(f_.sucsat, i),
+                                                                        cell_row(f_.bsw, i)));
+    }
+  }
+
+private:
+  template <class Suction>
+  ACCELERATE
+  void initialize_flux(const int i, const Suction& suction) const {
+    namespace T = canflux_tmp;
+    const auto& tmp = f_.tmp;
+    ELM::canopy_fluxes::initialize_flux(
+        Land_, f_.snl(i), f_.frac_veg_nosno(i), f_.frac_sno(i), f_.forc_hgt_u_patch(i), f_.thm(i), f_.thv(i),
+        f_.max_dayl(i), f_.dayl(i), f_.altmax_indx(i), f_.altmax_lastyear_indx(i), cell_row(f_.t_soisno, i),
+        cell_row(f_.h2osoi_ice, i), cell_row(f_.h2osoi_liq, i), cell_row(f_.dz, i), cell_row(f_.rootfr, i),
+        psn_pft_.tc_stress, suction, cell_row(f_.watsat, i), psn_pft_.smpso, psn_pft_.smpsc, f_.elai(i),
+        f_.esai(i), f_.emv(i), f_.emg(i), f_.qg(i), f_.t_grnd(i), f_.forc_t(i), f_.forc_pbot(i), f_.forc_lwrad(i),
+        f_.forc_u(i), f_.forc_v(i), f_.forc_q(i), f_.forc_th(i), f_.z0mg(i), f_.btran(i), f_.displa(i),
+        f_.z0mv(i), f_.z0hv(i), f_.z0qv(i), cell_row(f_.rootr, i), cell_row(f_.eff_porosity, i),
+        tmp(i, T::dayl_factor), tmp(i, T::air), tmp(i, T::bir), tmp(i, T::cir), tmp(i, T::el), tmp(i, T::qsatl),
+        tmp(i, T::qsatldT), tmp(i, T::taf), tmp(i, T::qaf), tmp(i, T::um), tmp(i, T::ur), tmp(i, T::obu),
+        tmp(i, T::zldis), tmp(i, T::delq), f_.t_veg(i));
+  }
+
+  ELM::LandType Land_;
+  ELM::PFTDataPSN psn_pft_;
+  CanopyFluxesFields f_;
+  ViewD3 suction_tables_;
+};
+
+// btran and rootr of every cell, after CanopyFluxesInit
+std::vector<double> root_stress_outputs(const CanopyFluxesFields& f) {
+  std::vector<double> out;
+  const auto btran = host_copy(f.btran);
+  const auto rootr = host_copy(f.rootr);
+  for (int i = 0; i < static_cast<int>(btran.extent(0)); ++i) {
+    out.push_back(btran(i));
+    for (int k = 0; k < ELM::ELMdims::nlevgrnd; ++k) {
+      out.push_back(rootr(i, k));
+    }
+  }
+  return out;
+}
+
+struct CanopyFluxesStability {
+  CanopyFluxesStability(const ELM::LandType& Land, const ELM::PFTDataPSN& psn_pft, const double dtime,
+                        const CanopyFluxesFields& f)
+      : Land_{Land}, psn_pft_{psn_pft}, dtime_{dtime}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    namespace T = canflux_tmp;
+    const auto& tmp = f_.tmp;
+    ELM::canopy_fluxes::stability_iteration(
+        Land_, dtime_, f_.snl(i), f_.frac_veg_nosno(i), f_.frac_sno(i), f_.forc_hgt_u_patch(i),
+        f_.forc_hgt_t_patch(i), f_.forc_hgt_q_patch(i), f_.fwet(i), f_.fdry(i), f_.laisun(i), f_.laisha(i),
+        f_.forc_rho(i), f_.snow_depth(i), f_.soilbeta(i), f_.frac_h2osfc(i), f_.t_h2osfc(i), f_.sabv(i),
+        f_.h2ocan(i), f_.htop(i), cell_row(f_.t_soisno, i), tmp(i, T::air), tmp(i, T::bir), tmp(i, T::cir),
+        tmp(i, T::ur), tmp(i, T::zldis), f_.displa(i), f_.elai(i), f_.esai(i), f_.t_grnd(i), f_.forc_pbot(i),
+        f_.forc_q(i), f_.forc_th(i), f_.z0mg(i), f_.z0mv(i), f_.z0hv(i), f_.z0qv(i), f_.thm(i), f_.thv(i), f_.qg(i),
+        psn_pft_, f_.nrad(i), f_.t10(i), cell_row(f_.tlai_z, i), f_.vcmaxcintsha(i), f_.vcmaxcintsun(i),
+        cell_row(f_.parsha_z, i), cell_row(f_.parsun_z, i), cell_row(f_.laisha_z, i), cell_row(f_.laisun_z, i),
+        f_.forc_pco2(i), f_.forc_po2(i), tmp(i, T::dayl_factor), f_.btran(i), f_.qflx_tran_veg(i),
+        f_.qflx_evap_veg(i), f_.eflx_sh_veg(i), tmp(i, T::wtg), tmp(i, T::wtl0), tmp(i, T::wta0), tmp(i, T::wtal),
+        tmp(i, T::el), tmp(i, T::qsatl), tmp(i, T::qsatldT), tmp(i, T::taf), tmp(i, T::qaf), tmp(i, T::um),
+        tmp(i, T::dth), tmp(i, T::dqh), tmp(i, T::obu), tmp(i, T::temp1), tmp(i, T::temp2), tmp(i, T::temp12m),
+        tmp(i, T::temp22m), tmp(i, T::tlbef), tmp(i, T::delq), tmp(i, T::dt_veg), f_.t_veg(i), tmp(i, T::wtgq),
+        tmp(i, T::wtalq), tmp(i, T::wtlq0), tmp(i, T::wtaq0));
+  }
+
+private:
+  ELM::LandType Land_;
+  ELM::PFTDataPSN psn_pft_;
+  double dtime_;
+  CanopyFluxesFields f_;
+};
+
+struct CanopyFluxesCompute {
+  CanopyFluxesCompute(const ELM::LandType& Land, const double dtime, const CanopyFluxesFields& f)
+      : Land_{Land}, dtime_{dtime}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    namespace T = canflux_tmp;
+    const auto& tmp = f_.tmp;
+    ELM::canopy_fluxes::compute_flux(
+        Land_, dtime_, f_.snl(i), f_.frac_veg_nosno(i), f_.frac_sno(i), cell_row(f_.t_soisno, i), f_.frac_h2osfc(i),
+        f_.t_h2osfc(i), f_.sabv(i), f_.qg_snow(i), f_.qg_soil(i), f_.qg_h2osfc(i), f_.dqgdT(i), f_.htvp(i),
+        tmp(i, T::wtg), tmp(i, T::wtl0), tmp(i, T::wta0), tmp(i, T::wtal), tmp(i, T::air), tmp(i, T::bir),
+        tmp(i, T::cir), tmp(i, T::qsatl), tmp(i, T::qsatldT), tmp(i, T::dth), tmp(i, T::dqh), tmp(i, T::temp1),
+        tmp(i, T::temp2), tmp(i, T::temp12m), tmp(i, T::temp22m), tmp(i, T::tlbef), tmp(i, T::delq),
+        tmp(i, T::dt_veg), f_.t_veg(i), f_.t_grnd(i), f_.forc_pbot(i), f_.qflx_tran_veg(i), f_.qflx_evap_veg(i),
+        f_.eflx_sh_veg(i), f_.forc_q(i), f_.forc_rho(i), f_.thm(i), f_.emv(i), f_.emg(i), f_.forc_lwrad(i),
+        tmp(i, T::wtgq), tmp(i, T::wtalq), tmp(i, T::wtlq0), tmp(i, T::wtaq0), f_.h2ocan(i), f_.eflx_sh_grnd(i),
+        f_.eflx_sh_snow(i), f_.eflx_sh_soil(i), f_.eflx_sh_h2osfc(i), f_.qflx_evap_soi(i), f_.qflx_ev_snow(i),
+        f_.qflx_ev_soil(i), f_.qflx_ev_h2osfc(i), f_.dlrad(i), f_.ulrad(i), f_.cgrnds(i), f_.cgrndl(i), f_.cgrnd(i),
+        f_.t_ref2m(i), f_.t_ref2m_r(i), f_.q_ref2m(i), f_.rh_ref2m(i), f_.rh_ref2m_r(i), f_.canopy_err(i));
+  }
+
+private:
+  ELM::LandType Land_;
+  double dtime_;
+  CanopyFluxesFields f_;
+};
+
+// sun and shade photosynthesis as called from the first pass of canopy_fluxes::stability_iteration
+// leaf boundary layer resistance uses the canopy air wind speed from initialize_flux
+struct Photosynthesis {
+  Photosynthesis(const ELM::PFTDataPSN& psn_pft, const CanopyFluxesFields& f) : psn_pft_{psn_pft}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    namespace T = canflux_tmp;
+    const auto& tmp = f_.tmp;
+    const double svpts = tmp(i, T::el);
+    const double eah = f_.forc_pbot(i) * tmp(i, T::qaf) / 0.622;
+    const double uaf = std::max(tmp(i, T::um), 0.1);
+    const double cf = 0.01 / (std::sqrt(uaf) * std::sqrt(psn_pft_.dleaf));
+    const double rb = 1.0 / (cf * uaf);
+    ELM::photosynthesis::photosynthesis(psn_pft_, f_.nrad(i), f_.forc_pbot(i), f_.t_veg(i), f_.t10(i), svpts, eah,
+                                        f_.forc_po2(i), f_.forc_pco2(i), rb, f_.btran(i), tmp(i, T::dayl_factor),
+                                        f_.thm(i), cell_row(f_.tlai_z, i), f_.vcmaxcintsun(i),
+                                        cell_row(f_.parsun_z, i), cell_row(f_.laisun_z, i), f_.rssun(i));
+    ELM::photosynthesis::photosynthesis(psn_pft_, f_.nrad(i), f_.forc_pbot(i), f_.t_veg(i), f_.t10(i), svpts, eah,
+                                        f_.forc_po2(i), f_.forc_pco2(i), rb, f_.btran(i), tmp(i, T::dayl_factor),
+                                        f_.thm(i), cell_row(f_.tlai_z, i), f_.vcmaxcintsha(i),
+                                        cell_row(f_.parsha_z, i), cell_row(f_.laisha_z, i), f_.rssha(i));
+  }
+
+private:
+  ELM::PFTDataPSN psn_pft_;
+  CanopyFluxesFields f_;
+};
+
+// Photosynthesis with one team per cell, canopy layers across the team
+struct PhotosynthesisTeam {
+  PhotosynthesisTeam(const ELM::PFTDataPSN& psn_pft, const CanopyFluxesFields& f) : psn_pft_{psn_pft}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const ELM::TeamMember& member) const {
+    namespace T = canflux_tmp;
+    const int i = member.league_rank();
+    const auto& tmp = f_.tmp;
+    const double svpts = tmp(i, T::el);
+    const double eah = f_.forc_pbot(i) * tmp(i, T::qaf) / 0.622;
+    const double uaf = std::max(tmp(i, T::um), 0.1);
+    const double cf = 0.01 / (std::sqrt(uaf) * std::sqrt(psn_pft_.dleaf));
+    const double rb = 1.0 / (cf * uaf);
+    ELM::photosynthesis::photosynthesis(member, psn_pft_, f_.nrad(i), f_.forc_pbot(i), f_.t_veg(i), f_.t10(i), svpts,
+                                        eah, f_.forc_po2(i), f_.forc_pco2(i), rb, f_.btran(i),
+                                        tmp(i, T::dayl_factor), f_.thm(i), cell_row(f_.tlai_z, i),
+                                        f_.vcmaxcintsun(i), cell_row(f_.parsun_z, i), cell_row(f_.laisun_z, i),
+                                        f_.rssun(i));
+    ELM::photosynthesis::photosynthesis(member, psn_pft_, f_.nrad(i), f_.forc_pbot(i), f_.t_veg(i), f_.t10(i), svpts,
+                                        eah, f_.forc_po2(i), f_.forc_pco2(i), rb, f_.btran(i),
+                                        tmp(i, T::dayl_factor), f_.thm(i), cell_row(f_.tlai_z, i),
+                                        f_.vcmaxcintsha(i), cell_row(f_.parsha_z, i), cell_row(f_.laisha_z, i),
+                                        f_.rssha(i));
+  }
+
+private:
+  ELM::PFTDataPSN psn_pft_;
+  CanopyFluxesFields f_;
+};
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// bareground_fluxes kernels
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+// columns of the per-cell temporaries passed between the bareground_fluxes stages
+// the fixture column is vegetated, frac_veg_nosno is set to 0 so the bare ground path is taken
+namespace bgflux_tmp {
+enum : int { zldis, displa, dth, dqh, obu, ur, um, temp1, temp2, temp12m, temp22m, ustar, count };
+} // namespace bgflux_tmp
+
+struct BareGroundFluxesFields {
+  explicit BareGroundFluxesFields(CellFields& c)
+      : snl{c.i1("snl")}, frac_veg_nosno{c.i1_fill("frac_veg_nosno", 0)}, forc_u{c.d1_perturbed("forc_u")},
+        forc_v{c.d1_perturbed("forc_v")}, forc_q{c.d1_perturbed("forc_q")}, forc_th{c.d1_perturbed("forc_th")},
+        thm{c.d1_perturbed("thm")}, thv{c.d1_perturbed("thv")}, t_grnd{c.d1_perturbed("t_grnd")},
+        qg{c.d1_perturbed("qg")}, z0mg{c.d1("z0mg")}, dlrad{c.d1("dlrad")}, ulrad{c.d1("ulrad")},
+        forc_hgt_t_patch{c.d1("forc_hgt_t_patch")}, forc_hgt_u_patch{c.d1("forc_hgt_u_patch")},
+        forc_hgt_q_patch{c.d1("forc_hgt_q_patch")}, z0hg{c.d1("z0hg")}, z0qg{c.d1("z0qg")},
+        forc_rho{c.d1("forc_rho")}, soilbeta{c.d1("soilbeta")}, dqgdT{c.d1("dqgdT")}, htvp{c.d1("htvp")},
+        t_h2osfc{c.d1("t_h2osfc")}, qg_snow{c.d1("qg_snow")}, qg_soil{c.d1("qg_soil")},
+        qg_h2osfc{c.d1("qg_h2osfc")}, forc_pbot{c.d1_perturbed("forc_pbot")}, cgrnds{c.d1("cgrnds")},
+        cgrndl{c.d1("cgrndl")}, cgrnd{c.d1("cgrnd")}, eflx_sh_grnd{c.d1("eflx_sh_grnd")},
+        eflx_sh_tot{c.d1("eflx_sh_tot")}, eflx_sh_snow{c.d1("eflx_sh_snow")}, eflx_sh_soil{c.d1("eflx_sh_soil")},
+        eflx_sh_h2osfc{c.d1("eflx_sh_h2osfc")}, qflx_evap_soi{c.d1("qflx_evap_soi")},
+        qflx_evap_tot{c.d1("qflx_evap_tot")}, qflx_ev_snow{c.d1("qflx_ev_snow")},
+        qflx_ev_soil{c.d1("qflx_ev_soil")}, qflx_ev_h2osfc{c.d1("qflx_ev_h2osfc")}, t_ref2m{c.d1("t_ref2m")},
+        t_ref2m_r{c.d1("t_ref2m_r")}, q_ref2m{c.d1("q_ref2m")}, rh_ref2m{c.d1("rh_ref2m")},
+        rh_ref2m_r{c.d1("rh_ref2m_r")}, t_soisno{c.d2_perturbed("t_soisno")},
+        tmp{c.d2_zeros("bareground_fluxes_tmp", bgflux_tmp::count)} {}
+
+  ViewI1 snl, frac_veg_nosno;
+  ViewD1 forc_u, forc_v, forc_q, forc_th, thm, thv, t_grnd, qg, z0mg, dlrad, ulrad, forc_hgt_t_patch,
+      forc_hgt_u_patch, forc_hgt_q_patch, z0hg, z0qg, forc_rho, soilbeta, dqgdT, htvp, t_h2osfc, qg_snow, qg_soil,
+      qg_h2osfc, forc_pbot, cgrnds, cgrndl, cgrnd, eflx_sh_grnd, eflx_sh_tot, eflx_sh_snow, eflx_sh_soil,
+      eflx_sh_h2osfc, qflx_evap_soi, qflx_evap_tot, qflx_ev_snow, qflx_ev_soil, qflx_ev_h2osfc, t_ref2m, t_ref2m_r,
+      q_ref2m, rh_ref2m, rh_ref2m_r;
+  ViewD2 t_soisno;
+  ViewD2 tmp;
+};
+
+struct BareGroundFluxesInit {
+  BareGroundFluxesInit(const ELM::LandType& Land, const BareGroundFluxesFields& f) : Land_{Land}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    namespace T = bgflux_tmp;
+    const auto& tmp = f_.tmp;
+    ELM::bareground_fluxes::initialize_flux(
+        Land_, f_.frac_veg_nosno(i), f_.forc_u(i), f_.forc_v(i), f_.forc_q(i), f_.forc_th(i), f_.forc_hgt_u_patch(i),
+        f_.thm(i), f_.thv(i), f_.t_grnd(i), f_.qg(i), f_.z0mg(i), f_.dlrad(i), f_.ulrad(i), tmp(i, T::zldis),
+        tmp(i, T::displa), tmp(i, T::dth), tmp(i, T::dqh), tmp(i, T::obu), tmp(i, T::ur), tmp(i, T::um));
+  }
+
+private:
+  ELM::LandType Land_;
+  BareGroundFluxesFields f_;
+};
+
+struct BareGroundFluxesStability {
+  BareGroundFluxesStability(const ELM::LandType& Land, const BareGroundFluxesFields& f) : Land_{Land}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    namespace T = bgflux_tmp;
+    const auto& tmp = f_.tmp;
+    ELM::bareground_fluxes::stability_iteration(
+        Land_, f_.frac_veg_nosno(i), f_.forc_hgt_t_patch(i), f_.forc_hgt_u_patch(i), f_.forc_hgt_q_patch(i),
+        f_.z0mg(i), tmp(i, T::zldis), tmp(i, T::displa), tmp(i, T::dth), tmp(i, T::dqh), tmp(i, T::ur),
+        f_.forc_q(i), f_.forc_th(i), f_.thv(i), f_.z0hg(i), f_.z0qg(i), tmp(i, T::obu), tmp(i, T::um),
+        tmp(i, T::temp1), tmp(i, T::temp2), tmp(i, T::temp12m), tmp(i, T::temp22m), tmp(i, T::ustar));
+  }
+
+private:
+  ELM::LandType Land_;
+  BareGroundFluxesFields f_;
+};
+
+struct BareGroundFluxesCompute {
+  BareGroundFluxesCompute(const ELM::LandType& Land, const BareGroundFluxesFields& f) : Land_{Land}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    namespace T = bgflux_tmp;
+    const auto& tmp = f_.tmp;
+    ELM::bareground_fluxes::compute_flux(
+        Land_, f_.frac_veg_nosno(i), f_.snl(i), f_.forc_rho(i), f_.soilbeta(i), f_.dqgdT(i), f_.htvp(i),
+        f_.t_h2osfc(i), f_.qg_snow(i), f_.qg_soil(i), f_.qg_h2osfc(i), cell_row(f_.t_soisno, i), f_.forc_pbot(i),
+        tmp(i, T::dth), tmp(i, T::dqh), tmp(i, T::temp1), tmp(i, T::temp2), tmp(i, T::temp12m), tmp(i, T::temp22m),
+        tmp(i, T::ustar), f_.forc_q(i), f_.thm(i), f_.cgrnds(i), f_.cgrndl(i), f_.cgrnd(i), f_.eflx_sh_grnd(i),
+        f_.eflx_sh_tot(i), f_.eflx_sh_snow(i), f_.eflx_sh_soil(i), f_.eflx_sh_h2osfc(i), f_.qflx_evap_soi(i),
+        f_.qflx_evap_tot(i), f_.qflx_ev_snow(i), f_.qflx_ev_soil(i), f_.qflx_ev_h2osfc(i), f_.t_ref2m(i),
+        f_.t_ref2m_r(i), f_.q_ref2m(i), f_.rh_ref2m(i), f_.rh_ref2m_r(i));
+  }
+
+private:
+  ELM::LandType Land_;
+  BareGroundFluxesFields f_;
+};
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// snow_snicar kernels
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+using SnicarTables = ELM::SnicarData<ViewD1, ViewD2, ViewD3>;
+
+// fill a SNICAR optics table from the SnowOptics fixture variable of the same name, stored row-major
+template <class View_t, class Fill>
+void fill_table(const CellFields& optics, View_t& v, const size_t size, Fill&& fill) {
+  const auto& vals = optics.get(v.label());
+  if (vals.size() != size) {
+    throw std::runtime_error("ELM ERROR: SnowOptics variable " + v.label() + " has " + std::to_string(vals.size()) +
+                             " values, expected " + std::to_string(size));
+  }
+  auto h_v = host_copy(v);
+  fill(h_v, vals);
+  NS::deep_copy(v, h_v);
+}
+
+void fill_table(const CellFields& optics, ViewD1& v) {
+  fill_table(optics, v, v.extent(0), [](auto& h_v, const std::vector<double>& vals) {
+    for (int i = 0; i < static_cast<int>(h_v.extent(0)); ++i) {
+      h_v(i) = vals[i];
+    }
+  });
+}
+
+void fill_table(const CellFields& optics, ViewD2& v) {
+  fill_table(optics, v, v.extent(0) * v.extent(1), [](auto& h_v, const std::vector<double>& vals) {
+    const int n1 = h_v.extent(1);
+    for (int i = 0; i < static_cast<int>(h_v.extent(0)); ++i) {
+      for (int j = 0; j < n1; ++j) {
+        h_v(i, j) = vals[i * n1 + j];
+      }
+    }
+  });
+}
+
+void fill_table(const CellFields& optics, ViewD3& v) {
+  fill_table(optics, v, v.extent(0) * v.extent(1) * v.extent(2), [](auto& h_v, const std::vector<double>& vals) {
+    const int n1 = h_v.extent(1);
+    const int n2 = h_v.extent(2);
+    for (int i = 0; i < static_cast<int>(h_v.extent(0)); ++i) {
+      for (int j = 0; j < n1; ++j) {
+        for (int k = 0; k < n2; ++k) {
+          h_v(i, j, k) = vals[(i * n1 + j) * n2 + k];
+        }
+      }
+    }
+  });
+}
+
+SnicarTables fixture_snicar_tables(const CellFields& optics) {
+  SnicarTables t;
+  for (auto* v : {&t.ss_alb_oc1, &t.asm_prm_oc1, &t.ext_cff_mss_oc1, &t.ss_alb_oc2, &t.asm_prm_oc2,
+                  &t.ext_cff_mss_oc2, &t.ss_alb_dst1, &t.asm_prm_dst1, &t.ext_cff_mss_dst1, &t.ss_alb_dst2,
+                  &t.asm_prm_dst2, &t.ext_cff_mss_dst2, &t.ss_alb_dst3, &t.asm_prm_dst3, &t.ext_cff_mss_dst3,
+                  &t.ss_alb_dst4, &t.asm_prm_dst4, &t.ext_cff_mss_dst4}) {
+    fill_table(optics, *v);
+  }
+  for (auto* v : {&t.ss_alb_snw_drc, &t.asm_prm_snw_drc, &t.ext_cff_mss_snw_drc, &t.ss_alb_snw_dfs,
+                  &t.asm_prm_snw_dfs, &t.ext_cff_mss_snw_dfs, &t.ss_alb_bc1, &t.asm_prm_bc1, &t.ext_cff_mss_bc1,
+                  &t.ss_alb_bc2, &t.asm_prm_bc2, &t.ext_cff_mss_bc2}) {
+    fill_table(optics, *v);
+  }
+  fill_table(optics, t.bcenh);
+  return t;
+}
+
+// synthetic snowpack with 50% snow cover - the first half of the cells is snow-free and the
+// snowpack in the second half deepens from 1 to nlevsno layers along the cell index
+int synthetic_snl(const int i, const int ncells) {
+  const int nsnow = ncells / 2;
+  const int first = ncells - nsnow;
+  return i < first ? 0 : 1 + (ELM::ELMdims::nlevsno * (i - first)) / nsnow;
+}
+
+// ice mass of snow layer j, layers above the top snow layer are empty
+double synthetic_h2osoi_ice(const int i, const int j, const int ncells) {
+  const bool active = j >= ELM::ELMdims::nlevsno - synthetic_snl(i, ncells);
+  return active ? 20.0 * (1.0 + 0.2 * cell_noise(i * ELM::ELMdims::nlevsno + j, "h2osoi_ice")) : 0.0;
+}
+
+double synthetic_h2osoi_liq(const int i, const int j, const int ncells) {
+  const bool active = j >= ELM::ELMdims::nlevsno - synthetic_snl(i, ncells);
+  return active ? 0.5 : 0.0;
+}
+
+// grain radius grows with depth below the top snow layer [microns]
+double synthetic_snw_rds(const int i, const int j, const int ncells) {
+  const int top = ELM::ELMdims::nlevsno - synthetic_snl(i, ncells);
+  return j >= top ? 80.0 + 60.0 * (j - top) : 0.0;
+}
+
+struct SnowFields {
+  explicit SnowFields(CellFields& c)
+      : snl{c.i1_cells("snl", [n = c.ncells()](const int i) { return synthetic_snl(i, n); })},
+        snl_top{c.i1_fill("snl_top", 0)}, snl_btm{c.i1_fill("snl_btm", 0)}, flg_nosnl{c.i1_fill("flg_nosnl", 0)},
+        coszen{c.d1("coszen")}, h2osno{c.d1_cells("h2osno", [n = c.ncells()](const int i) {
+          double mass = 0.0;
+          for (int j = 0; j < ELM::ELMdims::nlevsno; ++j) {
+            mass += synthetic_h2osoi_ice(i, j, n) + synthetic_h2osoi_liq(i, j, n);
+          }
+          return mass;
+        })},
+        mu_not{c.d1_zeros("mu_not")},
+        h2osoi_liq{c.d2_cells("h2osoi_liq", ELM::ELMdims::nlevsno,
+                              [n = c.ncells()](const int i, const int j) { return synthetic_h2osoi_liq(i, j, n); })},
+        h2osoi_ice{c.d2_cells("h2osoi_ice", ELM::ELMdims::nlevsno,
+                              [n = c.ncells()](const int i, const int j) { return synthetic_h2osoi_ice(i, j, n); })},
+        snw_rds{c.d2_cells("snw_rds", ELM::ELMdims::nlevsno,
+                           [n = c.ncells()](const int i, const int j) { return synthetic_snw_rds(i, j, n); })},
+        albsoi{c.d2("albsoi")}, h2osoi_ice_lcl{c.d2_zeros("h2osoi_ice_lcl", ELM::ELMdims::nlevsno)},
+        h2osoi_liq_lcl{c.d2_zeros("h2osoi_liq_lcl", ELM::ELMdims::nlevsno)},
+        flx_slrd_lcl{c.d2_zeros("flx_slrd_lcl", ELM::ELMdims::numrad_snw)},
+        flx_slri_lcl{c.d2_zeros("flx_slri_lcl", ELM::ELMdims::numrad_snw)},
+        albout_lcl{c.d2_zeros("albout_lcl", ELM::ELMdims::numrad_snw)},
+        albsnd{c.d2_zeros("albsnd", ELM::ELMdims::numrad)},
+        snw_rds_lcl{c.i2_zeros("snw_rds_lcl", ELM::ELMdims::nlevsno)},
+        mss_cnc_aer_in_fdb{c.d3_zeros("mss_cnc_aer_in_fdb", ELM::ELMdims::nlevsno, ELM::ELMdims::sno_nbr_aer)},
+        g_star{c.d3_zeros("g_star", ELM::ELMdims::numrad_snw, ELM::ELMdims::nlevsno)},
+        omega_star{c.d3_zeros("omega_star", ELM::ELMdims::numrad_snw, ELM::ELMdims::nlevsno)},
+        tau_star{c.d3_zeros("tau_star", ELM::ELMdims::numrad_snw, ELM::ELMdims::nlevsno)},
+        flx_abs_lcl{c.d3_zeros("flx_abs_lcl", ELM::ELMdims::nlevsno + 1, ELM::ELMdims::numrad_snw)},
+        flx_absd_snw{c.d3_zeros("flx_absd_snw", ELM::ELMdims::nlevsno + 1, ELM::ELMdims::numrad)} {}
+
+  ViewI1 snl, snl_top, snl_btm, flg_nosnl;
+  ViewD1 coszen, h2osno, mu_not;
+  ViewD2 h2osoi_liq, h2osoi_ice, snw_rds, albsoi, h2osoi_ice_lcl, h2osoi_liq_lcl, flx_slrd_lcl, flx_slri_lcl;
+  ViewD2 albout_lcl, albsnd;
+  ViewI2 snw_rds_lcl;
+  ViewD3 mss_cnc_aer_in_fdb, g_star, omega_star, tau_star, flx_abs_lcl, flx_absd_snw;
+};
+
+// direct-beam SNICAR, as called for each cell by the driver
+struct SnowSnicar {
+  SnowSnicar(const ELM::LandType& Land, const SnicarTables& t, const SnowFields& f) : Land_{Land}, t_{t}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    const int flg_slr_in = 1;
+    ELM::snow_snicar::init_timestep(
+        Land_.urbpoi, flg_slr_in, f_.coszen(i), f_.h2osno(i), f_.snl(i), cell_row(f_.h2osoi_liq, i),
+        cell_row(f_.h2osoi_ice, i), cell_row(f_.snw_rds, i), f_.snl_top(i), f_.snl_btm(i),
+        cell_slab(f_.flx_abs_lcl, i), cell_slab(f_.flx_absd_snw, i), f_.flg_nosnl(i), cell_row(f_.h2osoi_ice_lcl, i),
+        cell_row(f_.h2osoi_liq_lcl, i), cell_row(f_.snw_rds_lcl, i), f_.mu_not(i), cell_row(f_.flx_slrd_lcl, i),
+        cell_row(f_.flx_slri_lcl, i));
+
+    ELM::snow_snicar::snow_aerosol_mie_params(
+        Land_.urbpoi, flg_slr_in, f_.snl_top(i), f_.snl_btm(i), f_.coszen(i), f_.h2osno(i),
+        cell_row(f_.snw_rds_lcl, i), cell_row(f_.h2osoi_ice_lcl, i), cell_row(f_.h2osoi_liq_lcl, i), t_.ss_alb_oc1,
+        t_.asm_prm_oc1, t_.ext_cff_mss_oc1, t_.ss_alb_oc2, t_.asm_prm_oc2, t_.ext_cff_mss_oc2, t_.ss_alb_dst1,
+        t_.asm_prm_dst1, t_.ext_cff_mss_dst1, t_.ss_alb_dst2, t_.asm_prm_dst2, t_.ext_cff_mss_dst2, t_.ss_alb_dst3,
+        t_.asm_prm_dst3, t_.ext_cff_mss_dst3, t_.ss_alb_dst4, t_.asm_prm_dst4, t_.ext_cff_mss_dst4,
+        t_.ss_alb_snw_drc, t_.asm_prm_snw_drc, t_.ext_cff_mss_snw_drc, t_.ss_alb_snw_dfs, t_.asm_prm_snw_dfs,
+        t_.ext_cff_mss_snw_dfs, t_.ss_alb_bc1, t_.asm_prm_bc1, t_.ext_cff_mss_bc1, t_.ss_alb_bc2, t_.asm_prm_bc2,
+        t_.ext_cff_mss_bc2, t_.bcenh, cell_slab(f_.mss_cnc_aer_in_fdb, i), cell_slab(f_.g_star, i),
+        cell_slab(f_.omega_star, i), cell_slab(f_.tau_star, i));
+
+    ELM::snow_snicar::snow_radiative_transfer_solver(
+        Land_.urbpoi, flg_slr_in, f_.flg_nosnl(i), f_.snl_top(i), f_.snl_btm(i), f_.coszen(i), f_.h2osno(i),
+        f_.mu_not(i), cell_row(f_.flx_slrd_lcl, i), cell_row(f_.flx_slri_lcl, i), cell_row(f_.albsoi, i),
+        cell_slab(f_.g_star, i), cell_slab(f_.omega_star, i), cell_slab(f_.tau_star, i), cell_row(f_.albout_lcl, i),
+        cell_slab(f_.flx_abs_lcl, i));
+
+    ELM::snow_snicar::snow_albedo_radiation_factor(
+        Land_.urbpoi, flg_slr_in, f_.snl_top(i), f_.coszen(i), f_.mu_not(i), f_.h2osno(i),
+        cell_row(f_.snw_rds_lcl, i), cell_row(f_.albsoi, i), cell_row(f_.albout_lcl, i),
+        cell_slab(f_.flx_abs_lcl, i), cell_row(f_.albsnd, i), cell_slab(f_.flx_absd_snw, i));
+  }
+
+private:
+  ELM::LandType Land_;
+  SnicarTables t_;
+  SnowFields f_;
+};
+
+// SNICAR outputs of every cell, on the host
+std::vector<double> snicar_outputs(const SnowFields& f) {
+  std::vector<double> vals;
+  const auto h_albsnd = host_copy(f.albsnd);
+  const auto h_flx_absd_snw = host_copy(f.flx_absd_snw);
+  for (int i = 0; i < static_cast<int>(f.albsnd.extent(0)); ++i) {
+    for (int ib = 0; ib < ELM::ELMdims::numrad; ++ib) {
+      vals.push_back(h_albsnd(i, ib));
+      for (int j = 0; j <= ELM::ELMdims::nlevsno; ++j) {
+        vals.push_back(h_flx_absd_snw(i, j, ib));
+      }
+    }
+  }
+  return vals;
+}
+
+#ifndef ENABLE_KOKKOS
+// use the host schedule kind for the lifetime of the object
+class ScopedHostSchedule {
+public:
+  ScopedHostSchedule(const ELM::HostSchedule::Kind& kind, const int& chunk) : saved_{ELM::host_schedule()} {
+    ELM::set_host_schedule(kind, chunk, saved_.min_parallel);
+  }
+  ~ScopedHostSchedule() { ELM::host_schedule() = saved_; }
+
+private:
+  ELM::HostSchedule saved_;
+};
+#endif
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// driver
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+struct Options {
+  std::string data_dir{ELM_TEST_DATA_DIR};
+  int ncells{65536};
+  int nreps{10};
+  double perturb{0.01};
+  std::string filter;
+  std::string baseline;
+  std::string write_baseline;
+  double tolerance{0.10};
+  int nlevcan{ELM::ELMdims::nlevcan};
+  int suction_npts{0};
+};
+
+struct Benchmark {
+  std::string name;
+  CellFields* cells;
+  std::function<void()> prepare; // untimed, runs the upstream kernels
+  std::function<void()> run;     // timed
+};
+
+struct Result {
+  std::string name;
+  double min_ns, median_ns; // per cell
+};
+
+Result time_benchmark(const Benchmark& bench, const int nreps) {
+  const int ncells = bench.cells->ncells();
+  std::vector<double> times;
+  for (int rep = -1; rep < nreps; ++rep) { // rep -1 is warm-up
+    bench.cells->reset();
+    bench.prepare();
+    fence();
+    const auto t0 = std::chrono::steady_clock::now();
+    bench.run();
+    fence();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - t0;
+    if (rep >= 0) {
+      times.push_back(elapsed.count() / ncells);
+    }
+  }
+  std::sort(times.begin(), times.end());
+  return {bench.name, times.front(), times[times.size() / 2]};
+}
+
+std::map<std::string, double> read_baseline(const std::string& filename) {
+  std::ifstream in_file(filename);
+  if (!in_file) {
+    throw std::runtime_error("ELM ERROR: can't open baseline file " + filename);
+  }
+  std::map<std::string, double> baseline;
+  std::string line_str, name;
+  while (std::getline(in_file, line_str)) {
+    std::istringstream line_ss(line_str);
+    double ns;
+    if (line_str.empty() || line_str[0] == '#' || !(line_ss >> name >> ns)) {
+      continue;
+    }
+    baseline[name] = ns;
+  }
+  return baseline;
+}
+
+void write_baseline(const std::string& filename, const Options& opts, const std::vector<Result>& results) {
+  std::ofstream out_file(filename);
+  if (!out_file) {
+    throw std::runtime_error("ELM ERROR: can't open baseline file " + filename);
+  }
+  out_file << "# kernel median_ns_per_cell\n";
+  out_file << "# backend " << backend_name() << " cells " << opts.ncells << " reps " << opts.nreps << " perturb "
+           << opts.perturb << "\n";
+  for (const auto& r : results) {
+    out_file << r.name << " " << std::setprecision(6) << r.median_ns << "\n";
+  }
+}
+
+// first cell is unperturbed and must reproduce the fixture output
+bool check_two_stream(const CellFields& out, const SurfaceAlbedoFields& f, const std::string& solver) {
+  bool same = true;
+  auto compare = [&](const ViewD2& arr) {
+    const auto h_arr = host_copy(arr);
+    const auto& expected = out.get(arr.label());
+    for (int j = 0; j < static_cast<int>(expected.size()); ++j) {
+      if (!ELM::IO::IsAlmostEqual(h_arr(0, j), expected[j], 1.0e-10)) {
+        std::cout << std::setprecision(15) << "    " << solver << " mismatch " << arr.label() << "(0, " << j
+                  << ") " << h_arr(0, j) << " != " << expected[j] << std::endl;
+        same = false;
+      }
+    }
+  };
+  for (const auto& arr : {f.albd, f.albi, f.fabd, f.fabi, f.ftdd, f.ftid, f.ftii}) {
+    compare(arr);
+  }
+  return same;
+}
+
+// largest relative difference between two sets of values
+double max_rel_diff(const std::vector<double>& a, const std::vector<double>& b) {
+  double diff = 0.0;
+  for (size_t i = 0; i != a.size(); ++i) {
+    diff = std::max(diff, std::abs(a[i] - b[i]) / std::max(std::abs(a[i]), 1.0e-30));
+  }
+  return diff;
+}
+
+// canopy_layer_lai() outputs of every cell, on the host
+std::vector<double> canopy_layer_outputs(const SurfaceAlbedoFields& f) {
+  std::vector<double> vals;
+  for (const auto& arr : {f.tlai_z, f.tsai_z, f.fsun_z, f.fabd_sun_z, f.fabd_sha_z, f.fabi_sun_z, f.fabi_sha_z}) {
+    const auto h_arr = host_copy(arr);
+    for (int i = 0; i < static_cast<int>(arr.extent(0)); ++i) {
+      for (int j = 0; j < static_cast<int>(arr.extent(1)); ++j) {
+        vals.push_back(h_arr(i, j));
+      }
+    }
+  }
+  const auto h_nrad = host_copy(f.nrad);
+  const auto h_ncan = host_copy(f.ncan);
+  for (int i = 0; i < static_cast<int>(f.nrad.extent(0)); ++i) {
+    vals.push_back(h_nrad(i));
+    vals.push_back(h_ncan(i));
+  }
+  return vals;
+}
+
+// two-stream outputs of every cell, on the host
+std::vector<double> two_stream_outputs(const SurfaceAlbedoFields& f) {
+  std::vector<double> vals;
+  for (const auto& arr : {f.albd, f.albi, f.fabd, f.fabd_sun, f.fabd_sha, f.fabi, f.fabi_sun, f.fabi_sha, f.ftdd,
+                          f.ftid, f.ftii, f.fsun_z, f.fabd_sun_z, f.fabd_sha_z, f.fabi_sun_z, f.fabi_sha_z}) {
+    const auto h_arr = host_copy(arr);
+    for (int i = 0; i < static_cast<int>(arr.extent(0)); ++i) {
+      for (int j = 0; j < static_cast<int>(arr.extent(1)); ++j) {
+        vals.push_back(h_arr(i, j));
+      }
+    }
+  }
+  for (const auto& arr : {f.vcmaxcintsun, f.vcmaxcintsha}) {
+    const auto h_arr = host_copy(arr);
+    for (int i = 0; i < static_cast<int>(arr.extent(0)); ++i) {
+      vals.push_back(h_arr(i));
+    }
+  }
+  return vals;
+}
+
+int run_benchmarks(const Options& opts) {
+  const auto Land = fixture_land();
+  const double dtime = 1800.0;
+  const int n = opts.ncells;
+
+  // daytime steps, so the radiation and photosynthesis paths are exercised
+  CellFields alb_cells(opts.data_dir + "/SurfaceAlbedo_OUT.txt", 17, n, opts.perturb);
+  CellFields can_cells(opts.data_dir + "/CanopyFluxes_IN.txt", 2, n, opts.perturb);
+  CellFields bg_cells(opts.data_dir + "/BareGroundFluxes_IN.txt", 2, n, opts.perturb);
+  CellFields snow_cells(opts.data_dir + "/SurfaceAlbedo_IN.txt", 17, n, opts.perturb);
+  const CellFields snow_optics(opts.data_dir + "/SnowOptics_IN.txt", 0, 1, 0.0);
+
+  const SurfaceAlbedoFields alb(alb_cells, opts.nlevcan);
+  alb_cells.reset();
+  check_canopy_layers(alb, opts.nlevcan);
+  const auto alb_pft = fixture_alb_pft(alb_cells, Land.vtype);
+  const CanopyFluxesFields can(can_cells);
+  const BareGroundFluxesFields bg(bg_cells);
+  const SnowFields snow(snow_cells);
+
+  const auto launch = [n](auto&& kernel, const std::string& name) {
+    invoke_kernel(kernel, std::make_tuple(n), name);
+  };
+
+  CanopyLayerLAI canopy_layer_lai(Land, alb);
+  ZeroCanopyLayerFluxes zero_canopy_layer_fluxes(Land, alb);
+  ELM::ChangeTracker<ViewI1, ViewD2> lai_tracker(n, 4);
+  const auto canopy_layer_lai_tracked = [&]() {
+    lai_tracker.update(std::array<ViewD1, 4>{alb.elai, alb.esai, alb.tlai, alb.tsai});
+    ELM::invoke_dirty_kernel(lai_tracker, canopy_layer_lai, zero_canopy_layer_fluxes, "canopy_layer_lai");
+  };
+  TwoStreamSolver two_stream(Land, alb_pft, alb);
+  const auto cell_pft = fixture_cell_pft(alb_pft, n);
+  const ViewI1 two_stream_path("two_stream_path", n);
+  const auto two_stream_blocks = two_stream_batch(Land, cell_pft, two_stream_path, alb);
+  CanopyFluxesInit can_init(Land, fixture_psn_pft, can);
+  std::unique_ptr<ELM::soil_moist_stress::SuctionTable<ViewD3>> suction_table;
+  CanopyFluxesInit can_init_tabulated(can_init);
+  if (opts.suction_npts > 0) {
+    suction_table = std::make_unique<ELM::soil_moist_stress::SuctionTable<ViewD3>>(n, opts.suction_npts);
+    const auto smpso = can_cells.d1_cells("smpso", [](int) { return fixture_psn_pft.smpso; });
+    const auto smpsc = can_cells.d1_cells("smpsc", [](int) { return fixture_psn_pft.smpsc; });
+    // sucsat and bsw are time-invariant - the table is built once, outside the timed loop, like in a model run
+    can_cells.reset();
+    suction_table->build(can.sucsat, can.bsw, smpso, smpsc);
+    can_init_tabulated = CanopyFluxesInit(Land, fixture_psn_pft, can, suction_table->tables());
+  }
+  CanopyFluxesStability can_stability(Land, fixture_psn_pft, dtime, can);
+  CanopyFluxesCompute can_compute(Land, dtime, can);
+  Photosynthesis psn(fixture_psn_pft, can);
+  PhotosynthesisTeam psn_team(fixture_psn_pft, can);
+  BareGroundFluxesInit bg_init(Land, bg);
+  BareGroundFluxesStability bg_stability(Land, bg);
+  BareGroundFluxesCompute bg_compute(Land, bg);
+  ELM::StateValidator validator(n, ELM::StateValidator::Action::Throw);
+  const auto validate_canopy_fluxes = [&]() {
+    namespace V = ELM::validation;
+    validator.check("canopy_fluxes", V::bounds("t_grnd", can.t_grnd, 150.0, 400.0),
+                    V::bounds("t_veg", can.t_veg, 150.0, 400.0), V::nonnegative("h2osoi_liq", can.h2osoi_liq),
+                    V::nonnegative("h2osoi_ice", can.h2osoi_ice), V::nonnegative("h2ocan", can.h2ocan),
+                    V::finite("eflx_sh_grnd", can.eflx_sh_grnd), V::finite("qflx_evap_soi", can.qflx_evap_soi),
+                    V::finite("t_ref2m", can.t_ref2m), V::finite("canopy_err", can.canopy_err));
+  };
+  SnowSnicar snicar(Land, fixture_snicar_tables(snow_optics), snow);
+  ELM::SnowBins<ViewI1> snow_bins(n);
+  const auto snicar_static = [&]() {
+#ifndef ENABLE_KOKKOS
+    ScopedHostSchedule schedule(ELM::HostSchedule::Kind::Static, 0);
+#endif
+    launch(snicar, "snicar");
+  };
+  const auto snicar_binned = [&]() {
+    snow_bins.update(snow.snl);
+    ELM::invoke_binned_kernel(snow_bins, snicar, "snicar");
+  };
+
+  const auto nothing = []() {};
+  std::vector<Benchmark> benchmarks = {
+      {"surface_albedo::canopy_layer_lai", &alb_cells, nothing,
+       [&]() { launch(canopy_layer_lai, "canopy_layer_lai"); }},
+      {"surface_albedo::canopy_layer_lai (tracked)", &alb_cells, nothing, canopy_layer_lai_tracked},
+      {"surface_albedo::two_stream_solver", &alb_cells, [&]() { launch(canopy_layer_lai, "canopy_layer_lai"); },
+       [&]() { launch(two_stream, "two_stream_solver"); }},
+      {"surface_albedo::ComputeTwoStream", &alb_cells, [&]() { launch(canopy_layer_lai, "canopy_layer_lai"); },
+       [&]() { ELM::surface_albedo::invoke_two_stream_solver(two_stream_blocks, n); }},
+      {"photosynthesis::photosynthesis", &can_cells, [&]() { launch(can_init, "canopy_fluxes_init"); },
+       [&]() { launch(psn, "photosynthesis"); }},
+      {"photosynthesis::photosynthesis (team)", &can_cells, [&]() { launch(can_init, "canopy_fluxes_init"); },
+       [&]() { invoke_team_kernel(psn_team, std::make_tuple(n), "photosynthesis_team"); }},
+      {"canopy_fluxes::initialize_flux", &can_cells, nothing, [&]() { launch(can_init, "canopy_fluxes_init"); }},
+      {"canopy_fluxes::stability_iteration", &can_cells, [&]() { launch(can_init, "canopy_fluxes_init"); },
+       [&]() { launch(can_stability, "canopy_fluxes_stability"); }},
+      {"canopy_fluxes::compute_flux", &can_cells,
+       [&]() {
+         launch(can_init, "canopy_fluxes_init");
+         launch(can_stability, "canopy_fluxes_stability");
+       },
+       [&]() { launch(can_compute, "canopy_fluxes_compute"); }},
+      {"bareground_fluxes::initialize_flux", &bg_cells, nothing, [&]() { launch(bg_init, "bareground_fluxes_init"); }},
+      {"bareground_fluxes::stability_iteration", &bg_cells, [&]() { launch(bg_init, "bareground_fluxes_init"); },
+       [&]() { launch(bg_stability, "bareground_fluxes_stability"); }},
+      {"bareground_fluxes::compute_flux", &bg_cells,
+       [&]() {
+         launch(bg_init, "bareground_fluxes_init");
+         launch(bg_stability, "bareground_fluxes_stability");
+       },
+       [&]() { launch(bg_compute, "bareground_fluxes_compute"); }},
+      {"state_validation::check", &can_cells,
+       [&]() {
+         launch(can_init, "canopy_fluxes_init");
+         launch(can_stability, "canopy_fluxes_stability");
+         launch(can_compute, "canopy_fluxes_compute");
+       },
+       validate_canopy_fluxes},
+      {"snow_snicar::snicar (static)", &snow_cells, nothing, snicar_static},
+#ifndef ENABLE_KOKKOS
+      {"snow_snicar::snicar (dynamic)", &snow_cells, nothing,
+       [&]() {
+         ScopedHostSchedule schedule(ELM::HostSchedule::Kind::Dynamic, 16);
+         launch(snicar, "snicar");
+       }},
+#endif
+      {"snow_snicar::snicar (snl bins)", &snow_cells, nothing, snicar_binned},
+  };
+  if (suction_table) {
+    const auto itr = std::find_if(benchmarks.begin(), benchmarks.end(),
+                                  [](const Benchmark& b) { return b.name == "canopy_fluxes::initialize_flux"; });
+    benchmarks.insert(std::next(itr), Benchmark{"canopy_fluxes::initialize_flux (table)", &can_cells, nothing,
+                                                [&]() { launch(can_init_tabulated, "canopy_fluxes_init"); }});
+  }
+
+  std::map<std::string, double> baseline;
+  if (!opts.baseline.empty()) {
+    baseline = read_baseline(opts.baseline);
+  }
+
+  std::cout << "backend " << backend_name() << ", " << n << " cells, " << opts.nreps << " reps, perturbation "
+            << opts.perturb << ", " << opts.nlevcan << " canopy layers\n\n";
+  std::cout << std::left << std::setw(42) << "kernel" << std::right << std::setw(14) << "min ns/cell" << std::setw(14)
+            << "med ns/cell" << std::setw(14) << "Mcells/s" << std::setw(14) << "baseline" << std::setw(10) << "ratio"
+            << "\n";
+
+  std::vector<Result> results;
+  int nregressions = 0;
+  for (const auto& bench : benchmarks) {
+    if (bench.name.find(opts.filter) == std::string::npos) {
+      continue;
+    }
+    const auto r = time_benchmark(bench, opts.nreps);
+    results.push_back(r);
+
+    std::cout << std::left << std::setw(42) << r.name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << r.min_ns << std::setw(14) << r.median_ns << std::setprecision(3) << std::setw(14)
+              << 1.0e3 / r.median_ns;
+    auto itr = baseline.find(r.name);
+    if (itr != baseline.end()) {
+      const double ratio = r.median_ns / itr->second;
+      const bool regressed = ratio > 1.0 + opts.tolerance;
+      nregressions += regressed;
+      std::cout << std::setprecision(1) << std::setw(14) << itr->second << std::setprecision(3) << std::setw(10)
+                << ratio << (regressed ? "  REGRESSION" : "");
+    }
+    std::cout << std::defaultfloat << std::endl;
+  }
+
+  // both solvers must reproduce the fixture for cell 0, and agree with each other on every cell
+  int status = 0;
+  const auto matches = [&opts](const std::string& name) { return name.find(opts.filter) != std::string::npos; };
+  if (matches("surface_albedo::two_stream_solver") || matches("surface_albedo::ComputeTwoStream")) {
+    alb_cells.reset();
+    launch(canopy_layer_lai, "canopy_layer_lai");
+    launch(two_stream, "two_stream_solver");
+    fence();
+    const auto expected = two_stream_outputs(alb);
+    if (!check_two_stream(alb_cells, alb, "two_stream_solver")) {
+      std::cout << "ELM ERROR: two_stream_solver does not reproduce SurfaceAlbedo_OUT.txt for cell 0" << std::endl;
+      status = 1;
+    }
+
+    alb_cells.reset();
+    launch(canopy_layer_lai, "canopy_layer_lai");
+    ELM::surface_albedo::invoke_two_stream_solver(two_stream_blocks, n);
+    fence();
+    const auto batched = two_stream_outputs(alb);
+    if (!check_two_stream(alb_cells, alb, "ComputeTwoStream")) {
+      std::cout << "ELM ERROR: ComputeTwoStream does not reproduce SurfaceAlbedo_OUT.txt for cell 0" << std::endl;
+      status = 1;
+    }
+    const double diff = max_rel_diff(expected, batched);
+    if (diff > 1.0e-12) {
+      std::cout << "ELM ERROR: ComputeTwoStream differs from two_stream_solver, max relative difference " << diff
+                << std::endl;
+      status = 1;
+    }
+  }
+
+  // skipping unchanged cells must not change the canopy layers
+  if (matches("surface_albedo::canopy_layer_lai (tracked)")) {
+    alb_cells.reset();
+    launch(canopy_layer_lai, "canopy_layer_lai");
+    fence();
+    const auto expected = canopy_layer_outputs(alb);
+
+    // a step with unchanged lai, after the layer fluxes were overwritten by a later stage
+    alb_cells.reset();
+    lai_tracker.invalidate();
+    canopy_layer_lai_tracked();
+    launch(two_stream, "two_stream_solver");
+    canopy_layer_lai_tracked();
+    fence();
+    const size_t nskipped = n - lai_tracker.count_dirty();
+    if (canopy_layer_outputs(alb) != expected || nskipped != static_cast<size_t>(n)) {
+      std::cout << "ELM ERROR: tracked canopy_layer_lai differs from canopy_layer_lai with unchanged lai" << std::endl;
+      status = 1;
+    }
+
+    // a new day - lai of every other cell changes
+    for (const auto& lai : {alb.elai, alb.tlai}) {
+      auto h_lai = host_copy(lai);
+      for (int i = 0; i < n; i += 2) {
+        h_lai(i) *= 1.1;
+      }
+      NS::deep_copy(lai, h_lai);
+    }
+    canopy_layer_lai_tracked();
+    fence();
+    const auto tracked = canopy_layer_outputs(alb);
+    const size_t ndirty = lai_tracker.count_dirty();
+    launch(canopy_layer_lai, "canopy_layer_lai");
+    fence();
+    if (canopy_layer_outputs(alb) != tracked || ndirty != static_cast<size_t>((n + 1) / 2)) {
+      std::cout << "ELM ERROR: tracked canopy_layer_lai differs from canopy_layer_lai after a change of lai"
+                << std::endl;
+      status = 1;
+    }
+    std::cout << "\ncanopy_layer_lai (tracked): " << nskipped << " of " << n << " cells skipped with unchanged lai, "
+              << n - ndirty << " after a change of lai in every other cell" << std::endl;
+  }
+
+  // the suction table must reproduce root water stress to within its error bound
+  if (suction_table && matches("canopy_fluxes::initialize_flux (table)")) {
+    can_cells.reset();
+    launch(can_init, "canopy_fluxes_init");
+    fence();
+    const auto expected = root_stress_outputs(can);
+
+    can_cells.reset();
+    launch(can_init_tabulated, "canopy_fluxes_init");
+    fence();
+    const double diff = max_rel_diff(expected, root_stress_outputs(can));
+    if (diff > 1.0e-5) {
+      std::cout << "ELM ERROR: initialize_flux with SuctionTable differs from soil_suction(), max relative difference "
+                << diff << std::endl;
+      status = 1;
+    }
+  }
+
+  // the fused check must pass the fixture state and report the first offending cells
+  if (matches("state_validation::check") && n > 1) {
+    can_cells.reset();
+    launch(can_init, "canopy_fluxes_init");
+    launch(can_stability, "canopy_fluxes_stability");
+    launch(can_compute, "canopy_fluxes_compute");
+    fence();
+    std::string report;
+    try {
+      validate_canopy_fluxes();
+      auto h_t_veg = host_copy(can.t_veg);
+      auto h_h2osoi_liq = host_copy(can.h2osoi_liq);
+      h_t_veg(n - 1) = std::nan("");
+      h_h2osoi_liq(n / 2, 3) = -1.0;
+      NS::deep_copy(can.t_veg, h_t_veg);
+      NS::deep_copy(can.h2osoi_liq, h_h2osoi_liq);
+      validate_canopy_fluxes();
+    } catch (const std::runtime_error& e) {
+      report = e.what();
+    }
+    const std::string expected = "h2osoi_liq(" + std::to_string(n / 2) + ", 3) = -1, t_veg(" + std::to_string(n - 1);
+    if (report.find(expected) == std::string::npos || validator.nfailures() != 1) {
+      std::cout << "ELM ERROR: StateValidator did not report the injected values, got \"" << report << "\""
+                << std::endl;
+      status = 1;
+    }
+  }
+
+  // scheduling must not change the SNICAR results
+  if (matches("snow_snicar::snicar")) {
+    snow_cells.reset();
+    snicar_static();
+    fence();
+    const auto expected = snicar_outputs(snow);
+
+    snow_cells.reset();
+    snicar_binned();
+    fence();
+    if (snicar_outputs(snow) != expected) {
+      std::cout << "ELM ERROR: snicar launched over SnowBins differs from the static launch" << std::endl;
+      status = 1;
+    }
+  }
+
+  if (!opts.write_baseline.empty()) {
+    write_baseline(opts.write_baseline, opts, results);
+  }
+  if (nregressions > 0) {
+    std::cout << "\n" << nregressions << " kernel(s) slower than baseline by more than " << 100.0 * opts.tolerance
+              << "%" << std::endl;
+    status = 1;
+  }
+  return status;
+}
+
+Options parse_options(int argc, char** argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    if (arg.rfind("--kokkos", 0) == 0) {
+      continue;
+    }
+    if (i + 1 == argc) {
+      throw std::runtime_error("ELM ERROR: missing value for option " + arg);
+    }
+    const std::string val(argv[++i]);
+    if (arg == "--data-dir") {
+      opts.data_dir = val;
+    } else if (arg == "--cells") {
+      opts.ncells = std::stoi(val);
+    } else if (arg == "--reps") {
+      opts.nreps = std::stoi(val);
+    } else if (arg == "--perturb") {
+      opts.perturb = std::stod(val);
+    } else if (arg == "--filter") {
+      opts.filter = val;
+    } else if (arg == "--baseline") {
+      opts.baseline = val;
+    } else if (arg == "--tolerance") {
+      opts.tolerance = std::stod(val);
+    } else if (arg == "--write-baseline") {
+      opts.write_baseline = val;
+    } else if (arg == "--nlevcan") {
+      opts.nlevcan = std::stoi(val);
+    } else if (arg == "--suction-table") {
+      opts.suction_npts = std::stoi(val);
+    } else {
+      throw std::runtime_error("ELM ERROR: unknown option " + arg);
+    }
+  }
+  if (opts.ncells < 1 || opts.nreps < 1 || opts.nlevcan < 1) {
+    throw std::runtime_error("ELM ERROR: --cells, --reps and --nlevcan must be positive");
+  }
+  if (opts.suction_npts < 0) {
+    throw std::runtime_error("ELM ERROR: --suction-table must not be negative");
+  }
+  if (opts.nlevcan > 1 && opts.nlevcan < 4) {
+    throw std::runtime_error("ELM ERROR: --nlevcan must be 1 (big leaf) or at least 4 (multi-layer canopy)");
+  }
+  return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+#ifdef ENABLE_KOKKOS
+  Kokkos::initialize(argc, argv);
+#endif
+
+  int status = 0;
+  try {
+    status = run_benchmarks(parse_options(argc, argv));
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    status = 2;
+  }
+
+#ifdef ENABLE_KOKKOS
+  Kokkos::finalize();
+#endif
+  return status;
+}
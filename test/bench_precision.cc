@@ -0,0 +1,518 @@
+#include "array.hh"
+
+#include "elm_constants.h"
+#include "land_data.h"
+#include "pft_data.h"
+
+#include "phenology_physics.h"
+#include "surface_albedo.h"
+#include "surface_radiation.h"
+
+#include "invoke_kernel.hh"
+#include "kokkos_includes.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+
+accuracy and cost of float storage for the radiation partitioning and phenology kernels
+
+each path is run twice over the same inputs, once with every RadReal/PhenReal field stored as double
+(the baseline) and once stored as float, independent of how the tree was configured
+(ENABLE_MIXED_PRECISION only selects the type the drivers use)
+
+paths:
+two_stream        canopy_layer_lai() + two_stream_solver()   every sunlit NSTEP of SurfaceAlbedo_OUT.txt
+sunshade          canopy_sunshade_fractions()                every NSTEP of CanopySunShadeFractions_IN.txt
+absorbed          total_absorbed_radiation() + reflected_radiation(), inputs narrowed to float
+                                                             every NSTEP of SurfaceRadiation_IN.txt
+phenology         ComputePhenology                           synthetic monthly lai/sai/heights, no fixture
+                                                             holds the monthly data
+
+reported per output field: max abs and max rel difference float vs double over all fixture steps, and
+for the double run the max abs difference to the fixture value where the fixture holds the output
+(a sanity check of the baseline, not of the float run)
+
+then, per path: bytes per cell of the fields that change type and ns/cell of both runs over --cells
+cells built by cycling through the fixture steps
+
+usage:
+bench_precision [--data-dir dir] [--cells N] [--reps N]
+*/
+
+#ifndef ELM_TEST_DATA_DIR
+#define ELM_TEST_DATA_DIR "data"
+#endif
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using Step = std::map<std::string, std::vector<double>>;
+
+constexpr int numrad = ELM::ELMdims::numrad;
+constexpr int nlevcan = ELM::ELMdims::nlevcan;
+
+struct Options {
+  std::string data_dir{ELM_TEST_DATA_DIR};
+  int ncells{1 << 14};
+  int nreps{10};
+};
+
+// every NSTEP of a fixture file, in file order
+std::vector<Step> read_fixture(const std::string& filename) {
+  std::ifstream in(filename);
+  if (!in) {
+    throw std::runtime_error("ELM ERROR: can't open fixture " + filename);
+  }
+  std::vector<Step> steps;
+  std::string line_str, name;
+  while (std::getline(in, line_str)) {
+    std::istringstream line_ss(line_str);
+    line_ss >> name;
+    if (name == "NSTEP") {
+      steps.emplace_back();
+    } else if (name != "!!!" && !steps.empty()) {
+      // nan and inf are read as the special value
+      std::vector<double> values;
+      std::string tok;
+      while (line_ss >> tok) {
+        const double val = std::strtod(tok.c_str(), nullptr);
+        values.push_back(std::isfinite(val) ? val : ELM::spval);
+      }
+      steps.back()[name] = values;
+    }
+  }
+  return steps;
+}
+
+const std::vector<double>& get(const Step& step, const std::string& name) {
+  auto itr = step.find(name);
+  if (itr == step.end()) {
+    throw std::runtime_error("ELM ERROR: fixture does not contain variable " + name);
+  }
+  return itr->second;
+}
+
+ELM::LandType fixture_land() {
+  ELM::LandType Land;
+  Land.ltype = 1;
+  Land.ctype = 1;
+  Land.vtype = 12;
+  return Land;
+}
+
+ELM::PFTDataAlb fixture_alb_pft(const Step& step, const int vtype) {
+  const int numpft = get(step, "xl").size();
+  ELM::PFTDataAlb alb_pft;
+  for (int ib = 0; ib < numrad; ++ib) {
+    alb_pft.rhol[ib] = get(step, "rhol").at(ib * numpft + vtype);
+    alb_pft.rhos[ib] = get(step, "rhos").at(ib * numpft + vtype);
+    alb_pft.taul[ib] = get(step, "taul").at(ib * numpft + vtype);
+    alb_pft.taus[ib] = get(step, "taus").at(ib * numpft + vtype);
+  }
+  alb_pft.xl = get(step, "xl").at(vtype);
+  return alb_pft;
+}
+
+// (ncells, n) array of type T filled by cycling through the fixture steps
+template <typename T>
+ELM::Array<T, 2> cycle_fill(const std::vector<Step>& steps, const std::string& name, const int ncells) {
+  const int n = get(steps[0], name).size();
+  ELM::Array<T, 2> arr(name, ncells, n);
+  for (int i = 0; i < ncells; ++i) {
+    const auto& vals = get(steps[i % steps.size()], name);
+    for (int j = 0; j < n; ++j) {
+      arr(i, j) = vals[j];
+    }
+  }
+  return arr;
+}
+
+template <typename T>
+ELM::Array<T, 1> cycle_fill_1(const std::vector<Step>& steps, const std::string& name, const int ncells) {
+  ELM::Array<T, 1> arr(name, ncells);
+  for (int i = 0; i < ncells; ++i) {
+    arr(i) = get(steps[i % steps.size()], name).at(0);
+  }
+  return arr;
+}
+
+// median ns/cell of nreps calls of f
+template <class F> double time_ns_per_cell(const Options& opts, F&& f) {
+  std::vector<double> t(opts.nreps);
+  for (auto& ti : t) {
+    const auto t0 = clock_type::now();
+    f();
+    const std::chrono::duration<double, std::nano> elapsed = clock_type::now() - t0;
+    ti = elapsed.count() / opts.ncells;
+  }
+  std::sort(t.begin(), t.end());
+  return t[t.size() / 2];
+}
+
+// float vs double differences of one output field over the first nsteps cells
+struct FieldError {
+  std::string name;
+  double max_abs{0.0}, max_rel{0.0}, ref_abs{-1.0};
+};
+
+template <class ArrD, class ArrF>
+FieldError compare(const ArrD& d, const ArrF& f, const int nsteps, const std::vector<Step>* ref = nullptr) {
+  FieldError err{d.label()};
+  const int n = d.size() / d.extent(0);
+  for (int i = 0; i < nsteps; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const double vd = d.data()[i * n + j], vf = f.data()[i * n + j];
+      err.max_abs = std::max(err.max_abs, std::abs(vd - vf));
+      if (std::abs(vd) > 1.0e-12) {
+        err.max_rel = std::max(err.max_rel, std::abs(vd - vf) / std::abs(vd));
+      }
+      if (ref) {
+        err.ref_abs = std::max(err.ref_abs, std::abs(vd - get((*ref)[i], d.label()).at(j)));
+      }
+    }
+  }
+  return err;
+}
+
+// a path fails if any float output differs from the double output by more than tol
+struct PathReport {
+  std::string name;
+  double tol;
+  std::vector<FieldError> errors{};
+  size_t bytes_double{0}, bytes_float{0};
+  double ns_double{0.0}, ns_float{0.0};
+};
+
+void print(const PathReport& r) {
+  std::cout << "\n" << r.name << "\n";
+  std::cout << "  " << std::left << std::setw(20) << "field" << std::right << std::setw(14) << "max abs" << std::setw(14)
+            << "max rel" << std::setw(16) << "double vs ref" << "\n";
+  for (const auto& e : r.errors) {
+    std::cout << "  " << std::left << std::setw(20) << e.name << std::right << std::scientific << std::setprecision(3)
+              << std::setw(14) << e.max_abs << std::setw(14) << e.max_rel << std::setw(16);
+    if (e.ref_abs < 0.0) {
+      std::cout << "-";
+    } else {
+      std::cout << e.ref_abs;
+    }
+    std::cout << std::defaultfloat << "\n";
+  }
+  std::cout << std::fixed << std::setprecision(1) << "  bytes/cell " << r.bytes_double << " -> " << r.bytes_float
+            << "    ns/cell " << r.ns_double << " -> " << r.ns_float << " (" << std::setprecision(2)
+            << r.ns_double / r.ns_float << "x)" << std::defaultfloat << "\n";
+}
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// two_stream - canopy_layer_lai() + two_stream_solver()
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+template <typename R> struct TwoStreamFields {
+  TwoStreamFields(const std::vector<Step>& s, const int n)
+      : nrad("nrad", n), ncan("ncan", n), elai{cycle_fill_1<double>(s, "elai", n)},
+        esai{cycle_fill_1<double>(s, "esai", n)}, tlai{cycle_fill_1<double>(s, "tlai", n)},
+        tsai{cycle_fill_1<double>(s, "tsai", n)}, coszen{cycle_fill_1<double>(s, "coszen", n)},
+        t_veg{cycle_fill_1<double>(s, "t_veg", n)}, fwet{cycle_fill_1<double>(s, "fwet", n)},
+        vcmaxcintsun("vcmaxcintsun", n), vcmaxcintsha("vcmaxcintsha", n), tlai_z("tlai_z", n, nlevcan),
+        tsai_z("tsai_z", n, nlevcan), albgrd{cycle_fill<R>(s, "albgrd", n)}, albgri{cycle_fill<R>(s, "albgri", n)},
+        albd("albd", n, numrad), ftid("ftid", n, numrad), ftdd("ftdd", n, numrad), fabd("fabd", n, numrad),
+        fabd_sun("fabd_sun", n, numrad), fabd_sha("fabd_sha", n, numrad), albi("albi", n, numrad),
+        ftii("ftii", n, numrad), fabi("fabi", n, numrad), fabi_sun("fabi_sun", n, numrad),
+        fabi_sha("fabi_sha", n, numrad), fsun_z("fsun_z", n, nlevcan), fabd_sun_z("fabd_sun_z", n, nlevcan),
+        fabd_sha_z("fabd_sha_z", n, nlevcan), fabi_sun_z("fabi_sun_z", n, nlevcan),
+        fabi_sha_z("fabi_sha_z", n, nlevcan) {}
+
+  // fields stored as R
+  std::vector<ELM::Array<R, 2>> rad() const {
+    return {albgrd, albgri, albd, ftid, ftdd, fabd, fabd_sun, fabd_sha, albi, ftii, fabi, fabi_sun, fabi_sha,
+            fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z};
+  }
+
+  ELM::Array<int, 1> nrad, ncan;
+  ELM::Array<double, 1> elai, esai, tlai, tsai, coszen, t_veg, fwet, vcmaxcintsun, vcmaxcintsha;
+  ELM::Array<double, 2> tlai_z, tsai_z;
+  ELM::Array<R, 2> albgrd, albgri, albd, ftid, ftdd, fabd, fabd_sun, fabd_sha, albi, ftii, fabi, fabi_sun, fabi_sha;
+  ELM::Array<R, 2> fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z;
+};
+
+template <typename R> struct TwoStream {
+  TwoStream(const ELM::LandType& Land, const ELM::PFTDataAlb& alb_pft, const TwoStreamFields<R>& f)
+      : Land_{Land}, alb_pft_{alb_pft}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    ELM::surface_albedo::canopy_layer_lai(Land_.urbpoi, f_.elai(i), f_.esai(i), f_.tlai(i), f_.tsai(i), f_.nrad(i),
+                                          f_.ncan(i), f_.tlai_z[i], f_.tsai_z[i], f_.fsun_z[i], f_.fabd_sun_z[i],
+                                          f_.fabd_sha_z[i], f_.fabi_sun_z[i], f_.fabi_sha_z[i]);
+    ELM::surface_albedo::two_stream_solver(
+        Land_, f_.nrad(i), f_.coszen(i), f_.t_veg(i), f_.fwet(i), f_.elai(i), f_.esai(i), f_.tlai_z[i],
+        f_.tsai_z[i], f_.albgrd[i], f_.albgri[i], alb_pft_, f_.vcmaxcintsun(i), f_.vcmaxcintsha(i), f_.albd[i],
+        f_.ftid[i], f_.ftdd[i], f_.fabd[i], f_.fabd_sun[i], f_.fabd_sha[i], f_.albi[i], f_.ftii[i], f_.fabi[i],
+        f_.fabi_sun[i], f_.fabi_sha[i], f_.fsun_z[i], f_.fabd_sun_z[i], f_.fabd_sha_z[i], f_.fabi_sun_z[i],
+        f_.fabi_sha_z[i]);
+  }
+
+private:
+  ELM::LandType Land_;
+  ELM::PFTDataAlb alb_pft_;
+  TwoStreamFields<R> f_;
+};
+
+PathReport two_stream_path(const Options& opts) {
+  const auto Land = fixture_land();
+  std::vector<Step> steps;
+  for (const auto& s : read_fixture(opts.data_dir + "/SurfaceAlbedo_OUT.txt")) {
+    if (ELM::surface_albedo::vegsol(Land, get(s, "coszen")[0], get(s, "elai")[0], get(s, "esai")[0])) {
+      steps.push_back(s);
+    }
+  }
+  const auto alb_pft = fixture_alb_pft(steps.at(0), Land.vtype);
+
+  PathReport r{"two_stream (" + std::to_string(steps.size()) + " sunlit steps of SurfaceAlbedo_OUT.txt)", 1.0e-5};
+  TwoStreamFields<double> fd(steps, opts.ncells);
+  TwoStreamFields<float> ff(steps, opts.ncells);
+  r.ns_double = time_ns_per_cell(opts, [&] { invoke_kernel(TwoStream(Land, alb_pft, fd), std::make_tuple(opts.ncells)); });
+  r.ns_float = time_ns_per_cell(opts, [&] { invoke_kernel(TwoStream(Land, alb_pft, ff), std::make_tuple(opts.ncells)); });
+
+  const auto rad_d = fd.rad();
+  const auto rad_f = ff.rad();
+  for (size_t v = 2; v != rad_d.size(); ++v) {
+    r.errors.push_back(compare(rad_d[v], rad_f[v], steps.size(), &steps));
+  }
+  for (const auto& arr : rad_f) {
+    r.bytes_float += arr.size() / opts.ncells * sizeof(float);
+    r.bytes_double += arr.size() / opts.ncells * sizeof(double);
+  }
+  return r;
+}
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// sunshade - canopy_sunshade_fractions(), absorbed PAR passed on to photosynthesis
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+template <typename R> struct SunShadeFields {
+  SunShadeFields(const std::vector<Step>& s, const int n)
+      : nrad{cycle_fill_1<int>(s, "nrad", n)}, elai{cycle_fill_1<double>(s, "elai", n)},
+        laisun("laisun", n), laisha("laisha", n), tlai_z{cycle_fill<double>(s, "tlai_z", n)},
+        forc_solad{cycle_fill<double>(s, "forc_solad", n)}, forc_solai{cycle_fill<double>(s, "forc_solai", n)},
+        parsun_z("parsun_z", n, nlevcan), parsha_z("parsha_z", n, nlevcan), laisun_z("laisun_z", n, nlevcan),
+        laisha_z("laisha_z", n, nlevcan), fsun_z{cycle_fill<R>(s, "fsun_z", n)},
+        fabd_sun_z{cycle_fill<R>(s, "fabd_sun_z", n)}, fabd_sha_z{cycle_fill<R>(s, "fabd_sha_z", n)},
+        fabi_sun_z{cycle_fill<R>(s, "fabi_sun_z", n)}, fabi_sha_z{cycle_fill<R>(s, "fabi_sha_z", n)} {}
+
+  ELM::Array<int, 1> nrad;
+  ELM::Array<double, 1> elai, laisun, laisha;
+  ELM::Array<double, 2> tlai_z, forc_solad, forc_solai, parsun_z, parsha_z, laisun_z, laisha_z;
+  ELM::Array<R, 2> fsun_z, fabd_sun_z, fabd_sha_z, fabi_sun_z, fabi_sha_z;
+};
+
+template <typename R> struct SunShade {
+  SunShade(const ELM::LandType& Land, const SunShadeFields<R>& f) : Land_{Land}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    ELM::surface_radiation::canopy_sunshade_fractions(
+        Land_, f_.nrad(i), f_.elai(i), f_.tlai_z[i], f_.fsun_z[i], f_.forc_solad[i], f_.forc_solai[i],
+        f_.fabd_sun_z[i], f_.fabd_sha_z[i], f_.fabi_sun_z[i], f_.fabi_sha_z[i], f_.parsun_z[i], f_.parsha_z[i],
+        f_.laisun_z[i], f_.laisha_z[i], f_.laisun(i), f_.laisha(i));
+  }
+
+private:
+  ELM::LandType Land_;
+  SunShadeFields<R> f_;
+};
+
+PathReport sunshade_path(const Options& opts) {
+  const auto Land = fixture_land();
+  const auto steps = read_fixture(opts.data_dir + "/CanopySunShadeFractions_IN.txt");
+
+  PathReport r{"sunshade (" + std::to_string(steps.size()) + " steps of CanopySunShadeFractions_IN.txt, W/m2)", 1.0e-3};
+  SunShadeFields<double> fd(steps, opts.ncells);
+  SunShadeFields<float> ff(steps, opts.ncells);
+  r.ns_double = time_ns_per_cell(opts, [&] { invoke_kernel(SunShade(Land, fd), std::make_tuple(opts.ncells)); });
+  r.ns_float = time_ns_per_cell(opts, [&] { invoke_kernel(SunShade(Land, ff), std::make_tuple(opts.ncells)); });
+
+  // the fixture is an input file, its par/lai values are from the previous call and not compared
+  r.errors.push_back(compare(fd.parsun_z, ff.parsun_z, steps.size()));
+  r.errors.push_back(compare(fd.parsha_z, ff.parsha_z, steps.size()));
+  r.errors.push_back(compare(fd.laisun_z, ff.laisun_z, steps.size()));
+  r.errors.push_back(compare(fd.laisha_z, ff.laisha_z, steps.size()));
+  r.bytes_double = 5 * nlevcan * sizeof(double);
+  r.bytes_float = 5 * nlevcan * sizeof(float);
+  return r;
+}
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// absorbed - total_absorbed_radiation() + reflected_radiation()
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+template <typename R> struct AbsorbedFields {
+  AbsorbedFields(const std::vector<Step>& s, const int n)
+      : snl{cycle_fill_1<int>(s, "snl", n)}, sabv("sabv", n, 1), fsa("fsa", n, 1), sabg("sabg", n, 1),
+        sabg_soil("sabg_soil", n, 1), sabg_snow("sabg_snow", n, 1), fsr("fsr", n, 1),
+        forc_solad{cycle_fill<double>(s, "forc_solad", n)}, forc_solai{cycle_fill<double>(s, "forc_solai", n)},
+        albsod{cycle_fill<double>(s, "albsod", n)}, albsoi{cycle_fill<double>(s, "albsoi", n)},
+        albsnd_hst{cycle_fill<double>(s, "albsnd_hst", n)}, albsni_hst{cycle_fill<double>(s, "albsni_hst", n)},
+        ftdd{cycle_fill<R>(s, "ftdd", n)}, ftid{cycle_fill<R>(s, "ftid", n)}, ftii{cycle_fill<R>(s, "ftii", n)},
+        fabd{cycle_fill<R>(s, "fabd", n)}, fabi{cycle_fill<R>(s, "fabi", n)}, albgrd{cycle_fill<R>(s, "albgrd", n)},
+        albgri{cycle_fill<R>(s, "albgri", n)}, albd{cycle_fill<R>(s, "albd", n)}, albi{cycle_fill<R>(s, "albi", n)} {}
+
+  ELM::Array<int, 1> snl;
+  ELM::Array<double, 2> sabv, fsa, sabg, sabg_soil, sabg_snow, fsr;
+  ELM::Array<double, 2> forc_solad, forc_solai, albsod, albsoi, albsnd_hst, albsni_hst;
+  ELM::Array<R, 2> ftdd, ftid, ftii, fabd, fabi, albgrd, albgri, albd, albi;
+};
+
+template <typename R> struct Absorbed {
+  Absorbed(const ELM::LandType& Land, const AbsorbedFields<R>& f) : Land_{Land}, f_{f} {}
+
+  ACCELERATE
+  void operator()(const int i) const {
+    double trd[numrad], tri[numrad];
+    ELM::surface_radiation::total_absorbed_radiation(
+        Land_, f_.snl(i), f_.ftdd[i], f_.ftid[i], f_.ftii[i], f_.forc_solad[i], f_.forc_solai[i], f_.fabd[i],
+        f_.fabi[i], f_.albsod[i], f_.albsoi[i], f_.albsnd_hst[i], f_.albsni_hst[i], f_.albgrd[i], f_.albgri[i],
+        f_.sabv(i, 0), f_.fsa(i, 0), f_.sabg(i, 0), f_.sabg_soil(i, 0), f_.sabg_snow(i, 0), trd, tri);
+    ELM::surface_radiation::reflected_radiation(Land_, f_.albd[i], f_.albi[i], f_.forc_solad[i], f_.forc_solai[i],
+                                                f_.fsr(i, 0));
+  }
+
+private:
+  ELM::LandType Land_;
+  AbsorbedFields<R> f_;
+};
+
+PathReport absorbed_path(const Options& opts) {
+  const auto Land = fixture_land();
+  const auto steps = read_fixture(opts.data_dir + "/SurfaceRadiation_IN.txt");
+
+  PathReport r{"absorbed (" + std::to_string(steps.size()) + " steps of SurfaceRadiation_IN.txt, W/m2)", 1.0e-3};
+  AbsorbedFields<double> fd(steps, opts.ncells);
+  AbsorbedFields<float> ff(steps, opts.ncells);
+  r.ns_double = time_ns_per_cell(opts, [&] { invoke_kernel(Absorbed(Land, fd), std::make_tuple(opts.ncells)); });
+  r.ns_float = time_ns_per_cell(opts, [&] { invoke_kernel(Absorbed(Land, ff), std::make_tuple(opts.ncells)); });
+
+  for (const auto& [d, f] : {std::make_pair(fd.sabv, ff.sabv), std::make_pair(fd.fsa, ff.fsa),
+                             std::make_pair(fd.sabg, ff.sabg), std::make_pair(fd.sabg_soil, ff.sabg_soil),
+                             std::make_pair(fd.sabg_snow, ff.sabg_snow), std::make_pair(fd.fsr, ff.fsr)}) {
+    r.errors.push_back(compare(d, f, steps.size()));
+  }
+  r.bytes_double = 9 * numrad * sizeof(double);
+  r.bytes_float = 9 * numrad * sizeof(float);
+  return r;
+}
+
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+// phenology - ComputePhenology over synthetic monthly data
+/* =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-*/
+
+template <typename R> struct PhenologyFields {
+  explicit PhenologyFields(const int n)
+      : mlai("mlai", 3, n), msai("msai", 3, n), mhtop("mhtop", 3, n), mhbot("mhbot", 3, n), elai("elai", n),
+        esai("esai", n), htop("htop", n), hbot("hbot", n), tlai("tlai", n), tsai("tsai", n) {
+    // lai 0 - 6, sai 0 - 2, heights 0.05 - 30 m, smooth month to month changes
+    for (int i = 0; i < n; ++i) {
+      const double x = (i % 1009) / 1009.0;
+      for (int m = 0; m < 3; ++m) {
+        mlai(m, i) = 6.0 * x * (0.8 + 0.1 * m);
+        msai(m, i) = 2.0 * (1.0 - x) * (0.9 + 0.05 * m);
+        mhtop(m, i) = 0.1 + 29.9 * x;
+        mhbot(m, i) = 0.05 + 10.0 * x;
+      }
+    }
+  }
+
+  ELM::Array<R, 2> mlai, msai, mhtop, mhbot;
+  ELM::Array<R, 1> elai, esai, htop, hbot, tlai, tsai;
+};
+
+PathReport phenology_path(const Options& opts) {
+  const int n = opts.ncells;
+  ELM::Array<double, 1> snow_depth("snow_depth", n), frac_sno("frac_sno", n);
+  ELM::Array<int, 1> vtype("vtype", n);
+  for (int i = 0; i < n; ++i) {
+    snow_depth(i) = 0.5 * ((i * 7) % 101) / 100.0;
+    frac_sno(i) = ((i * 13) % 97) / 96.0;
+    vtype(i) = i % 17;
+  }
+  ELM::Array<int, 1> fveg_d("frac_veg_nosno_alb", n), fveg_f("frac_veg_nosno_alb", n);
+  const double wt1 = 0.37, wt2 = 0.63;
+
+  PathReport r{"phenology (" + std::to_string(n) + " cells of synthetic monthly data, no fixture)", 1.0e-5};
+  PhenologyFields<double> fd(n);
+  PhenologyFields<float> ff(n);
+  auto run = [&](const auto& f, const ELM::Array<int, 1>& fveg) {
+    ELM::phenology::ComputePhenology compute(f.mlai, f.msai, f.mhtop, f.mhbot, snow_depth, frac_sno, vtype, wt1, wt2,
+                                             0, 1, f.elai, f.esai, f.htop, f.hbot, f.tlai, f.tsai, fveg);
+    return time_ns_per_cell(opts, [&] { invoke_kernel(compute, std::make_tuple(n)); });
+  };
+  r.ns_double = run(fd, fveg_d);
+  r.ns_float = run(ff, fveg_f);
+
+  r.errors.push_back(compare(fd.elai, ff.elai, n));
+  r.errors.push_back(compare(fd.esai, ff.esai, n));
+  r.errors.push_back(compare(fd.tlai, ff.tlai, n));
+  r.errors.push_back(compare(fd.htop, ff.htop, n));
+  r.errors.push_back(compare(fd.hbot, ff.hbot, n));
+  FieldError fveg{"frac_veg_nosno_alb"};
+  for (int i = 0; i < n; ++i) {
+    fveg.max_abs = std::max(fveg.max_abs, std::abs(static_cast<double>(fveg_d(i) - fveg_f(i))));
+  }
+  r.errors.push_back(fveg);
+  // 4 monthly fields x 3 months + 6 interpolated fields
+  r.bytes_double = 18 * sizeof(double);
+  r.bytes_float = 18 * sizeof(float);
+  return r;
+}
+
+bool passed(const PathReport& r) {
+  return std::all_of(r.errors.begin(), r.errors.end(), [&](const FieldError& e) { return e.max_abs <= r.tol; });
+}
+
+Options parse_options(int argc, char** argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    if (arg == "--data-dir" && i + 1 < argc) {
+      opts.data_dir = argv[++i];
+    } else if (arg == "--cells" && i + 1 < argc) {
+      opts.ncells = std::stoi(argv[++i]);
+    } else if (arg == "--reps" && i + 1 < argc) {
+      opts.nreps = std::stoi(argv[++i]);
+    } else {
+      throw std::runtime_error("ELM ERROR: bench_precision unknown option " + arg);
+    }
+  }
+  return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  try {
+    const auto opts = parse_options(argc, argv);
+    std::cout << "float vs double storage, " << opts.ncells << " cells, " << opts.nreps << " reps" << std::endl;
+    bool ok = true;
+    for (const auto& report : {two_stream_path(opts), sunshade_path(opts), absorbed_path(opts), phenology_path(opts)}) {
+      print(report);
+      ok = passed(report) && ok;
+    }
+    if (!ok) {
+      std::cerr << "ELM ERROR: bench_precision float results exceed tolerance" << std::endl;
+      return 1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+  return 0;
+}
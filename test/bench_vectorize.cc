@@ -0,0 +1,213 @@
+#include "array.hh"
+#include "array_span.hh"
+
+#include "elm_constants.h"
+#include "qsat.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+
+host vectorization benchmark for ELM::Array kernels
+
+compares the same per-cell physics written three ways
+  array  - a cell loop indexing ELM::Array, as invoke_kernel runs functors on the host
+  span   - for_cell_blocks + simd_for over restrict-qualified, aligned Spans
+  left   - (cell, lev) data in a LayoutLeft LayoutArray, cells innermost
+
+kernels:
+qsat                 ELM::qsat() for every cell
+column_water         sum over nlevgrnd of h2osoi_liq + h2osoi_ice for every cell
+
+results of the three forms are checked against each other
+
+the target is built with the compiler's vectorization report enabled (see test/CMakeLists.txt),
+loops that vectorized are reported against array_span.hh (simd_for) and this file
+
+usage:
+bench_vectorize [--cells N] [--reps N]
+*/
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr int nlevgrnd = ELM::ELMdims::nlevgrnd;
+
+struct Options {
+  int ncells{1 << 16};
+  int nreps{20};
+};
+
+Options parse_options(int argc, char** argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    if (arg == "--cells" && i + 1 < argc) {
+      opts.ncells = std::stoi(argv[++i]);
+    } else if (arg == "--reps" && i + 1 < argc) {
+      opts.nreps = std::stoi(argv[++i]);
+    } else {
+      throw std::runtime_error("ELM ERROR: bench_vectorize unknown option " + arg);
+    }
+  }
+  return opts;
+}
+
+// median ns/cell of nreps calls of f
+template <class F> double time_ns_per_cell(const Options& opts, F&& f) {
+  std::vector<double> t(opts.nreps);
+  for (auto& ti : t) {
+    const auto t0 = clock_type::now();
+    f();
+    const std::chrono::duration<double, std::nano> elapsed = clock_type::now() - t0;
+    ti = elapsed.count() / opts.ncells;
+  }
+  std::sort(t.begin(), t.end());
+  return t[t.size() / 2];
+}
+
+double max_rel_diff(const double* a, const double* b, const size_t n) {
+  double diff = 0.0;
+  for (size_t i = 0; i != n; ++i) {
+    diff = std::max(diff, std::abs(a[i] - b[i]) / std::max(std::abs(a[i]), 1.0e-30));
+  }
+  return diff;
+}
+
+void report(const std::string& kernel, const std::string& form, const double& ns, const double& ref_ns,
+            const double& diff) {
+  std::cout << std::left << std::setw(16) << kernel << std::setw(8) << form << std::right << std::fixed
+            << std::setprecision(2) << std::setw(12) << ns << std::setw(10) << ref_ns / ns << std::scientific
+            << std::setprecision(1) << std::setw(12) << diff << std::defaultfloat << "\n";
+}
+
+// saturation vapor pressure and humidity over a range of temperature and pressure
+bool bench_qsat(const Options& opts) {
+  const int n = opts.ncells;
+  ELM::Array<double, 1> t("t", n), p("p", n);
+  for (int i = 0; i != n; ++i) {
+    t(i) = 230.0 + 80.0 * (i % 997) / 997.0;
+    p(i) = 8.0e4 + 2.0e4 * (i % 113) / 113.0;
+  }
+
+  std::vector<ELM::Array<double, 1>> out;
+  for (const auto& name : {"es", "esdT", "qs", "qsdT"}) {
+    out.emplace_back(name, n);
+  }
+  const auto es = out[0], esdT = out[1], qs = out[2], qsdT = out[3];
+  const double array_ns = time_ns_per_cell(opts, [&] {
+    for (int i = 0; i < n; ++i) {
+      ELM::qsat(t(i), p(i), es(i), esdT(i), qs(i), qsdT(i));
+    }
+  });
+
+  std::vector<ELM::Array<double, 1>> out_s;
+  for (const auto& name : {"es_s", "esdT_s", "qs_s", "qsdT_s"}) {
+    out_s.emplace_back(name, n);
+  }
+  const auto t_s = ELM::make_span(t), p_s = ELM::make_span(p);
+  const auto es_s = ELM::make_span(out_s[0]), esdT_s = ELM::make_span(out_s[1]);
+  const auto qs_s = ELM::make_span(out_s[2]), qsdT_s = ELM::make_span(out_s[3]);
+  const double span_ns = time_ns_per_cell(opts, [&] {
+    ELM::for_cell_blocks(n, [&](const int begin, const int end) {
+      ELM::simd_for(begin, end, [&](const int i) {
+        ELM::qsat(t_s(i), p_s(i), es_s(i), esdT_s(i), qs_s(i), qsdT_s(i));
+      });
+    });
+  });
+
+  double diff = 0.0;
+  for (int v = 0; v != 4; ++v) {
+    diff = std::max(diff, max_rel_diff(out[v].data(), out_s[v].data(), n));
+  }
+  report("qsat", "array", array_ns, array_ns, 0.0);
+  report("qsat", "span", span_ns, array_ns, diff);
+  return diff < 1.0e-12;
+}
+
+// total soil water per column
+bool bench_column_water(const Options& opts) {
+  const int n = opts.ncells;
+  ELM::Array<double, 2> liq("h2osoi_liq", n, nlevgrnd), ice("h2osoi_ice", n, nlevgrnd);
+  ELM::LayoutArray<double, 2, ELM::LayoutLeft> liq_l("h2osoi_liq_left", {n, nlevgrnd});
+  ELM::LayoutArray<double, 2, ELM::LayoutLeft> ice_l("h2osoi_ice_left", {n, nlevgrnd});
+  for (int i = 0; i != n; ++i) {
+    for (int j = 0; j != nlevgrnd; ++j) {
+      liq(i, j) = liq_l(i, j) = 10.0 + (i * 7 + j * 3) % 17;
+      ice(i, j) = ice_l(i, j) = (i + j) % 5 == 0 ? 2.5 : 0.0;
+    }
+  }
+  ELM::Array<double, 1> total("total", n), total_s("total_s", n), total_l("total_l", n);
+
+  const double array_ns = time_ns_per_cell(opts, [&] {
+    for (int i = 0; i < n; ++i) {
+      double sum = 0.0;
+      for (int j = 0; j < nlevgrnd; ++j) {
+        sum += liq(i, j) + ice(i, j);
+      }
+      total(i) = sum;
+    }
+  });
+
+  // same LayoutRight data, blocked over cells with restrict spans
+  const auto liq_s = ELM::make_span(liq), ice_s = ELM::make_span(ice);
+  const auto tot_s = ELM::make_span(total_s);
+  const double span_ns = time_ns_per_cell(opts, [&] {
+    ELM::for_cell_blocks(n, [&](const int begin, const int end) {
+      ELM::simd_for(begin, end, [&](const int i) {
+        double sum = 0.0;
+        for (int j = 0; j < nlevgrnd; ++j) {
+          sum += liq_s(i, j) + ice_s(i, j);
+        }
+        tot_s(i) = sum;
+      });
+    });
+  });
+
+  // LayoutLeft - levels outermost inside a block, unit stride over cells
+  const auto liq_ls = liq_l.span(), ice_ls = ice_l.span();
+  const auto tot_l = ELM::make_span(total_l);
+  const double left_ns = time_ns_per_cell(opts, [&] {
+    ELM::for_cell_blocks(n, [&](const int begin, const int end) {
+      ELM::simd_for(begin, end, [&](const int i) { tot_l(i) = 0.0; });
+      for (int j = 0; j < nlevgrnd; ++j) {
+        ELM::simd_for(begin, end, [&](const int i) { tot_l(i) += liq_ls(i, j) + ice_ls(i, j); });
+      }
+    });
+  });
+
+  const double diff = std::max(max_rel_diff(total.data(), total_s.data(), n),
+                               max_rel_diff(total.data(), total_l.data(), n));
+  report("column_water", "array", array_ns, array_ns, 0.0);
+  report("column_water", "span", span_ns, array_ns, max_rel_diff(total.data(), total_s.data(), n));
+  report("column_water", "left", left_ns, array_ns, max_rel_diff(total.data(), total_l.data(), n));
+  return diff < 1.0e-12;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  try {
+    const auto opts = parse_options(argc, argv);
+    std::cout << opts.ncells << " cells, " << opts.nreps << " reps\n\n";
+    std::cout << std::left << std::setw(16) << "kernel" << std::setw(8) << "form" << std::right << std::setw(12)
+              << "ns/cell" << std::setw(10) << "speedup" << std::setw(12) << "max rdiff" << "\n";
+    bool ok = bench_qsat(opts);
+    ok = bench_column_water(opts) && ok;
+    if (!ok) {
+      std::cerr << "ELM ERROR: bench_vectorize results differ between forms" << std::endl;
+      return 1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+  return 0;
+}